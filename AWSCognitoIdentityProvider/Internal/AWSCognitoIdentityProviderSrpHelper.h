@@ -18,6 +18,11 @@ NS_ASSUME_NONNULL_BEGIN
 - (instancetype)initN:(AWSJKBigInteger *)N g:(AWSJKBigInteger *)g k:(AWSJKBigInteger *)k;
 - (AWSJKBigInteger*)calculateK:(AWSJKBigInteger*)N g:(AWSJKBigInteger*)g;
 
+/**
+ g^exponent mod N. For the default group this uses a table of precomputed powers of g, shared by every state.
+ */
+- (AWSJKBigInteger*)powerOfG:(AWSJKBigInteger*)exponent;
+
 @property(nonatomic, retain) AWSJKBigInteger *N;
 @property(nonatomic, retain) AWSJKBigInteger *g;
 @property(nonatomic, retain) AWSJKBigInteger *k;
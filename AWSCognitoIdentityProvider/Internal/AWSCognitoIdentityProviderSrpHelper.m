@@ -23,15 +23,142 @@ AWSJKBigInteger* finalizeSignedBigIntHash(CC_SHA256_CTX *ctx);
 
 static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129024E088A67CC74020BBEA63B139B22514A08798E3404DDEF9519B3CD3A431B302B0A6DF25F14374FE1356D6D51C245E485B576625E7EC6F44C42E9A637ED6B0BFF5CB6F406B7EDEE386BFB5A899FA5AE9F24117C4B1FE649286651ECE45B3DC2007CB8A163BF0598DA48361C55D39A69163FA8FD24CF5F83655D23DCA3AD961C62F356208552BB9ED529077096966D670C354E4ABC9804F1746C08CA18217C32905E462E36CE3BE39E772C180E86039B2783A2EC07A28FB5C55DF06F4C52C9DE2BCBF6955817183995497CEA956AE515D2261898FA051015728E5A8AAAC42DAD33170D04507A33A85521ABDF1CBA64ECFB850458DBEF0A8AEA71575D060C7DB3970F85A6E1E4C7ABF5AE8CDB0933D71E8C94E04A25619DCEE3D2261AD2EE6BF12FFA06D98A0864D87602733EC86A64521F2B18177B200CBBE117577A615D6C770988C0BAD946E208E24FA074E5AB3143DB5BFCE0FD108E4B82D120A93AD2CAFFFFFFFFFFFFFFFF";
 
+enum {
+    // The private value a and the password hash x are both 256 bits.
+    AWSSrpFixedBaseExponentBits = 256,
+    AWSSrpFixedBaseWindowBits = 4,
+    AWSSrpFixedBaseTableLength = AWSSrpFixedBaseExponentBits / AWSSrpFixedBaseWindowBits,
+};
+
+#pragma mark - Fixed-base exponentiation
+
+/*
+ Computes g^e mod N for a fixed g with the method of Brickell, Gordon, McCurley and Wilson. The table holds
+ g^(16^i) for each 4-bit digit of a 256-bit exponent, so an exponentiation takes no squarings and at most 94
+ multiplications instead of the 256 squarings of the generic method. Values are kept in Montgomery form.
+ The table is read-only once built and can be shared between threads.
+ */
+@interface AWSCognitoIdentityProviderSrpFixedBaseTable : NSObject
+
+- (instancetype)initWithBase:(AWSJKBigInteger*)g modulus:(AWSJKBigInteger*)N;
+
+// Returns nil if the exponent is negative or longer than the table covers.
+- (AWSJKBigInteger*)powWithExponent:(AWSJKBigInteger*)exponent;
+
+@end
+
+@implementation AWSCognitoIdentityProviderSrpFixedBaseTable {
+    aws_mp_int _N;
+    aws_mp_digit _rho;
+    // R mod N, which is 1 in Montgomery form
+    aws_mp_int _one;
+    // g^(2^(AWSSrpFixedBaseWindowBits * i)) in Montgomery form
+    aws_mp_int _powers[AWSSrpFixedBaseTableLength];
+}
+
+static int montgomeryMultiply(aws_mp_int *a, aws_mp_int *b, aws_mp_int *c, aws_mp_int *N, aws_mp_digit rho) {
+    int result = aws_mp_mul(a, b, c);
+    if (result != AWS_MP_OKAY) {
+        return result;
+    }
+    return aws_mp_montgomery_reduce(c, N, rho);
+}
+
+- (instancetype)initWithBase:(AWSJKBigInteger*)g modulus:(AWSJKBigInteger*)N {
+    if (self = [super init]) {
+        aws_mp_init_copy(&_N, [N value]);
+        aws_mp_montgomery_setup(&_N, &_rho);
+        aws_mp_init(&_one);
+        aws_mp_montgomery_calc_normalization(&_one, &_N);
+
+        aws_mp_init(&_powers[0]);
+        aws_mp_mulmod([g value], &_one, &_N, &_powers[0]);
+        for (int i = 1; i < AWSSrpFixedBaseTableLength; i++) {
+            aws_mp_init_copy(&_powers[i], &_powers[i - 1]);
+            for (int j = 0; j < AWSSrpFixedBaseWindowBits; j++) {
+                montgomeryMultiply(&_powers[i], &_powers[i], &_powers[i], &_N, _rho);
+            }
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    for (int i = 0; i < AWSSrpFixedBaseTableLength; i++) {
+        aws_mp_clear(&_powers[i]);
+    }
+    aws_mp_clear_multi(&_one, &_N, NULL);
+}
+
+- (AWSJKBigInteger*)powWithExponent:(AWSJKBigInteger*)exponent {
+    aws_mp_int *e = [exponent value];
+    if (e->sign == AWS_MP_NEG || aws_mp_count_bits(e) > AWSSrpFixedBaseExponentBits) {
+        return nil;
+    }
+
+    uint8_t bytes[AWSSrpFixedBaseExponentBits / 8] = {0};
+    int byteCount = aws_mp_unsigned_bin_size(e);
+    aws_mp_to_unsigned_bin(e, bytes + sizeof(bytes) - byteCount);
+
+    // Little-endian 4-bit digits of the exponent
+    int digits[AWSSrpFixedBaseTableLength];
+    for (int i = 0; i < AWSSrpFixedBaseTableLength; i++) {
+        uint8_t byte = bytes[sizeof(bytes) - 1 - i / 2];
+        digits[i] = (i & 1) ? byte >> 4 : byte & 0x0f;
+    }
+
+    // A = prod over d of (prod over digits[i] >= d of g^(16^i)) = prod over i of g^(digits[i] * 16^i)
+    aws_mp_int A, B;
+    aws_mp_init_copy(&A, &_one);
+    aws_mp_init_copy(&B, &_one);
+    for (int d = (1 << AWSSrpFixedBaseWindowBits) - 1; d >= 1; d--) {
+        for (int i = 0; i < AWSSrpFixedBaseTableLength; i++) {
+            if (digits[i] == d) {
+                montgomeryMultiply(&B, &_powers[i], &B, &_N, _rho);
+            }
+        }
+        montgomeryMultiply(&A, &B, &A, &_N, _rho);
+    }
+    // Leave Montgomery form
+    aws_mp_montgomery_reduce(&A, &_N, _rho);
+
+    AWSJKBigInteger *result = [[AWSJKBigInteger alloc] initWithValue:&A];
+    aws_mp_clear_multi(&A, &B, NULL);
+    return result;
+}
+
+@end
+
 #pragma mark - Srp State
+
+@interface AWSCognitoIdentityProviderSrpCommonState()
+
+@property(nonatomic, strong) AWSCognitoIdentityProviderSrpFixedBaseTable *fixedBaseTable;
+
+@end
+
 @implementation AWSCognitoIdentityProviderSrpCommonState
 - (instancetype)init {
     if (self = [super init]) {
-            self.N = [[AWSJKBigInteger alloc] initWithString:N_IN_HEX
-                                               andRadix:16];
-
-            self.g = [[AWSJKBigInteger alloc] initWithUnsignedLong:2l];
-            self.k = [self calculateK:self.N g:self.g];
+        // The group is fixed, so N, g, k and the table of powers of g are built once per process.
+        static AWSJKBigInteger *defaultN = nil;
+        static AWSJKBigInteger *defaultG = nil;
+        static AWSJKBigInteger *defaultK = nil;
+        static AWSCognitoIdentityProviderSrpFixedBaseTable *defaultFixedBaseTable = nil;
+        static dispatch_once_t onceToken;
+        dispatch_once(&onceToken, ^{
+            defaultN = [[AWSJKBigInteger alloc] initWithString:N_IN_HEX
+                                                      andRadix:16];
+            defaultG = [[AWSJKBigInteger alloc] initWithUnsignedLong:2l];
+            defaultK = [self calculateK:defaultN g:defaultG];
+            defaultFixedBaseTable = [[AWSCognitoIdentityProviderSrpFixedBaseTable alloc] initWithBase:defaultG
+                                                                                               modulus:defaultN];
+        });
+
+        self.N = defaultN;
+        self.g = defaultG;
+        self.k = defaultK;
+        self.fixedBaseTable = defaultFixedBaseTable;
     }
     return self;
 }
@@ -75,6 +202,14 @@ static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129
 
     return finalizeUnsignedBigIntHash(&ctx);
 }
+
+- (AWSJKBigInteger*)powerOfG:(AWSJKBigInteger*)exponent {
+    AWSJKBigInteger *power = [self.fixedBaseTable powWithExponent:exponent];
+    if (power) {
+        return power;
+    }
+    return [self.g pow:exponent andMod:self.N];
+}
 @end
 
 @implementation AWSCognitoIdentityProviderSrpClientState
@@ -90,10 +225,7 @@ static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129
     me.privateA = [AWSCognitoIdentityProviderSrpHelper
             generatePrivateABigInt:commonState.N];
 
-    me.publicA = [AWSCognitoIdentityProviderSrpHelper
-            generatePublicABigInt:me.privateA
-                                N:commonState.N
-                                g:commonState.g];
+    me.publicA = [commonState powerOfG:me.privateA];
 
     me.timestamp = [NSDate date];
     return me;
@@ -157,7 +289,7 @@ static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129
         self.commonState = [[AWSCognitoIdentityProviderSrpCommonState alloc] init];
 
         AWSJKBigInteger *privateA = [AWSCognitoIdentityProviderSrpHelper generatePrivateABigInt:self.commonState.N];
-        AWSJKBigInteger *publicA = [AWSCognitoIdentityProviderSrpHelper generatePublicABigInt:privateA N:self.commonState.N g:self.commonState.g];
+        AWSJKBigInteger *publicA = [self.commonState powerOfG:privateA];
 
         self.clientState = [AWSCognitoIdentityProviderSrpClientState
                 clientStateForUserName:userName password:password privateA:privateA publicA:publicA];
@@ -183,12 +315,10 @@ static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129
                               password:password
                               salt:self.salt];
 
-        AWSJKBigInteger *N = [[AWSJKBigInteger alloc] initWithString:N_IN_HEX
-                                       andRadix:16];
-        AWSJKBigInteger *g = [[AWSJKBigInteger alloc] initWithUnsignedLong:2l];
-        
+        self.commonState = [[AWSCognitoIdentityProviderSrpCommonState alloc] init];
+
         //calculate v
-        self.v = [g pow:x andMod:N];
+        self.v = [self.commonState powerOfG:x];
     }
     return self;
 }
@@ -270,16 +400,16 @@ static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129
     self.u = [AWSCognitoIdentityProviderSrpHelper hashBigInts:@[self.clientState.publicA, B]];
 
     AWSJKBigInteger *k = self.commonState.k;
-    AWSJKBigInteger *g = self.commonState.g;
     AWSJKBigInteger *N = self.commonState.N;
 
     AWSJKBigInteger *a = self.clientState.privateA;
     AWSJKBigInteger *exp = [a add:[self.u multiply:self.x]];
-    AWSJKBigInteger *base = [B subtract:[k multiply:[g pow:self.x andMod:N]]];
+    AWSJKBigInteger *base = [B subtract:[k multiply:[self.commonState powerOfG:self.x]]];
 
     //Need this for negative base #s
     base = [AWSCognitoIdentityProviderSrpHelper mod:base divisor:N];
 
+    // N is odd, so libtommath exponentiates with Montgomery reduction.
     AWSJKBigInteger *S = [base pow:exp andMod:N];
     S = [AWSCognitoIdentityProviderSrpHelper mod:S divisor:N];
     
@@ -287,11 +417,15 @@ static NSString* N_IN_HEX = @"FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD129
 }
 
 + (NSString *)generateDateString:(NSDate *)date {
-    NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"UTC"];
-    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
-    dateFormatter.timeZone = timeZone;
-    dateFormatter.dateFormat = @"EEE MMM d HH:mm:ss 'UTC' yyyy";
-    dateFormatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+    static NSDateFormatter *dateFormatter = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSTimeZone *timeZone = [NSTimeZone timeZoneWithName:@"UTC"];
+        dateFormatter = [[NSDateFormatter alloc] init];
+        dateFormatter.timeZone = timeZone;
+        dateFormatter.dateFormat = @"EEE MMM d HH:mm:ss 'UTC' yyyy";
+        dateFormatter.locale = [[NSLocale alloc] initWithLocaleIdentifier:@"en_US_POSIX"];
+    });
     return [dateFormatter stringFromDate:date];
 }
 
@@ -327,7 +461,7 @@ void updateHashWithUnsignedBigInt(CC_SHA256_CTX *ctx, AWSJKBigInteger *bigInt, u
     unsigned int byteCount = [bigInt countBytes];
     uint8_t *targetBuffer = buffer;
     
-    if (byteCount <= bufferSize) {
+    if (byteCount > bufferSize) {
         targetBuffer = malloc(sizeof(uint8_t) * byteCount);
     }
     
@@ -344,7 +478,7 @@ void updateHashWithSignedBigInt(CC_SHA256_CTX *ctx, AWSJKBigInteger *bigInt, uin
     unsigned int byteCount = [bigInt countBytes] + 1;
     uint8_t *targetBuffer = buffer;
 
-    if (byteCount <= bufferSize) {
+    if (byteCount > bufferSize) {
         targetBuffer = malloc(sizeof(uint8_t) * byteCount);
     }
 
@@ -0,0 +1,128 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCognitoIdentityProviderSrpHelper.h"
+#import "AWSJKBigInteger.h"
+
+@interface AWSCognitoIdentityProviderSrpHelperTests : XCTestCase
+
+@end
+
+@implementation AWSCognitoIdentityProviderSrpHelperTests
+
+- (AWSJKBigInteger *)randomBigIntegerWithByteLength:(NSUInteger)byteLength {
+    NSMutableData *data = [NSMutableData dataWithLength:byteLength];
+    arc4random_buf(data.mutableBytes, byteLength);
+    NSMutableString *hex = [NSMutableString stringWithString:@"0"];
+    const uint8_t *bytes = data.bytes;
+    for (NSUInteger i = 0; i < byteLength; i++) {
+        [hex appendFormat:@"%02x", bytes[i]];
+    }
+    return [[AWSJKBigInteger alloc] initWithString:hex andRadix:16];
+}
+
+- (AWSCognitoIdentityProviderSrpServerState *)serverStateWithCommonState:(AWSCognitoIdentityProviderSrpCommonState *)commonState
+                                                                password:(NSString *)password
+                                                                 userName:(NSString *)userName {
+    AWSJKBigInteger *salt = [self randomBigIntegerWithByteLength:16];
+    AWSJKBigInteger *x = [AWSCognitoIdentityProviderSrpHelper calculateX:@"pool" userName:userName password:password salt:salt];
+    AWSJKBigInteger *v = [commonState.g pow:x andMod:commonState.N];
+    AWSJKBigInteger *b = [self randomBigIntegerWithByteLength:32];
+    // B = (k * v + g^b) % N
+    AWSJKBigInteger *B = [[[commonState.k multiply:v] add:[commonState.g pow:b andMod:commonState.N]] remainder:commonState.N];
+
+    return [AWSCognitoIdentityProviderSrpServerState serverStateForPoolName:@"pool"
+                                                           publicBHexString:[B stringValueWithRadix:16]
+                                                              saltHexString:[salt stringValueWithRadix:16]
+                                                             derivedKeyInfo:@"Caldera Derived Key"
+                                                             derivedKeySize:16
+                                                         serviceSecretBlock:[NSData data]];
+}
+
+- (void)testCommonStateIsBuiltOnce {
+    AWSCognitoIdentityProviderSrpCommonState *first = [AWSCognitoIdentityProviderSrpCommonState new];
+    AWSCognitoIdentityProviderSrpCommonState *second = [AWSCognitoIdentityProviderSrpCommonState new];
+
+    XCTAssertEqual(first.N, second.N);
+    XCTAssertEqual(first.k, second.k);
+    XCTAssertEqual([[first calculateK:first.N g:first.g] compare:first.k], NSOrderedSame);
+}
+
+- (void)testPowerOfGMatchesGenericExponentiation {
+    AWSCognitoIdentityProviderSrpCommonState *commonState = [AWSCognitoIdentityProviderSrpCommonState new];
+    NSMutableArray<AWSJKBigInteger *> *exponents = [NSMutableArray arrayWithObjects:
+                                                    [[AWSJKBigInteger alloc] initWithUnsignedLong:0],
+                                                    [[AWSJKBigInteger alloc] initWithUnsignedLong:1],
+                                                    [[AWSJKBigInteger alloc] initWithString:@"FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF" andRadix:16],
+                                                    nil];
+    for (NSUInteger i = 0; i < 32; i++) {
+        [exponents addObject:[self randomBigIntegerWithByteLength:i + 1]];
+    }
+
+    for (AWSJKBigInteger *exponent in exponents) {
+        AWSJKBigInteger *expected = [commonState.g pow:exponent andMod:commonState.N];
+        XCTAssertEqual([[commonState powerOfG:exponent] compare:expected], NSOrderedSame, @"exponent %@", exponent);
+    }
+}
+
+- (void)testPowerOfGFallsBackForLongExponents {
+    AWSCognitoIdentityProviderSrpCommonState *commonState = [AWSCognitoIdentityProviderSrpCommonState new];
+    AWSJKBigInteger *exponent = [self randomBigIntegerWithByteLength:64];
+    AWSJKBigInteger *expected = [commonState.g pow:exponent andMod:commonState.N];
+
+    XCTAssertEqual([[commonState powerOfG:exponent] compare:expected], NSOrderedSame);
+}
+
+- (void)testCalculateSMatchesGenericExponentiation {
+    AWSCognitoIdentityProviderSrpHelper *helper = [AWSCognitoIdentityProviderSrpHelper beginUserAuthentication:@"user" password:@"password"];
+    AWSCognitoIdentityProviderSrpCommonState *commonState = helper.commonState;
+    AWSCognitoIdentityProviderSrpServerState *serverState = [self serverStateWithCommonState:commonState password:@"password" userName:@"user"];
+
+    AWSJKBigInteger *S = [helper calculateS:serverState];
+
+    // S = ((B - k * g^x) ^ (a + u * x)) % N
+    AWSJKBigInteger *N = commonState.N;
+    AWSJKBigInteger *base = [serverState.publicB subtract:[commonState.k multiply:[commonState.g pow:helper.x andMod:N]]];
+    base = [[N add:[base remainder:N]] remainder:N];
+    AWSJKBigInteger *exponent = [helper.clientState.privateA add:[helper.u multiply:helper.x]];
+    XCTAssertEqual([S compare:[base pow:exponent andMod:N]], NSOrderedSame);
+    XCTAssertEqual([helper.clientState.publicA compare:[commonState.g pow:helper.clientState.privateA andMod:N]], NSOrderedSame);
+}
+
+#pragma mark - Benchmarks
+
+// Client side of step one of USER_SRP_AUTH: a and A = g^a.
+- (void)testBeginUserAuthenticationPerformance {
+    [AWSCognitoIdentityProviderSrpCommonState new];
+    [self measureBlock:^{
+        for (int i = 0; i < 20; i++) {
+            XCTAssertNotNil([AWSCognitoIdentityProviderSrpHelper beginUserAuthentication:@"user" password:@"password"]);
+        }
+    }];
+}
+
+// Client side of step two: S, the authentication key and the signature.
+- (void)testCompleteAuthenticationPerformance {
+    AWSCognitoIdentityProviderSrpHelper *helper = [AWSCognitoIdentityProviderSrpHelper beginUserAuthentication:@"user" password:@"password"];
+    AWSCognitoIdentityProviderSrpServerState *serverState = [self serverStateWithCommonState:helper.commonState password:@"password" userName:@"user"];
+    [self measureBlock:^{
+        for (int i = 0; i < 20; i++) {
+            XCTAssertNotNil([helper completeAuthentication:serverState]);
+        }
+    }];
+}
+
+@end
@@ -56,6 +56,7 @@ FOUNDATION_EXPORT const unsigned char AWSCoreVersionString[] DEPRECATED_MSG_ATTR
 #import "AWSTimestampSerialization.h"
 #import "AWSURLRequestSerialization.h"
 #import "AWSURLResponseSerialization.h"
+#import "AWSEventStreamCodec.h"
 #import "AWSURLSessionManager.h"
 #import "AWSSignature.h"
 #import "AWSURLRequestRetryHandler.h"
@@ -19,7 +19,15 @@
 FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Algorithm;
 FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
 
+/**
+ `NSURLProtocol` property key under which the V4 signer stores the hex-encoded SHA-256 of a request's `HTTPBody`. A
+ request carrying this property is signed with the stored hash instead of hashing the body again, so it must only be
+ copied along with an unchanged body.
+ */
+FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4PayloadHashPropertyKey;
+
 @class AWSEndpoint;
+@class AWSCredentials;
 
 @protocol AWSCredentialsProvider;
 
@@ -43,6 +51,11 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
 
 @property (nonatomic, strong, readonly) id<AWSCredentialsProvider> _Nonnull credentialsProvider;
 
+/**
+ The number of payload bytes in each chunk of S3 request bodies that are streamed with `aws-chunked` encoding. 0, the default, uses `AWSS3ChunkedEncodingDefaultChunkSize`. See `AWSS3ChunkedEncodingInputStream`.
+ */
+@property (nonatomic, assign) NSUInteger chunkedEncodingChunkSize;
+
 - (instancetype _Nonnull)initWithCredentialsProvider:(id<AWSCredentialsProvider> _Nonnull)credentialsProvider
                                    endpoint:(AWSEndpoint * _Nonnull)endpoint;
 
@@ -98,6 +111,12 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
                                                 signBody:(BOOL)signBody
                                         signSessionToken:(BOOL)signSessionToken;
 
+/**
+ Returns the hex-encoded SHA-256 of the request body, reusing the `AWSSignatureV4PayloadHashPropertyKey` property when
+ present and storing it on the request otherwise.
+ */
++ (NSString * _Nonnull)payloadHashForRequest:(NSMutableURLRequest * _Nonnull)request;
+
 + (NSString * _Nonnull)getCanonicalizedRequest:(NSString * _Nonnull)method
                                  path:(NSString * _Nonnull)path
                                 query:(NSString * _Nullable)query
@@ -113,6 +132,47 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
 
 @end
 
+/**
+ Presigns many URLs that share credentials, date, HTTP method, expiry, headers and query parameters and differ only in
+ their path, such as GET URLs for many objects in one S3 bucket.
+
+ Everything but the path is canonicalized once when the presigner is created, and the derived signing key is absorbed
+ into a reusable HMAC state, so each URL costs one SHA-256 of its canonical request and one HMAC. The payload is
+ signed as `UNSIGNED-PAYLOAD` and the session token, if any, is part of the signed query, as with
+ `generateQueryStringForSignatureV4WithCredentialProvider:` when `signBody` is NO.
+
+ A presigner is immutable once created and may be used from several threads.
+ */
+@interface AWSSignatureV4URLPresigner : NSObject
+
+- (instancetype _Nonnull)init NS_UNAVAILABLE;
+
+/**
+ @param credentials the credentials to sign with; they are not refreshed
+ @param httpMethod the HTTP method of the presigned requests
+ @param expireDuration the number of seconds the URLs are valid for
+ @param endpoint the endpoint the URLs point at, including any virtual-hosted bucket in its host
+ @param date the date of the signed credential, normally `-[NSDate aws_clockSkewFixedDate]`
+ @param requestHeaders the headers to sign, including `host`
+ @param requestParameters the URL parameters to sign
+ */
+- (instancetype _Nonnull)initWithCredentials:(AWSCredentials * _Nonnull)credentials
+                                  httpMethod:(AWSHTTPMethod)httpMethod
+                              expireDuration:(int32_t)expireDuration
+                                    endpoint:(AWSEndpoint * _Nonnull)endpoint
+                                        date:(NSDate * _Nonnull)date
+                              requestHeaders:(NSDictionary<NSString *, NSString *> * _Nullable)requestHeaders
+                           requestParameters:(NSDictionary<NSString *, id> * _Nullable)requestParameters NS_DESIGNATED_INITIALIZER;
+
+/**
+ Returns the presigned URL for a path.
+
+ @param keyPath the URL-encoded request path, without the leading slash
+ */
+- (NSURL * _Nullable)signedURLWithKeyPath:(NSString * _Nonnull)keyPath;
+
+@end
+
 @interface AWSSignatureV2Signer : NSObject <AWSNetworkingRequestInterceptor>
 
 @property (nonatomic, strong, readonly) id<AWSCredentialsProvider> _Nullable credentialsProvider;
@@ -125,6 +185,18 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
 
 @end
 
+/**
+ * The default number of payload bytes per chunk. With its signature a chunk is
+ * exactly 32 KB.
+ **/
+FOUNDATION_EXPORT const NSUInteger AWSS3ChunkedEncodingDefaultChunkSize;
+
+/**
+ * S3 rejects chunks smaller than 8 KB other than the last one, so smaller
+ * chunk sizes are raised to this.
+ **/
+FOUNDATION_EXPORT const NSUInteger AWSS3ChunkedEncodingMinimumChunkSize;
+
 /**
  * A subclass of NSInputStream that wraps an input stream and adds
  * signature of chunk data.
@@ -132,9 +204,16 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
 @interface AWSS3ChunkedEncodingInputStream : NSInputStream <NSStreamDelegate>
 
 @property (atomic, assign) int64_t totalLengthOfChunkSignatureSent;
+
+/**
+ * The number of payload bytes in each chunk. Only the last chunk of data
+ * can be shorter; it is followed by the empty final chunk.
+ **/
+@property (nonatomic, assign, readonly) NSUInteger chunkSize;
+
 /**
  * Initialize the input stream with date, scope, signing key and signature
- * of request headers.
+ * of request headers, using `AWSS3ChunkedEncodingDefaultChunkSize`.
  **/
 - (instancetype _Nonnull )initWithInputStream:(NSInputStream * _Nonnull)stream
                                          date:(NSDate * _Nullable)date
@@ -143,8 +222,30 @@ FOUNDATION_EXPORT NSString * _Nonnull const AWSSignatureV4Terminator;
                               headerSignature:(NSString * _Nullable)headerSignature;
 
 /**
- * Computes new content length after data being chunked encoded.
+ * Initialize the input stream with date, scope, signing key and signature
+ * of request headers. Chunks are read and signed whole, so a larger chunk
+ * size, such as 1 MB, means fewer signatures and fewer bytes of framing per
+ * GB uploaded, at the cost of one chunk-sized buffer per stream. 0 uses
+ * `AWSS3ChunkedEncodingDefaultChunkSize`.
+ **/
+- (instancetype _Nonnull )initWithInputStream:(NSInputStream * _Nonnull)stream
+                                         date:(NSDate * _Nullable)date
+                                        scope:(NSString * _Nullable)scope
+                                     kSigning:(NSData * _Nullable)kSigning
+                              headerSignature:(NSString * _Nullable)headerSignature
+                                    chunkSize:(NSUInteger)chunkSize;
+
+/**
+ * Computes new content length after data being chunked encoded with
+ * `AWSS3ChunkedEncodingDefaultChunkSize`.
  **/
 + (NSUInteger)computeContentLengthForChunkedData:(NSUInteger)dataLength;
 
+/**
+ * Computes new content length after data being chunked encoded with the
+ * given chunk size.
+ **/
++ (NSUInteger)computeContentLengthForChunkedData:(NSUInteger)dataLength
+                                       chunkSize:(NSUInteger)chunkSize;
+
 @end
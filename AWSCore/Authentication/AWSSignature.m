@@ -25,6 +25,42 @@
 static NSString *const AWSSigV4Marker = @"AWS4";
 NSString *const AWSSignatureV4Algorithm = @"AWS4-HMAC-SHA256";
 NSString *const AWSSignatureV4Terminator = @"aws4_request";
+NSString *const AWSSignatureV4PayloadHashPropertyKey = @"com.amazonaws.AWSSignatureV4Signer.payloadHash";
+
+// Writes 2 * length lowercase hex characters, matching `+[AWSSignatureSignerUtility hexEncode:]`.
+static void AWSSignatureHexEncodeBytes(const uint8_t *bytes, size_t length, char *hex) {
+    static const char digits[] = "0123456789abcdef";
+    for (size_t i = 0; i < length; i++) {
+        hex[2 * i] = digits[bytes[i] >> 4];
+        hex[2 * i + 1] = digits[bytes[i] & 0x0f];
+    }
+}
+
+// HMAC-SHA256 split into its inner and outer hashes, so that a key, and any message prefix absorbed into the inner
+// state, can be reused by copying the states.
+static void AWSSignatureHMACSHA256Init(NSData *key, CC_SHA256_CTX *innerContext, CC_SHA256_CTX *outerContext) {
+    uint8_t innerPad[CC_SHA256_BLOCK_BYTES] = {0};
+    uint8_t outerPad[CC_SHA256_BLOCK_BYTES] = {0};
+    // SigV4 keys are SHA-256 digests, well under the block size.
+    memcpy(innerPad, [key bytes], MIN([key length], (NSUInteger)CC_SHA256_BLOCK_BYTES));
+    memcpy(outerPad, [key bytes], MIN([key length], (NSUInteger)CC_SHA256_BLOCK_BYTES));
+    for (int i = 0; i < CC_SHA256_BLOCK_BYTES; i++) {
+        innerPad[i] ^= 0x36;
+        outerPad[i] ^= 0x5c;
+    }
+    CC_SHA256_Init(innerContext);
+    CC_SHA256_Update(innerContext, innerPad, CC_SHA256_BLOCK_BYTES);
+    CC_SHA256_Init(outerContext);
+    CC_SHA256_Update(outerContext, outerPad, CC_SHA256_BLOCK_BYTES);
+}
+
+// Finishes the HMAC of everything absorbed into the inner state. Both states are taken by value and left untouched.
+static void AWSSignatureHMACSHA256Final(CC_SHA256_CTX innerContext, CC_SHA256_CTX outerContext, uint8_t *mac) {
+    uint8_t innerDigest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(innerDigest, &innerContext);
+    CC_SHA256_Update(&outerContext, innerDigest, sizeof(innerDigest));
+    CC_SHA256_Final(mac, &outerContext);
+}
 
 @implementation AWSSignatureSignerUtility
 
@@ -141,6 +177,15 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
 
 @property (nonatomic, strong) AWSEndpoint *endpoint;
 
++ (NSString *)getCanonicalURIForPath:(NSString *)path
+                         serviceName:(NSString *)serviceName;
++ (NSString *)getCredentialScopeForDate:(NSDate *)date
+                             regionName:(NSString *)regionName
+                            serviceName:(NSString *)serviceName;
++ (NSString *)getURIEncodedQueryStringForSigV4:(NSArray<NSURLQueryItem *> *)queryItems;
++ (NSString *)getCanonicalizedQueryString:(NSString *)query;
++ (NSString *)getCanonicalizedHeaderString:(NSDictionary *)headers;
+
 @end
 
 @implementation AWSSignatureV4Signer
@@ -238,13 +283,15 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
     NSUInteger contentLength = [[urlRequest allHTTPHeaderFields][@"Content-Length"] integerValue];
     if (nil != stream) {
         contentSha256 = @"STREAMING-AWS4-HMAC-SHA256-PAYLOAD";
-        [urlRequest setValue:[NSString stringWithFormat:@"%lu", (unsigned long)[AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:contentLength]]
+        NSUInteger chunkedContentLength = [AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:contentLength
+                                                                                                    chunkSize:self.chunkedEncodingChunkSize];
+        [urlRequest setValue:[NSString stringWithFormat:@"%lu", (unsigned long)chunkedContentLength]
           forHTTPHeaderField:@"Content-Length"];
         [urlRequest setValue:nil forHTTPHeaderField:@"Content-Length"]; //remove Content-Length header if it is a HTTPBodyStream
         [urlRequest addValue:@"aws-chunked" forHTTPHeaderField:@"Content-Encoding"]; //add aws-chunked keyword for s3 chunk upload
         [urlRequest setValue:[NSString stringWithFormat:@"%lu", (unsigned long)contentLength] forHTTPHeaderField:@"x-amz-decoded-content-length"];
     } else {
-        contentSha256 = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:[AWSSignatureSignerUtility hashData:[urlRequest HTTPBody]] encoding:NSASCIIStringEncoding]];
+        contentSha256 = [AWSSignatureV4Signer payloadHashForRequest:urlRequest];
         //using Content-Length with value of '0' cause auth issue, remove it.
         if (contentLength == 0) {
             [urlRequest setValue:nil forHTTPHeaderField:@"Content-Length"];
@@ -305,7 +352,8 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
                                                                                                            date:date
                                                                                                           scope:scope
                                                                                                        kSigning:kSigning
-                                                                                                headerSignature:signatureString];
+                                                                                                headerSignature:signatureString
+                                                                                                      chunkSize:self.chunkedEncodingChunkSize];
         [urlRequest setHTTPBodyStream:chunkedStream];
     }
 
@@ -337,7 +385,7 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
         query = [NSString stringWithFormat:@""];
     }
 
-    NSString *contentSha256 = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:[AWSSignatureSignerUtility hashData:request.HTTPBody] encoding:NSASCIIStringEncoding]];
+    NSString *contentSha256 = [AWSSignatureV4Signer payloadHashForRequest:request];
 
     NSString *canonicalRequest = [AWSSignatureV4Signer getCanonicalizedRequest:request.HTTPMethod
                                                                           path:path
@@ -499,26 +547,8 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
         // if you have query string parameters. e.g. https://s3.amazonaws.com/examplebucket/myphoto.jpg
         // /examplebucket/myphoto.jpg is the absolute path. In the absolute path, you don't encode the "/".
 
-        NSString *pathToEncode;
-
-        if ([urlComponents.path hasPrefix:@"/"]) {
-            NSRange firstCharacter = NSMakeRange(0, 1);
-            pathToEncode = [urlComponents.path stringByReplacingCharactersInRange:firstCharacter withString:@""];
-        } else {
-            pathToEncode = urlComponents.path;
-        }
-        
-        NSString *canonicalURI;
-        if ([[serviceName lowercaseString] isEqualToString:@"s3"]) {
-            canonicalURI = [NSString stringWithFormat:@"/%@", [pathToEncode aws_stringWithURLEncodingPath]];
-        } else {
-            NSCharacterSet *pathChars = [NSCharacterSet URLPathAllowedCharacterSet];
-            canonicalURI = [NSString stringWithFormat:@"/%@",
-                                     [[[[pathToEncode stringByRemovingPercentEncoding]
-                                        stringByRemovingPercentEncoding]
-                                       stringByAddingPercentEncodingWithAllowedCharacters: pathChars]
-                                      aws_stringWithURLEncodingPathWithoutPriorDecoding]];
-        }
+        NSString *canonicalURI = [self getCanonicalURIForPath:urlComponents.path
+                                                  serviceName:serviceName];
 
         NSString *contentSha256;
         if(signBody && [request.HTTPMethod isEqualToString:@"GET"]){
@@ -582,6 +612,31 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
     }];
 }
 
++ (NSString *)getCanonicalURIForPath:(NSString *)path
+                         serviceName:(NSString *)serviceName {
+    NSString *pathToEncode;
+
+    if ([path hasPrefix:@"/"]) {
+        NSRange firstCharacter = NSMakeRange(0, 1);
+        pathToEncode = [path stringByReplacingCharactersInRange:firstCharacter withString:@""];
+    } else {
+        pathToEncode = path;
+    }
+
+    NSString *canonicalURI;
+    if ([[serviceName lowercaseString] isEqualToString:@"s3"]) {
+        canonicalURI = [NSString stringWithFormat:@"/%@", [pathToEncode aws_stringWithURLEncodingPath]];
+    } else {
+        NSCharacterSet *pathChars = [NSCharacterSet URLPathAllowedCharacterSet];
+        canonicalURI = [NSString stringWithFormat:@"/%@",
+                                 [[[[pathToEncode stringByRemovingPercentEncoding]
+                                    stringByRemovingPercentEncoding]
+                                   stringByAddingPercentEncodingWithAllowedCharacters: pathChars]
+                                  aws_stringWithURLEncodingPathWithoutPriorDecoding]];
+    }
+    return canonicalURI;
+}
+
 + (NSString *)getCredentialScopeForDate:(NSDate *)date
                              regionName:(NSString *)regionName
                             serviceName:(NSString *)serviceName {
@@ -612,6 +667,15 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
     return queryString;
 }
 
++ (NSString *)payloadHashForRequest:(NSMutableURLRequest *)request {
+    NSString *contentSha256 = [NSURLProtocol propertyForKey:AWSSignatureV4PayloadHashPropertyKey inRequest:request];
+    if (!contentSha256) {
+        contentSha256 = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:[AWSSignatureSignerUtility hashData:request.HTTPBody] encoding:NSASCIIStringEncoding]];
+        [NSURLProtocol setProperty:contentSha256 forKey:AWSSignatureV4PayloadHashPropertyKey inRequest:request];
+    }
+    return contentSha256;
+}
+
 + (NSString *)getCanonicalizedRequest:(NSString *)method path:(NSString *)path query:(NSString *)query headers:(NSDictionary *)headers contentSha256:(NSString *)contentSha256 {
     NSMutableString *canonicalRequest = [NSMutableString new];
     [canonicalRequest appendString:method];
@@ -779,6 +843,117 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
 
 @end
 
+#pragma mark - AWSSignatureV4URLPresigner
+
+@interface AWSSignatureV4URLPresigner()
+
+@property (nonatomic, strong) NSData *canonicalRequestPrefix;
+@property (nonatomic, strong) NSData *canonicalRequestSuffix;
+@property (nonatomic, strong) NSString *serviceName;
+@property (nonatomic, strong) NSString *baseURLString;
+@property (nonatomic, strong) NSString *queryString;
+
+@end
+
+@implementation AWSSignatureV4URLPresigner {
+    // HMAC-SHA256 with the signing key, split into its two hashes. The inner hash has already absorbed the
+    // string to sign up to the canonical request hash, which is the only part that differs between URLs.
+    CC_SHA256_CTX _innerContext;
+    CC_SHA256_CTX _outerContext;
+}
+
+- (instancetype)initWithCredentials:(AWSCredentials *)credentials
+                         httpMethod:(AWSHTTPMethod)httpMethod
+                     expireDuration:(int32_t)expireDuration
+                           endpoint:(AWSEndpoint *)endpoint
+                               date:(NSDate *)date
+                     requestHeaders:(NSDictionary<NSString *, NSString *> *)requestHeaders
+                  requestParameters:(NSDictionary<NSString *, id> *)requestParameters {
+    if (self = [super init]) {
+        NSString *regionName = endpoint.regionName;
+        _serviceName = endpoint.serviceName;
+
+        NSURLComponents *urlComponents = [[NSURLComponents alloc] initWithURL:endpoint.URL resolvingAgainstBaseURL:NO];
+        urlComponents.percentEncodedPath = @"";
+        urlComponents.percentEncodedQuery = nil;
+        _baseURLString = urlComponents.string;
+
+        // The same query parameters, in the same order, as sigV4SignedURLWithRequest: adds
+        NSMutableArray<NSURLQueryItem *> *queryItems = [[NSMutableArray alloc] initWithArray:[AWSNetworkingHelpers queryItemsFromDictionary:requestParameters]];
+        [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Algorithm" value:AWSSignatureV4Algorithm]];
+        NSString *credentialsScope = [AWSSignatureV4Signer getCredentialScopeForDate:date
+                                                                          regionName:regionName
+                                                                         serviceName:_serviceName];
+        NSString *credential = [NSString stringWithFormat:@"%@/%@", credentials.accessKey, credentialsScope];
+        [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Credential" value:credential]];
+        NSString *iso8601Date = [date aws_stringValue:AWSDateISO8601DateFormat2];
+        [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Date" value:iso8601Date]];
+        [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Expires" value:[NSString stringWithFormat:@"%d", expireDuration]]];
+        NSString *signedHeaders = [AWSSignatureV4Signer getSignedHeadersString:requestHeaders];
+        [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-SignedHeaders" value:signedHeaders]];
+        if (credentials.sessionKey.length > 0) {
+            [queryItems addObject:[NSURLQueryItem queryItemWithName:@"X-Amz-Security-Token" value:credentials.sessionKey]];
+        }
+        _queryString = [AWSSignatureV4Signer getURIEncodedQueryStringForSigV4:queryItems];
+
+        // The canonical request is <method>\n<canonical URI>\n<everything else>, and only the URI depends on the path.
+        NSString *method = [NSString aws_stringWithHTTPMethod:httpMethod];
+        _canonicalRequestPrefix = [[NSString stringWithFormat:@"%@\n", method] dataUsingEncoding:NSUTF8StringEncoding];
+        NSString *canonicalRequestSuffix = [NSString stringWithFormat:@"\n%@\n%@\n%@\n%@",
+                                            [AWSSignatureV4Signer getCanonicalizedQueryString:_queryString],
+                                            [AWSSignatureV4Signer getCanonicalizedHeaderString:requestHeaders],
+                                            signedHeaders,
+                                            @"UNSIGNED-PAYLOAD"];
+        _canonicalRequestSuffix = [canonicalRequestSuffix dataUsingEncoding:NSUTF8StringEncoding];
+
+        NSData *kSigning = [AWSSignatureV4Signer getV4DerivedKey:credentials.secretKey
+                                                            date:[date aws_stringValue:AWSDateShortDateFormat1]
+                                                          region:regionName
+                                                         service:_serviceName];
+        NSData *stringToSignPrefix = [[NSString stringWithFormat:@"%@\n%@\n%@\n", AWSSignatureV4Algorithm, iso8601Date, credentialsScope] dataUsingEncoding:NSUTF8StringEncoding];
+        AWSSignatureHMACSHA256Init(kSigning, &_innerContext, &_outerContext);
+        CC_SHA256_Update(&_innerContext, [stringToSignPrefix bytes], (CC_LONG)[stringToSignPrefix length]);
+
+        AWSDDLogVerbose(@"AWS4 PresignedURL batch: [%@] [%@]", canonicalRequestSuffix, credentialsScope);
+    }
+
+    return self;
+}
+
+- (NSURL *)signedURLWithKeyPath:(NSString *)keyPath {
+    // Mirrors sigV4SignedURLWithRequest:, which canonicalizes the decoded path of the request URL.
+    NSString *path = [NSString stringWithFormat:@"/%@", keyPath];
+    NSString *canonicalURI = [AWSSignatureV4Signer getCanonicalURIForPath:([path stringByRemovingPercentEncoding] ?: path)
+                                                              serviceName:self.serviceName];
+    const char *canonicalURIBytes = [canonicalURI UTF8String];
+
+    uint8_t digest[CC_SHA256_DIGEST_LENGTH];
+    char canonicalRequestHash[2 * CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_CTX context;
+    CC_SHA256_Init(&context);
+    CC_SHA256_Update(&context, [self.canonicalRequestPrefix bytes], (CC_LONG)[self.canonicalRequestPrefix length]);
+    CC_SHA256_Update(&context, canonicalURIBytes, (CC_LONG)strlen(canonicalURIBytes));
+    CC_SHA256_Update(&context, [self.canonicalRequestSuffix bytes], (CC_LONG)[self.canonicalRequestSuffix length]);
+    CC_SHA256_Final(digest, &context);
+    AWSSignatureHexEncodeBytes(digest, CC_SHA256_DIGEST_LENGTH, canonicalRequestHash);
+
+    char signature[2 * CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_CTX innerContext = _innerContext;
+    CC_SHA256_Update(&innerContext, canonicalRequestHash, sizeof(canonicalRequestHash));
+    AWSSignatureHMACSHA256Final(innerContext, _outerContext, digest);
+    AWSSignatureHexEncodeBytes(digest, CC_SHA256_DIGEST_LENGTH, signature);
+
+    NSString *URLString = [NSString stringWithFormat:@"%@%@?%@&X-Amz-Signature=%.*s",
+                           self.baseURLString,
+                           path,
+                           self.queryString,
+                           (int)sizeof(signature),
+                           signature];
+    return [NSURL URLWithString:URLString];
+}
+
+@end
+
 #pragma mark - AWSSignatureV2Signer
 
 @interface AWSSignatureV2Signer()
@@ -845,39 +1020,71 @@ NSString *const AWSSignatureV4Terminator = @"aws4_request";
 
 #pragma mark - S3ChunkedEncodingInputStream
 
-static NSUInteger defaultChunkSize = 32 * 1024 - 91;
-static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855";
+const NSUInteger AWSS3ChunkedEncodingDefaultChunkSize = 32 * 1024 - 91;
+const NSUInteger AWSS3ChunkedEncodingMinimumChunkSize = 8 * 1024;
+
+// The empty-string SHA-256 between the prior signature and the chunk hash in each chunk's string to sign.
+static const char AWSS3ChunkedEncodingEmptyHashLine[] = "\ne3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855\n";
+
+// A chunk is <size in hex, at least 6 digits>;chunk-signature=<64 hex digits>\r\n<data>\r\n
+enum {
+    AWSS3ChunkedEncodingSignatureLength = 2 * CC_SHA256_DIGEST_LENGTH,
+    AWSS3ChunkedEncodingHeaderLengthWithoutSize = 17 + AWSS3ChunkedEncodingSignatureLength + 2,
+    AWSS3ChunkedEncodingMaximumHeaderLength = 2 * sizeof(NSUInteger) + AWSS3ChunkedEncodingHeaderLengthWithoutSize,
+};
+
+static NSUInteger AWSS3ChunkedEncodingHeaderLength(NSUInteger dataLength) {
+    NSUInteger digits = 1;
+    for (NSUInteger remaining = dataLength >> 4; remaining > 0; remaining >>= 4) {
+        digits++;
+    }
+    return MAX(digits, (NSUInteger)6) + AWSS3ChunkedEncodingHeaderLengthWithoutSize;
+}
+
+static NSUInteger AWSS3ChunkedEncodingEffectiveChunkSize(NSUInteger chunkSize) {
+    if (chunkSize == 0) {
+        return AWSS3ChunkedEncodingDefaultChunkSize;
+    }
+    return MAX(chunkSize, AWSS3ChunkedEncodingMinimumChunkSize);
+}
 
 @interface AWSS3ChunkedEncodingInputStream()
 
 // original input stream
 @property (nonatomic, strong) NSInputStream *stream;
 
-// buffer for chunked data plus header
-@property (nonatomic, strong) NSMutableData *chunkData;
+// A flag indicates the original stream has no more data
+@property (nonatomic, assign) BOOL sourceAtEnd;
 
-// Mark the location of chunkData to be read
-@property (nonatomic, assign) NSUInteger location;
+// A flag indicates the empty final chunk has been signed
+@property (nonatomic, assign) BOOL finalChunkSigned;
 
 // A flag indicates end of stream
 @property (nonatomic, assign) BOOL endOfStream;
 
-// SigV4 related properties
-// Date, used in signing
-@property (nonatomic, strong) NSDate *date;
+// A flag indicates the original stream failed
+@property (nonatomic, assign) BOOL readFailed;
 
-// Keypath/Scope
-@property (nonatomic, strong) NSString *scope;
+@end
 
-// Signature of previous chunk. It's initialized as that of headers.
-@property (nonatomic, strong) NSString *priorSha256;
+@implementation AWSS3ChunkedEncodingInputStream {
+    // Room for the longest chunk header, then the chunk data and its trailing CRLF. Each chunk is read straight into
+    // place and its header is written just before the data, so a signed chunk is one contiguous range.
+    uint8_t *_chunkBuffer;
+    NSUInteger _chunkStart;
+    NSUInteger _chunkEnd;
 
-// SigV4 signing key
-@property (nonatomic, strong) NSData *kSigning;
+    // Mark the location of _chunkBuffer to be read
+    NSUInteger _location;
 
-@end
+    // HMAC-SHA256 with the signing key. The inner hash has already absorbed the start of every chunk's string to sign:
+    // AWS4-HMAC-SHA256-PAYLOAD\n<date>\n<scope>\n
+    CC_SHA256_CTX _innerContext;
+    CC_SHA256_CTX _outerContext;
 
-@implementation AWSS3ChunkedEncodingInputStream
+    // Signature of previous chunk. It's initialized as that of headers.
+    char _priorSignature[AWSS3ChunkedEncodingSignatureLength];
+}
 
 @synthesize delegate = _delegate;
 
@@ -886,22 +1093,48 @@ static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427a
                               scope:(NSString *)scope
                            kSigning:(NSData *)kSigning
                     headerSignature:(NSString *)headerSignature {
+    return [self initWithInputStream:stream
+                                date:date
+                               scope:scope
+                            kSigning:kSigning
+                     headerSignature:headerSignature
+                           chunkSize:AWSS3ChunkedEncodingDefaultChunkSize];
+}
+
+- (instancetype)initWithInputStream:(NSInputStream *)stream
+                               date:(NSDate *)date
+                              scope:(NSString *)scope
+                           kSigning:(NSData *)kSigning
+                    headerSignature:(NSString *)headerSignature
+                          chunkSize:(NSUInteger)chunkSize {
     if (self = [super init]) {
         _stream = stream;
         _stream.delegate = self;
-        _date = [date copy];
-        _scope = [scope copy];
-        _kSigning = [kSigning copy];
-        _priorSha256 = [headerSignature copy];
+        _chunkSize = AWSS3ChunkedEncodingEffectiveChunkSize(chunkSize);
 
         // Chunk size plus signature header
-        NSUInteger chunkSize = defaultChunkSize + [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:defaultChunkSize];
-        _chunkData = [[NSMutableData alloc] initWithCapacity:chunkSize];
+        _chunkBuffer = malloc(AWSS3ChunkedEncodingMaximumHeaderLength + _chunkSize + 2);
+
+        NSString *stringToSignPrefix = [NSString stringWithFormat:@"%@\n%@\n%@\n",
+                                        @"AWS4-HMAC-SHA256-PAYLOAD",
+                                        [date aws_stringValue:AWSDateISO8601DateFormat2],
+                                        scope];
+        NSData *stringToSignPrefixData = [stringToSignPrefix dataUsingEncoding:NSUTF8StringEncoding];
+        AWSSignatureHMACSHA256Init(kSigning, &_innerContext, &_outerContext);
+        CC_SHA256_Update(&_innerContext, [stringToSignPrefixData bytes], (CC_LONG)[stringToSignPrefixData length]);
+
+        memset(_priorSignature, '0', sizeof(_priorSignature));
+        NSData *headerSignatureData = [headerSignature dataUsingEncoding:NSUTF8StringEncoding];
+        memcpy(_priorSignature, [headerSignatureData bytes], MIN([headerSignatureData length], sizeof(_priorSignature)));
     }
 
     return self;
 }
 
+- (void)dealloc {
+    free(_chunkBuffer);
+}
+
 - (void)stream:(NSStream *)aStream handleEvent:(NSStreamEvent)eventCode {
     if ((eventCode & (1 << 4))) {
         // toggle the NSStreamEventEndEncountered bit.
@@ -915,96 +1148,94 @@ static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427a
 // Read next chunk of data from stream, and sign the chunk.
 // Returns YES on a successful read, NO otherwise.
 - (BOOL)nextChunk {
-    if (self.endOfStream) {
+    if (self.finalChunkSigned || self.readFailed) {
         return NO;
     }
 
-    // clear current chunkData for next chunk
-    [self.chunkData setLength:0];
-
-    uint8_t *chunkBuffer = calloc(defaultChunkSize, sizeof(uint8_t));
-    NSInteger read = [self.stream read:chunkBuffer maxLength:defaultChunkSize];
-
-    // mark end of stream if no data is read
-    self.endOfStream = (read <= 0);
+    // Fill the whole chunk; only the last chunk of data may be shorter.
+    uint8_t *data = _chunkBuffer + AWSS3ChunkedEncodingMaximumHeaderLength;
+    NSUInteger length = 0;
+    while (length < self.chunkSize && !self.sourceAtEnd) {
+        NSInteger read = [self.stream read:data + length maxLength:self.chunkSize - length];
+
+        // return NO if stream read failed
+        if (read < 0) {
+            self.readFailed = YES;
+            AWSDDLogError(@"stream read failed streamStatus: %lu streamError: %@", (unsigned long)[self.stream streamStatus], [self.stream streamError].description);
+            return NO;
+        }
 
-    // return NO if stream read failed
-    if (read < 0) {
-        free(chunkBuffer);
-        AWSDDLogError(@"stream read failed streamStatus: %lu streamError: %@", (unsigned long)[self.stream streamStatus], [self.stream streamError].description);
-        return NO;
+        // mark end of stream if no data is read
+        self.sourceAtEnd = (read == 0);
+        length += read;
     }
 
-    NSData *data = [NSData dataWithBytesNoCopy:chunkBuffer length:read];
-    [self.chunkData appendData:[self getSignedChunk:data]];
+    [self signChunkOfLength:length];
+    self.finalChunkSigned = (length == 0);
 
-    AWSDDLogVerbose(@"stream read: %ld, chunk size: %lu", (long)read, (unsigned long)[self.chunkData length]);
+    AWSDDLogVerbose(@"stream read: %lu, chunk size: %lu", (unsigned long)length, (unsigned long)(_chunkEnd - _chunkStart));
 
     return YES;
 }
 
-// Signs data
-- (NSData *)getSignedChunk:(NSData *)data {
-    NSString *chunkSha256 = [self dataToHexString:[AWSSignatureSignerUtility hashData:data]];
-    NSString *stringToSign = [NSString stringWithFormat:
-                              @"%@\n%@\n%@\n%@\n%@\n%@",
-                              @"AWS4-HMAC-SHA256-PAYLOAD",
-                              [self.date aws_stringValue:AWSDateISO8601DateFormat2],
-                              self.scope,
-                              self.priorSha256,
-                              emptyStringSha256,
-                              chunkSha256];
-    AWSDDLogVerbose(@"AWS4 String to Sign: [%@]", stringToSign);
-
-    NSData *signature = [AWSSignatureSignerUtility sha256HMacWithData:[stringToSign dataUsingEncoding:NSUTF8StringEncoding]
-                                                              withKey:self.kSigning];
-    self.priorSha256 = [self dataToHexString:signature];
-    NSString *chunkedHeader = [NSString stringWithFormat:@"%06lx;chunk-signature=%@\r\n", (unsigned long)[data length], self.priorSha256];
-    AWSDDLogVerbose(@"AWS4 Chunked Header: [%@]", chunkedHeader);
-
-    NSMutableData *signedChunk = [NSMutableData data];
-    [signedChunk appendData:[chunkedHeader dataUsingEncoding:NSUTF8StringEncoding]];
-    [signedChunk appendData:data];
-    [signedChunk appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-
-    self.totalLengthOfChunkSignatureSent += [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:0];
-    return signedChunk;
-}
-
-- (NSString *)dataToHexString:(NSData *) data {
-    return [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:data
-                                                                      encoding:NSASCIIStringEncoding]];
+// Signs the chunk data in place and frames it with its header and trailing CRLF.
+- (void)signChunkOfLength:(NSUInteger)length {
+    uint8_t *data = _chunkBuffer + AWSS3ChunkedEncodingMaximumHeaderLength;
+
+    // String to sign: <prefix><prior signature>\n<empty string hash>\n<chunk hash>
+    uint8_t digest[CC_SHA256_DIGEST_LENGTH];
+    char chunkSha256[AWSS3ChunkedEncodingSignatureLength];
+    CC_SHA256(data, (CC_LONG)length, digest);
+    AWSSignatureHexEncodeBytes(digest, CC_SHA256_DIGEST_LENGTH, chunkSha256);
+
+    CC_SHA256_CTX innerContext = _innerContext;
+    CC_SHA256_Update(&innerContext, _priorSignature, sizeof(_priorSignature));
+    CC_SHA256_Update(&innerContext, AWSS3ChunkedEncodingEmptyHashLine, sizeof(AWSS3ChunkedEncodingEmptyHashLine) - 1);
+    CC_SHA256_Update(&innerContext, chunkSha256, sizeof(chunkSha256));
+    AWSSignatureHMACSHA256Final(innerContext, _outerContext, digest);
+    AWSSignatureHexEncodeBytes(digest, CC_SHA256_DIGEST_LENGTH, _priorSignature);
+
+    NSUInteger headerLength = AWSS3ChunkedEncodingHeaderLength(length);
+    char header[AWSS3ChunkedEncodingMaximumHeaderLength + 1];
+    snprintf(header, sizeof(header), "%06lx;chunk-signature=%.*s\r\n", (unsigned long)length, (int)sizeof(_priorSignature), _priorSignature);
+    AWSDDLogVerbose(@"AWS4 Chunked Header: [%.*s]", (int)headerLength, header);
+
+    _chunkStart = AWSS3ChunkedEncodingMaximumHeaderLength - headerLength;
+    memcpy(_chunkBuffer + _chunkStart, header, headerLength);
+    data[length] = '\r';
+    data[length + 1] = '\n';
+    _chunkEnd = AWSS3ChunkedEncodingMaximumHeaderLength + length + 2;
+    _location = _chunkStart;
+
+    self.totalLengthOfChunkSignatureSent += headerLength + 2;
 }
 
 #pragma mark NSInputStream methods
 
 - (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)len {
-    //change the defaultChunkSize according to caller reading capacity.
-    defaultChunkSize = len - [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:0];
     // check whether there is data available
-    if ([self.chunkData length] <= self.location) {
+    if (_location >= _chunkEnd) {
         // set up next chunk
-        if ([self nextChunk]) {
-            // rewind location
-            self.location = 0;
-        } else {
-            return 0;
+        if (![self nextChunk]) {
+            return self.readFailed ? -1 : 0;
         }
     }
 
     // compute how many bytes to read from chunk
-    NSUInteger length = MIN(len, [self.chunkData length] - self.location);
-    NSRange range = {self.location, length};
-    [self.chunkData getBytes:(void *)buffer range:range];
+    NSUInteger length = MIN(len, _chunkEnd - _location);
+    memcpy(buffer, _chunkBuffer + _location, length);
 
     // Update location
-    self.location += length;
+    _location += length;
+    if (self.finalChunkSigned && _location >= _chunkEnd) {
+        self.endOfStream = YES;
+    }
 
     return length;
 }
 
 - (BOOL)hasBytesAvailable {
-	return !self.endOfStream;
+	return !self.endOfStream && !self.readFailed;
 }
 
 - (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)len {
@@ -1074,17 +1305,24 @@ static NSString *const emptyStringSha256 = @"e3b0c44298fc1c149afbf4c8996fb92427a
  * <data>\r\n
  **/
 + (NSUInteger)oneChunkedDataSize:(NSUInteger)dataLength {
-    return [[NSString stringWithFormat:@"%06lx;chunk-signature=%@\r\n",  (unsigned long)dataLength, emptyStringSha256] length] + dataLength + [@"\r\n" length];
+    return AWSS3ChunkedEncodingHeaderLength(dataLength) + dataLength + [@"\r\n" length];
 }
 
 + (NSUInteger)computeContentLengthForChunkedData:(NSUInteger)dataLength {
+    return [self computeContentLengthForChunkedData:dataLength
+                                          chunkSize:AWSS3ChunkedEncodingDefaultChunkSize];
+}
+
++ (NSUInteger)computeContentLengthForChunkedData:(NSUInteger)dataLength
+                                       chunkSize:(NSUInteger)chunkSize {
+    chunkSize = AWSS3ChunkedEncodingEffectiveChunkSize(chunkSize);
     NSUInteger result = 0;
 
     // length of full chunks
-    result += (dataLength / defaultChunkSize) * [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:defaultChunkSize];
+    result += (dataLength / chunkSize) * [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:chunkSize];
     
     // length of remaining data
-    NSUInteger remainingDataLength = dataLength % defaultChunkSize;
+    NSUInteger remainingDataLength = dataLength % chunkSize;
     if (remainingDataLength > 0) {
         result += [AWSS3ChunkedEncodingInputStream oneChunkedDataSize:remainingDataLength];
     }
@@ -12,6 +12,24 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/*!
+ Pool for latency-sensitive work on the request path. Service responses are deserialized and their tasks completed in
+ it, so continuations that run inline on completion run here too. Runs at `NSQualityOfServiceUserInitiated`.
+ */
+FOUNDATION_EXPORT NSString *const AWSExecutorPoolNameRequest;
+
+/*!
+ Pool for CPU-bound work that never waits, such as serializing and compressing request bodies and reading and hashing
+ S3 multipart upload parts. Runs at `NSQualityOfServiceUtility`.
+ */
+FOUNDATION_EXPORT NSString *const AWSExecutorPoolNameSerialization;
+
+/*!
+ Pool for background persistence and flushing, such as the Kinesis and Pinpoint recorders.
+ Runs at `NSQualityOfServiceUtility` with a small concurrency limit so it cannot starve the request pool.
+ */
+FOUNDATION_EXPORT NSString *const AWSExecutorPoolNameBackground;
+
 /*!
  An object that can run a given block.
  */
@@ -51,6 +69,46 @@ NS_ASSUME_NONNULL_BEGIN
  */
 + (instancetype)executorWithOperationQueue:(NSOperationQueue *)queue;
 
+/*!
+ Returns a new executor that runs at most `maxConcurrentOperationCount` continuations at a time at the given quality of
+ service. Continuations beyond the limit are queued and started in FIFO order as running ones finish.
+ @param name A name used to label the underlying dispatch queue.
+ @param maxConcurrentOperationCount The maximum number of continuations running at once. Must be greater than 0.
+ @param qualityOfService The quality of service continuations run at.
+ */
++ (instancetype)executorWithName:(NSString *)name
+     maxConcurrentOperationCount:(NSUInteger)maxConcurrentOperationCount
+                qualityOfService:(NSQualityOfService)qualityOfService;
+
+/*!
+ Returns the executor of the named pool. The `AWSExecutorPoolName*` pools are registered by default; any other name must
+ be registered with `registerPoolNamed:maxConcurrentOperationCount:qualityOfService:` first. For a name that is not
+ registered, a warning is logged and `defaultExecutor` is returned.
+ @param name The name of the pool.
+ */
++ (instancetype)executorForPoolNamed:(NSString *)name;
+
+/*!
+ Registers, or replaces, the named pool. Executors that were already returned for the name keep their previous pool, so
+ pools should be configured before the SDK clients are created.
+ @param name The name of the pool.
+ @param maxConcurrentOperationCount The maximum number of continuations running at once. Must be greater than 0.
+ @param qualityOfService The quality of service continuations run at.
+ */
++ (void)registerPoolNamed:(NSString *)name
+maxConcurrentOperationCount:(NSUInteger)maxConcurrentOperationCount
+         qualityOfService:(NSQualityOfService)qualityOfService;
+
+/*!
+ Returns a new serial queue that runs at the quality of service of the named pool. Use it where work must stay ordered,
+ such as a recorder's database queue. The queue occupies at most one thread but is not counted against the pool's
+ concurrency limit. If no pool is registered with the name, a warning is logged and the queue runs at the default quality
+ of service.
+ @param label The label of the queue.
+ @param name The name of the pool.
+ */
++ (dispatch_queue_t)serialQueueWithLabel:(NSString *)label inPoolNamed:(NSString *)name;
+
 /*!
  Runs the given block using this executor's particular strategy.
  @param block The block to execute.
@@ -37,6 +37,106 @@ __attribute__((noinline)) static size_t remaining_stack_size(size_t *restrict to
     return (*totalSize) - (size_t)(endStack - frameAddr);
 }
 
+NSString *const AWSExecutorPoolNameRequest = @"com.amazonaws.executor.request";
+NSString *const AWSExecutorPoolNameSerialization = @"com.amazonaws.executor.serialization";
+NSString *const AWSExecutorPoolNameBackground = @"com.amazonaws.executor.background";
+
+static qos_class_t awsbf_qos_class(NSQualityOfService qualityOfService) {
+    switch (qualityOfService) {
+        case NSQualityOfServiceUserInteractive:
+            return QOS_CLASS_USER_INTERACTIVE;
+        case NSQualityOfServiceUserInitiated:
+            return QOS_CLASS_USER_INITIATED;
+        case NSQualityOfServiceUtility:
+            return QOS_CLASS_UTILITY;
+        case NSQualityOfServiceBackground:
+            return QOS_CLASS_BACKGROUND;
+        case NSQualityOfServiceDefault:
+        default:
+            return QOS_CLASS_DEFAULT;
+    }
+}
+
+/*!
+ A concurrent dispatch queue at a fixed QoS with a width limit. Blocks beyond the limit wait in a FIFO and are started by
+ the block that finishes, so no thread is ever parked waiting for a slot.
+ */
+@interface AWSExecutorPool : NSObject
+
+@property (nonatomic, strong, readonly) dispatch_queue_t queue;
+@property (nonatomic, assign, readonly) qos_class_t qosClass;
+@property (nonatomic, assign, readonly) NSUInteger maxConcurrentOperationCount;
+
+- (instancetype)initWithName:(NSString *)name
+ maxConcurrentOperationCount:(NSUInteger)maxConcurrentOperationCount
+            qualityOfService:(NSQualityOfService)qualityOfService;
+
+- (void)enqueue:(dispatch_block_t)block;
+
+@end
+
+@implementation AWSExecutorPool {
+    pthread_mutex_t _lock;
+    NSMutableArray<dispatch_block_t> *_pendingBlocks;
+    NSUInteger _runningCount;
+}
+
+- (instancetype)initWithName:(NSString *)name
+ maxConcurrentOperationCount:(NSUInteger)maxConcurrentOperationCount
+            qualityOfService:(NSQualityOfService)qualityOfService {
+    self = [super init];
+    if (!self) return self;
+
+    _qosClass = awsbf_qos_class(qualityOfService);
+    dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_CONCURRENT, _qosClass, 0);
+    _queue = dispatch_queue_create([name UTF8String], attributes);
+    _maxConcurrentOperationCount = MAX(maxConcurrentOperationCount, 1);
+    _pendingBlocks = [NSMutableArray new];
+    pthread_mutex_init(&_lock, NULL);
+
+    return self;
+}
+
+- (void)dealloc {
+    pthread_mutex_destroy(&_lock);
+}
+
+- (void)enqueue:(dispatch_block_t)block {
+    pthread_mutex_lock(&_lock);
+    if (_runningCount < _maxConcurrentOperationCount) {
+        _runningCount++;
+        pthread_mutex_unlock(&_lock);
+        [self run:block];
+    } else {
+        [_pendingBlocks addObject:[block copy]];
+        pthread_mutex_unlock(&_lock);
+    }
+}
+
+- (void)run:(dispatch_block_t)block {
+    dispatch_async(self.queue, ^{
+        @autoreleasepool {
+            block();
+        }
+
+        dispatch_block_t next = nil;
+        pthread_mutex_lock(&self->_lock);
+        if (self->_pendingBlocks.count > 0) {
+            next = self->_pendingBlocks.firstObject;
+            [self->_pendingBlocks removeObjectAtIndex:0];
+        } else {
+            self->_runningCount--;
+        }
+        pthread_mutex_unlock(&self->_lock);
+
+        if (next) {
+            [self run:next];
+        }
+    });
+}
+
+@end
+
 @interface AWSExecutor ()
 
 @property (nonatomic, copy) void(^block)(void(^block)(void));
@@ -114,6 +214,85 @@ __attribute__((noinline)) static size_t remaining_stack_size(size_t *restrict to
     }];
 }
 
+#pragma mark - Pools
+
++ (NSMutableDictionary<NSString *, AWSExecutorPool *> *)pools {
+    static NSMutableDictionary<NSString *, AWSExecutorPool *> *pools = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSUInteger processorCount = MAX([NSProcessInfo processInfo].activeProcessorCount, 1);
+        pools = [NSMutableDictionary new];
+        pools[AWSExecutorPoolNameRequest] = [[AWSExecutorPool alloc] initWithName:AWSExecutorPoolNameRequest
+                                                      maxConcurrentOperationCount:processorCount * 2
+                                                                 qualityOfService:NSQualityOfServiceUserInitiated];
+        pools[AWSExecutorPoolNameSerialization] = [[AWSExecutorPool alloc] initWithName:AWSExecutorPoolNameSerialization
+                                                            maxConcurrentOperationCount:processorCount
+                                                                       qualityOfService:NSQualityOfServiceUtility];
+        // Utility rather than Background: background QoS can be throttled enough that a flush started in a
+        // background task does not finish before the task expires.
+        pools[AWSExecutorPoolNameBackground] = [[AWSExecutorPool alloc] initWithName:AWSExecutorPoolNameBackground
+                                                         maxConcurrentOperationCount:2
+                                                                    qualityOfService:NSQualityOfServiceUtility];
+    });
+    return pools;
+}
+
++ (AWSExecutorPool *)poolNamed:(NSString *)name {
+    NSMutableDictionary<NSString *, AWSExecutorPool *> *pools = [self pools];
+    @synchronized(pools) {
+        return pools[name];
+    }
+}
+
++ (instancetype)executorWithPool:(AWSExecutorPool *)pool {
+    return [self executorWithBlock:^void(void(^block)(void)) {
+        [pool enqueue:block];
+    }];
+}
+
++ (instancetype)executorWithName:(NSString *)name
+     maxConcurrentOperationCount:(NSUInteger)maxConcurrentOperationCount
+                qualityOfService:(NSQualityOfService)qualityOfService {
+    return [self executorWithPool:[[AWSExecutorPool alloc] initWithName:name
+                                            maxConcurrentOperationCount:maxConcurrentOperationCount
+                                                       qualityOfService:qualityOfService]];
+}
+
++ (instancetype)executorForPoolNamed:(NSString *)name {
+    AWSExecutorPool *pool = [self poolNamed:name];
+    if (!pool) {
+        NSLog(@"Warning: No executor pool is registered with the name %@. The default executor is used instead.", name);
+        return [self defaultExecutor];
+    }
+    return [self executorWithPool:pool];
+}
+
++ (void)registerPoolNamed:(NSString *)name
+maxConcurrentOperationCount:(NSUInteger)maxConcurrentOperationCount
+         qualityOfService:(NSQualityOfService)qualityOfService {
+    AWSExecutorPool *pool = [[AWSExecutorPool alloc] initWithName:name
+                                      maxConcurrentOperationCount:maxConcurrentOperationCount
+                                                 qualityOfService:qualityOfService];
+    NSMutableDictionary<NSString *, AWSExecutorPool *> *pools = [self pools];
+    @synchronized(pools) {
+        pools[name] = pool;
+    }
+}
+
++ (dispatch_queue_t)serialQueueWithLabel:(NSString *)label inPoolNamed:(NSString *)name {
+    AWSExecutorPool *pool = [self poolNamed:name];
+    if (!pool) {
+        NSLog(@"Warning: No executor pool is registered with the name %@. The queue runs at the default quality of service.", name);
+        return dispatch_queue_create([label UTF8String], DISPATCH_QUEUE_SERIAL);
+    }
+    // The QoS attribute is set on the serial queue itself so that it, rather than the submitting thread's QoS, decides
+    // what its blocks run at.
+    dispatch_queue_attr_t attributes = dispatch_queue_attr_make_with_qos_class(DISPATCH_QUEUE_SERIAL, pool.qosClass, 0);
+    dispatch_queue_t queue = dispatch_queue_create([label UTF8String], attributes);
+    dispatch_set_target_queue(queue, pool.queue);
+    return queue;
+}
+
 #pragma mark - Initializer
 
 - (instancetype)initWithBlock:(void(^)(void(^block)(void)))block {
@@ -11,6 +11,7 @@
 #import "AWSTask.h"
 
 #import <libkern/OSAtomic.h>
+#import <stdatomic.h>
 
 #import "AWSBolts.h"
 
@@ -26,19 +27,38 @@ NSInteger const kAWSMultipleErrorsError = 80175001;
 
 NSString *const AWSTaskMultipleErrorsUserInfoKey = @"errors";
 
+/**
+ The whole lifecycle of a task is a single atomic word. `Completing` is only observed by the thread that won the race to
+ complete the task while it stores the result or error; everyone else sees the task as pending until the final state
+ is published.
+ */
+typedef NS_ENUM(uint_fast32_t, AWSTaskState) {
+    AWSTaskStatePending = 0,
+    AWSTaskStateCompleting,
+    AWSTaskStateSucceeded,
+    AWSTaskStateFaulted,
+    AWSTaskStateCancelled,
+};
+
+/**
+ Continuations are kept in a lock-free singly linked stack, allocated only when a continuation is added to a task that
+ has not completed yet.
+ */
+typedef struct awsbf_continuation {
+    void *block; // retained dispatch_block_t
+    struct awsbf_continuation *next;
+} awsbf_continuation_t;
+
+// Marks the stack as drained; continuations added afterwards run immediately.
+static awsbf_continuation_t *const AWSTaskContinuationsClosed = (awsbf_continuation_t *)(uintptr_t)1;
+
 @interface AWSTask () {
+    _Atomic(uint_fast32_t) _state;
+    _Atomic(awsbf_continuation_t *) _continuations;
     id _result;
     NSError *_error;
 }
 
-@property (nonatomic, assign, readwrite, getter=isCancelled) BOOL cancelled;
-@property (nonatomic, assign, readwrite, getter=isFaulted) BOOL faulted;
-@property (nonatomic, assign, readwrite, getter=isCompleted) BOOL completed;
-
-@property (nonatomic, strong) NSObject *lock;
-@property (nonatomic, strong) NSCondition *condition;
-@property (nonatomic, strong) NSMutableArray *callbacks;
-
 @end
 
 @implementation AWSTask
@@ -49,15 +69,14 @@ NSString *const AWSTaskMultipleErrorsUserInfoKey = @"errors";
     self = [super init];
     if (!self) return self;
 
-    _lock = [[NSObject alloc] init];
-    _condition = [[NSCondition alloc] init];
-    _callbacks = [NSMutableArray array];
+    atomic_init(&_state, AWSTaskStatePending);
+    atomic_init(&_continuations, NULL);
 
     return self;
 }
 
 - (instancetype)initWithResult:(nullable id)result {
-    self = [super init];
+    self = [self init];
     if (!self) return self;
 
     [self trySetResult:result];
@@ -66,7 +85,7 @@ NSString *const AWSTaskMultipleErrorsUserInfoKey = @"errors";
 }
 
 - (instancetype)initWithError:(NSError *)error {
-    self = [super init];
+    self = [self init];
     if (!self) return self;
 
     [self trySetError:error];
@@ -75,7 +94,7 @@ NSString *const AWSTaskMultipleErrorsUserInfoKey = @"errors";
 }
 
 - (instancetype)initCancelled {
-    self = [super init];
+    self = [self init];
     if (!self) return self;
 
     [self trySetCancelled];
@@ -83,6 +102,17 @@ NSString *const AWSTaskMultipleErrorsUserInfoKey = @"errors";
     return self;
 }
 
+- (void)dealloc {
+    // Continuations of a task that never completed are released without being run.
+    awsbf_continuation_t *continuation = atomic_load_explicit(&_continuations, memory_order_acquire);
+    while (continuation && continuation != AWSTaskContinuationsClosed) {
+        awsbf_continuation_t *next = continuation->next;
+        CFRelease(continuation->block);
+        free(continuation);
+        continuation = next;
+    }
+}
+
 #pragma mark - Task Class methods
 
 + (instancetype)taskWithResult:(nullable id)result {
@@ -231,82 +261,109 @@ NSString *const AWSTaskMultipleErrorsUserInfoKey = @"errors";
 
 #pragma mark - Custom Setters/Getters
 
-- (nullable id)result {
-    @synchronized(self.lock) {
-        return _result;
-    }
+- (AWSTaskState)state {
+    return (AWSTaskState)atomic_load_explicit(&_state, memory_order_acquire);
 }
 
-- (BOOL)trySetResult:(nullable id)result {
-    @synchronized(self.lock) {
-        if (self.completed) {
-            return NO;
-        }
-        self.completed = YES;
-        _result = result;
-        [self runContinuations];
-        return YES;
-    }
+- (nullable id)result {
+    return self.state == AWSTaskStateSucceeded ? _result : nil;
 }
 
 - (nullable NSError *)error {
-    @synchronized(self.lock) {
-        return _error;
-    }
+    return self.state == AWSTaskStateFaulted ? _error : nil;
 }
 
-- (BOOL)trySetError:(NSError *)error {
-    @synchronized(self.lock) {
-        if (self.completed) {
-            return NO;
-        }
-        self.completed = YES;
-        self.faulted = YES;
-        _error = error;
-        [self runContinuations];
-        return YES;
-    }
+- (BOOL)isCancelled {
+    return self.state == AWSTaskStateCancelled;
 }
 
-- (BOOL)isCancelled {
-    @synchronized(self.lock) {
-        return _cancelled;
+- (BOOL)isFaulted {
+    return self.state == AWSTaskStateFaulted;
+}
+
+- (BOOL)isCompleted {
+    return self.state >= AWSTaskStateSucceeded;
+}
+
+- (BOOL)beginCompleting {
+    uint_fast32_t expected = AWSTaskStatePending;
+    return atomic_compare_exchange_strong_explicit(&_state, &expected, AWSTaskStateCompleting,
+                                                   memory_order_acquire, memory_order_relaxed);
+}
+
+- (void)finishCompletingWithState:(AWSTaskState)state {
+    atomic_store_explicit(&_state, state, memory_order_release);
+    [self runContinuations];
+}
+
+- (BOOL)trySetResult:(nullable id)result {
+    if (![self beginCompleting]) {
+        return NO;
     }
+    _result = result;
+    [self finishCompletingWithState:AWSTaskStateSucceeded];
+    return YES;
 }
 
-- (BOOL)isFaulted {
-    @synchronized(self.lock) {
-        return _faulted;
+- (BOOL)trySetError:(NSError *)error {
+    if (![self beginCompleting]) {
+        return NO;
     }
+    _error = error;
+    [self finishCompletingWithState:AWSTaskStateFaulted];
+    return YES;
 }
 
 - (BOOL)trySetCancelled {
-    @synchronized(self.lock) {
-        if (self.completed) {
-            return NO;
-        }
-        self.completed = YES;
-        self.cancelled = YES;
-        [self runContinuations];
-        return YES;
+    if (![self beginCompleting]) {
+        return NO;
     }
+    [self finishCompletingWithState:AWSTaskStateCancelled];
+    return YES;
 }
 
-- (BOOL)isCompleted {
-    @synchronized(self.lock) {
-        return _completed;
+- (void)addContinuation:(dispatch_block_t)block {
+    awsbf_continuation_t *head = atomic_load_explicit(&_continuations, memory_order_acquire);
+    awsbf_continuation_t *continuation = NULL;
+    while (head != AWSTaskContinuationsClosed) {
+        if (!continuation) {
+            continuation = malloc(sizeof(awsbf_continuation_t));
+            continuation->block = (__bridge_retained void *)[block copy];
+        }
+        continuation->next = head;
+        if (atomic_compare_exchange_weak_explicit(&_continuations, &head, continuation,
+                                                  memory_order_acq_rel, memory_order_acquire)) {
+            return;
+        }
     }
+
+    // The task completed while we were trying to enqueue.
+    if (continuation) {
+        CFRelease(continuation->block);
+        free(continuation);
+    }
+    block();
 }
 
 - (void)runContinuations {
-    @synchronized(self.lock) {
-        [self.condition lock];
-        [self.condition broadcast];
-        [self.condition unlock];
-        for (void (^callback)(void) in self.callbacks) {
-            callback();
-        }
-        [self.callbacks removeAllObjects];
+    awsbf_continuation_t *continuation = atomic_exchange_explicit(&_continuations, AWSTaskContinuationsClosed,
+                                                                  memory_order_acq_rel);
+
+    // The stack is LIFO; reverse it so continuations run in the order they were added.
+    awsbf_continuation_t *ordered = NULL;
+    while (continuation) {
+        awsbf_continuation_t *next = continuation->next;
+        continuation->next = ordered;
+        ordered = continuation;
+        continuation = next;
+    }
+
+    while (ordered) {
+        awsbf_continuation_t *next = ordered->next;
+        dispatch_block_t block = (__bridge_transfer dispatch_block_t)ordered->block;
+        free(ordered);
+        block();
+        ordered = next;
     }
 }
 
@@ -355,17 +412,12 @@ NSString *const AWSTaskMultipleErrorsUserInfoKey = @"errors";
         }
     };
 
-    BOOL completed;
-    @synchronized(self.lock) {
-        completed = self.completed;
-        if (!completed) {
-            [self.callbacks addObject:[^{
-                [executor execute:executionBlock];
-            } copy]];
-        }
-    }
-    if (completed) {
+    if (self.completed) {
         [executor execute:executionBlock];
+    } else {
+        [self addContinuation:^{
+            [executor execute:executionBlock];
+        }];
     }
 
     return tcs.task;
@@ -419,35 +471,27 @@ NSString *const AWSTaskMultipleErrorsUserInfoKey = @"errors";
         [self warnOperationOnMainThread];
     }
 
-    @synchronized(self.lock) {
-        if (self.completed) {
-            return;
-        }
-        [self.condition lock];
-    }
-    // TODO: (nlutsenko) Restructure this to use Bolts-Swift thread access synchronization architecture
-    // In the meantime, it's absolutely safe to get `_completed` aka an ivar, as long as it's a `BOOL` aka less than word size.
-    while (!_completed) {
-        [self.condition wait];
+    if (self.completed) {
+        return;
     }
-    [self.condition unlock];
+
+    // Only tasks that are actually waited on pay for a synchronization primitive.
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [self addContinuation:^{
+        dispatch_semaphore_signal(semaphore);
+    }];
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
 }
 
 #pragma mark - NSObject
 
 - (NSString *)description {
-    // Acquire the data from the locked properties
-    BOOL completed;
-    BOOL cancelled;
-    BOOL faulted;
-    NSString *resultDescription = nil;
-
-    @synchronized(self.lock) {
-        completed = self.completed;
-        cancelled = self.cancelled;
-        faulted = self.faulted;
-        resultDescription = completed ? [NSString stringWithFormat:@" result = %@", self.result] : @"";
-    }
+    // Take a single snapshot of the state so the flags are consistent with each other.
+    AWSTaskState state = self.state;
+    BOOL completed = state >= AWSTaskStateSucceeded;
+    BOOL cancelled = state == AWSTaskStateCancelled;
+    BOOL faulted = state == AWSTaskStateFaulted;
+    NSString *resultDescription = completed ? [NSString stringWithFormat:@" result = %@", self.result] : @"";
 
     // Description string includes status information and, if available, the
     // result since in some ways this is what a promise actually "is".
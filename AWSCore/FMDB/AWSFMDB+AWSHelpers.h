@@ -19,6 +19,66 @@
 
 NS_ASSUME_NONNULL_BEGIN
 
+/**
+ Number of WAL frames after which SQLite checkpoints the write-ahead log back into the database file.
+ */
+FOUNDATION_EXPORT int const AWSFMDatabaseWALAutoCheckpointPages;
+
+/**
+ Size in bytes the write-ahead log file is truncated to after a checkpoint.
+ */
+FOUNDATION_EXPORT long long const AWSFMDatabaseWALJournalSizeLimit;
+
+@interface AWSFMDatabase (AWSHelpers)
+
+/**
+ Applies the settings the SDK uses for its persistent stores:
+
+ - `journal_mode = WAL`, so commits append to the log instead of rewriting the rollback journal.
+ - `synchronous = NORMAL`, which is durable across application crashes in WAL mode and only fsyncs on checkpoint.
+ - `wal_autocheckpoint` and `journal_size_limit` to keep the log file bounded.
+ - `auto_vacuum = INCREMENTAL` in place of `FULL`, so deletes no longer move pages on every commit. An existing
+   database created with another vacuum mode is rebuilt once with `VACUUM` to switch over.
+
+ Must be called outside of a transaction, before any other statement is run on the connection.
+
+ @return `YES` if every setting was applied, `NO` otherwise. See `lastError` for details.
+ */
+- (BOOL)aws_configureWriteAheadLogging;
+
+/**
+ Returns the pages freed by earlier deletes to the file system. Stores opened with
+ `aws_configureWriteAheadLogging` should call this after bulk deletes instead of relying on `auto_vacuum = FULL`.
+
+ @return `YES` on success, `NO` otherwise.
+ */
+- (BOOL)aws_incrementalVacuum;
+
+/**
+ Runs an update for a list of values with as few statements as possible. `sql` contains a single `%@` where the list
+ of `?` placeholders goes, for example `DELETE FROM Event WHERE id IN (%@)`. Long lists are split into several
+ statements that each stay below SQLite's limit on bound variables.
+
+ Call it inside a transaction to apply the whole list atomically.
+
+ @param sql The statement with a `%@` in place of the placeholder list.
+ @param values The values to bind.
+
+ @return `YES` on success, `NO` otherwise. See `lastError` for details.
+ */
+- (BOOL)aws_executeUpdate:(NSString *)sql withValuesInList:(NSArray *)values;
+
+/**
+ The number of bytes the database at the given path occupies on disk, including its write-ahead log.
+
+ @param aPath The file path of the database.
+
+ @return The size in bytes, or `0` if the database file does not exist.
+ */
++ (unsigned long long)aws_diskBytesUsedAtPath:(NSString *)aPath;
+
+@end
+
 @interface AWSFMDatabaseQueue (AWSHelpers)
 
 /**
@@ -32,6 +92,16 @@ NS_ASSUME_NONNULL_BEGIN
 
 + (instancetype)serialDatabaseQueueWithPath:(NSString*)aPath;
 
+/**
+ Convenience method to open a serial database queue, as `serialDatabaseQueueWithPath:` does, and configure it with
+ `aws_configureWriteAheadLogging`.
+
+ @param aPath The file path of the database.
+
+ @return The `FMDatabaseQueue` object. `nil` on error.
+ */
++ (nullable instancetype)writeAheadLogDatabaseQueueWithPath:(NSString*)aPath;
+
 @end
 
 
@@ -16,6 +16,89 @@
 #import <Foundation/Foundation.h>
 #import <sqlite3.h>
 #import "AWSFMDB+AWSHelpers.h"
+#import "AWSFMDatabaseAdditions.h"
+
+int const AWSFMDatabaseWALAutoCheckpointPages = 1000;
+long long const AWSFMDatabaseWALJournalSizeLimit = 1024 * 1024; // 1MB
+
+// Values reported by `PRAGMA auto_vacuum`.
+static int const AWSFMDatabaseAutoVacuumIncremental = 2;
+// Below the SQLITE_MAX_VARIABLE_NUMBER of 999 that SQLite builds before 3.32 default to.
+static NSUInteger const AWSFMDatabaseMaximumValuesPerStatement = 500;
+
+@implementation AWSFMDatabase (AWSHelpers)
+
+- (BOOL)aws_configureWriteAheadLogging {
+    // auto_vacuum has to be settled before the database switches to WAL: on an existing database the new mode only
+    // takes effect after a VACUUM.
+    if ([self intForQuery:@"PRAGMA auto_vacuum"] != AWSFMDatabaseAutoVacuumIncremental) {
+        if (![self executeStatements:@"PRAGMA auto_vacuum = INCREMENTAL"]) {
+            AWSDDLogError(@"Failed to set 'auto_vacuum' to 'INCREMENTAL'. %@", self.lastError);
+            return NO;
+        }
+        if ([self intForQuery:@"PRAGMA page_count"] > 0 && ![self executeStatements:@"VACUUM"]) {
+            AWSDDLogError(@"Failed to rebuild the database for incremental vacuum. %@", self.lastError);
+            return NO;
+        }
+    }
+
+    NSString *journalMode = [self stringForQuery:@"PRAGMA journal_mode = WAL"];
+    if (![[journalMode lowercaseString] isEqualToString:@"wal"]) {
+        AWSDDLogError(@"Failed to set 'journal_mode' to 'WAL', database is using '%@'. %@", journalMode, self.lastError);
+        return NO;
+    }
+
+    NSString *statements = [NSString stringWithFormat:
+                            @"PRAGMA synchronous = NORMAL;"
+                            @"PRAGMA wal_autocheckpoint = %d;"
+                            @"PRAGMA journal_size_limit = %lld;",
+                            AWSFMDatabaseWALAutoCheckpointPages,
+                            AWSFMDatabaseWALJournalSizeLimit];
+    if (![self executeStatements:statements]) {
+        AWSDDLogError(@"Failed to configure write-ahead logging. %@", self.lastError);
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)aws_incrementalVacuum {
+    if ([self intForQuery:@"PRAGMA freelist_count"] == 0) {
+        return YES;
+    }
+    if (![self executeStatements:@"PRAGMA incremental_vacuum"]) {
+        AWSDDLogError(@"Failed to run 'incremental_vacuum'. %@", self.lastError);
+        return NO;
+    }
+    return YES;
+}
+
+- (BOOL)aws_executeUpdate:(NSString *)sql withValuesInList:(NSArray *)values {
+    NSUInteger count = [values count];
+    for (NSUInteger location = 0; location < count; location += AWSFMDatabaseMaximumValuesPerStatement) {
+        NSRange range = NSMakeRange(location, MIN(AWSFMDatabaseMaximumValuesPerStatement, count - location));
+        NSMutableString *placeholders = [NSMutableString stringWithCapacity:range.length * 2];
+        for (NSUInteger i = 0; i < range.length; i++) {
+            [placeholders appendString:(i == 0) ? @"?" : @",?"];
+        }
+        if (![self executeUpdate:[NSString stringWithFormat:sql, placeholders]
+            withArgumentsInArray:[values subarrayWithRange:range]]) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
++ (unsigned long long)aws_diskBytesUsedAtPath:(NSString *)aPath {
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    unsigned long long diskBytesUsed = 0;
+    for (NSString *path in @[aPath, [aPath stringByAppendingString:@"-wal"]]) {
+        NSDictionary *attributes = [fileManager attributesOfItemAtPath:path error:nil];
+        diskBytesUsed += [attributes fileSize];
+    }
+    return diskBytesUsed;
+}
+
+@end
 
 @implementation AWSFMDatabaseQueue (AWSHelpers)
 
@@ -27,6 +110,23 @@
                                                flags:flags];
 }
 
++ (instancetype)writeAheadLogDatabaseQueueWithPath:(NSString*)aPath {
+    AWSFMDatabaseQueue *databaseQueue = [self serialDatabaseQueueWithPath:aPath];
+    if (!databaseQueue) {
+        return nil;
+    }
+
+    __block BOOL configured = NO;
+    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        configured = [db aws_configureWriteAheadLogging];
+    }];
+    if (!configured) {
+        // The queue is still usable in rollback-journal mode; callers shouldn't lose their store over this.
+        AWSDDLogWarn(@"Write-ahead logging is not enabled for database at [%@]", aPath);
+    }
+    return databaseQueue;
+}
+
 @end
 
 @implementation AWSFMDatabasePool (AWSHelpers)
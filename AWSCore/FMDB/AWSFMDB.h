@@ -6,3 +6,4 @@
 
 // AWS Helpers
 #import "AWSFMDB+AWSHelpers.h"
+#import "AWSFMDatabaseReadWriteQueue.h"
@@ -0,0 +1,97 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+#import "AWSFMDatabaseQueue.h"
+
+@class AWSFMDatabase;
+@class AWSFMDatabasePool;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ The default number of read-only connections kept by an `AWSFMDatabaseReadWriteQueue`.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSFMDatabaseReadWriteQueueDefaultMaximumNumberOfReaders;
+
+/**
+ A database queue that separates writers from readers.
+
+ Writes keep the `AWSFMDatabaseQueue` semantics: `inDatabase:` and `inTransaction:` run on a single serial connection
+ opened in write-ahead-log mode. `inReadOnlyDatabase:` runs on one of a bounded pool of read-only connections, so
+ lookups see the last committed state without waiting for a long write transaction to finish.
+
+ Because it is an `AWSFMDatabaseQueue`, it can be passed anywhere a plain queue is expected.
+ */
+@interface AWSFMDatabaseReadWriteQueue : AWSFMDatabaseQueue
+
+/**
+ The maximum number of read-only connections used concurrently.
+ */
+@property (nonatomic, readonly) NSUInteger maximumNumberOfReaders;
+
+/**
+ The pool backing `inReadOnlyDatabase:`. `nil` when write-ahead logging could not be enabled, in which case reads fall
+ back to the writer connection.
+ */
+@property (nonatomic, readonly, nullable) AWSFMDatabasePool *readerPool;
+
+/**
+ Creates a queue with `AWSFMDatabaseReadWriteQueueDefaultMaximumNumberOfReaders` readers.
+
+ @param aPath The file path of the database.
+
+ @return The `AWSFMDatabaseReadWriteQueue` object. `nil` on error.
+ */
++ (nullable instancetype)readWriteQueueWithPath:(NSString *)aPath;
+
+/**
+ Creates a queue with the given number of readers.
+
+ @param aPath The file path of the database.
+ @param maximumNumberOfReaders The maximum number of read-only connections. Must be greater than `0`.
+
+ @return The `AWSFMDatabaseReadWriteQueue` object. `nil` on error.
+ */
++ (nullable instancetype)readWriteQueueWithPath:(NSString *)aPath
+                         maximumNumberOfReaders:(NSUInteger)maximumNumberOfReaders;
+
+- (nullable instancetype)initWithPath:(NSString *)aPath
+               maximumNumberOfReaders:(NSUInteger)maximumNumberOfReaders NS_DESIGNATED_INITIALIZER;
+
+/**
+ Runs a block on a read-only connection. Blocks when all readers are busy.
+
+ Writes attempted from the block fail with `SQLITE_READONLY`. Do not call `inReadOnlyDatabase:` from inside the block.
+
+ @param block The code to be run on a read-only connection.
+ */
+- (void)inReadOnlyDatabase:(void (^)(AWSFMDatabase *db))block;
+
+@end
+
+@interface AWSFMDatabaseQueue (AWSReadOnly)
+
+/**
+ Runs a read-only block. Plain `AWSFMDatabaseQueue`s run it through `inDatabase:`; `AWSFMDatabaseReadWriteQueue` runs
+ it on a reader connection. This lets helpers that take an `AWSFMDatabaseQueue` opt in to concurrent reads.
+
+ @param block The code to be run.
+ */
+- (void)inReadOnlyDatabase:(void (^)(AWSFMDatabase *db))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
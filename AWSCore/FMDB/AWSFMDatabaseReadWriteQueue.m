@@ -0,0 +1,102 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <sqlite3.h>
+#import "AWSFMDatabaseReadWriteQueue.h"
+#import "AWSFMDatabase.h"
+#import "AWSFMDatabasePool.h"
+#import "AWSFMDB+AWSHelpers.h"
+
+NSUInteger const AWSFMDatabaseReadWriteQueueDefaultMaximumNumberOfReaders = 4;
+
+@interface AWSFMDatabaseReadWriteQueue()
+
+@property (nonatomic, strong) AWSFMDatabasePool *readerPool;
+@property (nonatomic, strong) dispatch_semaphore_t readerSemaphore;
+
+@end
+
+@implementation AWSFMDatabaseReadWriteQueue
+
++ (instancetype)readWriteQueueWithPath:(NSString *)aPath {
+    return [self readWriteQueueWithPath:aPath
+                 maximumNumberOfReaders:AWSFMDatabaseReadWriteQueueDefaultMaximumNumberOfReaders];
+}
+
++ (instancetype)readWriteQueueWithPath:(NSString *)aPath
+                maximumNumberOfReaders:(NSUInteger)maximumNumberOfReaders {
+    return [[self alloc] initWithPath:aPath maximumNumberOfReaders:maximumNumberOfReaders];
+}
+
+- (instancetype)initWithPath:(NSString *)aPath flags:(int)openFlags vfs:(NSString *)vfsName {
+    return [self initWithPath:aPath maximumNumberOfReaders:AWSFMDatabaseReadWriteQueueDefaultMaximumNumberOfReaders];
+}
+
+- (instancetype)initWithPath:(NSString *)aPath
+      maximumNumberOfReaders:(NSUInteger)maximumNumberOfReaders {
+    NSParameterAssert(maximumNumberOfReaders > 0);
+
+    // Same flags as `serialDatabaseQueueWithPath:`.
+    int writerFlags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_FULLMUTEX;
+    if (self = [super initWithPath:aPath flags:writerFlags vfs:nil]) {
+        _maximumNumberOfReaders = MAX(maximumNumberOfReaders, 1);
+
+        // Creates the database file and switches it to WAL before any reader opens it. Readers in rollback-journal
+        // mode would block the writer, so they are only enabled when WAL is in effect.
+        __block BOOL writeAheadLogging = NO;
+        [self inDatabase:^(AWSFMDatabase *db) {
+            writeAheadLogging = [db aws_configureWriteAheadLogging];
+        }];
+
+        if (writeAheadLogging) {
+            _readerPool = [AWSFMDatabasePool databasePoolWithPath:aPath
+                                                            flags:SQLITE_OPEN_READONLY | SQLITE_OPEN_FULLMUTEX];
+            _readerPool.maximumNumberOfDatabasesToCreate = _maximumNumberOfReaders;
+            _readerSemaphore = dispatch_semaphore_create(_maximumNumberOfReaders);
+        } else {
+            AWSDDLogWarn(@"Write-ahead logging is not enabled for database at [%@]. Reads will use the writer connection.", aPath);
+        }
+    }
+    return self;
+}
+
+- (void)inReadOnlyDatabase:(void (^)(AWSFMDatabase *db))block {
+    AWSFMDatabasePool *readerPool = self.readerPool;
+    if (!readerPool) {
+        [self inDatabase:block];
+        return;
+    }
+
+    // The pool hands out `nil` once `maximumNumberOfDatabasesToCreate` connections are checked out, so wait for a free
+    // reader instead of letting the block run without a database.
+    dispatch_semaphore_wait(self.readerSemaphore, DISPATCH_TIME_FOREVER);
+    [readerPool inDatabase:block];
+    dispatch_semaphore_signal(self.readerSemaphore);
+}
+
+- (void)close {
+    [self.readerPool releaseAllDatabases];
+    [super close];
+}
+
+@end
+
+@implementation AWSFMDatabaseQueue (AWSReadOnly)
+
+- (void)inReadOnlyDatabase:(void (^)(AWSFMDatabase *db))block {
+    [self inDatabase:block];
+}
+
+@end
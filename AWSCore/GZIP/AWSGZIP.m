@@ -29,6 +29,9 @@
 //
 //  3. This notice may not be removed or altered from any source distribution.
 //
+//  Modified by Amazon.com: compressed output is sized with deflateBound and
+//  gunzipped output with the gzip trailer, so neither is grown while (de)compressing.
+//
 
 
 #import "AWSGZIP.h"
@@ -39,6 +42,27 @@ void awsgzip_loadGZIP(){
 
 static const NSUInteger ChunkSize = 16384;
 
+// Deflate never does better than roughly 1032:1, so a larger trailer is corrupt or hostile.
+static const NSUInteger MaximumCompressionRatio = 1032;
+
+// The uncompressed length recorded in the gzip trailer (ISIZE), or a guess for zlib data.
+// The trailer only describes the last member and is modulo 2^32, so it is a hint, not a limit.
+static NSUInteger AWSGZIPInflatedLengthHint(NSData *data)
+{
+    const uint8_t *bytes = [data bytes];
+    NSUInteger length = [data length];
+    if (length >= 18 && bytes[0] == 0x1f && bytes[1] == 0x8b)
+    {
+        const uint8_t *trailer = bytes + length - 4;
+        uint32_t isize = (uint32_t)trailer[0] | ((uint32_t)trailer[1] << 8) | ((uint32_t)trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+        if (isize > 0)
+        {
+            return MIN((NSUInteger)isize, length * MaximumCompressionRatio);
+        }
+    }
+    return (NSUInteger)(length * 1.5);
+}
+
 
 @implementation NSData (AWSGZIP)
 
@@ -58,20 +82,17 @@ static const NSUInteger ChunkSize = 16384;
         int compression = (level < 0.0f)? Z_DEFAULT_COMPRESSION: (int)(roundf(level * 9));
         if (deflateInit2(&stream, compression, Z_DEFLATED, 31, 8, Z_DEFAULT_STRATEGY) == Z_OK)
         {
-            NSMutableData *data = [NSMutableData dataWithLength:ChunkSize];
-            while (stream.avail_out == 0)
+            // deflateBound is the worst case for the whole input, so a single Z_FINISH pass always completes.
+            NSMutableData *data = [NSMutableData dataWithLength:deflateBound(&stream, (uLong)[self length])];
+            stream.next_out = (uint8_t *)[data mutableBytes];
+            stream.avail_out = (uInt)[data length];
+            int status = deflate(&stream, Z_FINISH);
+            deflateEnd(&stream);
+            if (status == Z_STREAM_END)
             {
-                if (stream.total_out >= [data length])
-                {
-                    data.length += ChunkSize;
-                }
-                stream.next_out = (uint8_t *)[data mutableBytes] + stream.total_out;
-                stream.avail_out = (uInt)([data length] - stream.total_out);
-                deflate(&stream, Z_FINISH);
+                data.length = stream.total_out;
+                return data;
             }
-            deflateEnd(&stream);
-            data.length = stream.total_out;
-            return data;
         }
     }
     return nil;
@@ -94,7 +115,7 @@ static const NSUInteger ChunkSize = 16384;
         stream.total_out = 0;
         stream.avail_out = 0;
         
-        NSMutableData *data = [NSMutableData dataWithLength:(NSUInteger)([self length] * 1.5)];
+        NSMutableData *data = [NSMutableData dataWithLength:AWSGZIPInflatedLengthHint(self)];
         if (inflateInit2(&stream, 47) == Z_OK)
         {
             int status = Z_OK;
@@ -102,7 +123,7 @@ static const NSUInteger ChunkSize = 16384;
             {
                 if (stream.total_out >= [data length])
                 {
-                    data.length += [self length] / 2;
+                    data.length += MAX([self length] / 2, ChunkSize);
                 }
                 stream.next_out = (uint8_t *)[data mutableBytes] + stream.total_out;
                 stream.avail_out = (uInt)([data length] - stream.total_out);
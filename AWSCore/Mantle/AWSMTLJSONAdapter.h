@@ -67,6 +67,12 @@ extern const NSInteger AWSMTLJSONAdapterErrorInvalidJSONDictionary;
 // does not actually exist in +propertyKeys.
 extern const NSInteger AWSMTLJSONAdapterErrorInvalidJSONMapping;
 
+// An exception was thrown and caught.
+extern const NSInteger AWSMTLJSONAdapterErrorExceptionThrown;
+
+// Associated with the NSException that was caught.
+extern NSString * const AWSMTLJSONAdapterThrownExceptionErrorKey;
+
 // Converts a MTLModel object to and from a JSON dictionary.
 @interface AWSMTLJSONAdapter : NSObject
 
@@ -19,7 +19,7 @@ const NSInteger AWSMTLJSONAdapterErrorInvalidJSONMapping = 4;
 const NSInteger AWSMTLJSONAdapterErrorExceptionThrown = 1;
 
 // Associated with the NSException that was caught.
-static NSString * const AWSMTLJSONAdapterThrownExceptionErrorKey = @"AWSMTLJSONAdapterThrownException";
+NSString * const AWSMTLJSONAdapterThrownExceptionErrorKey = @"AWSMTLJSONAdapterThrownException";
 
 @interface AWSMTLJSONAdapter ()
 
@@ -41,6 +41,7 @@ FOUNDATION_EXPORT NSString *const AWSResponseObjectErrorUserInfoKey;
 
 typedef void (^AWSNetworkingUploadProgressBlock) (int64_t bytesSent, int64_t totalBytesSent, int64_t totalBytesExpectedToSend);
 typedef void (^AWSNetworkingDownloadProgressBlock) (int64_t bytesWritten, int64_t totalBytesWritten, int64_t totalBytesExpectedToWrite);
+typedef void (^AWSNetworkingDownloadDataBlock) (NSData *data);
 
 #pragma mark - AWSHTTPMethod
 
@@ -80,6 +81,13 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
                      headers:(NSDictionary *)headers
                   parameters:(NSDictionary *)parameters;
 
+@optional
+/**
+ Set from `AWSNetworkingConfiguration` before each request is serialized.
+ */
+@property (nonatomic, assign) float GZIPCompressionLevel;
+@property (nonatomic, assign) NSUInteger GZIPMinimumBodyLength;
+
 @end
 
 @protocol AWSNetworkingRequestInterceptor <NSObject>
@@ -172,6 +180,31 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
  */
 @property (nonatomic, assign) NSTimeInterval timeoutIntervalForResource;
 
+/**
+ The compression level, from 0.0 (fastest) to 1.0 (smallest), for request bodies the service sends gzip encoded, such as Kinesis `PutRecords`. A negative value, the default, uses the zlib default level.
+ */
+@property (nonatomic, assign) float GZIPCompressionLevel;
+
+/**
+ Request bodies shorter than this many bytes are sent uncompressed, without a `Content-Encoding` header, even when the service gzip encodes the operation. The default is 0, which compresses every body.
+ */
+@property (nonatomic, assign) NSUInteger GZIPMinimumBodyLength;
+
+/**
+ The number of payload bytes in each signed chunk of S3 request bodies that are streamed with `aws-chunked` encoding, such as `putObject` and `uploadPart` bodies given as a file URL. Larger chunks, up to 1 MB or more, spend less CPU on signing per GB uploaded. The default is 0, which uses `AWSS3ChunkedEncodingDefaultChunkSize`; values under 8 KB are raised to 8 KB.
+ */
+@property (nonatomic, assign) NSUInteger chunkedEncodingChunkSize;
+
+/**
+ When YES, a read request that is identical to one already in flight on the same service client does not go to the network; it completes with the result or error of the request in flight. Requests are identical when their HTTP method, URL, headers and body hash match before signing. GET and HEAD requests, such as S3 `getObject` and `headObject` or IoT `getShadow`, are coalesced, as are the operations in `coalescedReadTargets`. Requests that download to a file, stream or report progress are always sent on their own. Results that conform to `NSCopying` are copied for each caller. Cancelling a request that joined another completes it with `AWSNetworkingErrorCancelled` and leaves the other running; cancelling the request that was sent sends it again for the callers still waiting. The default is NO.
+ */
+@property (nonatomic, assign) BOOL coalescesReadRequests;
+
+/**
+ The `X-Amz-Target` values of read-only operations that are sent as POST requests, for example `DynamoDB_20120810.DescribeTable`, to coalesce when `coalescesReadRequests` is YES.
+ */
+@property (nonatomic, copy) NSSet<NSString *> *coalescedReadTargets;
+
 @end
 
 #pragma mark - AWSNetworkingRequest
@@ -186,9 +219,23 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
 @property (nonatomic, copy) AWSNetworkingUploadProgressBlock uploadProgress;
 @property (nonatomic, copy) AWSNetworkingDownloadProgressBlock downloadProgress;
 
+/**
+ Called on the session's delegate queue with each chunk of a successful (2xx) response body as it arrives, so that the
+ body can be consumed before the response completes. The body is still buffered and returned as usual. Once a chunk has
+ been delivered the request is no longer retried, since the consumer would otherwise see the body twice.
+ */
+@property (nonatomic, copy) AWSNetworkingDownloadDataBlock downloadData;
+
 @property (readonly, nonatomic, strong) NSURLSessionTask *task;
 @property (readonly, nonatomic, assign, getter = isCancelled) BOOL cancelled;
 
+/**
+ The request produced by `requestSerializer` on the first attempt, before any interceptor ran. Retries start from a copy
+ of it, so the body is not serialized, compressed or hashed again; only the interceptors (date and signature) run. It is
+ cleared whenever `parameters` is set, and is never populated for requests with an `HTTPBodyStream`.
+ */
+@property (nonatomic, strong) NSURLRequest *serializedURLRequest;
+
 - (void)assignProperties:(AWSNetworkingConfiguration *)configuration;
 - (void)cancel;
 - (void)pause;
@@ -199,6 +246,10 @@ typedef NS_ENUM(NSInteger, AWSHTTPMethod) {
 
 @property (nonatomic, copy) AWSNetworkingUploadProgressBlock uploadProgress;
 @property (nonatomic, copy) AWSNetworkingDownloadProgressBlock downloadProgress;
+/**
+ See `-[AWSNetworkingRequest downloadData]`.
+ */
+@property (nonatomic, copy) AWSNetworkingDownloadDataBlock downloadData;
 @property (nonatomic, assign, readonly, getter = isCancelled) BOOL cancelled;
 @property (nonatomic, strong) NSURL *downloadingFileURL;
 
@@ -111,6 +111,7 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     if (self = [super init]) {
         _maxRetryCount = 3;
         _allowsCellularAccess = YES;
+        _GZIPCompressionLevel = -1.0f;
     }
     return self;
 }
@@ -166,6 +167,11 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     configuration.maxRetryCount = self.maxRetryCount;
     configuration.timeoutIntervalForRequest = self.timeoutIntervalForRequest;
     configuration.timeoutIntervalForResource = self.timeoutIntervalForResource;
+    configuration.GZIPCompressionLevel = self.GZIPCompressionLevel;
+    configuration.GZIPMinimumBodyLength = self.GZIPMinimumBodyLength;
+    configuration.chunkedEncodingChunkSize = self.chunkedEncodingChunkSize;
+    configuration.coalescesReadRequests = self.coalescesReadRequests;
+    configuration.coalescedReadTargets = self.coalescedReadTargets;
 
     return configuration;
 }
@@ -178,6 +184,8 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
 
 @property (nonatomic, strong) NSURLSessionTask *task;
 @property (nonatomic, assign, getter = isCancelled) BOOL cancelled;
+// Called once, by `cancel`, for a request that has no task of its own because it joined one in flight.
+@property (nonatomic, copy) void (^cancellationHandler)(void);
 
 @end
 
@@ -223,6 +231,20 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     if (!self.retryHandler) {
         self.retryHandler = configuration.retryHandler;
     }
+
+    if (self.GZIPCompressionLevel < 0.0f) {
+        self.GZIPCompressionLevel = configuration.GZIPCompressionLevel;
+    }
+
+    if (self.GZIPMinimumBodyLength == 0) {
+        self.GZIPMinimumBodyLength = configuration.GZIPMinimumBodyLength;
+    }
+}
+
+- (void)setParameters:(NSDictionary *)parameters {
+    _parameters = parameters;
+    // The cached body was built from the previous parameters.
+    self.serializedURLRequest = nil;
 }
 
 - (void)setTask:(NSURLSessionTask *)task {
@@ -241,13 +263,31 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     }
 }
 
+- (void)setCancellationHandler:(void (^)(void))cancellationHandler {
+    BOOL cancelled = NO;
+    @synchronized(self) {
+        cancelled = _cancelled;
+        _cancellationHandler = cancelled ? nil : [cancellationHandler copy];
+    }
+    // Cancelled before the handler was set.
+    if (cancelled && cancellationHandler) {
+        cancellationHandler();
+    }
+}
+
 - (void)cancel {
+    void (^cancellationHandler)(void) = nil;
     @synchronized(self) {
         if (!_cancelled) {
             _cancelled = YES;
             [self.task cancel];
+            cancellationHandler = _cancellationHandler;
+            _cancellationHandler = nil;
         }
     }
+    if (cancellationHandler) {
+        cancellationHandler();
+    }
 }
 
 - (void)pause {
@@ -278,6 +318,7 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     encodingBehaviors[@"shouldWriteDirectly"] = @(AWSMTLModelEncodingBehaviorUnconditional);
 
     encodingBehaviors[@"downloadProgress"] = @(AWSMTLModelEncodingBehaviorExcluded);
+    encodingBehaviors[@"downloadData"] = @(AWSMTLModelEncodingBehaviorExcluded);
     encodingBehaviors[@"internalRequest"] = @(AWSMTLModelEncodingBehaviorExcluded);
     encodingBehaviors[@"uploadProgress"] = @(AWSMTLModelEncodingBehaviorExcluded);
 
@@ -299,6 +340,13 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     return NULL;
 }
 
+// This may be a bug in our version of Mantle--despite declaring these properties as "excluded",
+// Mantle attempts to decode them from an archive, and fails when it cannot find the field name.
+- (nullable id)decodeDownloadDataWithCoder:(NSCoder *)coder
+                              modelVersion:(NSUInteger)modelVersion {
+    return NULL;
+}
+
 // This may be a bug in our version of Mantle--despite declaring these properties as "excluded",
 // Mantle attempts to decode them from an archive, and fails when it cannot find the field name.
 - (nullable id)decodeInternalRequestWithCoder:(NSCoder *)coder
@@ -321,6 +369,10 @@ NSString *const AWSNetworkingErrorDomain = @"com.amazonaws.AWSNetworkingErrorDom
     self.internalRequest.downloadProgress = downloadProgress;
 }
 
+- (void)setDownloadData:(AWSNetworkingDownloadDataBlock)downloadData {
+    self.internalRequest.downloadData = downloadData;
+}
+
 - (BOOL)isCancelled {
     return [self.internalRequest isCancelled];
 }
@@ -20,6 +20,7 @@
 #import "AWSSignature.h"
 #import "AWSBolts.h"
 #import "AWSCredentialsProvider.h"
+#import <CommonCrypto/CommonCrypto.h>
 
 NSString* const AWSResponseObjectErrorUserInfoKey = @"ResponseObjectError";
 
@@ -50,10 +51,15 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 @property (nonatomic, strong) NSURL *tempDownloadedFileURL;
 @property (nonatomic, assign) BOOL shouldWriteDirectly;
 @property (nonatomic, assign) BOOL shouldWriteToFile;
+@property (nonatomic, assign) BOOL shouldStreamResponseData;
+@property (nonatomic, assign) BOOL hasStreamedResponseData;
 
 @property (atomic, assign) int64_t lastTotalLengthOfChunkSignatureSent;
 @property (atomic, assign) int64_t payloadTotalBytesWritten;
 
+// Set once the first attempt has been checked against the requests in flight.
+@property (nonatomic, assign) BOOL coalescingChecked;
+
 @end
 
 @implementation AWSURLSessionManagerDelegate
@@ -68,11 +74,26 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
 @end
 
+// Identical read requests in flight. The leader is sent; the joiners complete with its result. Guarded by the session
+// manager's inFlightReadRequests.
+@interface AWSURLSessionManagerCoalescedRequest : NSObject
+
+@property (nonatomic, strong) NSString *key;
+@property (nonatomic, strong) AWSURLSessionManagerDelegate *leader;
+@property (nonatomic, strong) NSMutableArray<AWSURLSessionManagerDelegate *> *joiners;
+
+@end
+
+@implementation AWSURLSessionManagerCoalescedRequest
+
+@end
+
 #pragma mark - AWSNetworkingRequest
 
 @interface AWSNetworkingRequest()
 
 @property (nonatomic, strong) NSURLSessionTask *task;
+@property (nonatomic, copy) void (^cancellationHandler)(void);
 
 @end
 
@@ -85,6 +106,8 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 @property (nonatomic, strong) NSURLSession *session;
 @property (nonatomic, strong) AWSSynchronizedMutableDictionary *sessionManagerDelegates;
 @property (nonatomic) BOOL isSessionValid;
+// Coalescable read requests in flight, keyed by coalescingKeyForRequest:
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSURLSessionManagerCoalescedRequest *> *inFlightReadRequests;
 
 @end
 
@@ -121,6 +144,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
                                                  delegate:self
                                             delegateQueue:nil];
         _sessionManagerDelegates = [AWSSynchronizedMutableDictionary new];
+        _inFlightReadRequests = [NSMutableDictionary new];
         _isSessionValid = YES;
     }
 
@@ -152,11 +176,10 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
     }
 
     if (delegate.downloadingFileURL) delegate.shouldWriteToFile = YES;
+    delegate.shouldStreamResponseData = NO;
     delegate.responseData = nil;
     delegate.responseObject = nil;
     delegate.error = nil;
-    NSMutableURLRequest *mutableRequest = [NSMutableURLRequest requestWithURL:delegate.request.URL];
-    mutableRequest.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
 
     AWSNetworkingRequest *request = delegate.request;
     if (request.isCancelled) {
@@ -166,14 +189,48 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
         return;
     }
 
-    mutableRequest.HTTPMethod = [NSString aws_stringWithHTTPMethod:delegate.request.HTTPMethod];
-
     AWSTask *task = [AWSTask taskWithResult:nil];
+    NSMutableURLRequest *mutableRequest = nil;
+
+    if (request.serializedURLRequest) {
+        // A retry: reuse the body serialized for the first attempt.
+        mutableRequest = [request.serializedURLRequest mutableCopy];
+    } else {
+        mutableRequest = [NSMutableURLRequest requestWithURL:delegate.request.URL];
+        mutableRequest.cachePolicy = NSURLRequestReloadIgnoringLocalCacheData;
+        mutableRequest.HTTPMethod = [NSString aws_stringWithHTTPMethod:delegate.request.HTTPMethod];
+
+        if (request.requestSerializer) {
+            if ([request.requestSerializer respondsToSelector:@selector(setGZIPCompressionLevel:)]) {
+                request.requestSerializer.GZIPCompressionLevel = request.GZIPCompressionLevel;
+            }
+            if ([request.requestSerializer respondsToSelector:@selector(setGZIPMinimumBodyLength:)]) {
+                request.requestSerializer.GZIPMinimumBodyLength = request.GZIPMinimumBodyLength;
+            }
+            // Serializing and compressing the body is bounded by the serialization pool. Signing, which follows, can
+            // wait for a credentials refresh that needs the pools itself, so the chain leaves the pool before it.
+            task = [[[AWSTask taskWithResult:nil] continueWithExecutor:[AWSExecutor executorForPoolNamed:AWSExecutorPoolNameSerialization]
+                                                      withSuccessBlock:^id _Nullable(AWSTask * _Nonnull task) {
+                return [request.requestSerializer serializeRequest:mutableRequest
+                                                           headers:request.headers
+                                                        parameters:request.parameters];
+            }] continueWithExecutor:[AWSExecutor executorWithDispatchQueue:dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0)]
+                     withSuccessBlock:^id _Nullable(AWSTask * _Nonnull task) {
+                // Streams can only be read once, so requests with a body stream are serialized on every attempt.
+                if (!mutableRequest.HTTPBodyStream) {
+                    request.serializedURLRequest = [mutableRequest copy];
+                }
+                return nil;
+            }];
+        }
+    }
 
-    if (request.requestSerializer) {
-        task = [request.requestSerializer serializeRequest:mutableRequest
-                                                   headers:request.headers
-                                                parameters:request.parameters];
+    if (!delegate.coalescingChecked && [self canCoalesceRequest:request]) {
+        delegate.coalescingChecked = YES;
+        task = [task continueWithSuccessBlock:^id _Nullable(AWSTask * _Nonnull task) {
+            // A request that joined one in flight is done here; its task completes with the other request's result.
+            return [self joinInFlightRequest:mutableRequest delegate:delegate] ? [AWSTask cancelledTask] : nil;
+        }];
     }
 
     for(id<AWSNetworkingRequestInterceptor>interceptor in request.requestInterceptors) {
@@ -186,6 +243,8 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
         AWSNetworkingRequest *request = delegate.request;
         return [request.requestSerializer validateRequest:mutableRequest];
     }] continueWithSuccessBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        [self cachePayloadHashOfRequest:mutableRequest forNetworkingRequest:delegate.request];
+
         switch (delegate.taskType) {
             case AWSURLSessionTaskTypeData:
                 delegate.request.task = [self.session dataTaskWithRequest:mutableRequest];
@@ -226,6 +285,171 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
     }];
 }
 
+#pragma mark - Request coalescing
+
+- (BOOL)canCoalesceRequest:(AWSNetworkingRequest *)request {
+    // A request whose response goes anywhere but its task's result has to be sent on its own.
+    return self.configuration.coalescesReadRequests
+    && !request.downloadingFileURL
+    && !request.uploadingFileURL
+    && !request.shouldWriteDirectly
+    && !request.downloadData
+    && !request.downloadProgress
+    && !request.uploadProgress;
+}
+
+- (BOOL)isReadRequest:(NSURLRequest *)request {
+    if (request.HTTPBodyStream) {
+        return NO;
+    }
+    if ([request.HTTPMethod isEqualToString:@"GET"] || [request.HTTPMethod isEqualToString:@"HEAD"]) {
+        return YES;
+    }
+    NSString *target = [request valueForHTTPHeaderField:@"X-Amz-Target"];
+    return target && [self.configuration.coalescedReadTargets containsObject:target];
+}
+
+// What the signature covers, less the date and the signature itself, which the interceptors have not added yet.
+- (NSString *)coalescingKeyForRequest:(NSURLRequest *)request {
+    NSMutableString *key = [NSMutableString stringWithFormat:@"%@\n%@\n", request.HTTPMethod, request.URL.absoluteString];
+    NSDictionary<NSString *, NSString *> *headers = request.allHTTPHeaderFields;
+    for (NSString *name in [[headers allKeys] sortedArrayUsingSelector:@selector(caseInsensitiveCompare:)]) {
+        [key appendFormat:@"%@:%@\n", [name lowercaseString], headers[name]];
+    }
+
+    uint8_t digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256([request.HTTPBody bytes], (CC_LONG)[request.HTTPBody length], digest);
+    for (int i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) {
+        [key appendFormat:@"%02x", digest[i]];
+    }
+    return key;
+}
+
+// Returns YES if an identical request is in flight and the delegate's task will complete with its result. Otherwise the
+// request is registered as in flight until its task completes, and NO is returned.
+- (BOOL)joinInFlightRequest:(NSURLRequest *)request delegate:(AWSURLSessionManagerDelegate *)delegate {
+    if (![self isReadRequest:request]) {
+        return NO;
+    }
+
+    NSString *key = [self coalescingKeyForRequest:request];
+    AWSURLSessionManagerCoalescedRequest *coalescedRequest = nil;
+    BOOL joined = NO;
+    @synchronized(self.inFlightReadRequests) {
+        coalescedRequest = self.inFlightReadRequests[key];
+        if (coalescedRequest) {
+            [coalescedRequest.joiners addObject:delegate];
+            joined = YES;
+        } else {
+            coalescedRequest = [AWSURLSessionManagerCoalescedRequest new];
+            coalescedRequest.key = key;
+            coalescedRequest.leader = delegate;
+            coalescedRequest.joiners = [NSMutableArray new];
+            self.inFlightReadRequests[key] = coalescedRequest;
+        }
+    }
+
+    if (!joined) {
+        [self completeJoinersWhenLeaderCompletes:coalescedRequest];
+        return NO;
+    }
+
+    AWSDDLogDebug(@"Coalescing %@ %@ with the identical request in flight.", request.HTTPMethod, request.URL);
+    // A joiner has no task to cancel, so cancelling it only detaches it. Runs at once if it was already cancelled.
+    delegate.request.cancellationHandler = ^{
+        [self detachJoiner:delegate fromCoalescedRequest:coalescedRequest];
+    };
+    return YES;
+}
+
+- (void)detachJoiner:(AWSURLSessionManagerDelegate *)delegate
+fromCoalescedRequest:(AWSURLSessionManagerCoalescedRequest *)coalescedRequest {
+    BOOL detached = NO;
+    @synchronized(self.inFlightReadRequests) {
+        NSUInteger index = [coalescedRequest.joiners indexOfObjectIdenticalTo:delegate];
+        if (index != NSNotFound) {
+            [coalescedRequest.joiners removeObjectAtIndex:index];
+            detached = YES;
+        }
+    }
+
+    if (detached) {
+        [delegate.taskCompletionSource trySetError:[NSError errorWithDomain:AWSNetworkingErrorDomain
+                                                                       code:AWSNetworkingErrorCancelled
+                                                                   userInfo:nil]];
+    }
+}
+
+// Hands the leader's result to the joiners. If the leader's caller cancelled it, the joiners did not, so the request
+// is sent again with the first joiner as the leader.
+- (void)completeJoinersWhenLeaderCompletes:(AWSURLSessionManagerCoalescedRequest *)coalescedRequest {
+    AWSURLSessionManagerDelegate *leader = coalescedRequest.leader;
+    [leader.taskCompletionSource.task continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        AWSURLSessionManagerDelegate *nextLeader = nil;
+        NSArray<AWSURLSessionManagerDelegate *> *joiners = nil;
+        NSUInteger waitingCount = 0;
+        @synchronized(self.inFlightReadRequests) {
+            waitingCount = [coalescedRequest.joiners count];
+            if (leader.request.isCancelled && waitingCount > 0) {
+                nextLeader = coalescedRequest.joiners.firstObject;
+                [coalescedRequest.joiners removeObjectAtIndex:0];
+                coalescedRequest.leader = nextLeader;
+            } else {
+                joiners = [coalescedRequest.joiners copy];
+                [coalescedRequest.joiners removeAllObjects];
+                if (self.inFlightReadRequests[coalescedRequest.key] == coalescedRequest) {
+                    [self.inFlightReadRequests removeObjectForKey:coalescedRequest.key];
+                }
+            }
+        }
+
+        if (nextLeader) {
+            AWSDDLogDebug(@"The leader of a coalesced request was cancelled; sending it again for %lu waiting callers.",
+                          (unsigned long)waitingCount);
+            // From here on the new leader has a task of its own to cancel.
+            nextLeader.request.cancellationHandler = nil;
+            [self completeJoinersWhenLeaderCompletes:coalescedRequest];
+            [self taskWithDelegate:nextLeader];
+            return nil;
+        }
+
+        for (AWSURLSessionManagerDelegate *joiner in joiners) {
+            joiner.request.cancellationHandler = nil;
+            AWSTaskCompletionSource *taskCompletionSource = joiner.taskCompletionSource;
+            if (task.error) {
+                [taskCompletionSource trySetError:task.error];
+            } else if (task.cancelled) {
+                [taskCompletionSource trySetCancelled];
+            } else if ([task.result conformsToProtocol:@protocol(NSCopying)]) {
+                [taskCompletionSource trySetResult:[task.result copy]];
+            } else {
+                [taskCompletionSource trySetResult:task.result];
+            }
+        }
+        return nil;
+    }];
+}
+
+- (void)cachePayloadHashOfRequest:(NSURLRequest *)signedRequest
+             forNetworkingRequest:(AWSNetworkingRequest *)request {
+    NSURLRequest *serializedURLRequest = request.serializedURLRequest;
+    if (!serializedURLRequest
+        || [NSURLProtocol propertyForKey:AWSSignatureV4PayloadHashPropertyKey inRequest:serializedURLRequest]) {
+        return;
+    }
+
+    // Only carry the hash over if the interceptors signed the body that was cached. The signed request is a copy of
+    // the cached one, so unless an interceptor replaced the body both share the same data and the comparison is cheap.
+    NSString *payloadHash = [NSURLProtocol propertyForKey:AWSSignatureV4PayloadHashPropertyKey inRequest:signedRequest];
+    NSData *signedBody = signedRequest.HTTPBody;
+    NSData *serializedBody = serializedURLRequest.HTTPBody;
+    if (payloadHash && (signedBody == serializedBody || [signedBody isEqualToData:serializedBody])) {
+        NSMutableURLRequest *mutableRequest = [serializedURLRequest mutableCopy];
+        [NSURLProtocol setProperty:payloadHash forKey:AWSSignatureV4PayloadHashPropertyKey inRequest:mutableRequest];
+        request.serializedURLRequest = mutableRequest;
+    }
+}
+
 /**
  Invalidates the underlying NSURLSession to avoid memory leaks. Internally, calls
  `-[NSURLSession finishTasksAndInvalidate]` so that any in-process tasks are allowed
@@ -259,7 +483,10 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
     [self printHTTPHeadersForResponse:sessionTask.response];
 
-    [[[AWSTask taskWithResult:nil] continueWithSuccessBlock:^id(AWSTask *task) {
+    // Deserializing the response and completing the call, along with the continuations that run inline when it
+    // completes, are bounded by the request pool instead of blocking the session's delegate queue.
+    [[[AWSTask taskWithResult:nil] continueWithExecutor:[AWSExecutor executorForPoolNamed:AWSExecutorPoolNameRequest]
+                                       withSuccessBlock:^id(AWSTask *task) {
         AWSURLSessionManagerDelegate *delegate = [self.sessionManagerDelegates objectForKey:@(sessionTask.taskIdentifier)];
 
         if (delegate.responseFilehandle) {
@@ -350,7 +577,8 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
 
         if (delegate.error
             && ([sessionTask.response isKindOfClass:[NSHTTPURLResponse class]] || sessionTask.response == nil)
-            && delegate.request.retryHandler) {
+            && delegate.request.retryHandler
+            && !delegate.hasStreamedResponseData) {
             AWSNetworkingRetryType retryType = [delegate.request.retryHandler shouldRetry:delegate.currentRetryCount
                                                                           originalRequest:delegate.request
                                                                                  response:(NSHTTPURLResponse *)sessionTask.response
@@ -396,9 +624,11 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
                                                                                                     response:(NSHTTPURLResponse *)sessionTask.response
                                                                                                         data:delegate.responseData
                                                                                                        error:delegate.error];
-                    [NSThread sleepForTimeInterval:timeIntervalToSleep];
                     delegate.currentRetryCount++;
-                    [self taskWithDelegate:delegate];
+                    // Waiting here would hold a slot of the request pool for the whole backoff.
+                    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(timeIntervalToSleep * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^{
+                        [self taskWithDelegate:delegate];
+                    });
                 }
                     break;
 
@@ -476,6 +706,7 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
         
         if (httpResponse.statusCode >= 200 && httpResponse.statusCode < 300) {
             // status is good, we can keep value of shouldWriteToFile
+            delegate.shouldStreamResponseData = (delegate.request.downloadData != nil);
         } else {
             // got error status code, avoid write data to disk
             delegate.shouldWriteToFile = NO;
@@ -579,6 +810,12 @@ typedef NS_ENUM(NSInteger, AWSURLSessionTaskType) {
         }
     }
     
+    AWSNetworkingDownloadDataBlock downloadData = delegate.request.downloadData;
+    if (downloadData && delegate.shouldStreamResponseData) {
+        delegate.hasStreamedResponseData = YES;
+        downloadData(data);
+    }
+
     AWSNetworkingDownloadProgressBlock downloadProgress = delegate.request.downloadProgress;
     if (downloadProgress) {
 
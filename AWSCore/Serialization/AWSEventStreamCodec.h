@@ -0,0 +1,164 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+FOUNDATION_EXPORT NSString *const AWSEventStreamErrorDomain;
+
+/* NSError codes in AWSEventStreamErrorDomain. */
+typedef NS_ENUM(NSInteger, AWSEventStreamErrorType) {
+    AWSEventStreamErrorUnknown,
+    AWSEventStreamErrorIncompletePrelude, // Fewer bytes than the 12 byte prelude were left at the end of the data
+    AWSEventStreamErrorIncompleteMessage, // The data ended in the middle of a message
+    AWSEventStreamErrorInvalidMessageLength, // The prelude lengths are out of bounds
+    AWSEventStreamErrorPreludeChecksumMismatch,
+    AWSEventStreamErrorMessageChecksumMismatch,
+    AWSEventStreamErrorInvalidHeader, // A header is truncated, has an unknown type, or is too long to encode
+};
+
+/* Header value types of the `application/vnd.amazon.eventstream` format. */
+typedef NS_ENUM(uint8_t, AWSEventStreamHeaderType) {
+    AWSEventStreamHeaderTypeBoolTrue = 0,
+    AWSEventStreamHeaderTypeBoolFalse = 1,
+    AWSEventStreamHeaderTypeByte = 2,
+    AWSEventStreamHeaderTypeInt16 = 3,
+    AWSEventStreamHeaderTypeInt32 = 4,
+    AWSEventStreamHeaderTypeInt64 = 5,
+    AWSEventStreamHeaderTypeByteArray = 6,
+    AWSEventStreamHeaderTypeString = 7,
+    AWSEventStreamHeaderTypeTimestamp = 8,
+    AWSEventStreamHeaderTypeUUID = 9,
+};
+
+/**
+ Maximum length of a message, prelude and checksums included, allowed by the format.
+ */
+FOUNDATION_EXPORT NSUInteger const AWSEventStreamMaximumMessageLength;
+
+/**
+ A typed event-stream header value.
+ */
+@interface AWSEventStreamHeaderValue : NSObject <NSCopying>
+
+@property (nonatomic, assign, readonly) AWSEventStreamHeaderType type;
+
+/**
+ The value: an `NSNumber` for the boolean and integer types, `NSData` for byte arrays, `NSString` for strings, `NSDate`
+ for timestamps and `NSUUID` for UUIDs.
+ */
+@property (nonatomic, strong, readonly) id value;
+
+/**
+ The value if this is a string header, otherwise nil.
+ */
+@property (nonatomic, strong, readonly, nullable) NSString *stringValue;
+
++ (instancetype)headerValueWithBool:(BOOL)value;
++ (instancetype)headerValueWithByte:(int8_t)value;
++ (instancetype)headerValueWithInt16:(int16_t)value;
++ (instancetype)headerValueWithInt32:(int32_t)value;
++ (instancetype)headerValueWithInt64:(int64_t)value;
++ (instancetype)headerValueWithByteArray:(NSData *)value;
++ (instancetype)headerValueWithString:(NSString *)value;
++ (instancetype)headerValueWithTimestamp:(NSDate *)value;
++ (instancetype)headerValueWithUUID:(NSUUID *)value;
+
+@end
+
+/**
+ A single event-stream message.
+ */
+@interface AWSEventStreamMessage : NSObject
+
+@property (nonatomic, strong, readonly) NSDictionary<NSString *, AWSEventStreamHeaderValue *> *headers;
+
+/**
+ The payload. Messages returned by `AWSEventStreamDecoder` reference the decoded bytes instead of copying them, so the
+ payload keeps the buffer it was decoded from alive.
+ */
+@property (nonatomic, strong, readonly) NSData *payload;
+
+- (instancetype)initWithHeaders:(NSDictionary<NSString *, AWSEventStreamHeaderValue *> *)headers
+                        payload:(NSData *)payload;
+
+/**
+ Convenience for string headers such as `:message-type` and `:event-type`.
+ */
+- (nullable NSString *)stringValueForHeader:(NSString *)name;
+
+@end
+
+@interface AWSEventStreamEncoder : NSObject
+
+/**
+ Encodes a message into a single buffer sized up front. Header lengths are UTF-8 byte counts and the message checksum
+ continues from the prelude checksum, so no byte is checksummed twice.
+ */
++ (nullable NSData *)encodeMessage:(AWSEventStreamMessage *)message
+                             error:(NSError **)error;
+
+/**
+ Convenience for the common case of string headers only.
+ */
++ (nullable NSData *)encodeMessageWithStringHeaders:(NSDictionary<NSString *, NSString *> *)headers
+                                            payload:(NSData *)payload
+                                              error:(NSError **)error;
+
+@end
+
+/**
+ An incremental decoder. Data can be fed in arbitrary chunks; each call returns the messages completed by that chunk and
+ keeps any trailing partial message until the next call. Both checksums are verified.
+
+ After an error the stream can no longer be trusted; the decoder discards its buffered bytes and the caller is
+ expected to close the connection.
+ */
+@interface AWSEventStreamDecoder : NSObject
+
+/**
+ Messages whose prelude declares a larger length fail with `AWSEventStreamErrorInvalidMessageLength`. Defaults to
+ `AWSEventStreamMaximumMessageLength`.
+ */
+@property (nonatomic, assign) NSUInteger maximumMessageLength;
+
+/**
+ Bytes of a partial message held until more data arrives.
+ */
+@property (nonatomic, assign, readonly) NSUInteger bufferedByteCount;
+
+/**
+ Decodes as many messages as `data` completes.
+
+ @return The completed messages, possibly none, or nil on error.
+ */
+- (nullable NSArray<AWSEventStreamMessage *> *)decodeData:(NSData *)data
+                                                    error:(NSError **)error;
+
+/**
+ Discards any buffered partial message.
+ */
+- (void)reset;
+
+/**
+ Decodes data that must hold one or more whole messages, such as a WebSocket message.
+ */
++ (nullable NSArray<AWSEventStreamMessage *> *)decodeMessagesFromData:(NSData *)data
+                                                                 error:(NSError **)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,646 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import "AWSEventStreamCodec.h"
+
+#import <zlib.h>
+
+NSString *const AWSEventStreamErrorDomain = @"com.amazonaws.AWSEventStreamErrorDomain";
+NSUInteger const AWSEventStreamMaximumMessageLength = 16 * 1024 * 1024;
+
+// Total length, headers length and prelude CRC.
+static NSUInteger const AWSEventStreamPreludeLength = 12;
+// Prelude plus the trailing message CRC.
+static NSUInteger const AWSEventStreamMinimumMessageLength = 16;
+
+static NSError *AWSEventStreamError(AWSEventStreamErrorType code, NSString *reason) {
+    return [NSError errorWithDomain:AWSEventStreamErrorDomain
+                               code:code
+                           userInfo:@{NSLocalizedFailureReasonErrorKey : reason}];
+}
+
+static inline uint16_t AWSEventStreamReadUInt16(const uint8_t *bytes) {
+    return (uint16_t)((bytes[0] << 8) | bytes[1]);
+}
+
+static inline uint32_t AWSEventStreamReadUInt32(const uint8_t *bytes) {
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | (uint32_t)bytes[3];
+}
+
+static inline uint64_t AWSEventStreamReadUInt64(const uint8_t *bytes) {
+    return ((uint64_t)AWSEventStreamReadUInt32(bytes) << 32) | AWSEventStreamReadUInt32(bytes + 4);
+}
+
+static inline uint8_t *AWSEventStreamWriteUInt16(uint8_t *cursor, uint16_t value) {
+    value = CFSwapInt16HostToBig(value);
+    memcpy(cursor, &value, sizeof(value));
+    return cursor + sizeof(value);
+}
+
+static inline uint8_t *AWSEventStreamWriteUInt32(uint8_t *cursor, uint32_t value) {
+    value = CFSwapInt32HostToBig(value);
+    memcpy(cursor, &value, sizeof(value));
+    return cursor + sizeof(value);
+}
+
+static inline uint8_t *AWSEventStreamWriteUInt64(uint8_t *cursor, uint64_t value) {
+    value = CFSwapInt64HostToBig(value);
+    memcpy(cursor, &value, sizeof(value));
+    return cursor + sizeof(value);
+}
+
+#pragma mark - AWSEventStreamHeaderValue
+
+@interface AWSEventStreamHeaderValue()
+
+- (NSUInteger)encodedValueLength;
+- (uint8_t *)writeValueToBuffer:(uint8_t *)cursor;
+
+@end
+
+@implementation AWSEventStreamHeaderValue
+
+- (instancetype)initWithType:(AWSEventStreamHeaderType)type value:(id)value {
+    if (self = [super init]) {
+        _type = type;
+        _value = value;
+    }
+    return self;
+}
+
++ (instancetype)headerValueWithBool:(BOOL)value {
+    return [[self alloc] initWithType:value ? AWSEventStreamHeaderTypeBoolTrue : AWSEventStreamHeaderTypeBoolFalse
+                                value:@(value)];
+}
+
++ (instancetype)headerValueWithByte:(int8_t)value {
+    return [[self alloc] initWithType:AWSEventStreamHeaderTypeByte value:@(value)];
+}
+
++ (instancetype)headerValueWithInt16:(int16_t)value {
+    return [[self alloc] initWithType:AWSEventStreamHeaderTypeInt16 value:@(value)];
+}
+
++ (instancetype)headerValueWithInt32:(int32_t)value {
+    return [[self alloc] initWithType:AWSEventStreamHeaderTypeInt32 value:@(value)];
+}
+
++ (instancetype)headerValueWithInt64:(int64_t)value {
+    return [[self alloc] initWithType:AWSEventStreamHeaderTypeInt64 value:@(value)];
+}
+
++ (instancetype)headerValueWithByteArray:(NSData *)value {
+    return [[self alloc] initWithType:AWSEventStreamHeaderTypeByteArray value:[value copy]];
+}
+
++ (instancetype)headerValueWithString:(NSString *)value {
+    return [[self alloc] initWithType:AWSEventStreamHeaderTypeString value:[value copy]];
+}
+
++ (instancetype)headerValueWithTimestamp:(NSDate *)value {
+    return [[self alloc] initWithType:AWSEventStreamHeaderTypeTimestamp value:value];
+}
+
++ (instancetype)headerValueWithUUID:(NSUUID *)value {
+    return [[self alloc] initWithType:AWSEventStreamHeaderTypeUUID value:value];
+}
+
+- (nullable NSString *)stringValue {
+    return self.type == AWSEventStreamHeaderTypeString ? self.value : nil;
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    // Immutable.
+    return self;
+}
+
+- (BOOL)isEqual:(id)object {
+    if (self == object) {
+        return YES;
+    }
+    if (![object isKindOfClass:[AWSEventStreamHeaderValue class]]) {
+        return NO;
+    }
+    AWSEventStreamHeaderValue *other = object;
+    return self.type == other.type && [self.value isEqual:other.value];
+}
+
+- (NSUInteger)hash {
+    return [self.value hash] ^ self.type;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"%@", self.value];
+}
+
+/**
+ Bytes taken by the value after the type byte, or NSNotFound if it cannot be encoded.
+ */
+- (NSUInteger)encodedValueLength {
+    switch (self.type) {
+        case AWSEventStreamHeaderTypeBoolTrue:
+        case AWSEventStreamHeaderTypeBoolFalse:
+            return 0;
+        case AWSEventStreamHeaderTypeByte:
+            return 1;
+        case AWSEventStreamHeaderTypeInt16:
+            return 2;
+        case AWSEventStreamHeaderTypeInt32:
+            return 4;
+        case AWSEventStreamHeaderTypeInt64:
+        case AWSEventStreamHeaderTypeTimestamp:
+            return 8;
+        case AWSEventStreamHeaderTypeByteArray: {
+            NSUInteger length = [(NSData *)self.value length];
+            return length <= UINT16_MAX ? 2 + length : NSNotFound;
+        }
+        case AWSEventStreamHeaderTypeString: {
+            NSUInteger length = [(NSString *)self.value lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+            return length <= UINT16_MAX ? 2 + length : NSNotFound;
+        }
+        case AWSEventStreamHeaderTypeUUID:
+            return 16;
+    }
+    return NSNotFound;
+}
+
+- (uint8_t *)writeValueToBuffer:(uint8_t *)cursor {
+    switch (self.type) {
+        case AWSEventStreamHeaderTypeBoolTrue:
+        case AWSEventStreamHeaderTypeBoolFalse:
+            return cursor;
+        case AWSEventStreamHeaderTypeByte:
+            *cursor = (uint8_t)[self.value charValue];
+            return cursor + 1;
+        case AWSEventStreamHeaderTypeInt16:
+            return AWSEventStreamWriteUInt16(cursor, (uint16_t)[self.value shortValue]);
+        case AWSEventStreamHeaderTypeInt32:
+            return AWSEventStreamWriteUInt32(cursor, (uint32_t)[self.value intValue]);
+        case AWSEventStreamHeaderTypeInt64:
+            return AWSEventStreamWriteUInt64(cursor, (uint64_t)[self.value longLongValue]);
+        case AWSEventStreamHeaderTypeTimestamp: {
+            int64_t milliseconds = (int64_t)llround([(NSDate *)self.value timeIntervalSince1970] * 1000.0);
+            return AWSEventStreamWriteUInt64(cursor, (uint64_t)milliseconds);
+        }
+        case AWSEventStreamHeaderTypeByteArray: {
+            NSData *data = self.value;
+            cursor = AWSEventStreamWriteUInt16(cursor, (uint16_t)data.length);
+            memcpy(cursor, data.bytes, data.length);
+            return cursor + data.length;
+        }
+        case AWSEventStreamHeaderTypeString: {
+            NSString *string = self.value;
+            NSUInteger length = 0;
+            uint8_t *valueStart = cursor + 2;
+            [string getBytes:valueStart
+                   maxLength:UINT16_MAX
+                  usedLength:&length
+                    encoding:NSUTF8StringEncoding
+                     options:0
+                       range:NSMakeRange(0, string.length)
+              remainingRange:NULL];
+            AWSEventStreamWriteUInt16(cursor, (uint16_t)length);
+            return valueStart + length;
+        }
+        case AWSEventStreamHeaderTypeUUID: {
+            uuid_t uuid;
+            [(NSUUID *)self.value getUUIDBytes:uuid];
+            memcpy(cursor, uuid, sizeof(uuid));
+            return cursor + sizeof(uuid);
+        }
+    }
+    return cursor;
+}
+
+@end
+
+#pragma mark - AWSEventStreamMessage
+
+@implementation AWSEventStreamMessage
+
+- (instancetype)initWithHeaders:(NSDictionary<NSString *, AWSEventStreamHeaderValue *> *)headers
+                        payload:(NSData *)payload {
+    if (self = [super init]) {
+        _headers = [headers copy];
+        _payload = payload;
+    }
+    return self;
+}
+
+- (nullable NSString *)stringValueForHeader:(NSString *)name {
+    return self.headers[name].stringValue;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p> headers = %@, payload length = %lu",
+            NSStringFromClass([self class]), self, self.headers, (unsigned long)self.payload.length];
+}
+
+@end
+
+#pragma mark - AWSEventStreamEncoder
+
+@implementation AWSEventStreamEncoder
+
++ (nullable NSData *)encodeMessage:(AWSEventStreamMessage *)message
+                             error:(NSError **)error {
+    NSUInteger headersLength = 0;
+    for (NSString *name in message.headers) {
+        NSUInteger nameLength = [name lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        NSUInteger valueLength = [message.headers[name] encodedValueLength];
+        if (nameLength == 0 || nameLength > UINT8_MAX || valueLength == NSNotFound) {
+            if (error) {
+                *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader,
+                                             [NSString stringWithFormat:@"Header %@ cannot be encoded", name]);
+            }
+            return nil;
+        }
+        // Name length, name, type, value.
+        headersLength += 1 + nameLength + 1 + valueLength;
+    }
+
+    NSUInteger messageLength = AWSEventStreamMinimumMessageLength + headersLength + message.payload.length;
+    if (messageLength > AWSEventStreamMaximumMessageLength) {
+        if (error) {
+            *error = AWSEventStreamError(AWSEventStreamErrorInvalidMessageLength,
+                                         [NSString stringWithFormat:@"Message length %lu exceeds the maximum of %lu",
+                                          (unsigned long)messageLength, (unsigned long)AWSEventStreamMaximumMessageLength]);
+        }
+        return nil;
+    }
+
+    NSMutableData *data = [NSMutableData dataWithLength:messageLength];
+    uint8_t *bytes = data.mutableBytes;
+    uint8_t *cursor = bytes;
+
+    cursor = AWSEventStreamWriteUInt32(cursor, (uint32_t)messageLength);
+    cursor = AWSEventStreamWriteUInt32(cursor, (uint32_t)headersLength);
+    uLong crc = crc32(0L, bytes, (uInt)(cursor - bytes));
+    cursor = AWSEventStreamWriteUInt32(cursor, (uint32_t)crc);
+
+    for (NSString *name in message.headers) {
+        AWSEventStreamHeaderValue *value = message.headers[name];
+        NSUInteger nameLength = 0;
+        [name getBytes:cursor + 1
+             maxLength:UINT8_MAX
+            usedLength:&nameLength
+              encoding:NSUTF8StringEncoding
+               options:0
+                 range:NSMakeRange(0, name.length)
+        remainingRange:NULL];
+        *cursor = (uint8_t)nameLength;
+        cursor += 1 + nameLength;
+        *cursor++ = value.type;
+        cursor = [value writeValueToBuffer:cursor];
+    }
+
+    memcpy(cursor, message.payload.bytes, message.payload.length);
+    cursor += message.payload.length;
+
+    // The message CRC covers the prelude CRC too, so continue from it instead of starting over.
+    crc = crc32(crc, bytes + AWSEventStreamPreludeLength - 4, (uInt)(cursor - bytes - (AWSEventStreamPreludeLength - 4)));
+    AWSEventStreamWriteUInt32(cursor, (uint32_t)crc);
+
+    return data;
+}
+
++ (nullable NSData *)encodeMessageWithStringHeaders:(NSDictionary<NSString *, NSString *> *)headers
+                                            payload:(NSData *)payload
+                                              error:(NSError **)error {
+    NSMutableDictionary<NSString *, AWSEventStreamHeaderValue *> *headerValues = [NSMutableDictionary dictionaryWithCapacity:headers.count];
+    for (NSString *name in headers) {
+        headerValues[name] = [AWSEventStreamHeaderValue headerValueWithString:headers[name]];
+    }
+    AWSEventStreamMessage *message = [[AWSEventStreamMessage alloc] initWithHeaders:headerValues
+                                                                            payload:payload];
+    return [self encodeMessage:message error:error];
+}
+
+@end
+
+#pragma mark - AWSEventStreamDecoder
+
+@interface AWSEventStreamDecoder()
+
+@property (nonatomic, strong) NSMutableData *buffer;
+// Length of the message being buffered, known once its prelude has been buffered.
+@property (nonatomic, assign) NSUInteger bufferedMessageLength;
+
+@end
+
+@implementation AWSEventStreamDecoder
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _maximumMessageLength = AWSEventStreamMaximumMessageLength;
+        _buffer = [NSMutableData new];
+    }
+    return self;
+}
+
+- (NSUInteger)bufferedByteCount {
+    return self.buffer.length;
+}
+
+- (void)reset {
+    self.buffer.length = 0;
+    self.bufferedMessageLength = 0;
+}
+
++ (nullable NSArray<AWSEventStreamMessage *> *)decodeMessagesFromData:(NSData *)data
+                                                                 error:(NSError **)error {
+    AWSEventStreamDecoder *decoder = [AWSEventStreamDecoder new];
+    NSArray<AWSEventStreamMessage *> *messages = [decoder decodeData:data error:error];
+    if (!messages) {
+        return nil;
+    }
+
+    NSUInteger remaining = decoder.bufferedByteCount;
+    if (remaining > 0) {
+        if (error) {
+            if (remaining < AWSEventStreamPreludeLength) {
+                *error = AWSEventStreamError(AWSEventStreamErrorIncompletePrelude,
+                                             [NSString stringWithFormat:@"Prelude is %lu bytes, only %lu bytes left",
+                                              (unsigned long)AWSEventStreamPreludeLength, (unsigned long)remaining]);
+            } else {
+                *error = AWSEventStreamError(AWSEventStreamErrorIncompleteMessage,
+                                             [NSString stringWithFormat:@"Prelude specifies a message of %lu bytes, only %lu bytes left",
+                                              (unsigned long)decoder.bufferedMessageLength, (unsigned long)remaining]);
+            }
+        }
+        return nil;
+    }
+    return messages;
+}
+
+- (nullable NSArray<AWSEventStreamMessage *> *)decodeData:(NSData *)data
+                                                    error:(NSError **)error {
+    // Copying immutable data only retains it; payload slices below rely on it not changing.
+    NSData *input = [data copy];
+    const uint8_t *bytes = input.bytes;
+    NSUInteger length = input.length;
+    NSUInteger offset = 0;
+    NSMutableArray<AWSEventStreamMessage *> *messages = [NSMutableArray new];
+
+    // Finish the message left over from the previous call. Only this message is copied.
+    while (self.buffer.length > 0 && offset < length) {
+        NSUInteger target = self.buffer.length < AWSEventStreamPreludeLength ? AWSEventStreamPreludeLength : self.bufferedMessageLength;
+        NSUInteger count = MIN(target - self.buffer.length, length - offset);
+        [self.buffer appendBytes:bytes + offset length:count];
+        offset += count;
+
+        if (self.buffer.length == AWSEventStreamPreludeLength) {
+            NSUInteger messageLength = 0;
+            if (![self validatePrelude:self.buffer.bytes messageLength:&messageLength error:error]) {
+                [self reset];
+                return nil;
+            }
+            self.bufferedMessageLength = messageLength;
+        } else if (self.buffer.length == self.bufferedMessageLength) {
+            NSData *messageData = [self.buffer copy];
+            [self reset];
+            AWSEventStreamMessage *message = [self messageFromBytes:messageData.bytes
+                                                             length:messageData.length
+                                                         sourceData:messageData
+                                                              error:error];
+            if (!message) {
+                return nil;
+            }
+            [messages addObject:message];
+        }
+    }
+
+    // Everything else is decoded in place.
+    while (offset < length) {
+        NSUInteger available = length - offset;
+        if (available < AWSEventStreamPreludeLength) {
+            [self.buffer appendBytes:bytes + offset length:available];
+            break;
+        }
+
+        NSUInteger messageLength = 0;
+        if (![self validatePrelude:bytes + offset messageLength:&messageLength error:error]) {
+            [self reset];
+            return nil;
+        }
+        if (available < messageLength) {
+            [self.buffer appendBytes:bytes + offset length:available];
+            self.bufferedMessageLength = messageLength;
+            break;
+        }
+
+        AWSEventStreamMessage *message = [self messageFromBytes:bytes + offset
+                                                         length:messageLength
+                                                     sourceData:input
+                                                          error:error];
+        if (!message) {
+            [self reset];
+            return nil;
+        }
+        [messages addObject:message];
+        offset += messageLength;
+    }
+
+    return messages;
+}
+
+- (BOOL)validatePrelude:(const uint8_t *)bytes
+          messageLength:(NSUInteger *)messageLength
+                  error:(NSError **)error {
+    uint32_t totalLength = AWSEventStreamReadUInt32(bytes);
+    uint32_t headersLength = AWSEventStreamReadUInt32(bytes + 4);
+
+    // The lengths are checked before the checksum so that garbage is reported as such, not as a checksum mismatch.
+    if (totalLength < AWSEventStreamMinimumMessageLength
+        || totalLength > self.maximumMessageLength
+        || headersLength > totalLength - AWSEventStreamMinimumMessageLength) {
+        if (error) {
+            *error = AWSEventStreamError(AWSEventStreamErrorInvalidMessageLength,
+                                         [NSString stringWithFormat:@"Invalid prelude: message length %u, headers length %u",
+                                          totalLength, headersLength]);
+        }
+        return NO;
+    }
+
+    uint32_t expectedCRC = AWSEventStreamReadUInt32(bytes + 8);
+    uint32_t actualCRC = (uint32_t)crc32(0L, bytes, 8);
+    if (expectedCRC != actualCRC) {
+        if (error) {
+            *error = AWSEventStreamError(AWSEventStreamErrorPreludeChecksumMismatch,
+                                         [NSString stringWithFormat:@"Prelude checksum %08x does not match computed %08x",
+                                          expectedCRC, actualCRC]);
+        }
+        return NO;
+    }
+
+    *messageLength = totalLength;
+    return YES;
+}
+
+/**
+ Decodes a message whose prelude has already been validated. `sourceData` owns `bytes` and is retained by the payload.
+ */
+- (nullable AWSEventStreamMessage *)messageFromBytes:(const uint8_t *)bytes
+                                              length:(NSUInteger)length
+                                          sourceData:(NSData *)sourceData
+                                               error:(NSError **)error {
+    // The prelude CRC is the checksum of the first 8 bytes, so the message CRC continues from it.
+    uint32_t preludeCRC = AWSEventStreamReadUInt32(bytes + 8);
+    uint32_t expectedCRC = AWSEventStreamReadUInt32(bytes + length - 4);
+    uint32_t actualCRC = (uint32_t)crc32(preludeCRC, bytes + 8, (uInt)(length - AWSEventStreamPreludeLength));
+    if (expectedCRC != actualCRC) {
+        if (error) {
+            *error = AWSEventStreamError(AWSEventStreamErrorMessageChecksumMismatch,
+                                         [NSString stringWithFormat:@"Message checksum %08x does not match computed %08x",
+                                          expectedCRC, actualCRC]);
+        }
+        return nil;
+    }
+
+    NSUInteger headersLength = AWSEventStreamReadUInt32(bytes + 4);
+    const uint8_t *headersStart = bytes + AWSEventStreamPreludeLength;
+    NSDictionary<NSString *, AWSEventStreamHeaderValue *> *headers = [self headersFromBytes:headersStart
+                                                                                     length:headersLength
+                                                                                      error:error];
+    if (!headers) {
+        return nil;
+    }
+
+    const uint8_t *payloadStart = headersStart + headersLength;
+    NSUInteger payloadLength = length - AWSEventStreamMinimumMessageLength - headersLength;
+    NSData *payload = nil;
+    if (payloadLength == 0) {
+        payload = [NSData data];
+    } else {
+        // A slice of the source buffer, which the deallocator keeps alive.
+        payload = [[NSData alloc] initWithBytesNoCopy:(void *)payloadStart
+                                               length:payloadLength
+                                          deallocator:^(void *unusedBytes, NSUInteger unusedLength) {
+                                              [sourceData self];
+                                          }];
+    }
+
+    return [[AWSEventStreamMessage alloc] initWithHeaders:headers payload:payload];
+}
+
+- (nullable NSDictionary<NSString *, AWSEventStreamHeaderValue *> *)headersFromBytes:(const uint8_t *)bytes
+                                                                              length:(NSUInteger)length
+                                                                               error:(NSError **)error {
+    NSMutableDictionary<NSString *, AWSEventStreamHeaderValue *> *headers = [NSMutableDictionary new];
+    const uint8_t *cursor = bytes;
+    const uint8_t *end = bytes + length;
+
+#define AWS_EVENT_STREAM_REQUIRE(count) \
+    if ((NSUInteger)(end - cursor) < (count)) { \
+        goto truncated; \
+    }
+
+    while (cursor < end) {
+        NSUInteger nameLength = *cursor++;
+        AWS_EVENT_STREAM_REQUIRE(nameLength + 1);
+        NSString *name = [[NSString alloc] initWithBytes:cursor length:nameLength encoding:NSUTF8StringEncoding];
+        cursor += nameLength;
+        AWSEventStreamHeaderType type = *cursor++;
+        if (!name) {
+            if (error) {
+                *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader, @"Header name is not valid UTF-8");
+            }
+            return nil;
+        }
+
+        AWSEventStreamHeaderValue *value = nil;
+        switch (type) {
+            case AWSEventStreamHeaderTypeBoolTrue:
+                value = [AWSEventStreamHeaderValue headerValueWithBool:YES];
+                break;
+            case AWSEventStreamHeaderTypeBoolFalse:
+                value = [AWSEventStreamHeaderValue headerValueWithBool:NO];
+                break;
+            case AWSEventStreamHeaderTypeByte:
+                AWS_EVENT_STREAM_REQUIRE(1);
+                value = [AWSEventStreamHeaderValue headerValueWithByte:(int8_t)*cursor];
+                cursor += 1;
+                break;
+            case AWSEventStreamHeaderTypeInt16:
+                AWS_EVENT_STREAM_REQUIRE(2);
+                value = [AWSEventStreamHeaderValue headerValueWithInt16:(int16_t)AWSEventStreamReadUInt16(cursor)];
+                cursor += 2;
+                break;
+            case AWSEventStreamHeaderTypeInt32:
+                AWS_EVENT_STREAM_REQUIRE(4);
+                value = [AWSEventStreamHeaderValue headerValueWithInt32:(int32_t)AWSEventStreamReadUInt32(cursor)];
+                cursor += 4;
+                break;
+            case AWSEventStreamHeaderTypeInt64:
+                AWS_EVENT_STREAM_REQUIRE(8);
+                value = [AWSEventStreamHeaderValue headerValueWithInt64:(int64_t)AWSEventStreamReadUInt64(cursor)];
+                cursor += 8;
+                break;
+            case AWSEventStreamHeaderTypeTimestamp: {
+                AWS_EVENT_STREAM_REQUIRE(8);
+                int64_t milliseconds = (int64_t)AWSEventStreamReadUInt64(cursor);
+                value = [AWSEventStreamHeaderValue headerValueWithTimestamp:[NSDate dateWithTimeIntervalSince1970:milliseconds / 1000.0]];
+                cursor += 8;
+                break;
+            }
+            case AWSEventStreamHeaderTypeByteArray:
+            case AWSEventStreamHeaderTypeString: {
+                AWS_EVENT_STREAM_REQUIRE(2);
+                NSUInteger valueLength = AWSEventStreamReadUInt16(cursor);
+                cursor += 2;
+                AWS_EVENT_STREAM_REQUIRE(valueLength);
+                if (type == AWSEventStreamHeaderTypeString) {
+                    NSString *string = [[NSString alloc] initWithBytes:cursor length:valueLength encoding:NSUTF8StringEncoding];
+                    if (!string) {
+                        if (error) {
+                            *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader,
+                                                         [NSString stringWithFormat:@"Value of header %@ is not valid UTF-8", name]);
+                        }
+                        return nil;
+                    }
+                    value = [AWSEventStreamHeaderValue headerValueWithString:string];
+                } else {
+                    value = [AWSEventStreamHeaderValue headerValueWithByteArray:[NSData dataWithBytes:cursor length:valueLength]];
+                }
+                cursor += valueLength;
+                break;
+            }
+            case AWSEventStreamHeaderTypeUUID:
+                AWS_EVENT_STREAM_REQUIRE(16);
+                value = [AWSEventStreamHeaderValue headerValueWithUUID:[[NSUUID alloc] initWithUUIDBytes:cursor]];
+                cursor += 16;
+                break;
+            default:
+                if (error) {
+                    *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader,
+                                                 [NSString stringWithFormat:@"Header %@ has unknown type %u", name, type]);
+                }
+                return nil;
+        }
+        headers[name] = value;
+    }
+
+#undef AWS_EVENT_STREAM_REQUIRE
+
+    return headers;
+
+truncated:
+    if (error) {
+        *error = AWSEventStreamError(AWSEventStreamErrorInvalidHeader, @"Headers are truncated");
+    }
+    return nil;
+}
+
+@end
@@ -20,6 +20,16 @@
 
 @interface AWSJSONRequestSerializer : NSObject <AWSURLRequestSerializer>
 
+/**
+ The compression level for bodies sent with `Content-Encoding: gzip`. A negative value, the default, uses the zlib default level.
+ */
+@property (nonatomic, assign) float GZIPCompressionLevel;
+
+/**
+ Bodies shorter than this many bytes are sent uncompressed and without the `Content-Encoding` header. Defaults to 0.
+ */
+@property (nonatomic, assign) NSUInteger GZIPMinimumBodyLength;
+
 - (instancetype)initWithJSONDefinition:(NSDictionary *)JSONDefinition
                             actionName:(NSString *)actionName;
 
@@ -55,9 +55,17 @@
 
 @implementation AWSJSONRequestSerializer
 
+- (instancetype)init {
+    if (self = [super init]) {
+        _GZIPCompressionLevel = -1.0f;
+    }
+
+    return self;
+}
+
 - (instancetype)initWithJSONDefinition:(NSDictionary *)JSONDefinition
                             actionName:(NSString *)actionName {
-    if (self = [super init]) {
+    if (self = [self init]) {
 
         _serviceDefinitionJSON = JSONDefinition;
         if (_serviceDefinitionJSON == nil) {
@@ -113,8 +121,16 @@
         NSData *bodyData = [AWSJSONBuilder jsonDataForDictionary:parameters actionName:self.actionName serviceDefinitionRule:self.serviceDefinitionJSON error:&error];
         if (!error) {
             if (headers[@"Content-Encoding"] && [headers[@"Content-Encoding"] rangeOfString:@"gzip"].location != NSNotFound) {
-                //gzip the body
-                request.HTTPBody = [bodyData awsgzip_gzippedData];
+                if ([bodyData length] >= self.GZIPMinimumBodyLength) {
+                    //gzip the body
+                    request.HTTPBody = [bodyData awsgzip_gzippedDataWithCompressionLevel:self.GZIPCompressionLevel];
+                } else {
+                    //too small to be worth compressing, so send it as is
+                    NSMutableDictionary *mutableHeaders = [headers mutableCopy];
+                    [mutableHeaders removeObjectForKey:@"Content-Encoding"];
+                    headers = mutableHeaders;
+                    request.HTTPBody = bodyData;
+                }
             } else {
                 request.HTTPBody = bodyData;
             }
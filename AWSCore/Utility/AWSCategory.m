@@ -346,7 +346,7 @@ static NSTimeInterval _clockskew = 0.0;
              * Ref. https://developer.apple.com/library/ios/documentation/Cocoa/Conceptual/ObjCRuntimeGuide/Articles/ocrtPropertyIntrospection.html#//apple_ref/doc/uid/TP40008048-CH101-SW1
              */
             if ([attributes rangeOfString:@",R,"].location == NSNotFound) {
-                if (![key isEqualToString:@"uploadProgress"] && ![key isEqualToString:@"downloadProgress"]) {
+                if (![key isEqualToString:@"uploadProgress"] && ![key isEqualToString:@"downloadProgress"] && ![key isEqualToString:@"downloadData"]) {
                     //do not copy progress block since they do not have getter method and they have already been copied via internalRequest. copy it again will result in overwrite the current value to nil.
                     [self setValue:[object valueForKey:key]
                             forKey:key];
@@ -0,0 +1,118 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <AWSCore/AWSCore.h>
+
+@interface AWSExecutorTests : XCTestCase
+
+@end
+
+@implementation AWSExecutorTests
+
+- (void)testPoolRespectsConcurrencyLimit {
+    AWSExecutor *executor = [AWSExecutor executorWithName:@"AWSExecutorTests.limit"
+                              maxConcurrentOperationCount:2
+                                         qualityOfService:NSQualityOfServiceUtility];
+    __block NSInteger running = 0;
+    __block NSInteger maximumRunning = 0;
+    NSObject *lock = [NSObject new];
+
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 20; i++) {
+        [tasks addObject:[AWSTask taskFromExecutor:executor withBlock:^id{
+            @synchronized (lock) {
+                running++;
+                maximumRunning = MAX(maximumRunning, running);
+            }
+            [NSThread sleepForTimeInterval:0.01];
+            @synchronized (lock) {
+                running--;
+            }
+            return nil;
+        }]];
+    }
+
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+    XCTAssertEqual(maximumRunning, 2);
+}
+
+- (void)testPoolStartsQueuedBlocksInOrder {
+    AWSExecutor *executor = [AWSExecutor executorWithName:@"AWSExecutorTests.order"
+                              maxConcurrentOperationCount:1
+                                         qualityOfService:NSQualityOfServiceDefault];
+    NSMutableArray<NSNumber *> *order = [NSMutableArray new];
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 50; i++) {
+        [tasks addObject:[AWSTask taskFromExecutor:executor withBlock:^id{
+            [order addObject:@(i)];
+            return nil;
+        }]];
+    }
+
+    [[AWSTask taskForCompletionOfAllTasks:tasks] waitUntilFinished];
+    XCTAssertEqual(order.count, 50);
+    for (NSUInteger i = 0; i < order.count; i++) {
+        XCTAssertEqualObjects(order[i], @(i));
+    }
+}
+
+- (void)testDefaultPoolsRunAtTheirQualityOfService {
+    NSDictionary<NSString *, NSNumber *> *expected = @{AWSExecutorPoolNameRequest : @(QOS_CLASS_USER_INITIATED),
+                                                       AWSExecutorPoolNameSerialization : @(QOS_CLASS_UTILITY),
+                                                       AWSExecutorPoolNameBackground : @(QOS_CLASS_UTILITY)};
+    for (NSString *name in expected) {
+        AWSTask *task = [AWSTask taskFromExecutor:[AWSExecutor executorForPoolNamed:name] withBlock:^id{
+            return @(qos_class_self());
+        }];
+        [task waitUntilFinished];
+        XCTAssertEqualObjects(task.result, expected[name], @"%@", name);
+    }
+}
+
+- (void)testRegisteredPoolIsUsed {
+    [AWSExecutor registerPoolNamed:@"AWSExecutorTests.registered"
+       maxConcurrentOperationCount:1
+                  qualityOfService:NSQualityOfServiceBackground];
+    AWSTask *task = [AWSTask taskFromExecutor:[AWSExecutor executorForPoolNamed:@"AWSExecutorTests.registered"] withBlock:^id{
+        return @(qos_class_self());
+    }];
+    [task waitUntilFinished];
+    XCTAssertEqualObjects(task.result, @(QOS_CLASS_BACKGROUND));
+}
+
+- (void)testUnregisteredPoolFallsBackToDefaultExecutor {
+    XCTAssertEqual([AWSExecutor executorForPoolNamed:@"AWSExecutorTests.unregistered"], [AWSExecutor defaultExecutor]);
+
+    // Looking the name up did not register a pool for it.
+    [AWSExecutor registerPoolNamed:@"AWSExecutorTests.unregistered"
+       maxConcurrentOperationCount:1
+                  qualityOfService:NSQualityOfServiceBackground];
+    XCTAssertNotEqual([AWSExecutor executorForPoolNamed:@"AWSExecutorTests.unregistered"], [AWSExecutor defaultExecutor]);
+}
+
+- (void)testSerialQueueInPool {
+    dispatch_queue_t queue = [AWSExecutor serialQueueWithLabel:@"AWSExecutorTests.serial" inPoolNamed:AWSExecutorPoolNameBackground];
+    __block qos_class_t qosClass = QOS_CLASS_UNSPECIFIED;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"ran"];
+    dispatch_async(queue, ^{
+        qosClass = qos_class_self();
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqual(qosClass, QOS_CLASS_UTILITY);
+}
+
+@end
@@ -0,0 +1,102 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+#import "AWSGZIP.h"
+#import "AWSURLRequestSerialization.h"
+
+@interface AWSGZIPTests : XCTestCase
+
+@end
+
+@implementation AWSGZIPTests
+
+// Log events shaped like a CloudWatch Logs PutLogEvents batch.
+- (NSData *)logBatchOfLength:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithCapacity:length];
+    NSUInteger index = 0;
+    while ([data length] < length) {
+        NSString *event = [NSString stringWithFormat:@"{\"timestamp\":%lu,\"message\":\"GET /items/%lu 200 %lums\"},",
+                           (unsigned long)(1600000000000 + index), (unsigned long)(index * 7919 % 10007), (unsigned long)(index % 97)];
+        [data appendData:[event dataUsingEncoding:NSUTF8StringEncoding]];
+        index++;
+    }
+    data.length = length;
+    return data;
+}
+
+- (void)testGzippedDataRoundTrip {
+    NSData *data = [self logBatchOfLength:200000];
+    NSData *compressed = [data awsgzip_gzippedData];
+
+    XCTAssertNotNil(compressed);
+    XCTAssertLessThan([compressed length], [data length]);
+    XCTAssertEqualObjects([compressed awsgzip_gunzippedData], data);
+}
+
+- (void)testGzippedDataOfIncompressibleInput {
+    NSMutableData *data = [NSMutableData dataWithLength:65536];
+    arc4random_buf([data mutableBytes], [data length]);
+
+    NSData *compressed = [data awsgzip_gzippedDataWithCompressionLevel:1.0f];
+    XCTAssertNotNil(compressed);
+    XCTAssertEqualObjects([compressed awsgzip_gunzippedData], data);
+}
+
+- (void)testJSONSerializerSkipsBodiesBelowMinimumLength {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"http://aws.amazon.com"]];
+    request.HTTPMethod = @"POST";
+
+    AWSJSONRequestSerializer *serializer = [AWSJSONRequestSerializer new];
+    serializer.GZIPMinimumBodyLength = 1024;
+
+    [[serializer serializeRequest:request
+                          headers:@{@"Content-Encoding" : @"gzip"}
+                       parameters:@{@"Key1" : @"Value1"}] waitUntilFinished];
+
+    XCTAssertNil([request valueForHTTPHeaderField:@"Content-Encoding"]);
+    NSDictionary *body = [NSJSONSerialization JSONObjectWithData:request.HTTPBody options:0 error:nil];
+    XCTAssertEqualObjects(body, @{@"Key1" : @"Value1"});
+}
+
+- (void)testConfigurationCopiesGZIPSettings {
+    AWSNetworkingConfiguration *configuration = [AWSNetworkingConfiguration new];
+    XCTAssertEqual(configuration.GZIPCompressionLevel, -1.0f);
+    XCTAssertEqual(configuration.GZIPMinimumBodyLength, 0);
+
+    configuration.GZIPCompressionLevel = 0.2f;
+    configuration.GZIPMinimumBodyLength = 512;
+    AWSNetworkingConfiguration *copy = [configuration copy];
+    XCTAssertEqual(copy.GZIPCompressionLevel, 0.2f);
+    XCTAssertEqual(copy.GZIPMinimumBodyLength, 512);
+
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    [request assignProperties:configuration];
+    XCTAssertEqual(request.GZIPCompressionLevel, 0.2f);
+    XCTAssertEqual(request.GZIPMinimumBodyLength, 512);
+}
+
+#pragma mark - Benchmarks
+
+// One 1 MB PutLogEvents-sized batch, compressed in one shot into a deflateBound-sized buffer.
+- (void)testGzippedDataPerformance {
+    NSData *data = [self logBatchOfLength:1024 * 1024];
+    [self measureBlock:^{
+        XCTAssertNotNil([data awsgzip_gzippedDataWithCompressionLevel:0.1f]);
+    }];
+}
+
+@end
@@ -0,0 +1,358 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+#import "AWSURLSessionManager.h"
+
+@interface AWSRequestCoalescingTestsSerializer : NSObject <AWSURLRequestSerializer>
+
+@property (nonatomic, strong) NSData *body;
+
+@end
+
+@implementation AWSRequestCoalescingTestsSerializer
+
+- (AWSTask *)validateRequest:(NSURLRequest *)request {
+    return [AWSTask taskWithResult:nil];
+}
+
+- (AWSTask *)serializeRequest:(NSMutableURLRequest *)request
+                      headers:(NSDictionary *)headers
+                   parameters:(NSDictionary *)parameters {
+    [headers enumerateKeysAndObjectsUsingBlock:^(NSString *key, NSString *value, BOOL *stop) {
+        [request setValue:value forHTTPHeaderField:key];
+    }];
+    request.HTTPBody = self.body;
+    return [AWSTask taskWithResult:nil];
+}
+
+@end
+
+// Stands in for the signer: holds every request it sees until the test completes it, so nothing reaches the network.
+@interface AWSRequestCoalescingTestsInterceptor : NSObject <AWSNetworkingRequestInterceptor>
+
+@property (atomic, assign) NSUInteger interceptCount;
+@property (nonatomic, strong) AWSTaskCompletionSource *taskCompletionSource;
+
+@end
+
+@implementation AWSRequestCoalescingTestsInterceptor
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    }
+    return self;
+}
+
+- (AWSTask *)interceptRequest:(NSMutableURLRequest *)request {
+    self.interceptCount++;
+    return self.taskCompletionSource.task;
+}
+
+@end
+
+@interface AWSRequestCoalescingTests : XCTestCase
+
+@property (nonatomic, strong) AWSRequestCoalescingTestsInterceptor *interceptor;
+@property (nonatomic, strong) AWSRequestCoalescingTestsSerializer *serializer;
+
+@end
+
+@implementation AWSRequestCoalescingTests
+
+- (void)setUp {
+    [super setUp];
+    self.interceptor = [AWSRequestCoalescingTestsInterceptor new];
+    self.serializer = [AWSRequestCoalescingTestsSerializer new];
+}
+
+- (AWSURLSessionManager *)sessionManagerCoalescingReads:(BOOL)coalescesReadRequests {
+    AWSNetworkingConfiguration *configuration = [AWSNetworkingConfiguration new];
+    configuration.baseURL = [NSURL URLWithString:@"https://example.amazonaws.com"];
+    configuration.requestSerializer = self.serializer;
+    configuration.requestInterceptors = @[self.interceptor];
+    configuration.coalescesReadRequests = coalescesReadRequests;
+    configuration.coalescedReadTargets = [NSSet setWithObject:@"DynamoDB_20120810.DescribeTable"];
+    return [[AWSURLSessionManager alloc] initWithConfiguration:configuration];
+}
+
+- (AWSNetworkingRequest *)requestWithMethod:(AWSHTTPMethod)method path:(NSString *)path headers:(NSDictionary *)headers {
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.HTTPMethod = method;
+    request.URLString = path;
+    request.headers = headers;
+    return request;
+}
+
+- (NSError *)holdError {
+    return [NSError errorWithDomain:AWSNetworkingErrorDomain code:AWSNetworkingErrorUnknown userInfo:nil];
+}
+
+// Requests are serialized on the serialization pool, so they reach the interceptor asynchronously.
+- (void)waitForInterceptCount:(NSUInteger)interceptCount {
+    NSPredicate *predicate = [NSPredicate predicateWithBlock:^BOOL(id object, NSDictionary *bindings) {
+        return self.interceptor.interceptCount == interceptCount;
+    }];
+    [self waitForExpectations:@[[[XCTNSPredicateExpectation alloc] initWithPredicate:predicate object:nil]] timeout:5];
+}
+
+// Waits until joinerCount requests have joined the requests in flight.
+- (void)waitForJoinerCount:(NSUInteger)joinerCount sessionManager:(AWSURLSessionManager *)sessionManager {
+    NSMutableDictionary *inFlightReadRequests = [sessionManager valueForKey:@"inFlightReadRequests"];
+    NSPredicate *predicate = [NSPredicate predicateWithBlock:^BOOL(id object, NSDictionary *bindings) {
+        NSUInteger count = 0;
+        @synchronized(inFlightReadRequests) {
+            for (id coalescedRequest in [inFlightReadRequests allValues]) {
+                count += [[coalescedRequest valueForKey:@"joiners"] count];
+            }
+        }
+        return count == joinerCount;
+    }];
+    [self waitForExpectations:@[[[XCTNSPredicateExpectation alloc] initWithPredicate:predicate object:nil]] timeout:5];
+}
+
+/**
+ - Given: A session manager that coalesces reads
+ - When: Two identical GET requests are sent while the first is in flight
+ - Then: Only the first is signed and sent, and both complete with its error
+ */
+- (void)testIdenticalGETRequestsShareOneRoundTrip {
+    AWSURLSessionManager *sessionManager = [self sessionManagerCoalescingReads:YES];
+
+    AWSTask *first = [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:@{@"Accept" : @"application/json"}]];
+    [self waitForInterceptCount:1];
+    AWSTask *second = [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:@{@"accept" : @"application/json"}]];
+    [self waitForJoinerCount:1 sessionManager:sessionManager];
+    XCTAssertEqual(self.interceptor.interceptCount, 1);
+
+    NSError *error = [self holdError];
+    [self.interceptor.taskCompletionSource setError:error];
+    [first waitUntilFinished];
+    [second waitUntilFinished];
+    XCTAssertEqual(first.error, error);
+    XCTAssertEqual(second.error, error);
+
+    // Once the first request has completed, the same request goes out again.
+    self.interceptor.taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:@{@"Accept" : @"application/json"}]];
+    [self waitForInterceptCount:2];
+    [self.interceptor.taskCompletionSource setError:error];
+}
+
+/**
+ - Given: A session manager that coalesces reads
+ - When: GET requests that differ in path or headers are sent concurrently
+ - Then: Each is sent on its own
+ */
+- (void)testDifferentRequestsAreNotCoalesced {
+    AWSURLSessionManager *sessionManager = [self sessionManagerCoalescingReads:YES];
+
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil]];
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/b" headers:nil]];
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:@{@"Range" : @"bytes=0-9"}]];
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodHEAD path:@"/things/a" headers:nil]];
+    [self waitForInterceptCount:4];
+
+    [self.interceptor.taskCompletionSource setError:[self holdError]];
+}
+
+/**
+ - Given: A session manager that coalesces reads
+ - When: Identical POST requests are sent concurrently
+ - Then: They are coalesced only when their X-Amz-Target is one of the configured read targets
+ */
+- (void)testPOSTRequestsAreCoalescedOnlyForReadTargets {
+    AWSURLSessionManager *sessionManager = [self sessionManagerCoalescingReads:YES];
+    self.serializer.body = [@"{\"TableName\":\"Things\"}" dataUsingEncoding:NSUTF8StringEncoding];
+
+    NSDictionary *describeTable = @{@"X-Amz-Target" : @"DynamoDB_20120810.DescribeTable"};
+    NSDictionary *putItem = @{@"X-Amz-Target" : @"DynamoDB_20120810.PutItem"};
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodPOST path:@"/" headers:describeTable]];
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodPOST path:@"/" headers:describeTable]];
+    [self waitForInterceptCount:1];
+    [self waitForJoinerCount:1 sessionManager:sessionManager];
+
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodPOST path:@"/" headers:putItem]];
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodPOST path:@"/" headers:putItem]];
+    [self waitForInterceptCount:3];
+
+    // A different body is a different read.
+    self.serializer.body = [@"{\"TableName\":\"Others\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodPOST path:@"/" headers:describeTable]];
+    [self waitForInterceptCount:4];
+
+    [self.interceptor.taskCompletionSource setError:[self holdError]];
+}
+
+/**
+ - Given: A session manager that does not coalesce reads, and one that does
+ - When: Identical GET requests are sent concurrently, or identical downloads to a file
+ - Then: Each is sent on its own
+ */
+- (void)testRequestsAreNotCoalescedWhenDisabledOrDownloading {
+    AWSURLSessionManager *sessionManager = [self sessionManagerCoalescingReads:NO];
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil]];
+    [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil]];
+    [self waitForInterceptCount:2];
+
+    sessionManager = [self sessionManagerCoalescingReads:YES];
+    NSURL *fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:@"AWSRequestCoalescingTests"]];
+    for (int i = 0; i < 2; i++) {
+        AWSNetworkingRequest *request = [self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil];
+        request.downloadingFileURL = fileURL;
+        [sessionManager dataTaskWithRequest:request];
+    }
+    [self waitForInterceptCount:4];
+
+    [self.interceptor.taskCompletionSource setError:[self holdError]];
+}
+
+/**
+ - Given: A session manager that coalesces reads, with several callers waiting on one GET request
+ - When: The request fails and one of the waiting callers had cancelled
+ - Then: Every other caller gets the error and the cancelled caller gets AWSNetworkingErrorCancelled
+ */
+- (void)testErrorIsDeliveredToEveryJoiner {
+    AWSURLSessionManager *sessionManager = [self sessionManagerCoalescingReads:YES];
+
+    NSMutableArray<AWSNetworkingRequest *> *requests = [NSMutableArray new];
+    NSMutableArray<AWSTask *> *tasks = [NSMutableArray new];
+    for (int i = 0; i < 4; i++) {
+        AWSNetworkingRequest *request = [self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil];
+        [requests addObject:request];
+        [tasks addObject:[sessionManager dataTaskWithRequest:request]];
+        if (i == 0) {
+            [self waitForInterceptCount:1];
+        }
+    }
+    [self waitForJoinerCount:3 sessionManager:sessionManager];
+    XCTAssertEqual(self.interceptor.interceptCount, 1);
+
+    [requests[2] cancel];
+    NSError *error = [self holdError];
+    [self.interceptor.taskCompletionSource setError:error];
+    for (AWSTask *task in tasks) {
+        [task waitUntilFinished];
+    }
+
+    XCTAssertEqual(tasks[0].error, error);
+    XCTAssertEqual(tasks[1].error, error);
+    XCTAssertEqual(tasks[2].error.code, AWSNetworkingErrorCancelled);
+    XCTAssertEqual(tasks[3].error, error);
+    XCTAssertEqual(self.interceptor.interceptCount, 1);
+}
+
+/**
+ - Given: A session manager that coalesces reads, with a GET request in flight and an identical one joined to it
+ - When: The joined request is cancelled
+ - Then: It completes with AWSNetworkingErrorCancelled at once, and the request in flight carries on for its caller
+ */
+- (void)testCancellingJoinerDetachesIt {
+    AWSURLSessionManager *sessionManager = [self sessionManagerCoalescingReads:YES];
+    AWSNetworkingRequest *joinerRequest = [self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil];
+
+    AWSTask *leader = [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil]];
+    [self waitForInterceptCount:1];
+    AWSTask *joiner = [sessionManager dataTaskWithRequest:joinerRequest];
+    [self waitForJoinerCount:1 sessionManager:sessionManager];
+    XCTAssertEqual(self.interceptor.interceptCount, 1);
+
+    [joinerRequest cancel];
+    XCTAssertTrue(joiner.completed);
+    XCTAssertEqualObjects(joiner.error.domain, AWSNetworkingErrorDomain);
+    XCTAssertEqual(joiner.error.code, AWSNetworkingErrorCancelled);
+    XCTAssertFalse(leader.completed);
+
+    NSError *error = [self holdError];
+    [self.interceptor.taskCompletionSource setError:error];
+    [leader waitUntilFinished];
+    XCTAssertEqual(leader.error, error);
+    XCTAssertEqual(joiner.error.code, AWSNetworkingErrorCancelled);
+    XCTAssertEqual(self.interceptor.interceptCount, 1);
+}
+
+/**
+ - Given: A session manager that coalesces reads, with a GET request in flight and an identical one joined to it
+ - When: The request in flight is cancelled by its caller
+ - Then: The request is sent again for the joined caller, which completes with the outcome of that second request
+ */
+- (void)testCancellingLeaderSendsRequestAgainForJoiners {
+    AWSURLSessionManager *sessionManager = [self sessionManagerCoalescingReads:YES];
+    AWSNetworkingRequest *leaderRequest = [self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil];
+
+    AWSTask *leader = [sessionManager dataTaskWithRequest:leaderRequest];
+    [self waitForInterceptCount:1];
+    AWSTask *joiner = [sessionManager dataTaskWithRequest:[self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil]];
+    [self waitForJoinerCount:1 sessionManager:sessionManager];
+    XCTAssertEqual(self.interceptor.interceptCount, 1);
+
+    [leaderRequest cancel];
+    XCTAssertFalse(joiner.completed);
+
+    // The second attempt finds its outcome already decided.
+    AWSTaskCompletionSource *firstAttempt = self.interceptor.taskCompletionSource;
+    self.interceptor.taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    NSError *secondAttemptError = [NSError errorWithDomain:AWSNetworkingErrorDomain
+                                                      code:AWSNetworkingErrorUnknown
+                                                  userInfo:@{NSLocalizedDescriptionKey : @"second attempt"}];
+    [self.interceptor.taskCompletionSource setError:secondAttemptError];
+    [firstAttempt setError:[self holdError]];
+
+    [leader waitUntilFinished];
+    [joiner waitUntilFinished];
+    XCTAssertNotNil(leader.error);
+    XCTAssertEqual(joiner.error, secondAttemptError);
+    XCTAssertEqual(self.interceptor.interceptCount, 2);
+}
+
+/**
+ - Given: A session manager that coalesces reads, with a GET request in flight and an identical one joined to it
+ - When: Both callers cancel
+ - Then: The request is not sent again
+ */
+- (void)testCancellingEveryCallerDoesNotResend {
+    AWSURLSessionManager *sessionManager = [self sessionManagerCoalescingReads:YES];
+    AWSNetworkingRequest *leaderRequest = [self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil];
+    AWSNetworkingRequest *joinerRequest = [self requestWithMethod:AWSHTTPMethodGET path:@"/things/a" headers:nil];
+
+    AWSTask *leader = [sessionManager dataTaskWithRequest:leaderRequest];
+    [self waitForInterceptCount:1];
+    AWSTask *joiner = [sessionManager dataTaskWithRequest:joinerRequest];
+    [self waitForJoinerCount:1 sessionManager:sessionManager];
+
+    [joinerRequest cancel];
+    [leaderRequest cancel];
+    [self.interceptor.taskCompletionSource setError:[self holdError]];
+    [leader waitUntilFinished];
+    [joiner waitUntilFinished];
+
+    XCTAssertEqual(joiner.error.code, AWSNetworkingErrorCancelled);
+    XCTAssertEqual(self.interceptor.interceptCount, 1);
+}
+
+- (void)testConfigurationCopiesCoalescingSettings {
+    AWSNetworkingConfiguration *configuration = [AWSNetworkingConfiguration new];
+    XCTAssertFalse(configuration.coalescesReadRequests);
+
+    configuration.coalescesReadRequests = YES;
+    configuration.coalescedReadTargets = [NSSet setWithObject:@"DynamoDB_20120810.DescribeTable"];
+    AWSNetworkingConfiguration *copy = [configuration copy];
+    XCTAssertTrue(copy.coalescesReadRequests);
+    XCTAssertEqualObjects(copy.coalescedReadTargets, configuration.coalescedReadTargets);
+}
+
+@end
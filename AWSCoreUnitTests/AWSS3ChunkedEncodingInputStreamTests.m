@@ -0,0 +1,179 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+#import "AWSSignature.h"
+
+static NSString *const AWSS3ChunkedEncodingTestsScope = @"20130524/us-east-1/s3/aws4_request";
+static NSString *const AWSS3ChunkedEncodingTestsHeaderSignature = @"4f232c4386841ef735655705268965c44a0e4690baa4adea153f7db9fa80a0a9";
+static const NSUInteger AWSS3ChunkedEncodingTestsBenchmarkLength = 64 * 1024 * 1024;
+
+@interface AWSS3ChunkedEncodingInputStreamTests : XCTestCase
+
+@property (nonatomic, strong) NSDate *date;
+@property (nonatomic, strong) NSData *kSigning;
+
+@end
+
+@implementation AWSS3ChunkedEncodingInputStreamTests
+
+- (void)setUp {
+    [super setUp];
+    self.date = [NSDate dateWithTimeIntervalSince1970:1369353600];
+    self.kSigning = [AWSSignatureV4Signer getV4DerivedKey:@"wJalrXUtnFEMI/K7MDENG/bPxRfiCYEXAMPLEKEY"
+                                                     date:@"20130524"
+                                                   region:@"us-east-1"
+                                                  service:@"s3"];
+}
+
+- (NSData *)dataOfLength:(NSUInteger)length {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    arc4random_buf([data mutableBytes], length);
+    return data;
+}
+
+- (AWSS3ChunkedEncodingInputStream *)streamWithData:(NSData *)data chunkSize:(NSUInteger)chunkSize {
+    return [[AWSS3ChunkedEncodingInputStream alloc] initWithInputStream:[NSInputStream inputStreamWithData:data]
+                                                                   date:self.date
+                                                                  scope:AWSS3ChunkedEncodingTestsScope
+                                                               kSigning:self.kSigning
+                                                        headerSignature:AWSS3ChunkedEncodingTestsHeaderSignature
+                                                              chunkSize:chunkSize];
+}
+
+- (NSData *)readStream:(NSInputStream *)stream bufferLength:(NSUInteger)bufferLength {
+    NSMutableData *result = [NSMutableData new];
+    uint8_t *buffer = malloc(bufferLength);
+    [stream open];
+    while ([stream hasBytesAvailable]) {
+        NSInteger read = [stream read:buffer maxLength:bufferLength];
+        if (read <= 0) {
+            break;
+        }
+        [result appendBytes:buffer length:read];
+    }
+    [stream close];
+    free(buffer);
+    return result;
+}
+
+// The chunk signing chain built with the string based utility methods.
+- (NSData *)expectedChunkedDataForData:(NSData *)data chunkSize:(NSUInteger)chunkSize {
+    NSMutableData *expected = [NSMutableData new];
+    NSString *priorSignature = AWSS3ChunkedEncodingTestsHeaderSignature;
+    NSUInteger offset = 0;
+    for (;;) {
+        NSUInteger length = MIN(chunkSize, [data length] - offset);
+        NSData *chunk = [data subdataWithRange:NSMakeRange(offset, length)];
+        NSString *chunkSha256 = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:[AWSSignatureSignerUtility hashData:chunk]
+                                                                                           encoding:NSASCIIStringEncoding]];
+        NSString *stringToSign = [NSString stringWithFormat:@"AWS4-HMAC-SHA256-PAYLOAD\n%@\n%@\n%@\n%@\n%@",
+                                  [self.date aws_stringValue:AWSDateISO8601DateFormat2],
+                                  AWSS3ChunkedEncodingTestsScope,
+                                  priorSignature,
+                                  @"e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855",
+                                  chunkSha256];
+        NSData *signature = [AWSSignatureSignerUtility sha256HMacWithData:[stringToSign dataUsingEncoding:NSUTF8StringEncoding]
+                                                                  withKey:self.kSigning];
+        priorSignature = [AWSSignatureSignerUtility hexEncode:[[NSString alloc] initWithData:signature
+                                                                                    encoding:NSASCIIStringEncoding]];
+        NSString *header = [NSString stringWithFormat:@"%06lx;chunk-signature=%@\r\n", (unsigned long)length, priorSignature];
+        [expected appendData:[header dataUsingEncoding:NSUTF8StringEncoding]];
+        [expected appendData:chunk];
+        [expected appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
+
+        if (length == 0) {
+            break;
+        }
+        offset += length;
+    }
+    return expected;
+}
+
+- (void)testChunksMatchStringSigning {
+    NSData *data = [self dataOfLength:20000];
+    AWSS3ChunkedEncodingInputStream *stream = [self streamWithData:data chunkSize:8192];
+
+    NSData *chunked = [self readStream:stream bufferLength:32768];
+
+    XCTAssertEqualObjects(chunked, [self expectedChunkedDataForData:data chunkSize:8192]);
+    XCTAssertEqual([chunked length], [AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:[data length] chunkSize:8192]);
+    XCTAssertEqual(stream.totalLengthOfChunkSignatureSent, (int64_t)([chunked length] - [data length]));
+}
+
+- (void)testChunkSizeDoesNotDependOnReadLength {
+    NSData *data = [self dataOfLength:100000];
+    NSData *expected = [self expectedChunkedDataForData:data chunkSize:AWSS3ChunkedEncodingDefaultChunkSize];
+
+    // Reads smaller than a chunk header and reads larger than a chunk give the same body.
+    XCTAssertEqualObjects([self readStream:[self streamWithData:data chunkSize:0] bufferLength:7], expected);
+    XCTAssertEqualObjects([self readStream:[self streamWithData:data chunkSize:0] bufferLength:1024 * 1024], expected);
+}
+
+- (void)testLargeChunkSize {
+    NSUInteger chunkSize = 1024 * 1024;
+    NSData *data = [self dataOfLength:2 * chunkSize + 1];
+    AWSS3ChunkedEncodingInputStream *stream = [self streamWithData:data chunkSize:chunkSize];
+
+    NSData *chunked = [self readStream:stream bufferLength:32768];
+
+    XCTAssertEqual(stream.chunkSize, chunkSize);
+    XCTAssertEqualObjects(chunked, [self expectedChunkedDataForData:data chunkSize:chunkSize]);
+    XCTAssertEqual([chunked length], [AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:[data length] chunkSize:chunkSize]);
+}
+
+- (void)testEmptyBodyIsOneFinalChunk {
+    AWSS3ChunkedEncodingInputStream *stream = [self streamWithData:[NSData data] chunkSize:0];
+
+    NSData *chunked = [self readStream:stream bufferLength:1024];
+
+    XCTAssertEqualObjects(chunked, [self expectedChunkedDataForData:[NSData data] chunkSize:AWSS3ChunkedEncodingDefaultChunkSize]);
+    XCTAssertEqual([chunked length], 91);
+    XCTAssertFalse([stream hasBytesAvailable]);
+}
+
+- (void)testChunkSizeIsAtLeastMinimum {
+    AWSS3ChunkedEncodingInputStream *stream = [self streamWithData:[NSData data] chunkSize:1024];
+    XCTAssertEqual(stream.chunkSize, AWSS3ChunkedEncodingMinimumChunkSize);
+    XCTAssertEqual([AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:10000 chunkSize:1024],
+                   [AWSS3ChunkedEncodingInputStream computeContentLengthForChunkedData:10000 chunkSize:AWSS3ChunkedEncodingMinimumChunkSize]);
+}
+
+- (void)testConfigurationCopiesChunkSize {
+    AWSNetworkingConfiguration *configuration = [AWSNetworkingConfiguration new];
+    configuration.chunkedEncodingChunkSize = 1024 * 1024;
+    XCTAssertEqual([[configuration copy] chunkedEncodingChunkSize], 1024 * 1024);
+}
+
+#pragma mark - Benchmarks
+
+// 64 MB, read in the 32 KB pieces NSURLSession asks for. The default chunk size is the size the stream used for every
+// upload before chunk sizes became configurable; the time per GB is 16 times the measured time.
+- (void)testDefaultChunkSizePerformance {
+    NSData *data = [self dataOfLength:AWSS3ChunkedEncodingTestsBenchmarkLength];
+    [self measureBlock:^{
+        XCTAssertGreaterThan([[self readStream:[self streamWithData:data chunkSize:0] bufferLength:32768] length], [data length]);
+    }];
+}
+
+- (void)testOneMegabyteChunkSizePerformance {
+    NSData *data = [self dataOfLength:AWSS3ChunkedEncodingTestsBenchmarkLength];
+    [self measureBlock:^{
+        XCTAssertGreaterThan([[self readStream:[self streamWithData:data chunkSize:1024 * 1024] bufferLength:32768] length], [data length]);
+    }];
+}
+
+@end
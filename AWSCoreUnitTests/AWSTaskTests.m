@@ -0,0 +1,177 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <libkern/OSAtomic.h>
+#import <AWSCore/AWSCore.h>
+
+static NSUInteger const AWSTaskTestsContinuationCount = 10000;
+
+@interface AWSTaskTests : XCTestCase
+
+@end
+
+@implementation AWSTaskTests
+
+- (void)testContinuationsRunInRegistrationOrder {
+    AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    NSMutableArray<NSNumber *> *order = [NSMutableArray new];
+    for (NSUInteger i = 0; i < 100; i++) {
+        [taskCompletionSource.task continueWithExecutor:[AWSExecutor immediateExecutor] withBlock:^id(AWSTask *task) {
+            [order addObject:@(i)];
+            return nil;
+        }];
+    }
+    taskCompletionSource.result = @"done";
+
+    XCTAssertEqual(order.count, 100);
+    for (NSUInteger i = 0; i < order.count; i++) {
+        XCTAssertEqualObjects(order[i], @(i));
+    }
+}
+
+- (void)testContinuationAddedAfterCompletionRunsImmediately {
+    AWSTask *task = [AWSTask taskWithResult:@"done"];
+    __block id result = nil;
+    [task continueWithExecutor:[AWSExecutor immediateExecutor] withBlock:^id(AWSTask *t) {
+        result = t.result;
+        return nil;
+    }];
+    XCTAssertEqualObjects(result, @"done");
+}
+
+- (void)testOnlyFirstCompletionWins {
+    AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    __block NSInteger winners = 0;
+    dispatch_apply(64, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        BOOL won = NO;
+        switch (i % 3) {
+            case 0:
+                won = [taskCompletionSource trySetResult:@(i)];
+                break;
+            case 1:
+                won = [taskCompletionSource trySetError:[NSError errorWithDomain:@"AWSTaskTests" code:i userInfo:nil]];
+                break;
+            default:
+                won = [taskCompletionSource trySetCancelled];
+                break;
+        }
+        if (won) {
+            @synchronized (self) {
+                winners++;
+            }
+        }
+    });
+
+    AWSTask *task = taskCompletionSource.task;
+    XCTAssertEqual(winners, 1);
+    XCTAssertTrue(task.completed);
+    NSUInteger outcomes = (task.result != nil) + (task.error != nil) + (task.cancelled ? 1 : 0);
+    XCTAssertEqual(outcomes, 1);
+}
+
+- (void)testConcurrentContinuationsAllRun {
+    AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    __block int32_t count = 0;
+    dispatch_group_t group = dispatch_group_create();
+    dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        dispatch_apply(1000, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+            [taskCompletionSource.task continueWithExecutor:[AWSExecutor immediateExecutor] withBlock:^id(AWSTask *task) {
+                OSAtomicIncrement32Barrier(&count);
+                return nil;
+            }];
+        });
+    });
+    dispatch_group_async(group, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        taskCompletionSource.result = @"done";
+    });
+    dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+    XCTAssertEqual(count, 1000);
+}
+
+- (void)testWaitUntilFinished {
+    AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(0.1 * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        taskCompletionSource.result = @"done";
+    });
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"waited"];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [taskCompletionSource.task waitUntilFinished];
+        XCTAssertEqualObjects(taskCompletionSource.task.result, @"done");
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+- (void)testPendingTaskReleasesContinuations {
+    __weak id weakObject = nil;
+    @autoreleasepool {
+        AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+        NSObject *object = [NSObject new];
+        weakObject = object;
+        [taskCompletionSource.task continueWithBlock:^id(AWSTask *task) {
+            return object;
+        }];
+        taskCompletionSource = nil;
+    }
+    XCTAssertNil(weakObject);
+}
+
+- (void)testDescription {
+    AWSTask *task = [AWSTask taskWithResult:@"done"];
+    XCTAssertTrue([task.description containsString:@"completed = YES"]);
+    XCTAssertTrue([task.description containsString:@"result = done"]);
+    XCTAssertTrue([[AWSTask cancelledTask].description containsString:@"cancelled = YES"]);
+}
+
+#pragma mark - Benchmarks
+
+- (void)testContinuationThroughputOnPendingTask {
+    [self measureBlock:^{
+        AWSTaskCompletionSource *taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+        for (NSUInteger i = 0; i < AWSTaskTestsContinuationCount; i++) {
+            [taskCompletionSource.task continueWithExecutor:[AWSExecutor immediateExecutor] withBlock:^id(AWSTask *task) {
+                return nil;
+            }];
+        }
+        taskCompletionSource.result = @"done";
+    }];
+}
+
+- (void)testContinuationChainThroughput {
+    [self measureBlock:^{
+        AWSTask *task = [AWSTask taskWithResult:@0];
+        for (NSUInteger i = 0; i < AWSTaskTestsContinuationCount; i++) {
+            task = [task continueWithExecutor:[AWSExecutor immediateExecutor] withSuccessBlock:^id(AWSTask *t) {
+                return @([t.result unsignedIntegerValue] + 1);
+            }];
+        }
+        XCTAssertEqualObjects(task.result, @(AWSTaskTestsContinuationCount));
+    }];
+}
+
+- (void)testTaskCreationThroughput {
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < AWSTaskTestsContinuationCount * 10; i++) {
+            @autoreleasepool {
+                [AWSTask taskWithResult:@(i)];
+            }
+        }
+    }];
+}
+
+@end
@@ -31,12 +31,208 @@
 
 @interface AWSURLSessionManager()
 
+@property (nonatomic, strong) NSURLSession *session;
+
 - (void)invalidate;
 
 @end
 
+@interface AWSRequest()
+
+@property (nonatomic, strong) AWSNetworkingRequest *internalRequest;
+
+@end
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+
+// A data task that replays a canned 200 response, one body chunk and the session's completion error to the session
+// manager when resumed.
+@interface AWSURLSessionManagerTestsDataTask : NSURLSessionDataTask
+
+@property (nonatomic, assign) NSUInteger identifier;
+@property (nonatomic, strong) NSURLRequest *request;
+@property (nonatomic, strong) NSURLResponse *stubbedResponse;
+@property (nonatomic, copy) void (^resumeBlock)(AWSURLSessionManagerTestsDataTask *task);
+
+@end
+
+@implementation AWSURLSessionManagerTestsDataTask
+
+- (NSUInteger)taskIdentifier {
+    return self.identifier;
+}
+
+- (NSURLRequest *)originalRequest {
+    return self.request;
+}
+
+- (NSURLRequest *)currentRequest {
+    return self.request;
+}
+
+- (NSURLResponse *)response {
+    return self.stubbedResponse;
+}
+
+- (void)resume {
+    if (self.resumeBlock) {
+        self.resumeBlock(self);
+    }
+}
+
+- (void)cancel {
+}
+
+@end
+
+@interface AWSURLSessionManagerTestsSession : NSURLSession
+
+@property (nonatomic, weak) AWSURLSessionManager *sessionManager;
+@property (atomic, assign) NSUInteger taskCount;
+@property (nonatomic, strong) NSError *completionError;
+
+@end
+
+@implementation AWSURLSessionManagerTestsSession
+
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request {
+    AWSURLSessionManagerTestsDataTask *dataTask = [AWSURLSessionManagerTestsDataTask new];
+    dataTask.identifier = ++self.taskCount;
+    dataTask.request = request;
+    dataTask.stubbedResponse = [[NSHTTPURLResponse alloc] initWithURL:request.URL
+                                                           statusCode:200
+                                                          HTTPVersion:@"HTTP/1.1"
+                                                         headerFields:@{}];
+
+    NSError *completionError = self.completionError;
+    __weak AWSURLSessionManagerTestsSession *weakSelf = self;
+    dataTask.resumeBlock = ^(AWSURLSessionManagerTestsDataTask *task) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            AWSURLSessionManagerTestsSession *session = weakSelf;
+            AWSURLSessionManager *sessionManager = session.sessionManager;
+            [sessionManager URLSession:session
+                              dataTask:task
+                    didReceiveResponse:task.response
+                     completionHandler:^(NSURLSessionResponseDisposition disposition) {}];
+            [sessionManager URLSession:session
+                              dataTask:task
+                        didReceiveData:[@"chunk" dataUsingEncoding:NSUTF8StringEncoding]];
+            [sessionManager URLSession:session
+                                  task:task
+                  didCompleteWithError:completionError];
+        });
+    };
+    return dataTask;
+}
+
+@end
+
+#pragma clang diagnostic pop
+
+// Records the quality of service that request and response serialization run at.
+@interface AWSURLSessionManagerTestsSerializer : NSObject <AWSURLRequestSerializer, AWSHTTPURLResponseSerializer>
+
+@property (nonatomic, strong) NSData *body;
+@property (atomic, assign) qos_class_t requestQOSClass;
+@property (atomic, assign) qos_class_t responseQOSClass;
+
+@end
+
+@implementation AWSURLSessionManagerTestsSerializer
+
+- (AWSTask *)validateRequest:(NSURLRequest *)request {
+    return [AWSTask taskWithResult:nil];
+}
+
+- (AWSTask *)serializeRequest:(NSMutableURLRequest *)request
+                      headers:(NSDictionary *)headers
+                   parameters:(NSDictionary *)parameters {
+    self.requestQOSClass = qos_class_self();
+    request.HTTPBody = self.body;
+    return [AWSTask taskWithResult:nil];
+}
+
+- (BOOL)validateResponse:(NSHTTPURLResponse *)response
+             fromRequest:(NSURLRequest *)request
+                    data:(id)data
+                   error:(NSError *__autoreleasing *)error {
+    return YES;
+}
+
+- (id)responseObjectForResponse:(NSHTTPURLResponse *)response
+                originalRequest:(NSURLRequest *)originalRequest
+                 currentRequest:(NSURLRequest *)currentRequest
+                           data:(id)data
+                          error:(NSError *__autoreleasing *)error {
+    self.responseQOSClass = qos_class_self();
+    return @"result";
+}
+
+@end
+
+// Hashes the payload as the signer does, recording for every attempt the hash that the request already carried.
+@interface AWSURLSessionManagerTestsHashingInterceptor : NSObject <AWSNetworkingRequestInterceptor>
+
+@property (nonatomic, strong) NSData *replacementBody;
+@property (nonatomic, strong) NSMutableArray *cachedPayloadHashes;
+@property (nonatomic, strong) NSMutableArray<NSString *> *payloadHashes;
+
+@end
+
+@implementation AWSURLSessionManagerTestsHashingInterceptor
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _cachedPayloadHashes = [NSMutableArray new];
+        _payloadHashes = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (AWSTask *)interceptRequest:(NSMutableURLRequest *)request {
+    if (self.replacementBody) {
+        request.HTTPBody = self.replacementBody;
+    }
+    [self.cachedPayloadHashes addObject:[NSURLProtocol propertyForKey:AWSSignatureV4PayloadHashPropertyKey inRequest:request] ?: [NSNull null]];
+    [self.payloadHashes addObject:[AWSSignatureV4Signer payloadHashForRequest:request]];
+    return [AWSTask taskWithResult:nil];
+}
+
+@end
+
+@interface AWSURLSessionManagerTestsRetryHandler : NSObject <AWSURLRequestRetryHandler>
+
+@property (nonatomic, assign) uint32_t maxRetryCount;
+@property (atomic, assign) NSUInteger shouldRetryCount;
+
+@end
+
+@implementation AWSURLSessionManagerTestsRetryHandler
+
+- (AWSNetworkingRetryType)shouldRetry:(uint32_t)currentRetryCount
+                      originalRequest:(AWSNetworkingRequest *)originalRequest
+                             response:(NSHTTPURLResponse *)response
+                                 data:(NSData *)data
+                                error:(NSError *)error {
+    self.shouldRetryCount++;
+    return currentRetryCount < self.maxRetryCount ? AWSNetworkingRetryTypeShouldRetry : AWSNetworkingRetryTypeShouldNotRetry;
+}
+
+- (NSTimeInterval)timeIntervalForRetry:(uint32_t)currentRetryCount
+                              response:(NSHTTPURLResponse *)response
+                                  data:(NSData *)data
+                                 error:(NSError *)error {
+    return 0;
+}
+
+@end
+
 @interface AWSURLSessionManagerTests : XCTestCase
 
+@property (nonatomic, strong) AWSURLSessionManager *sessionManager;
+@property (nonatomic, strong) AWSURLSessionManagerTestsSession *session;
+
 @end
 
 // These tests rely on knowledge of AWSNetworking internals, but are needed to assert that we're properly releasing
@@ -113,4 +309,192 @@
     }] waitUntilFinished];
 }
 
+/**
+ - Given: An AWSNetworkingRequest with a body serialized for its first attempt
+ - When: Its parameters are replaced, as the retry handler does when resetting a stream
+ - Then: The serialized request is discarded
+ */
+- (void)testSerializedURLRequestIsClearedWhenParametersChange {
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.parameters = @{@"key" : @"value"};
+    request.serializedURLRequest = [NSURLRequest requestWithURL:[NSURL URLWithString:@"https://example.com"]];
+    XCTAssertNotNil(request.serializedURLRequest);
+
+    request.parameters = @{@"key" : @"other value"};
+    XCTAssertNil(request.serializedURLRequest);
+}
+
+/**
+ - Given: A request whose payload hash was computed by a previous signing
+ - When: The payload hash is requested again on a copy of the request
+ - Then: The stored hash is reused instead of hashing the body again
+ */
+- (void)testPayloadHashIsReusedAcrossCopies {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://example.com"]];
+    request.HTTPBody = [@"{\"key\":\"value\"}" dataUsingEncoding:NSUTF8StringEncoding];
+
+    NSString *payloadHash = [AWSSignatureV4Signer payloadHashForRequest:request];
+    XCTAssertEqual(payloadHash.length, 64);
+    XCTAssertEqualObjects([NSURLProtocol propertyForKey:AWSSignatureV4PayloadHashPropertyKey inRequest:request], payloadHash);
+
+    NSMutableURLRequest *retry = [request mutableCopy];
+    [NSURLProtocol setProperty:@"cached" forKey:AWSSignatureV4PayloadHashPropertyKey inRequest:retry];
+    XCTAssertEqualObjects([AWSSignatureV4Signer payloadHashForRequest:retry], @"cached");
+}
+
+/**
+ - Given: A service request
+ - When: A download data block is set on it
+ - Then: The block is forwarded to the networking request that the session manager streams the response body to
+ */
+- (void)testDownloadDataIsForwardedToNetworkingRequest {
+    AWSRequest *request = [AWSRequest new];
+    __block NSData *receivedData = nil;
+    request.downloadData = ^(NSData *data) {
+        receivedData = data;
+    };
+
+    XCTAssertNotNil(request.internalRequest.downloadData);
+    NSData *chunk = [@"chunk" dataUsingEncoding:NSUTF8StringEncoding];
+    request.internalRequest.downloadData(chunk);
+    XCTAssertEqualObjects(receivedData, chunk);
+}
+
+/**
+ - Given: A request that streams its response body to a download data block
+ - When: The connection drops after part of the body has been handed to the block
+ - Then: The request fails without being retried, so the block never sees the body twice
+ */
+- (void)testRequestIsNotRetriedAfterResponseDataHasStreamed {
+    AWSURLSessionManagerTestsRetryHandler *retryHandler = [AWSURLSessionManagerTestsRetryHandler new];
+    retryHandler.maxRetryCount = 1;
+
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    __block NSUInteger chunkCount = 0;
+    request.downloadData = ^(NSData *data) {
+        chunkCount++;
+    };
+
+    AWSTask *task = [self dataTaskWithRequest:request retryHandler:retryHandler completionError:[self connectionLostError]];
+    [task waitUntilFinished];
+
+    XCTAssertNotNil(task.error);
+    XCTAssertEqual(self.session.taskCount, 1);
+    XCTAssertEqual(retryHandler.shouldRetryCount, 0);
+    XCTAssertEqual(chunkCount, 1);
+}
+
+/**
+ - Given: A request without a download data block
+ - When: The connection drops after part of the body has been received
+ - Then: The retry handler is consulted and the request is sent again
+ */
+- (void)testRequestIsRetriedWhenResponseDataIsNotStreamed {
+    AWSURLSessionManagerTestsRetryHandler *retryHandler = [AWSURLSessionManagerTestsRetryHandler new];
+    retryHandler.maxRetryCount = 1;
+
+    AWSTask *task = [self dataTaskWithRequest:[AWSNetworkingRequest new] retryHandler:retryHandler completionError:[self connectionLostError]];
+    [task waitUntilFinished];
+
+    XCTAssertNotNil(task.error);
+    XCTAssertEqual(self.session.taskCount, 2);
+    XCTAssertEqual(retryHandler.shouldRetryCount, 2);
+}
+
+/**
+ - Given: A request with a body to serialize
+ - When: It is sent and its response is received
+ - Then: The body is serialized in the serialization pool and the response is handled in the request pool
+ */
+- (void)testSerializationRunsInExecutorPools {
+    AWSURLSessionManagerTestsSerializer *serializer = [AWSURLSessionManagerTestsSerializer new];
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.requestSerializer = serializer;
+    request.responseSerializer = serializer;
+
+    AWSTask *task = [self dataTaskWithRequest:request retryHandler:nil completionError:nil];
+    [task waitUntilFinished];
+
+    XCTAssertEqualObjects(task.result, @"result");
+    XCTAssertEqual(serializer.requestQOSClass, QOS_CLASS_UTILITY);
+    XCTAssertEqual(serializer.responseQOSClass, QOS_CLASS_USER_INITIATED);
+}
+
+/**
+ - Given: A request with a body that is signed on every attempt
+ - When: The connection drops and the request is retried
+ - Then: The retry is signed with the payload hash of the first attempt instead of hashing the body again
+ */
+- (void)testRetryReusesPayloadHash {
+    AWSURLSessionManagerTestsRetryHandler *retryHandler = [AWSURLSessionManagerTestsRetryHandler new];
+    retryHandler.maxRetryCount = 1;
+    AWSURLSessionManagerTestsSerializer *serializer = [AWSURLSessionManagerTestsSerializer new];
+    serializer.body = [@"{\"key\":\"value\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    AWSURLSessionManagerTestsHashingInterceptor *interceptor = [AWSURLSessionManagerTestsHashingInterceptor new];
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.requestSerializer = serializer;
+    request.requestInterceptors = @[interceptor];
+
+    AWSTask *task = [self dataTaskWithRequest:request retryHandler:retryHandler completionError:[self connectionLostError]];
+    [task waitUntilFinished];
+
+    XCTAssertEqual(self.session.taskCount, 2);
+    XCTAssertEqual([interceptor.payloadHashes count], 2);
+    XCTAssertEqualObjects(interceptor.cachedPayloadHashes[0], [NSNull null]);
+    XCTAssertEqualObjects(interceptor.cachedPayloadHashes[1], interceptor.payloadHashes[0]);
+}
+
+/**
+ - Given: A request whose body an interceptor replaces with different bytes of the same length
+ - When: The connection drops and the request is retried
+ - Then: The hash of the replaced body is not cached for the serialized body, so the retry hashes again
+ */
+- (void)testPayloadHashIsNotReusedForReplacedBody {
+    AWSURLSessionManagerTestsRetryHandler *retryHandler = [AWSURLSessionManagerTestsRetryHandler new];
+    retryHandler.maxRetryCount = 1;
+    AWSURLSessionManagerTestsSerializer *serializer = [AWSURLSessionManagerTestsSerializer new];
+    serializer.body = [@"{\"key\":\"value\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    AWSURLSessionManagerTestsHashingInterceptor *interceptor = [AWSURLSessionManagerTestsHashingInterceptor new];
+    interceptor.replacementBody = [@"{\"key\":\"other\"}" dataUsingEncoding:NSUTF8StringEncoding];
+    XCTAssertEqual(interceptor.replacementBody.length, serializer.body.length);
+    AWSNetworkingRequest *request = [AWSNetworkingRequest new];
+    request.requestSerializer = serializer;
+    request.requestInterceptors = @[interceptor];
+
+    AWSTask *task = [self dataTaskWithRequest:request retryHandler:retryHandler completionError:[self connectionLostError]];
+    [task waitUntilFinished];
+
+    XCTAssertEqual(self.session.taskCount, 2);
+    XCTAssertEqualObjects(interceptor.cachedPayloadHashes, (@[[NSNull null], [NSNull null]]));
+}
+
+- (NSError *)connectionLostError {
+    return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil];
+}
+
+// Sends the request through a session manager whose URL session is replaced by AWSURLSessionManagerTestsSession.
+- (AWSTask *)dataTaskWithRequest:(AWSNetworkingRequest *)request
+                    retryHandler:(id<AWSURLRequestRetryHandler>)retryHandler
+                 completionError:(NSError *)completionError {
+    AWSNetworkingConfiguration *configuration = [AWSNetworkingConfiguration new];
+    configuration.baseURL = [NSURL URLWithString:@"https://example.amazonaws.com"];
+    configuration.retryHandler = retryHandler;
+    self.sessionManager = [[AWSURLSessionManager alloc] initWithConfiguration:configuration];
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    self.session = [AWSURLSessionManagerTestsSession new];
+#pragma clang diagnostic pop
+    self.session.sessionManager = self.sessionManager;
+    self.session.completionError = completionError;
+
+    NSURLSession *originalSession = self.sessionManager.session;
+    self.sessionManager.session = self.session;
+    [originalSession invalidateAndCancel];
+
+    request.HTTPMethod = AWSHTTPMethodGET;
+    request.URLString = @"/things/a";
+    return [self.sessionManager dataTaskWithRequest:request];
+}
+
 @end
@@ -0,0 +1,155 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSCore.h"
+#import "AWSEventStreamCodec.h"
+
+// A Transcribe Streaming partial transcript event captured from the service.
+static NSString *const AWSEventStreamCodecTestsTranscriptEvent = @"AAABsgAAAFXfePLDCzpldmVudC10eXBlBwAPVHJhbnNjcmlwdEV2ZW50DTpjb250ZW50LXR5cGUHABBhcHBsaWNhdGlvbi9qc29uDTptZXNzYWdlLXR5cGUHAAVldmVudHsiVHJhbnNjcmlwdCI6eyJSZXN1bHRzIjpbeyJBbHRlcm5hdGl2ZXMiOlt7Ikl0ZW1zIjpbeyJDb250ZW50IjoiSGVsbG8iLCJFbmRUaW1lIjowLjIxLCJTdGFydFRpbWUiOjAuMTIsIlR5cGUiOiJwcm9udW5jaWF0aW9uIn0seyJDb250ZW50Ijoid2VyZSIsIkVuZFRpbWUiOjAuNDksIlN0YXJ0VGltZSI6MC4yMiwiVHlwZSI6InByb251bmNpYXRpb24ifV0sIlRyYW5zY3JpcHQiOiJIZWxsbyB3ZXJlIn1dLCJFbmRUaW1lIjowLjUzLCJJc1BhcnRpYWwiOnRydWUsIlJlc3VsdElkIjoiOTQ4NjJmNGEtMzc5My00ZTViLThlODUtMTkxNWM4ZDMzZjkyIiwiU3RhcnRUaW1lIjowLjEyfV19fRMshLQ=";
+
+@interface AWSEventStreamCodecTests : XCTestCase
+
+@end
+
+@implementation AWSEventStreamCodecTests
+
+- (void)testDecodeCapturedMessage {
+    NSData *data = [[NSData alloc] initWithBase64EncodedString:AWSEventStreamCodecTestsTranscriptEvent options:0];
+    NSError *error = nil;
+    NSArray<AWSEventStreamMessage *> *messages = [AWSEventStreamDecoder decodeMessagesFromData:data error:&error];
+    XCTAssertNil(error);
+    XCTAssertEqual(messages.count, 1);
+
+    AWSEventStreamMessage *message = messages.firstObject;
+    XCTAssertEqualObjects([message stringValueForHeader:@":message-type"], @"event");
+    XCTAssertEqualObjects([message stringValueForHeader:@":event-type"], @"TranscriptEvent");
+    XCTAssertEqualObjects([message stringValueForHeader:@":content-type"], @"application/json");
+    XCTAssertTrue([[[NSString alloc] initWithData:message.payload encoding:NSUTF8StringEncoding] hasPrefix:@"{\"Transcript\""]);
+
+    // The payload is a slice of the input, not a copy.
+    const uint8_t *start = data.bytes;
+    XCTAssertTrue((const uint8_t *)message.payload.bytes > start);
+    XCTAssertTrue((const uint8_t *)message.payload.bytes + message.payload.length < start + data.length);
+}
+
+- (void)testRoundTripAllHeaderTypes {
+    NSUUID *uuid = [NSUUID UUID];
+    NSDate *timestamp = [NSDate dateWithTimeIntervalSince1970:1600000000.123];
+    NSDictionary<NSString *, AWSEventStreamHeaderValue *> *headers = @{
+        @"true" : [AWSEventStreamHeaderValue headerValueWithBool:YES],
+        @"false" : [AWSEventStreamHeaderValue headerValueWithBool:NO],
+        @"byte" : [AWSEventStreamHeaderValue headerValueWithByte:-7],
+        @"int16" : [AWSEventStreamHeaderValue headerValueWithInt16:-1234],
+        @"int32" : [AWSEventStreamHeaderValue headerValueWithInt32:123456789],
+        @"int64" : [AWSEventStreamHeaderValue headerValueWithInt64:-1234567890123],
+        @"bytes" : [AWSEventStreamHeaderValue headerValueWithByteArray:[@"raw" dataUsingEncoding:NSUTF8StringEncoding]],
+        @"string" : [AWSEventStreamHeaderValue headerValueWithString:@"value"],
+        @"timestamp" : [AWSEventStreamHeaderValue headerValueWithTimestamp:timestamp],
+        @"uuid" : [AWSEventStreamHeaderValue headerValueWithUUID:uuid],
+    };
+    NSData *payload = [@"payload" dataUsingEncoding:NSUTF8StringEncoding];
+    AWSEventStreamMessage *message = [[AWSEventStreamMessage alloc] initWithHeaders:headers payload:payload];
+
+    NSError *error = nil;
+    NSData *encoded = [AWSEventStreamEncoder encodeMessage:message error:&error];
+    XCTAssertNil(error);
+
+    AWSEventStreamMessage *decoded = [AWSEventStreamDecoder decodeMessagesFromData:encoded error:&error].firstObject;
+    XCTAssertNil(error);
+    XCTAssertEqualObjects(decoded.payload, payload);
+    for (NSString *name in headers) {
+        if ([name isEqualToString:@"timestamp"]) {
+            XCTAssertEqualWithAccuracy([decoded.headers[name].value timeIntervalSince1970], timestamp.timeIntervalSince1970, 0.001);
+        } else {
+            XCTAssertEqualObjects(decoded.headers[name], headers[name], @"%@", name);
+        }
+    }
+}
+
+- (void)testNonASCIIHeadersUseUTF8Lengths {
+    NSError *error = nil;
+    NSData *encoded = [AWSEventStreamEncoder encodeMessageWithStringHeaders:@{@"café" : @"naïve ✓"}
+                                                                    payload:[NSData data]
+                                                                      error:&error];
+    XCTAssertNil(error);
+    AWSEventStreamMessage *decoded = [AWSEventStreamDecoder decodeMessagesFromData:encoded error:&error].firstObject;
+    XCTAssertNil(error);
+    XCTAssertEqualObjects([decoded stringValueForHeader:@"café"], @"naïve ✓");
+}
+
+- (void)testDecodeMultipleAndPartialMessages {
+    NSMutableData *stream = [NSMutableData new];
+    for (NSUInteger i = 0; i < 3; i++) {
+        NSData *payload = [[NSString stringWithFormat:@"message %lu", (unsigned long)i] dataUsingEncoding:NSUTF8StringEncoding];
+        [stream appendData:[AWSEventStreamEncoder encodeMessageWithStringHeaders:@{@":message-type" : @"event"}
+                                                                         payload:payload
+                                                                           error:nil]];
+    }
+
+    // All at once.
+    NSArray<AWSEventStreamMessage *> *messages = [AWSEventStreamDecoder decodeMessagesFromData:stream error:nil];
+    XCTAssertEqual(messages.count, 3);
+
+    // One byte at a time.
+    AWSEventStreamDecoder *decoder = [AWSEventStreamDecoder new];
+    NSMutableArray<AWSEventStreamMessage *> *decoded = [NSMutableArray new];
+    const uint8_t *bytes = stream.bytes;
+    for (NSUInteger i = 0; i < stream.length; i++) {
+        NSError *error = nil;
+        NSArray<AWSEventStreamMessage *> *chunkMessages = [decoder decodeData:[NSData dataWithBytes:bytes + i length:1] error:&error];
+        XCTAssertNil(error);
+        [decoded addObjectsFromArray:chunkMessages];
+    }
+    XCTAssertEqual(decoder.bufferedByteCount, 0);
+    XCTAssertEqual(decoded.count, 3);
+    for (NSUInteger i = 0; i < decoded.count; i++) {
+        NSString *expected = [NSString stringWithFormat:@"message %lu", (unsigned long)i];
+        XCTAssertEqualObjects([[NSString alloc] initWithData:decoded[i].payload encoding:NSUTF8StringEncoding], expected);
+    }
+}
+
+- (void)testChecksumMismatches {
+    NSData *data = [[NSData alloc] initWithBase64EncodedString:AWSEventStreamCodecTestsTranscriptEvent options:0];
+    NSError *error = nil;
+
+    NSMutableData *corruptPrelude = [data mutableCopy];
+    ((uint8_t *)corruptPrelude.mutableBytes)[9] ^= 0xFF;
+    XCTAssertNil([AWSEventStreamDecoder decodeMessagesFromData:corruptPrelude error:&error]);
+    XCTAssertEqual(error.code, AWSEventStreamErrorPreludeChecksumMismatch);
+
+    NSMutableData *corruptPayload = [data mutableCopy];
+    ((uint8_t *)corruptPayload.mutableBytes)[200] ^= 0xFF;
+    XCTAssertNil([AWSEventStreamDecoder decodeMessagesFromData:corruptPayload error:&error]);
+    XCTAssertEqual(error.code, AWSEventStreamErrorMessageChecksumMismatch);
+}
+
+- (void)testTruncatedAndInvalidData {
+    NSData *data = [[NSData alloc] initWithBase64EncodedString:AWSEventStreamCodecTestsTranscriptEvent options:0];
+    NSError *error = nil;
+
+    XCTAssertNil([AWSEventStreamDecoder decodeMessagesFromData:[data subdataWithRange:NSMakeRange(0, 4)] error:&error]);
+    XCTAssertEqual(error.code, AWSEventStreamErrorIncompletePrelude);
+
+    XCTAssertNil([AWSEventStreamDecoder decodeMessagesFromData:[data subdataWithRange:NSMakeRange(0, 100)] error:&error]);
+    XCTAssertEqual(error.code, AWSEventStreamErrorIncompleteMessage);
+
+    NSMutableData *junk = [NSMutableData dataWithLength:100];
+    memset(junk.mutableBytes, 0x01, junk.length);
+    XCTAssertNil([AWSEventStreamDecoder decodeMessagesFromData:junk error:&error]);
+    XCTAssertEqual(error.code, AWSEventStreamErrorInvalidMessageLength);
+}
+
+@end
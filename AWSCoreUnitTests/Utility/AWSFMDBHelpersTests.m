@@ -0,0 +1,173 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <AWSCore/AWSCore.h>
+
+static NSUInteger const AWSFMDBHelpersTestsRecordCount = 500;
+
+@interface AWSFMDBHelpersTests : XCTestCase
+
+@property (nonatomic, strong) NSString *databasePath;
+
+@end
+
+@implementation AWSFMDBHelpersTests
+
+- (void)setUp {
+    [super setUp];
+    self.databasePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+}
+
+- (void)tearDown {
+    for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+        [[NSFileManager defaultManager] removeItemAtPath:[self.databasePath stringByAppendingString:suffix] error:nil];
+    }
+    [super tearDown];
+}
+
+- (void)testWriteAheadLogDatabaseQueueConfiguration {
+    AWSFMDatabaseQueue *databaseQueue = [AWSFMDatabaseQueue writeAheadLogDatabaseQueueWithPath:self.databasePath];
+    XCTAssertNotNil(databaseQueue);
+
+    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        XCTAssertEqualObjects([[db stringForQuery:@"PRAGMA journal_mode"] lowercaseString], @"wal");
+        XCTAssertEqual([db intForQuery:@"PRAGMA synchronous"], 1); // NORMAL
+        XCTAssertEqual([db intForQuery:@"PRAGMA auto_vacuum"], 2); // INCREMENTAL
+        XCTAssertEqual([db intForQuery:@"PRAGMA wal_autocheckpoint"], AWSFMDatabaseWALAutoCheckpointPages);
+    }];
+    [databaseQueue close];
+}
+
+- (void)testExistingFullVacuumDatabaseIsConverted {
+    AWSFMDatabaseQueue *legacyQueue = [AWSFMDatabaseQueue serialDatabaseQueueWithPath:self.databasePath];
+    [legacyQueue inDatabase:^(AWSFMDatabase *db) {
+        XCTAssertTrue([db executeStatements:@"PRAGMA auto_vacuum = FULL"]);
+        XCTAssertTrue([db executeUpdate:@"CREATE TABLE record (data BLOB NOT NULL)"]);
+        XCTAssertTrue([db executeUpdate:@"INSERT INTO record (data) VALUES (?)", [self recordData]]);
+    }];
+    [legacyQueue close];
+
+    AWSFMDatabaseQueue *databaseQueue = [AWSFMDatabaseQueue writeAheadLogDatabaseQueueWithPath:self.databasePath];
+    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        XCTAssertEqual([db intForQuery:@"PRAGMA auto_vacuum"], 2);
+        XCTAssertEqual([db intForQuery:@"SELECT COUNT(*) FROM record"], 1);
+    }];
+    [databaseQueue close];
+}
+
+- (void)testIncrementalVacuumReleasesFreePages {
+    AWSFMDatabaseQueue *databaseQueue = [AWSFMDatabaseQueue writeAheadLogDatabaseQueueWithPath:self.databasePath];
+    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        XCTAssertTrue([db executeUpdate:@"CREATE TABLE record (data BLOB NOT NULL)"]);
+    }];
+    [self insertRecordsIntoQueue:databaseQueue];
+    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        XCTAssertTrue([db executeUpdate:@"DELETE FROM record"]);
+        XCTAssertGreaterThan([db intForQuery:@"PRAGMA freelist_count"], 0);
+        XCTAssertTrue([db aws_incrementalVacuum]);
+        XCTAssertEqual([db intForQuery:@"PRAGMA freelist_count"], 0);
+    }];
+    [databaseQueue close];
+    XCTAssertGreaterThan([AWSFMDatabase aws_diskBytesUsedAtPath:self.databasePath], 0);
+}
+
+- (void)testExecuteUpdateWithValuesInListSplitsLongLists {
+    AWSFMDatabaseQueue *databaseQueue = [AWSFMDatabaseQueue writeAheadLogDatabaseQueueWithPath:self.databasePath];
+    NSMutableArray<NSNumber *> *rowIds = [NSMutableArray new];
+    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        XCTAssertTrue([db executeUpdate:@"CREATE TABLE record (data BLOB NOT NULL)"]);
+        for (NSUInteger i = 0; i < 1500; i++) {
+            XCTAssertTrue([db executeUpdate:@"INSERT INTO record (data) VALUES (?)", [NSData data]]);
+            [rowIds addObject:@([db lastInsertRowId])];
+        }
+    }];
+
+    // More values than SQLite binds in one statement; every other row is deleted.
+    NSMutableArray<NSNumber *> *deletedRowIds = [NSMutableArray new];
+    for (NSUInteger i = 0; i < [rowIds count]; i += 2) {
+        [deletedRowIds addObject:rowIds[i]];
+    }
+    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        XCTAssertTrue([db aws_executeUpdate:@"DELETE FROM record WHERE rowid IN (%@)" withValuesInList:deletedRowIds]);
+        XCTAssertTrue([db aws_executeUpdate:@"DELETE FROM record WHERE rowid IN (%@)" withValuesInList:@[]]);
+        XCTAssertEqual([db intForQuery:@"SELECT COUNT(*) FROM record"], 750);
+        XCTAssertEqual([db intForQuery:@"SELECT COUNT(*) FROM record WHERE rowid = ?", rowIds[0]], 0);
+        XCTAssertEqual([db intForQuery:@"SELECT COUNT(*) FROM record WHERE rowid = ?", rowIds[1]], 1);
+    }];
+    [databaseQueue close];
+}
+
+#pragma mark - Benchmarks
+
+// Mirrors the recorders before write-ahead logging was enabled: rollback journal, full fsync and full auto-vacuum.
+- (void)testWriteHeavyPerformanceWithRollbackJournal {
+    [self measureBlock:^{
+        AWSFMDatabaseQueue *databaseQueue = [AWSFMDatabaseQueue serialDatabaseQueueWithPath:self.databasePath];
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            [db executeStatements:@"PRAGMA auto_vacuum = FULL"];
+            [db executeUpdate:@"CREATE TABLE IF NOT EXISTS record (data BLOB NOT NULL)"];
+        }];
+        [self runWriteHeavyWorkloadOnQueue:databaseQueue];
+        [databaseQueue close];
+        [self tearDown];
+    }];
+}
+
+- (void)testWriteHeavyPerformanceWithWriteAheadLog {
+    [self measureBlock:^{
+        AWSFMDatabaseQueue *databaseQueue = [AWSFMDatabaseQueue writeAheadLogDatabaseQueueWithPath:self.databasePath];
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            [db executeUpdate:@"CREATE TABLE IF NOT EXISTS record (data BLOB NOT NULL)"];
+        }];
+        [self runWriteHeavyWorkloadOnQueue:databaseQueue];
+        [databaseQueue close];
+        [self tearDown];
+    }];
+}
+
+#pragma mark - Helpers
+
+- (NSData *)recordData {
+    NSMutableData *data = [NSMutableData dataWithLength:1024];
+    memset(data.mutableBytes, 'a', data.length);
+    return data;
+}
+
+- (void)insertRecordsIntoQueue:(AWSFMDatabaseQueue *)databaseQueue {
+    NSData *data = [self recordData];
+    for (NSUInteger i = 0; i < AWSFMDBHelpersTestsRecordCount; i++) {
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            [db executeUpdate:@"INSERT INTO record (data) VALUES (?)", data];
+        }];
+    }
+}
+
+// One implicit transaction per insert, as saveRecord: does, followed by a drain that deletes in batches.
+- (void)runWriteHeavyWorkloadOnQueue:(AWSFMDatabaseQueue *)databaseQueue {
+    [self insertRecordsIntoQueue:databaseQueue];
+    __block BOOL hasRecords = YES;
+    while (hasRecords) {
+        [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+            [db executeUpdate:@"DELETE FROM record WHERE rowid IN (SELECT rowid FROM record LIMIT 128)"];
+            hasRecords = [db intForQuery:@"SELECT COUNT(*) FROM record"] > 0;
+        }];
+    }
+    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        [db aws_incrementalVacuum];
+    }];
+}
+
+@end
@@ -0,0 +1,119 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <AWSCore/AWSCore.h>
+
+@interface AWSFMDatabaseReadWriteQueueTests : XCTestCase
+
+@property (nonatomic, strong) NSString *databasePath;
+@property (nonatomic, strong) AWSFMDatabaseReadWriteQueue *databaseQueue;
+
+@end
+
+@implementation AWSFMDatabaseReadWriteQueueTests
+
+- (void)setUp {
+    [super setUp];
+    self.databasePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    self.databaseQueue = [AWSFMDatabaseReadWriteQueue readWriteQueueWithPath:self.databasePath
+                                                      maximumNumberOfReaders:2];
+    [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        XCTAssertTrue([db executeUpdate:@"CREATE TABLE record (value INTEGER NOT NULL)"]);
+        XCTAssertTrue([db executeUpdate:@"INSERT INTO record (value) VALUES (1)"]);
+    }];
+}
+
+- (void)tearDown {
+    [self.databaseQueue close];
+    for (NSString *suffix in @[@"", @"-wal", @"-shm"]) {
+        [[NSFileManager defaultManager] removeItemAtPath:[self.databasePath stringByAppendingString:suffix] error:nil];
+    }
+    [super tearDown];
+}
+
+- (void)testReaderPoolIsCreated {
+    XCTAssertNotNil(self.databaseQueue.readerPool);
+    XCTAssertEqual(self.databaseQueue.maximumNumberOfReaders, 2);
+}
+
+- (void)testReadDoesNotWaitForWriteTransaction {
+    XCTestExpectation *readFinished = [self expectationWithDescription:@"Read finished while the writer was busy"];
+    dispatch_semaphore_t transactionStarted = dispatch_semaphore_create(0);
+    dispatch_semaphore_t readDone = dispatch_semaphore_create(0);
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        [self.databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+            [db executeUpdate:@"INSERT INTO record (value) VALUES (2)"];
+            dispatch_semaphore_signal(transactionStarted);
+            // Hold the write transaction open until the reader has finished.
+            dispatch_semaphore_wait(readDone, dispatch_time(DISPATCH_TIME_NOW, 5 * NSEC_PER_SEC));
+        }];
+    });
+
+    dispatch_semaphore_wait(transactionStarted, DISPATCH_TIME_FOREVER);
+    [self.databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
+        // The uncommitted row is not visible.
+        XCTAssertEqual([db intForQuery:@"SELECT COUNT(*) FROM record"], 1);
+    }];
+    dispatch_semaphore_signal(readDone);
+    [readFinished fulfill];
+
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+
+    [self.databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
+        XCTAssertEqual([db intForQuery:@"SELECT COUNT(*) FROM record"], 2);
+    }];
+}
+
+- (void)testReaderCannotWrite {
+    [self.databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
+        XCTAssertFalse([db executeUpdate:@"INSERT INTO record (value) VALUES (3)"]);
+    }];
+}
+
+- (void)testConcurrentReadsAreBounded {
+    __block NSInteger activeReaders = 0;
+    __block NSInteger maximumActiveReaders = 0;
+    NSObject *lock = [NSObject new];
+
+    dispatch_apply(16, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t iteration) {
+        [self.databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
+            XCTAssertNotNil(db);
+            @synchronized(lock) {
+                activeReaders++;
+                maximumActiveReaders = MAX(maximumActiveReaders, activeReaders);
+            }
+            XCTAssertEqual([db intForQuery:@"SELECT COUNT(*) FROM record"], 1);
+            [NSThread sleepForTimeInterval:0.01];
+            @synchronized(lock) {
+                activeReaders--;
+            }
+        }];
+    });
+
+    XCTAssertLessThanOrEqual(maximumActiveReaders, 2);
+    XCTAssertEqual(self.databaseQueue.readerPool.countOfOpenDatabases, maximumActiveReaders);
+}
+
+- (void)testPlainQueueFallsBackToWriterConnection {
+    AWSFMDatabaseQueue *plainQueue = [AWSFMDatabaseQueue serialDatabaseQueueWithPath:self.databasePath];
+    [plainQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
+        XCTAssertEqual([db intForQuery:@"SELECT COUNT(*) FROM record"], 1);
+    }];
+    [plainQueue close];
+}
+
+@end
@@ -67,6 +67,7 @@ typedef NS_ENUM(NSInteger, AWSDynamoDBObjectMapperSaveBehavior) {
 @class AWSDynamoDBQueryExpression;
 @class AWSDynamoDBScanExpression;
 @class AWSDynamoDBPaginatedOutput;
+@class AWSDynamoDBObjectMapperBatchItemResult;
 
 /**
  A DynamoDB Modeling protocol. All objects mapped to an Amazon DynamoDB table row need to conform to this protocol.
@@ -526,6 +527,229 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
 configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
 completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable response, NSError * _Nullable error))completionHandler;
 
+/**
+ Scans through an Amazon DynamoDB table in `totalSegments` segments at once and passes every page of instantiated objects to `pageHandler`, using the default configuration.
+
+ Each segment is read page by page. The next page of a segment is requested only after the task returned by `pageHandler` for the previous page completes, and at most `scanConcurrencyLimit` segments are read at once, so no more than that many pages are held in memory. `expression.limit` sets the page size.
+
+ @param resultClass   The class of the result object.
+ @param expression    An expression object. Its `segment` and `totalSegments` are ignored.
+ @param totalSegments The number of segments to divide the table into.
+ @param pageHandler   Called with each page and the segment it belongs to. It may be called from several threads at once for different segments. Return a task to delay the next page of the segment until it completes, or `nil` to continue at once. A task that fails or is cancelled stops the scan.
+
+ @return AWSTask. `task.error` is the first error from DynamoDB or from `pageHandler`, or `nil` if every segment was read. `task.result` is always `nil`.
+ */
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+              pageHandler:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, NSUInteger segment))pageHandler;
+
+/**
+ Scans through an Amazon DynamoDB table in `totalSegments` segments at once and passes every page of instantiated objects to `pageHandler`, using the default configuration.
+
+ @param resultClass   The class of the result object.
+ @param expression    An expression object. Its `segment` and `totalSegments` are ignored.
+ @param totalSegments The number of segments to divide the table into.
+ @param pageHandler   Called with each page and the segment it belongs to. See `parallelScan:expression:totalSegments:pageHandler:`.
+ @param completionHandler The completion handler to call when every segment was read or the scan stopped.
+                          `error`: An error object that indicates why the scan stopped, or `nil` if every segment was read.
+ */
+- (void)parallelScan:(Class)resultClass
+          expression:(AWSDynamoDBScanExpression *)expression
+       totalSegments:(NSUInteger)totalSegments
+         pageHandler:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, NSUInteger segment))pageHandler
+   completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
+
+/**
+ Scans through an Amazon DynamoDB table in `totalSegments` segments at once and passes every page of instantiated objects to `pageHandler`.
+
+ @param resultClass   The class of the result object.
+ @param expression    An expression object. Its `segment` and `totalSegments` are ignored.
+ @param totalSegments The number of segments to divide the table into.
+ @param configuration A configuration.
+ @param pageHandler   Called with each page and the segment it belongs to. See `parallelScan:expression:totalSegments:pageHandler:`.
+
+ @return AWSTask. `task.error` is the first error from DynamoDB or from `pageHandler`, or `nil` if every segment was read. `task.result` is always `nil`.
+ */
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+            configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+              pageHandler:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, NSUInteger segment))pageHandler;
+
+/**
+ Scans through an Amazon DynamoDB table in `totalSegments` segments at once and passes every page of instantiated objects to `pageHandler`.
+
+ @param resultClass   The class of the result object.
+ @param expression    An expression object. Its `segment` and `totalSegments` are ignored.
+ @param totalSegments The number of segments to divide the table into.
+ @param configuration A configuration.
+ @param pageHandler   Called with each page and the segment it belongs to. See `parallelScan:expression:totalSegments:pageHandler:`.
+ @param completionHandler The completion handler to call when every segment was read or the scan stopped.
+                          `error`: An error object that indicates why the scan stopped, or `nil` if every segment was read.
+ */
+- (void)parallelScan:(Class)resultClass
+          expression:(AWSDynamoDBScanExpression *)expression
+       totalSegments:(NSUInteger)totalSegments
+       configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+         pageHandler:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, NSUInteger segment))pageHandler
+   completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
+
+/**
+ Loads the items with the keys of the given model objects using BatchGetItem and the default configuration. Only the key attributes of the models need to be set, and the models may belong to different tables.
+
+ The keys are sent 100 at a time, `batchConcurrencyLimit` requests at once. Keys that DynamoDB returns as unprocessed are sent again with exponential backoff, up to `batchRetryLimit` times.
+
+ @param models Models whose hash key, and range key if it exists, identify the items to load.
+
+ @return AWSTask. `task.result` has one `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`. Its `model` is the loaded object, or `nil` if no such item exists.
+ */
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models;
+
+/**
+ Loads the items with the keys of the given model objects using BatchGetItem and the default configuration.
+
+ @param models            Models whose hash key, and range key if it exists, identify the items to load.
+ @param completionHandler The completion handler to call when the load request is complete.
+                          `response`: One `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ Loads the items with the keys of the given model objects using BatchGetItem and the specified configuration.
+
+ @param models        Models whose hash key, and range key if it exists, identify the items to load.
+ @param configuration A configuration.
+
+ @return AWSTask. `task.result` has one `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`.
+ */
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                              configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration;
+
+/**
+ Loads the items with the keys of the given model objects using BatchGetItem and the specified configuration.
+
+ @param models            Models whose hash key, and range key if it exists, identify the items to load.
+ @param configuration     A configuration.
+ @param completionHandler The completion handler to call when the load request is complete.
+                          `response`: One `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+    configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ Saves the model objects using BatchWriteItem and the default configuration. The models may belong to different tables.
+
+ BatchWriteItem replaces whole items, so every save behaves like `AWSDynamoDBObjectMapperSaveBehaviorClobber` regardless of `saveBehavior`. When several models have the same key, only the last one is written.
+
+ The models are sent 25 at a time, `batchConcurrencyLimit` requests at once. Items that DynamoDB returns as unprocessed are sent again with exponential backoff, up to `batchRetryLimit` times.
+
+ @param models Models to save.
+
+ @return AWSTask. `task.result` has one `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`. Its `error` is set if the model was not saved.
+ */
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models;
+
+/**
+ Saves the model objects using BatchWriteItem and the default configuration.
+
+ @param models            Models to save.
+ @param completionHandler The completion handler to call when the save request is complete.
+                          `response`: One `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ Saves the model objects using BatchWriteItem and the specified configuration.
+
+ @param models        Models to save.
+ @param configuration A configuration.
+
+ @return AWSTask. `task.result` has one `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`.
+ */
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                              configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration;
+
+/**
+ Saves the model objects using BatchWriteItem and the specified configuration.
+
+ @param models            Models to save.
+ @param configuration     A configuration.
+ @param completionHandler The completion handler to call when the save request is complete.
+                          `response`: One `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+    configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ Removes the given model objects from their tables using BatchWriteItem and the default configuration.
+
+ The models are sent 25 at a time, `batchConcurrencyLimit` requests at once. Items that DynamoDB returns as unprocessed are sent again with exponential backoff, up to `batchRetryLimit` times.
+
+ @param models Models to delete.
+
+ @return AWSTask. `task.result` has one `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`. Its `error` is set if the item was not deleted.
+ */
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models;
+
+/**
+ Removes the given model objects from their tables using BatchWriteItem and the default configuration.
+
+ @param models            Models to delete.
+ @param completionHandler The completion handler to call when the remove request is complete.
+                          `response`: One `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+  completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ Removes the given model objects from their tables using BatchWriteItem and the specified configuration.
+
+ @param models        Models to delete.
+ @param configuration A configuration.
+
+ @return AWSTask. `task.result` has one `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`.
+ */
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                                configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration;
+
+/**
+ Removes the given model objects from their tables using BatchWriteItem and the specified configuration.
+
+ @param models            Models to delete.
+ @param configuration     A configuration.
+ @param completionHandler The completion handler to call when the remove request is complete.
+                          `response`: One `AWSDynamoDBObjectMapperBatchItemResult` per model, in the order of `models`.
+                          `error`: An error object that indicates why the request failed, or `nil` if the request was successful.
+ */
+- (void)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+      configuration:(nullable AWSDynamoDBObjectMapperConfiguration *)configuration
+  completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler;
+
+/**
+ The number of loads the read cache has answered without a GetItem request. Always 0 when the mapper was created with a `readCacheCountLimit` of 0.
+ */
+@property (nonatomic, assign, readonly) NSUInteger readCacheHitCount;
+
+/**
+ The number of loads that looked in the read cache and had to send a GetItem request. Loads with `consistentRead` set to @YES do not look in the cache and are not counted.
+ */
+@property (nonatomic, assign, readonly) NSUInteger readCacheMissCount;
+
+/**
+ Empties the read cache. Call this when items may have been changed by other clients or by another mapper.
+ */
+- (void)removeAllCachedItems;
+
 @end
 
 /**
@@ -543,6 +767,33 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
  */
 @property (nonatomic, strong, nullable) NSNumber *consistentRead;
 
+/**
+ The maximum number of BatchGetItem or BatchWriteItem requests a batch operation has in flight at once. The default is 4.
+ */
+@property (nonatomic, assign) NSUInteger batchConcurrencyLimit;
+
+/**
+ The number of times a batch operation sends unprocessed keys or items again before reporting them as failed. The delay doubles with every attempt. The default is 5.
+ */
+@property (nonatomic, assign) NSUInteger batchRetryLimit;
+
+/**
+ The maximum number of segments `parallelScan:expression:totalSegments:pageHandler:` reads at once. The default is 4.
+ */
+@property (nonatomic, assign) NSUInteger scanConcurrencyLimit;
+
+/**
+ The maximum number of items the mapper keeps in its read cache. The default is 0, which turns the cache off.
+
+ The cache is created with the configuration the mapper is registered with. `load:hashKey:rangeKey:` returns a cached item, keyed by table and primary key, until it expires or the mapper saves or removes a model with the same key. Writes made by other clients or other mappers are not seen until the cached item expires.
+ */
+@property (nonatomic, assign) NSUInteger readCacheCountLimit;
+
+/**
+ The number of seconds an item stays in the read cache after it is read. The default is 60.
+ */
+@property (nonatomic, assign) NSTimeInterval readCacheTimeToLive;
+
 @end
 
 /**
@@ -671,6 +922,20 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
  */
 @property (nonatomic, strong, nullable) NSString *indexName;
 
+/**
+ The segment to scan when the table is divided into `totalSegments` segments.
+
+ @see [AWSDynamoDBScanInput segment]
+ */
+@property (nonatomic, strong, nullable) NSNumber *segment;
+
+/**
+ The number of segments the table is divided into. Set it together with `segment`.
+
+ @see [AWSDynamoDBScanInput totalSegments]
+ */
+@property (nonatomic, strong, nullable) NSNumber *totalSegments;
+
 @end
 
 /**
@@ -718,6 +983,42 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
  */
 - (void)reloadWithCompletionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
 
+/**
+ Passes `self.items` to `block`, then loads and passes each following page until `self.lastEvaluatedKey` is `nil`. The next page is requested only after the task returned by `block` completes.
+
+ @param block Called with each page. Return a task to delay the next page until it completes, or `nil` to continue at once. A task that fails or is cancelled stops the enumeration.
+
+ @return `task.error` indicates why the enumeration stopped, or `nil` if every page was passed to `block`. `task.result` is always `nil`.
+ */
+- (AWSTask *)enumeratePagesUsingBlock:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))block;
+
+/**
+ Passes `self.items` to `block`, then loads and passes each following page until `self.lastEvaluatedKey` is `nil`.
+
+ @param block Called with each page. See `enumeratePagesUsingBlock:`.
+ @param completionHandler The completion handler to call when every page was passed to `block` or the enumeration stopped.
+                          `error`: An error object that indicates why the enumeration stopped, or `nil` if every page was passed to `block`.
+ */
+- (void)enumeratePagesUsingBlock:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))block
+               completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler;
+
+@end
+
+/**
+ The result for one model of a batch load, save or remove.
+ */
+@interface AWSDynamoDBObjectMapperBatchItemResult : NSObject
+
+/**
+ For `batchLoad:`, the loaded object, or `nil` if no such item exists. For `batchSave:` and `batchRemove:`, the model that was passed in.
+ */
+@property (nonatomic, strong, readonly, nullable) __kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model;
+
+/**
+ An error object that indicates why the request for this model failed, or `nil` if it was successful.
+ */
+@property (nonatomic, strong, readonly, nullable) NSError *error;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -13,6 +13,7 @@
 // permissions and limitations under the License.
 //
 
+#import <objc/runtime.h>
 #import "AWSDynamoDBObjectMapper.h"
 #import "AWSDynamoDB.h"
 #import "AWSBolts.h"
@@ -25,6 +26,40 @@ static NSString *const AWSInfoDynamoDBObjectMapper = @"DynamoDBObjectMapper";
 static const NSString *AWSDynamoDBObjectMapperHashKeyAttributePlaceHolder = @":awsddbomhashvalueplaceholder";
 NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
 
+// The most keys one BatchGetItem request and the most requests one BatchWriteItem request may carry.
+static const NSUInteger AWSDynamoDBObjectMapperBatchGetItemLimit = 100;
+static const NSUInteger AWSDynamoDBObjectMapperBatchWriteItemLimit = 25;
+static const NSUInteger AWSDynamoDBObjectMapperDefaultBatchConcurrencyLimit = 4;
+static const NSUInteger AWSDynamoDBObjectMapperDefaultBatchRetryLimit = 5;
+static const NSUInteger AWSDynamoDBObjectMapperDefaultScanConcurrencyLimit = 4;
+static const NSTimeInterval AWSDynamoDBObjectMapperBatchRetryBaseDelay = 0.05;
+static const NSTimeInterval AWSDynamoDBObjectMapperBatchRetryMaxDelay = 5.0;
+static const NSTimeInterval AWSDynamoDBObjectMapperDefaultReadCacheTimeToLive = 60.0;
+
+static void *AWSDynamoDBObjectModelMappingKey = &AWSDynamoDBObjectModelMappingKey;
+
+// Parses DynamoDB number strings. Integers that fit in a long long skip NSNumberFormatter, which dominates the cost of
+// loading numeric attributes.
+static NSNumber *AWSDynamoDBNumberFromString(NSString *string) {
+    NSUInteger length = [string length];
+    if (length > 0 && length <= 18) {
+        unichar characters[18];
+        [string getCharacters:characters range:NSMakeRange(0, length)];
+        NSUInteger index = characters[0] == '-' ? 1 : 0;
+        long long value = 0;
+        for (; index < length; index++) {
+            if (characters[index] < '0' || characters[index] > '9') {
+                break;
+            }
+            value = value * 10 + (characters[index] - '0');
+        }
+        if (index == length && (characters[0] != '-' || length > 1)) {
+            return @(characters[0] == '-' ? -value : value);
+        }
+    }
+    return [NSNumber aws_numberFromString:string];
+}
+
 @interface NSString (AWSDynamoDBObjectMapperSaveBehavior)
 
 - (AWSDynamoDBObjectMapperSaveBehavior)aws_saveBehaviorValue;
@@ -127,6 +162,189 @@ NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
 
 @end
 
+@interface AWSDynamoDBObjectMapperBatchItemResult()
+
+@property (nonatomic, strong, nullable) AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model;
+@property (nonatomic, strong, nullable) NSError *error;
+
+@end
+
+// One distinct key of a batch operation and the models that share it.
+@interface AWSDynamoDBObjectMapperBatchEntry : NSObject
+
+@property (nonatomic, strong) NSString *tableName;
+@property (nonatomic, strong) NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *key;
+@property (nonatomic, strong) NSString *keySignature;
+@property (nonatomic, strong, nullable) AWSDynamoDBWriteRequest *writeRequest;
+@property (nonatomic, strong) NSMutableIndexSet *indexes;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperBatchEntry
+
+@end
+
+@interface AWSDynamoDBObjectMapperReadCacheEntry : NSObject
+
+@property (nonatomic, strong) NSString *key;
+@property (nonatomic, strong) NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *item;
+@property (nonatomic, assign) CFAbsoluteTime expirationTime;
+@property (nonatomic, unsafe_unretained, nullable) AWSDynamoDBObjectMapperReadCacheEntry *next;
+@property (nonatomic, unsafe_unretained, nullable) AWSDynamoDBObjectMapperReadCacheEntry *previous;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperReadCacheEntry
+
+@end
+
+// Items returned by GetItem, keyed by table and primary key. Entries expire after the time to live, and the least
+// recently used entry is evicted when the cache is full. The dictionary owns the entries; the list through them runs
+// from the most recently used entry at the head to the least recently used at the tail.
+@interface AWSDynamoDBObjectMapperReadCache : NSObject
+
+@property (nonatomic, assign, readonly) NSUInteger countLimit;
+@property (nonatomic, assign, readonly) NSTimeInterval timeToLive;
+@property (atomic, assign, readonly) NSUInteger hitCount;
+@property (atomic, assign, readonly) NSUInteger missCount;
+// Changes whenever an item is removed. A read that started before the change must not store what it read.
+@property (atomic, assign, readonly) uint64_t generation;
+
+- (instancetype)initWithCountLimit:(NSUInteger)countLimit
+                        timeToLive:(NSTimeInterval)timeToLive;
+
+- (nullable NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)itemForKey:(NSString *)key;
+- (void)setItem:(NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)item
+         forKey:(NSString *)key
+     generation:(uint64_t)generation;
+- (void)removeItemsForKeys:(NSArray<NSString *> *)keys;
+- (void)removeAllItems;
+
+@end
+
+@interface AWSDynamoDBObjectMapperReadCache()
+
+@property (atomic, assign) NSUInteger hitCount;
+@property (atomic, assign) NSUInteger missCount;
+@property (atomic, assign) uint64_t generation;
+@property (nonatomic, strong) NSMutableDictionary<NSString *, AWSDynamoDBObjectMapperReadCacheEntry *> *entries;
+@property (nonatomic, unsafe_unretained, nullable) AWSDynamoDBObjectMapperReadCacheEntry *head;
+@property (nonatomic, unsafe_unretained, nullable) AWSDynamoDBObjectMapperReadCacheEntry *tail;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperReadCache
+
+- (instancetype)initWithCountLimit:(NSUInteger)countLimit
+                        timeToLive:(NSTimeInterval)timeToLive {
+    if (self = [super init]) {
+        _countLimit = countLimit;
+        _timeToLive = timeToLive;
+        _entries = [NSMutableDictionary dictionaryWithCapacity:countLimit];
+    }
+
+    return self;
+}
+
+- (NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)itemForKey:(NSString *)key {
+    @synchronized(self) {
+        AWSDynamoDBObjectMapperReadCacheEntry *entry = self.entries[key];
+        if (entry && entry.expirationTime <= CFAbsoluteTimeGetCurrent()) {
+            [self removeEntry:entry];
+            entry = nil;
+        }
+        if (!entry) {
+            self.missCount++;
+            return nil;
+        }
+
+        self.hitCount++;
+        [self unlinkEntry:entry];
+        [self insertEntryAtHead:entry];
+        return entry.item;
+    }
+}
+
+- (void)setItem:(NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)item
+         forKey:(NSString *)key
+     generation:(uint64_t)generation {
+    @synchronized(self) {
+        if (generation != self.generation) {
+            return;
+        }
+
+        AWSDynamoDBObjectMapperReadCacheEntry *entry = self.entries[key];
+        if (entry) {
+            [self unlinkEntry:entry];
+        } else {
+            entry = [AWSDynamoDBObjectMapperReadCacheEntry new];
+            entry.key = key;
+            self.entries[key] = entry;
+        }
+        entry.item = item;
+        entry.expirationTime = CFAbsoluteTimeGetCurrent() + self.timeToLive;
+        [self insertEntryAtHead:entry];
+
+        while ([self.entries count] > self.countLimit) {
+            [self removeEntry:self.tail];
+        }
+    }
+}
+
+- (void)removeItemsForKeys:(NSArray<NSString *> *)keys {
+    @synchronized(self) {
+        self.generation++;
+        for (NSString *key in keys) {
+            AWSDynamoDBObjectMapperReadCacheEntry *entry = self.entries[key];
+            if (entry) {
+                [self removeEntry:entry];
+            }
+        }
+    }
+}
+
+- (void)removeAllItems {
+    @synchronized(self) {
+        self.generation++;
+        [self.entries removeAllObjects];
+        self.head = nil;
+        self.tail = nil;
+    }
+}
+
+- (void)removeEntry:(AWSDynamoDBObjectMapperReadCacheEntry *)entry {
+    [self unlinkEntry:entry];
+    [self.entries removeObjectForKey:entry.key];
+}
+
+- (void)unlinkEntry:(AWSDynamoDBObjectMapperReadCacheEntry *)entry {
+    AWSDynamoDBObjectMapperReadCacheEntry *previous = entry.previous;
+    AWSDynamoDBObjectMapperReadCacheEntry *next = entry.next;
+    if (previous) {
+        previous.next = next;
+    } else {
+        self.head = next;
+    }
+    if (next) {
+        next.previous = previous;
+    } else {
+        self.tail = previous;
+    }
+    entry.previous = nil;
+    entry.next = nil;
+}
+
+- (void)insertEntryAtHead:(AWSDynamoDBObjectMapperReadCacheEntry *)entry {
+    entry.next = self.head;
+    self.head.previous = entry;
+    self.head = entry;
+    if (!self.tail) {
+        self.tail = entry;
+    }
+}
+
+@end
+
 @interface AWSDynamoDBAttributeValue (AWSDynamoDBObjectMapper)
 
 - (void)aws_setAttributeValue:(id)attributeValue;
@@ -187,7 +405,7 @@ NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
     } else if (self.S) {
         return self.S;
     } else if (self.N) {
-        return [NSNumber aws_numberFromString:self.N];
+        return AWSDynamoDBNumberFromString(self.N);
     } else if (self.B) {
         return self.B;
     } else if (self.SS) {
@@ -195,7 +413,7 @@ NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
     } else if (self.NS) {
         NSMutableSet *mutableSet = [NSMutableSet new];
         [self.NS enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
-            [mutableSet addObject:[NSNumber aws_numberFromString:obj]];
+            [mutableSet addObject:AWSDynamoDBNumberFromString(obj)];
         }];
 
         return mutableSet;
@@ -223,10 +441,204 @@ NSString *const AWSDynamoDBObjectMapperUserAgent = @"mapper";
 
 @end
 
+// How one property of a model class maps to a top level item attribute.
+@interface AWSDynamoDBObjectModelPropertyMapping : NSObject
+
+@property (nonatomic, strong) NSString *propertyKey;
+@property (nonatomic, strong) NSString *attributeName;
+@property (nonatomic, strong, nullable) NSValueTransformer *transformer;
+@property (nonatomic, assign) BOOL reverseTransformable;
+
+@end
+
+@implementation AWSDynamoDBObjectModelPropertyMapping
+
+@end
+
+// The property to attribute mapping of a model class, worked out once from +JSONKeyPathsByPropertyKey, the
+// JSON transformers, +ignoreAttributes and the key attributes, and attached to the class. AWSMTLJSONAdapter
+// repeats that work for every model, and builds a JSON dictionary between the model and the item.
+// Classes with nested key paths or +classForParsingJSONDictionary: keep going through AWSMTLJSONAdapter.
+@interface AWSDynamoDBObjectModelMapping : NSObject
+
+@property (nonatomic, assign, readonly) Class modelClass;
+@property (nonatomic, assign, readonly) BOOL direct;
+@property (nonatomic, strong, readonly) NSArray<NSString *> *keyAttributes;
+@property (nonatomic, strong, readonly) NSArray<AWSDynamoDBObjectModelPropertyMapping *> *propertyMappings;
+@property (nonatomic, strong, readonly) NSArray<AWSDynamoDBObjectModelPropertyMapping *> *savedPropertyMappings;
+@property (nonatomic, strong, readonly) NSArray<AWSDynamoDBObjectModelPropertyMapping *> *keyPropertyMappings;
+@property (nonatomic, strong, readonly, nullable) NSArray<NSString *> *ignoredAttributes;
+
++ (instancetype)mappingForClass:(Class)modelClass;
+
+- (NSDictionary *)JSONDictionaryFromModel:(AWSDynamoDBObjectModel *)model;
+- (NSDictionary *)keyJSONDictionaryFromModel:(AWSDynamoDBObjectModel *)model;
+- (nullable id)modelFromItem:(NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)item
+                       error:(NSError * __autoreleasing *)error;
+
+@end
+
+@implementation AWSDynamoDBObjectModelMapping
+
++ (instancetype)mappingForClass:(Class)modelClass {
+    AWSDynamoDBObjectModelMapping *mapping = objc_getAssociatedObject(modelClass, AWSDynamoDBObjectModelMappingKey);
+    if (!mapping) {
+        // Two threads may both build the mapping of a class. They build the same mapping, so either may win.
+        mapping = [[AWSDynamoDBObjectModelMapping alloc] initWithClass:modelClass];
+        objc_setAssociatedObject(modelClass, AWSDynamoDBObjectModelMappingKey, mapping, OBJC_ASSOCIATION_RETAIN);
+    }
+    return mapping;
+}
+
+- (instancetype)initWithClass:(Class)modelClass {
+    if (self = [super init]) {
+        _modelClass = modelClass;
+        _direct = ![modelClass respondsToSelector:@selector(classForParsingJSONDictionary:)];
+
+        NSMutableArray<NSString *> *keyAttributes = [NSMutableArray new];
+        NSString *hashKeyAttribute = [self aws_hashKeyAttributeForClass:modelClass];
+        if (hashKeyAttribute) {
+            [keyAttributes addObject:hashKeyAttribute];
+        }
+        NSString *rangeKeyAttribute = [self aws_rangeKeyAttributeForClass:modelClass];
+        if (rangeKeyAttribute) {
+            [keyAttributes addObject:rangeKeyAttribute];
+        }
+        _keyAttributes = keyAttributes;
+
+        if ([modelClass respondsToSelector:@selector(ignoreAttributes)]) {
+            _ignoredAttributes = [modelClass performSelector:@selector(ignoreAttributes)];
+        }
+
+        NSDictionary *JSONKeyPathsByPropertyKey = [modelClass JSONKeyPathsByPropertyKey];
+        NSMutableArray<AWSDynamoDBObjectModelPropertyMapping *> *propertyMappings = [NSMutableArray new];
+        NSMutableArray<AWSDynamoDBObjectModelPropertyMapping *> *savedPropertyMappings = [NSMutableArray new];
+        NSMutableArray<AWSDynamoDBObjectModelPropertyMapping *> *keyPropertyMappings = [NSMutableArray new];
+        for (NSString *propertyKey in [modelClass propertyKeys]) {
+            id JSONKeyPath = JSONKeyPathsByPropertyKey[propertyKey] ?: propertyKey;
+            if (JSONKeyPath == [NSNull null]) {
+                continue;
+            }
+            if ([JSONKeyPath rangeOfString:@"."].location != NSNotFound) {
+                _direct = NO;
+            }
+
+            AWSDynamoDBObjectModelPropertyMapping *propertyMapping = [AWSDynamoDBObjectModelPropertyMapping new];
+            propertyMapping.propertyKey = propertyKey;
+            propertyMapping.attributeName = JSONKeyPath;
+            propertyMapping.transformer = [self JSONTransformerForClass:modelClass key:propertyKey];
+            propertyMapping.reverseTransformable = [[propertyMapping.transformer class] allowsReverseTransformation];
+            [propertyMappings addObject:propertyMapping];
+            if (![_ignoredAttributes containsObject:JSONKeyPath]) {
+                [savedPropertyMappings addObject:propertyMapping];
+            }
+            if ([keyAttributes containsObject:JSONKeyPath]) {
+                [keyPropertyMappings addObject:propertyMapping];
+            }
+        }
+        _propertyMappings = propertyMappings;
+        _savedPropertyMappings = savedPropertyMappings;
+        _keyPropertyMappings = keyPropertyMappings;
+    }
+    return self;
+}
+
+// The transformer AWSMTLJSONAdapter would look up for the key.
+- (NSValueTransformer *)JSONTransformerForClass:(Class)modelClass key:(NSString *)key {
+    SEL selector = NSSelectorFromString([key stringByAppendingString:@"JSONTransformer"]);
+    if ([modelClass respondsToSelector:selector]) {
+        NSValueTransformer *(*transformerForKey)(id, SEL) = (void *)[modelClass methodForSelector:selector];
+        return transformerForKey(modelClass, selector);
+    }
+    if ([modelClass respondsToSelector:@selector(JSONTransformerForKey:)]) {
+        return [modelClass JSONTransformerForKey:key];
+    }
+    return nil;
+}
+
+- (NSDictionary *)JSONDictionaryFromModel:(AWSDynamoDBObjectModel *)model
+                         propertyMappings:(NSArray<AWSDynamoDBObjectModelPropertyMapping *> *)propertyMappings {
+    NSMutableDictionary *JSONDictionary = [NSMutableDictionary dictionaryWithCapacity:[propertyMappings count]];
+    for (AWSDynamoDBObjectModelPropertyMapping *propertyMapping in propertyMappings) {
+        id value = [model valueForKey:propertyMapping.propertyKey];
+        if (propertyMapping.reverseTransformable) {
+            value = [propertyMapping.transformer reverseTransformedValue:value];
+        }
+        JSONDictionary[propertyMapping.attributeName] = value ?: [NSNull null];
+    }
+    return JSONDictionary;
+}
+
+// The attributes of the model that are saved: the JSON dictionary of the model without the ignored attributes.
+- (NSDictionary *)JSONDictionaryFromModel:(AWSDynamoDBObjectModel *)model {
+    if (!self.direct) {
+        NSMutableDictionary *JSONDictionary = [[AWSMTLJSONAdapter JSONDictionaryFromModel:model] mutableCopy];
+        if (self.ignoredAttributes) {
+            [JSONDictionary removeObjectsForKeys:self.ignoredAttributes];
+        }
+        return JSONDictionary;
+    }
+    return [self JSONDictionaryFromModel:model propertyMappings:self.savedPropertyMappings];
+}
+
+- (NSDictionary *)keyJSONDictionaryFromModel:(AWSDynamoDBObjectModel *)model {
+    if (!self.direct) {
+        return [AWSMTLJSONAdapter JSONDictionaryFromModel:model];
+    }
+    return [self JSONDictionaryFromModel:model propertyMappings:self.keyPropertyMappings];
+}
+
+- (id)modelFromItem:(NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)item
+              error:(NSError * __autoreleasing *)error {
+    if (!self.direct) {
+        NSMutableDictionary *JSONDictionary = [NSMutableDictionary dictionaryWithCapacity:[item count]];
+        [item enumerateKeysAndObjectsUsingBlock:^(NSString *attributeName, AWSDynamoDBAttributeValue *attributeValue, BOOL *stop) {
+            JSONDictionary[attributeName] = [attributeValue aws_getAttributeValue];
+        }];
+        return [AWSMTLJSONAdapter modelOfClass:self.modelClass
+                            fromJSONDictionary:JSONDictionary
+                                         error:error];
+    }
+
+    NSMutableDictionary *dictionaryValue = [NSMutableDictionary dictionaryWithCapacity:[self.propertyMappings count]];
+    for (AWSDynamoDBObjectModelPropertyMapping *propertyMapping in self.propertyMappings) {
+        id value = [item[propertyMapping.attributeName] aws_getAttributeValue];
+        if (value == nil) {
+            continue;
+        }
+        if (propertyMapping.transformer) {
+            @try {
+                value = [propertyMapping.transformer transformedValue:value] ?: [NSNull null];
+            } @catch (NSException *exception) {
+                AWSDDLogError(@"Caught exception %@ transforming attribute \"%@\" of %@", exception, propertyMapping.attributeName, self.modelClass);
+
+                // Fail fast in Debug builds, as AWSMTLJSONAdapter does.
+#if DEBUG
+                @throw exception;
+#else
+                if (error) {
+                    *error = [NSError errorWithDomain:AWSMTLJSONAdapterErrorDomain
+                                                 code:AWSMTLJSONAdapterErrorExceptionThrown
+                                             userInfo:@{NSLocalizedDescriptionKey : exception.description,
+                                                        NSLocalizedFailureReasonErrorKey : exception.reason ?: @"",
+                                                        AWSMTLJSONAdapterThrownExceptionErrorKey : exception}];
+                }
+                return nil;
+#endif
+            }
+        }
+        dictionaryValue[propertyMapping.propertyKey] = value;
+    }
+    return [self.modelClass modelWithDictionary:dictionaryValue error:error];
+}
+
+@end
+
 @interface AWSDynamoDBObjectMapper()
 
 @property (nonatomic, strong) AWSDynamoDB *dynamoDB;
 @property (nonatomic, strong) AWSDynamoDBObjectMapperConfiguration *objectMapperConfiguration;
+@property (nonatomic, strong, nullable) AWSDynamoDBObjectMapperReadCache *readCache;
 
 - (AWSTask<AWSDynamoDBPaginatedOutput *> *)query:(Class)resultClass
                                       queryInput:(AWSDynamoDBQueryInput *)queryInput;
@@ -330,6 +742,10 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         _dynamoDB = [[AWSDynamoDB alloc] initWithConfiguration:_configuration];
 #pragma clang diagnostic pop
         _objectMapperConfiguration = [objectMapperConfiguration copy];
+        if (_objectMapperConfiguration.readCacheCountLimit > 0) {
+            _readCache = [[AWSDynamoDBObjectMapperReadCache alloc] initWithCountLimit:_objectMapperConfiguration.readCacheCountLimit
+                                                                          timeToLive:_objectMapperConfiguration.readCacheTimeToLive];
+        }
     }
 
     return self;
@@ -354,7 +770,10 @@ completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandl
             putItemInput.tableName = [[model class] performSelector:@selector(dynamoDBTableName)];
             putItemInput.item = [model itemForPutItemInput];
 
-            return [self.dynamoDB putItem:putItemInput];
+            return [self removeCachedItemsForKeys:[self readCacheKeysForModels:@[model]]
+                                        whileTask:^AWSTask *{
+                return [self.dynamoDB putItem:putItemInput];
+            }];
             break;
         }
         case AWSDynamoDBObjectMapperSaveBehaviorAppendSet:
@@ -366,7 +785,10 @@ completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandl
             updateItemInput.attributeUpdates = [model itemForUpdateItemInput:configuration.saveBehavior];
             updateItemInput.key = [model key];
 
-            return [self.dynamoDB updateItem:updateItemInput];
+            return [self removeCachedItemsForKeys:[self readCacheKeysForModels:@[model]]
+                                        whileTask:^AWSTask *{
+                return [self.dynamoDB updateItem:updateItemInput];
+            }];
             break;
         }
 
@@ -407,7 +829,10 @@ completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandl
     deleteItemInput.tableName = [[model class] performSelector:@selector(dynamoDBTableName)];
     deleteItemInput.key = [model key];
 
-    return [self.dynamoDB deleteItem:deleteItemInput];
+    return [self removeCachedItemsForKeys:[self readCacheKeysForModels:@[model]]
+                                whileTask:^AWSTask *{
+        return [self.dynamoDB deleteItem:deleteItemInput];
+    }];
 }
 
 - (void)remove:(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *)model
@@ -468,17 +893,40 @@ completionHandler:completionHandler];
     }
     getItemInput.key = key;
 
+    // The cache holds items rather than models, so every load returns a model of its own.
+    AWSDynamoDBObjectMapperReadCache *readCache = self.readCache;
+    NSString *cacheKey = nil;
+    uint64_t generation = 0;
+    if (readCache) {
+        cacheKey = [self keySignatureForTableName:getItemInput.tableName
+                                             item:key
+                                    keyAttributes:[key allKeys]];
+        if (![configuration.consistentRead boolValue]) {
+            NSDictionary *item = [readCache itemForKey:cacheKey];
+            if (item) {
+                NSError *error = nil;
+                id responseObject = [[AWSDynamoDBObjectModelMapping mappingForClass:resultClass] modelFromItem:item
+                                                                                                        error:&error];
+                if (error) {
+                    return [AWSTask taskWithError:error];
+                }
+                return [AWSTask taskWithResult:responseObject];
+            }
+        }
+        generation = readCache.generation;
+    }
+
     return [[self.dynamoDB getItem:getItemInput] continueWithSuccessBlock:^id(AWSTask *task) {
         AWSDynamoDBGetItemOutput *getItemOutput = task.result;
 
         NSError *error = nil;
-        NSDictionary *itemsDictionary = [self removeAttributes:getItemOutput.item];
-
         id responseObject = nil;
-        if ([itemsDictionary count] > 0) {
-            responseObject = [AWSMTLJSONAdapter modelOfClass:resultClass
-                                          fromJSONDictionary:itemsDictionary
-                                                       error:&error];
+        if ([getItemOutput.item count] > 0) {
+            [readCache setItem:getItemOutput.item
+                        forKey:cacheKey
+                    generation:generation];
+            responseObject = [[AWSDynamoDBObjectModelMapping mappingForClass:resultClass] modelFromItem:getItemOutput.item
+                                                                                                  error:&error];
             if (error) {
                 return [AWSTask taskWithError:error];
             }
@@ -591,13 +1039,11 @@ completionHandler:completionHandler];
 
         NSMutableArray *items = [NSMutableArray new];
         NSError *error = nil;
+        AWSDynamoDBObjectModelMapping *mapping = [AWSDynamoDBObjectModelMapping mappingForClass:resultClass];
         for (id item in queryOutput.items) {
 
-            NSDictionary *itemsDictionary = [self removeAttributes:item];
-
-            id responseObject = [AWSMTLJSONAdapter modelOfClass:resultClass
-                                             fromJSONDictionary:itemsDictionary
-                                                          error:&error];
+            id responseObject = [mapping modelFromItem:item
+                                                 error:&error];
             if (error) {
                 return [AWSTask taskWithError:error];
             }
@@ -651,11 +1097,20 @@ completionHandler:completionHandler];
 - (AWSTask<AWSDynamoDBPaginatedOutput *> *)scan:(Class)resultClass
                                      expression:(AWSDynamoDBScanExpression *)expression
                                   configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    return [self scan:resultClass
+            scanInput:[self scanInput:resultClass expression:expression]];
+}
+
+// Internal method
+- (AWSDynamoDBScanInput *)scanInput:(Class)resultClass
+                         expression:(AWSDynamoDBScanExpression *)expression {
     AWSDynamoDBScanInput *scanInput = [AWSDynamoDBScanInput new];
     scanInput.tableName = [resultClass performSelector:@selector(dynamoDBTableName)];
     scanInput.limit = expression.limit;
     scanInput.exclusiveStartKey = expression.exclusiveStartKey;
     scanInput.indexName = expression.indexName;
+    scanInput.segment = expression.segment;
+    scanInput.totalSegments = expression.totalSegments;
 
     //process expressionAttirubteValues
     // {@":hashval":@"somevalue"} -> @{":hashval":@{"S","somevalue"}};
@@ -676,8 +1131,7 @@ completionHandler:completionHandler];
     scanInput.projectionExpression = expression.projectionExpression;
     scanInput.expressionAttributeNames = expression.expressionAttributeNames;
 
-    return [self scan:resultClass
-            scanInput:scanInput];
+    return scanInput;
 }
 
 // Internal class
@@ -688,12 +1142,11 @@ completionHandler:completionHandler];
 
         NSMutableArray *items = [NSMutableArray new];
         NSError *error = nil;
+        AWSDynamoDBObjectModelMapping *mapping = [AWSDynamoDBObjectModelMapping mappingForClass:resultClass];
         for (id item in scanOutput.items) {
 
-            NSDictionary *itemsDictionary = [self removeAttributes:item];
-            id responseObject = [AWSMTLJSONAdapter modelOfClass:resultClass
-                                             fromJSONDictionary:itemsDictionary
-                                                          error:&error];
+            id responseObject = [mapping modelFromItem:item
+                                                 error:&error];
             if (error) {
                 return [AWSTask taskWithError:error];
             }
@@ -728,56 +1181,597 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
     }];
 }
 
-#pragma mark - Utility
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+              pageHandler:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, NSUInteger segment))pageHandler {
+    return [self parallelScan:resultClass
+                   expression:expression
+                totalSegments:totalSegments
+                configuration:self.objectMapperConfiguration
+                  pageHandler:pageHandler];
+}
 
-- (NSDictionary *)removeAttributes:(NSDictionary *)item {
-    NSMutableDictionary *mutableItem = [NSMutableDictionary new];
-    [item enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
-        if ([obj respondsToSelector:@selector(aws_getAttributeValue)]) {
-            id value = [obj aws_getAttributeValue];
-            if (value) {
-                [mutableItem setObject:value
-                                forKey:key];
+- (void)parallelScan:(Class)resultClass
+          expression:(AWSDynamoDBScanExpression *)expression
+       totalSegments:(NSUInteger)totalSegments
+         pageHandler:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, NSUInteger segment))pageHandler
+   completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler {
+    [self parallelScan:resultClass
+            expression:expression
+         totalSegments:totalSegments
+         configuration:self.objectMapperConfiguration
+           pageHandler:pageHandler
+     completionHandler:completionHandler];
+}
+
+- (AWSTask *)parallelScan:(Class)resultClass
+               expression:(AWSDynamoDBScanExpression *)expression
+            totalSegments:(NSUInteger)totalSegments
+            configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+              pageHandler:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, NSUInteger segment))pageHandler {
+    configuration = configuration ?: self.objectMapperConfiguration;
+    totalSegments = MAX(totalSegments, 1);
+
+    NSMutableArray<NSNumber *> *segments = [NSMutableArray arrayWithCapacity:totalSegments];
+    for (NSUInteger segment = 0; segment < totalSegments; segment++) {
+        [segments addObject:@(segment)];
+    }
+
+    // Set by the first segment that fails, so that the others stop at their next page.
+    __block NSError *scanError = nil;
+    NSObject *lock = [NSObject new];
+
+    return [[self runTasksFromEnumerator:[segments objectEnumerator]
+                        concurrencyLimit:MIN(MAX(configuration.scanConcurrencyLimit, 1), totalSegments)
+                                   block:^AWSTask *(NSNumber *segment) {
+        @synchronized(lock) {
+            if (scanError) {
+                return nil;
+            }
+        }
+        AWSDynamoDBScanInput *segmentScanInput = [self scanInput:resultClass expression:expression];
+        segmentScanInput.exclusiveStartKey = nil;
+        segmentScanInput.segment = totalSegments > 1 ? segment : nil;
+        segmentScanInput.totalSegments = totalSegments > 1 ? @(totalSegments) : nil;
+
+        return [[[self scan:resultClass
+                  scanInput:segmentScanInput] continueWithSuccessBlock:^id(AWSTask<AWSDynamoDBPaginatedOutput *> *task) {
+            return [task.result enumeratePagesUsingBlock:^AWSTask *(NSArray *items) {
+                @synchronized(lock) {
+                    if (scanError) {
+                        return [AWSTask cancelledTask];
+                    }
+                }
+                return pageHandler(items, [segment unsignedIntegerValue]);
+            }];
+        }] continueWithBlock:^id(AWSTask *task) {
+            if (task.error) {
+                @synchronized(lock) {
+                    if (!scanError) {
+                        scanError = task.error;
+                    }
+                }
+            } else if (task.cancelled) {
+                @synchronized(lock) {
+                    if (!scanError) {
+                        scanError = [NSError errorWithDomain:AWSDynamoDBErrorDomain
+                                                        code:AWSDynamoDBErrorUnknown
+                                                    userInfo:@{NSLocalizedDescriptionKey : @"The page handler cancelled the scan."}];
+                    }
+                }
+            }
+            return nil;
+        }];
+    }] continueWithBlock:^id(AWSTask *task) {
+        @synchronized(lock) {
+            if (scanError) {
+                return [AWSTask taskWithError:scanError];
             }
         }
+        return nil;
     }];
+}
 
-    return mutableItem;
+- (void)parallelScan:(Class)resultClass
+          expression:(AWSDynamoDBScanExpression *)expression
+       totalSegments:(NSUInteger)totalSegments
+       configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+         pageHandler:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items, NSUInteger segment))pageHandler
+   completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler {
+    [[self parallelScan:resultClass
+             expression:expression
+          totalSegments:totalSegments
+          configuration:configuration
+            pageHandler:pageHandler] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        if (completionHandler) {
+            completionHandler(task.error);
+        }
+        return nil;
+    }];
 }
 
-@end
+#pragma mark - Batch operations
 
-@implementation AWSDynamoDBObjectModel
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models {
+    return [self batchLoad:models
+             configuration:self.objectMapperConfiguration];
+}
 
-+ (NSDictionary *)JSONKeyPathsByPropertyKey {
-    return nil;
+- (void)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler {
+    [self batchLoad:models configuration:self.objectMapperConfiguration completionHandler:completionHandler];
 }
 
-- (NSDictionary *)removeIgnoredAttributesFromJSONDictionary:(NSDictionary *)JSONDictionary {
-    if ([[self class] respondsToSelector:@selector(ignoreAttributes)] == NO) {
-        return JSONDictionary;
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                              configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    configuration = configuration ?: self.objectMapperConfiguration;
+    NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *results = [self batchItemResultsForModels:models keepModels:NO];
+    NSArray<AWSDynamoDBObjectMapperBatchEntry *> *entries = [self batchEntriesForModels:models
+                                                                    writeRequestBlock:nil];
+
+    return [[self runBatchEntries:entries
+                        chunkSize:AWSDynamoDBObjectMapperBatchGetItemLimit
+                 concurrencyLimit:configuration.batchConcurrencyLimit
+                            block:^AWSTask *(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *chunk) {
+        return [self batchGetEntries:chunk
+                              models:models
+                             results:results
+                       configuration:configuration
+                             attempt:0];
+    }] continueWithBlock:^id(AWSTask *task) {
+        return results;
+    }];
+}
+
+- (void)batchLoad:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+    configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler {
+    [[self batchLoad:models
+       configuration:configuration] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        if (completionHandler) {
+            completionHandler(task.result, task.error);
+        }
+        return nil;
+    }];
+}
+
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models {
+    return [self batchSave:models
+             configuration:self.objectMapperConfiguration];
+}
+
+- (void)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler {
+    [self batchSave:models configuration:self.objectMapperConfiguration completionHandler:completionHandler];
+}
+
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                              configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    return [self batchWrite:models
+              configuration:configuration
+          writeRequestBlock:^AWSDynamoDBWriteRequest *(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model, NSDictionary *key) {
+        AWSDynamoDBWriteRequest *writeRequest = [AWSDynamoDBWriteRequest new];
+        writeRequest.putRequest = [AWSDynamoDBPutRequest new];
+        writeRequest.putRequest.item = [model itemForPutItemInput];
+        return writeRequest;
+    }];
+}
+
+- (void)batchSave:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+    configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler {
+    [[self batchSave:models
+       configuration:configuration] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        if (completionHandler) {
+            completionHandler(task.result, task.error);
+        }
+        return nil;
+    }];
+}
+
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models {
+    return [self batchRemove:models
+               configuration:self.objectMapperConfiguration];
+}
+
+- (void)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+  completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler {
+    [self batchRemove:models configuration:self.objectMapperConfiguration completionHandler:completionHandler];
+}
+
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                                configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    return [self batchWrite:models
+              configuration:configuration
+          writeRequestBlock:^AWSDynamoDBWriteRequest *(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model, NSDictionary *key) {
+        AWSDynamoDBWriteRequest *writeRequest = [AWSDynamoDBWriteRequest new];
+        writeRequest.deleteRequest = [AWSDynamoDBDeleteRequest new];
+        writeRequest.deleteRequest.key = key;
+        return writeRequest;
+    }];
+}
+
+- (void)batchRemove:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+      configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+  completionHandler:(void (^ _Nullable)(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> * _Nullable response, NSError * _Nullable error))completionHandler {
+    [[self batchRemove:models
+         configuration:configuration] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        if (completionHandler) {
+            completionHandler(task.result, task.error);
+        }
+        return nil;
+    }];
+}
+
+// Internal method
+- (AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)batchWrite:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                               configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+                                                           writeRequestBlock:(AWSDynamoDBWriteRequest *(^)(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model, NSDictionary *key))writeRequestBlock {
+    configuration = configuration ?: self.objectMapperConfiguration;
+    NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *results = [self batchItemResultsForModels:models keepModels:YES];
+    NSArray<AWSDynamoDBObjectMapperBatchEntry *> *entries = [self batchEntriesForModels:models
+                                                                    writeRequestBlock:writeRequestBlock];
+
+    return [[self removeCachedItemsForKeys:self.readCache ? [entries valueForKey:@"keySignature"] : nil
+                                 whileTask:^AWSTask *{
+        return [self runBatchEntries:entries
+                           chunkSize:AWSDynamoDBObjectMapperBatchWriteItemLimit
+                    concurrencyLimit:configuration.batchConcurrencyLimit
+                               block:^AWSTask *(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *chunk) {
+            return [self batchWriteEntries:chunk
+                                   results:results
+                             configuration:configuration
+                                   attempt:0];
+        }];
+    }] continueWithBlock:^id(AWSTask *task) {
+        return results;
+    }];
+}
+
+- (NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *)batchItemResultsForModels:(NSArray *)models
+                                                                      keepModels:(BOOL)keepModels {
+    NSMutableArray<AWSDynamoDBObjectMapperBatchItemResult *> *results = [NSMutableArray arrayWithCapacity:[models count]];
+    for (AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model in models) {
+        AWSDynamoDBObjectMapperBatchItemResult *result = [AWSDynamoDBObjectMapperBatchItemResult new];
+        if (keepModels) {
+            result.model = model;
+        }
+        [results addObject:result];
     }
+    return results;
+}
 
-    NSArray *ignoredAttrArray = [[self class] performSelector:@selector(ignoreAttributes)];
-    NSMutableDictionary *resultDictionary = [JSONDictionary mutableCopy];
-    [resultDictionary removeObjectsForKeys:ignoredAttrArray];
-    return resultDictionary;
+// Groups the models by table and key. BatchGetItem and BatchWriteItem reject requests that name the same key twice,
+// so each key is sent once and the last model with that key supplies the write request.
+- (NSArray<AWSDynamoDBObjectMapperBatchEntry *> *)batchEntriesForModels:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                                                     writeRequestBlock:(AWSDynamoDBWriteRequest *(^ _Nullable)(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model, NSDictionary *key))writeRequestBlock {
+    NSMutableArray<AWSDynamoDBObjectMapperBatchEntry *> *entries = [NSMutableArray new];
+    NSMutableDictionary<NSString *, AWSDynamoDBObjectMapperBatchEntry *> *entriesBySignature = [NSMutableDictionary new];
+    [models enumerateObjectsUsingBlock:^(AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model, NSUInteger idx, BOOL *stop) {
+        NSString *tableName = [[model class] dynamoDBTableName];
+        NSDictionary *key = [model key];
+        NSString *keySignature = [self keySignatureForTableName:tableName
+                                                           item:key
+                                                  keyAttributes:[key allKeys]];
+        AWSDynamoDBObjectMapperBatchEntry *entry = entriesBySignature[keySignature];
+        if (!entry) {
+            entry = [AWSDynamoDBObjectMapperBatchEntry new];
+            entry.tableName = tableName;
+            entry.key = key;
+            entry.keySignature = keySignature;
+            entry.indexes = [NSMutableIndexSet new];
+            entriesBySignature[keySignature] = entry;
+            [entries addObject:entry];
+        }
+        [entry.indexes addIndex:idx];
+        if (writeRequestBlock) {
+            entry.writeRequest = writeRequestBlock(model, key);
+        }
+    }];
+    return entries;
 }
 
-- (NSDictionary *)itemForPutItemInput {
-    NSMutableDictionary *item = [NSMutableDictionary new];
-    NSMutableArray *keyArray = [NSMutableArray new];
+- (NSString *)keySignatureForTableName:(NSString *)tableName
+                                  item:(NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)item
+                         keyAttributes:(NSArray<NSString *> *)keyAttributes {
+    // Lengths keep values that contain the separator from colliding.
+    NSMutableString *signature = [NSMutableString stringWithFormat:@"%lu:%@", (unsigned long)[tableName length], tableName];
+    for (NSString *attribute in [keyAttributes sortedArrayUsingSelector:@selector(compare:)]) {
+        AWSDynamoDBAttributeValue *attributeValue = item[attribute];
+        NSString *value = attributeValue.S;
+        NSString *type = @"S";
+        if (attributeValue.N) {
+            value = attributeValue.N;
+            type = @"N";
+        } else if (attributeValue.B) {
+            value = [attributeValue.B base64EncodedStringWithOptions:0];
+            type = @"B";
+        }
+        [signature appendFormat:@"|%lu:%@%@%lu:%@", (unsigned long)[attribute length], attribute, type, (unsigned long)[value length], value ?: @""];
+    }
+    return signature;
+}
 
-    NSString *hashKeyAttribute = [self aws_hashKeyAttributeForClass:[self class]];
-    [keyArray addObject:hashKeyAttribute];
+- (NSDictionary<NSString *, AWSDynamoDBObjectMapperBatchEntry *> *)entriesBySignatureForEntries:(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *)entries
+                                                                        keyAttributesByTable:(NSMutableDictionary<NSString *, NSArray<NSString *> *> *)keyAttributesByTable {
+    NSMutableDictionary<NSString *, AWSDynamoDBObjectMapperBatchEntry *> *entriesBySignature = [NSMutableDictionary dictionaryWithCapacity:[entries count]];
+    for (AWSDynamoDBObjectMapperBatchEntry *entry in entries) {
+        entriesBySignature[entry.keySignature] = entry;
+        if (!keyAttributesByTable[entry.tableName]) {
+            keyAttributesByTable[entry.tableName] = [entry.key allKeys];
+        }
+    }
+    return entriesBySignature;
+}
 
-    NSString *rangeKeyAttribute = [self aws_rangeKeyAttributeForClass:[self class]];
-    if (rangeKeyAttribute) {
-        [keyArray addObject:rangeKeyAttribute];
+// Sends the chunks with at most concurrencyLimit requests in flight.
+- (AWSTask *)runBatchEntries:(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *)entries
+                   chunkSize:(NSUInteger)chunkSize
+            concurrencyLimit:(NSUInteger)concurrencyLimit
+                       block:(AWSTask *(^)(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *chunk))block {
+    NSMutableArray<NSArray<AWSDynamoDBObjectMapperBatchEntry *> *> *chunks = [NSMutableArray new];
+    for (NSUInteger location = 0; location < [entries count]; location += chunkSize) {
+        [chunks addObject:[entries subarrayWithRange:NSMakeRange(location, MIN(chunkSize, [entries count] - location))]];
+    }
+
+    return [self runTasksFromEnumerator:[chunks objectEnumerator]
+                       concurrencyLimit:MIN(MAX(concurrencyLimit, 1), [chunks count])
+                                  block:block];
+}
+
+// Runs block for every object of the enumerator with at most concurrencyLimit of its tasks unfinished. Each finished task
+// picks up the next object.
+- (AWSTask *)runTasksFromEnumerator:(NSEnumerator *)enumerator
+                   concurrencyLimit:(NSUInteger)concurrencyLimit
+                              block:(AWSTask * _Nullable (^)(id object))block {
+    NSMutableArray<AWSTask *> *lanes = [NSMutableArray arrayWithCapacity:concurrencyLimit];
+    for (NSUInteger i = 0; i < concurrencyLimit; i++) {
+        [lanes addObject:[self runNextTaskFromEnumerator:enumerator block:block]];
+    }
+    return [AWSTask taskForCompletionOfAllTasks:lanes];
+}
+
+- (AWSTask *)runNextTaskFromEnumerator:(NSEnumerator *)enumerator
+                                 block:(AWSTask * _Nullable (^)(id object))block {
+    id object = nil;
+    @synchronized(enumerator) {
+        object = [enumerator nextObject];
+    }
+    if (!object) {
+        return [AWSTask taskWithResult:nil];
+    }
+    AWSTask *task = block(object) ?: [AWSTask taskWithResult:nil];
+    return [task continueWithBlock:^id(AWSTask *task) {
+        return [self runNextTaskFromEnumerator:enumerator block:block];
+    }];
+}
+
+- (AWSTask *)batchGetEntries:(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *)entries
+                      models:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models
+                     results:(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *)results
+               configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+                     attempt:(NSUInteger)attempt {
+    NSMutableDictionary<NSString *, NSMutableArray *> *keysByTable = [NSMutableDictionary new];
+    for (AWSDynamoDBObjectMapperBatchEntry *entry in entries) {
+        NSMutableArray *keys = keysByTable[entry.tableName];
+        if (!keys) {
+            keys = [NSMutableArray new];
+            keysByTable[entry.tableName] = keys;
+        }
+        [keys addObject:entry.key];
+    }
+    NSMutableDictionary<NSString *, AWSDynamoDBKeysAndAttributes *> *requestItems = [NSMutableDictionary dictionaryWithCapacity:[keysByTable count]];
+    for (NSString *tableName in keysByTable) {
+        AWSDynamoDBKeysAndAttributes *keysAndAttributes = [AWSDynamoDBKeysAndAttributes new];
+        keysAndAttributes.keys = keysByTable[tableName];
+        keysAndAttributes.consistentRead = configuration.consistentRead;
+        requestItems[tableName] = keysAndAttributes;
+    }
+    AWSDynamoDBBatchGetItemInput *batchGetItemInput = [AWSDynamoDBBatchGetItemInput new];
+    batchGetItemInput.requestItems = requestItems;
+
+    return [[self.dynamoDB batchGetItem:batchGetItemInput] continueWithBlock:^id(AWSTask *task) {
+        if (task.error) {
+            [self setError:task.error forEntries:entries results:results];
+            return nil;
+        }
+        AWSDynamoDBBatchGetItemOutput *batchGetItemOutput = task.result;
+
+        NSMutableDictionary<NSString *, NSArray<NSString *> *> *keyAttributesByTable = [NSMutableDictionary new];
+        NSDictionary<NSString *, AWSDynamoDBObjectMapperBatchEntry *> *entriesBySignature = [self entriesBySignatureForEntries:entries
+                                                                                                      keyAttributesByTable:keyAttributesByTable];
+        [batchGetItemOutput.responses enumerateKeysAndObjectsUsingBlock:^(NSString *tableName, NSArray<NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *> *items, BOOL *stop) {
+            for (NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *item in items) {
+                NSString *keySignature = [self keySignatureForTableName:tableName
+                                                                   item:item
+                                                          keyAttributes:keyAttributesByTable[tableName]];
+                AWSDynamoDBObjectMapperBatchEntry *entry = entriesBySignature[keySignature];
+                if (!entry) {
+                    AWSDDLogWarn(@"BatchGetItem returned an item that was not requested from table %@.", tableName);
+                    continue;
+                }
+                [entry.indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+                    NSError *error = nil;
+                    AWSDynamoDBObjectMapperBatchItemResult *result = results[idx];
+                    result.model = [[AWSDynamoDBObjectModelMapping mappingForClass:[models[idx] class]] modelFromItem:item
+                                                                                                                error:&error];
+                    result.error = error;
+                }];
+            }
+        }];
+
+        NSMutableArray<AWSDynamoDBObjectMapperBatchEntry *> *unprocessedEntries = [NSMutableArray new];
+        [batchGetItemOutput.unprocessedKeys enumerateKeysAndObjectsUsingBlock:^(NSString *tableName, AWSDynamoDBKeysAndAttributes *keysAndAttributes, BOOL *stop) {
+            for (NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *key in keysAndAttributes.keys) {
+                AWSDynamoDBObjectMapperBatchEntry *entry = entriesBySignature[[self keySignatureForTableName:tableName
+                                                                                                       item:key
+                                                                                              keyAttributes:keyAttributesByTable[tableName]]];
+                if (entry) {
+                    [unprocessedEntries addObject:entry];
+                }
+            }
+        }];
+
+        return [self retryUnprocessedEntries:unprocessedEntries
+                                     results:results
+                               configuration:configuration
+                                     attempt:attempt
+                                       block:^AWSTask *(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *retryEntries, NSUInteger retryAttempt) {
+            return [self batchGetEntries:retryEntries
+                                  models:models
+                                 results:results
+                           configuration:configuration
+                                 attempt:retryAttempt];
+        }];
+    }];
+}
+
+- (AWSTask *)batchWriteEntries:(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *)entries
+                       results:(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *)results
+                 configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+                       attempt:(NSUInteger)attempt {
+    NSMutableDictionary<NSString *, NSMutableArray<AWSDynamoDBWriteRequest *> *> *requestItems = [NSMutableDictionary new];
+    for (AWSDynamoDBObjectMapperBatchEntry *entry in entries) {
+        NSMutableArray<AWSDynamoDBWriteRequest *> *writeRequests = requestItems[entry.tableName];
+        if (!writeRequests) {
+            writeRequests = [NSMutableArray new];
+            requestItems[entry.tableName] = writeRequests;
+        }
+        [writeRequests addObject:entry.writeRequest];
+    }
+    AWSDynamoDBBatchWriteItemInput *batchWriteItemInput = [AWSDynamoDBBatchWriteItemInput new];
+    batchWriteItemInput.requestItems = requestItems;
+
+    return [[self.dynamoDB batchWriteItem:batchWriteItemInput] continueWithBlock:^id(AWSTask *task) {
+        if (task.error) {
+            [self setError:task.error forEntries:entries results:results];
+            return nil;
+        }
+        AWSDynamoDBBatchWriteItemOutput *batchWriteItemOutput = task.result;
+
+        NSMutableDictionary<NSString *, NSArray<NSString *> *> *keyAttributesByTable = [NSMutableDictionary new];
+        NSDictionary<NSString *, AWSDynamoDBObjectMapperBatchEntry *> *entriesBySignature = [self entriesBySignatureForEntries:entries
+                                                                                                      keyAttributesByTable:keyAttributesByTable];
+        NSMutableArray<AWSDynamoDBObjectMapperBatchEntry *> *unprocessedEntries = [NSMutableArray new];
+        [batchWriteItemOutput.unprocessedItems enumerateKeysAndObjectsUsingBlock:^(NSString *tableName, NSArray<AWSDynamoDBWriteRequest *> *writeRequests, BOOL *stop) {
+            for (AWSDynamoDBWriteRequest *writeRequest in writeRequests) {
+                NSDictionary *item = writeRequest.putRequest ? writeRequest.putRequest.item : writeRequest.deleteRequest.key;
+                AWSDynamoDBObjectMapperBatchEntry *entry = entriesBySignature[[self keySignatureForTableName:tableName
+                                                                                                       item:item
+                                                                                              keyAttributes:keyAttributesByTable[tableName]]];
+                if (entry) {
+                    [unprocessedEntries addObject:entry];
+                }
+            }
+        }];
+
+        return [self retryUnprocessedEntries:unprocessedEntries
+                                     results:results
+                               configuration:configuration
+                                     attempt:attempt
+                                       block:^AWSTask *(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *retryEntries, NSUInteger retryAttempt) {
+            return [self batchWriteEntries:retryEntries
+                                   results:results
+                             configuration:configuration
+                                   attempt:retryAttempt];
+        }];
+    }];
+}
+
+- (AWSTask *)retryUnprocessedEntries:(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *)entries
+                             results:(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *)results
+                       configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration
+                             attempt:(NSUInteger)attempt
+                               block:(AWSTask *(^)(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *entries, NSUInteger attempt))block {
+    if ([entries count] == 0) {
+        return nil;
+    }
+    if (attempt >= configuration.batchRetryLimit) {
+        NSString *message = [NSString stringWithFormat:@"The item was still unprocessed after %lu attempts.", (unsigned long)(attempt + 1)];
+        [self setError:[NSError errorWithDomain:AWSDynamoDBErrorDomain
+                                           code:AWSDynamoDBErrorProvisionedThroughputExceeded
+                                       userInfo:@{NSLocalizedDescriptionKey : message}]
+            forEntries:entries
+               results:results];
+        return nil;
+    }
+
+    // Exponential backoff with jitter, so that concurrent requests do not retry in step.
+    NSTimeInterval delay = MIN(AWSDynamoDBObjectMapperBatchRetryBaseDelay * (1 << MIN(attempt, 16)), AWSDynamoDBObjectMapperBatchRetryMaxDelay);
+    delay = delay / 2 + (delay / 2) * arc4random_uniform(1001) / 1000.0;
+    AWSDDLogDebug(@"Retrying %lu unprocessed items in %.3f seconds.", (unsigned long)[entries count], delay);
+    return [[AWSTask taskWithDelay:(int)(delay * 1000)] continueWithBlock:^id(AWSTask *task) {
+        return block(entries, attempt + 1);
+    }];
+}
+
+- (void)setError:(NSError *)error
+      forEntries:(NSArray<AWSDynamoDBObjectMapperBatchEntry *> *)entries
+         results:(NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *)results {
+    for (AWSDynamoDBObjectMapperBatchEntry *entry in entries) {
+        [entry.indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+            results[idx].error = error;
+        }];
+    }
+}
+
+- (NSUInteger)readCacheHitCount {
+    return self.readCache.hitCount;
+}
+
+- (NSUInteger)readCacheMissCount {
+    return self.readCache.missCount;
+}
+
+- (void)removeAllCachedItems {
+    [self.readCache removeAllItems];
+}
+
+- (nullable NSArray<NSString *> *)readCacheKeysForModels:(NSArray<AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *)models {
+    if (!self.readCache) {
+        return nil;
+    }
+
+    NSMutableArray<NSString *> *keys = [NSMutableArray arrayWithCapacity:[models count]];
+    for (AWSDynamoDBObjectModel<AWSDynamoDBModeling> *model in models) {
+        NSDictionary *key = [model key];
+        [keys addObject:[self keySignatureForTableName:[[model class] dynamoDBTableName]
+                                                  item:key
+                                         keyAttributes:[key allKeys]]];
     }
+    return keys;
+}
+
+// Removes the cached items before the write starts and again when it finishes, so that a load that was in flight
+// while the item changed does not leave the old item in the cache.
+- (AWSTask *)removeCachedItemsForKeys:(nullable NSArray<NSString *> *)keys
+                            whileTask:(AWSTask *(^)(void))block {
+    AWSDynamoDBObjectMapperReadCache *readCache = self.readCache;
+    if (!readCache || [keys count] == 0) {
+        return block();
+    }
+
+    [readCache removeItemsForKeys:keys];
+    return [block() continueWithBlock:^id(AWSTask *task) {
+        [readCache removeItemsForKeys:keys];
+        return task;
+    }];
+}
+
+@end
+
+@implementation AWSDynamoDBObjectModel
 
-    NSDictionary *dictionaryValue = [AWSMTLJSONAdapter JSONDictionaryFromModel:self];
-    dictionaryValue = [self removeIgnoredAttributesFromJSONDictionary:dictionaryValue];
++ (NSDictionary *)JSONKeyPathsByPropertyKey {
+    return nil;
+}
+
+- (NSDictionary *)itemForPutItemInput {
+    AWSDynamoDBObjectModelMapping *mapping = [AWSDynamoDBObjectModelMapping mappingForClass:[self class]];
+    NSArray *keyArray = mapping.keyAttributes;
+    NSDictionary *dictionaryValue = [mapping JSONDictionaryFromModel:self];
+    NSMutableDictionary *item = [NSMutableDictionary dictionaryWithCapacity:[dictionaryValue count]];
 
     for (id key in dictionaryValue) {
         if ([keyArray containsObject:key]) {
@@ -802,10 +1796,10 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
 
 - (NSDictionary *)itemForUpdateItemInput:(AWSDynamoDBObjectMapperSaveBehavior)behavior {
     // TODO: update this method to use UpdateExpression instead of AWSDynamoDBAttributeValueUpdate.
-    NSMutableDictionary *item = [NSMutableDictionary new];
-    NSArray *keyArray = [[self key] allKeys];
-    NSDictionary *dictionaryValue = [AWSMTLJSONAdapter JSONDictionaryFromModel:self];
-    dictionaryValue = [self removeIgnoredAttributesFromJSONDictionary:dictionaryValue];
+    AWSDynamoDBObjectModelMapping *mapping = [AWSDynamoDBObjectModelMapping mappingForClass:[self class]];
+    NSArray *keyArray = mapping.keyAttributes;
+    NSDictionary *dictionaryValue = [mapping JSONDictionaryFromModel:self];
+    NSMutableDictionary *item = [NSMutableDictionary dictionaryWithCapacity:[dictionaryValue count]];
 
     for (id key in dictionaryValue) {
         if (![keyArray containsObject:key]) {
@@ -854,19 +1848,11 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
 }
 
 - (NSDictionary *)key {
-    NSMutableDictionary *keyDictionary = [NSMutableDictionary new];
-    NSMutableArray *keyArray = [NSMutableArray new];
-
-    NSString *hashKeyAttribute = [self aws_hashKeyAttributeForClass:[self class]];
-    [keyArray addObject:hashKeyAttribute];
+    AWSDynamoDBObjectModelMapping *mapping = [AWSDynamoDBObjectModelMapping mappingForClass:[self class]];
+    NSArray *keyArray = mapping.keyAttributes;
+    NSMutableDictionary *keyDictionary = [NSMutableDictionary dictionaryWithCapacity:[keyArray count]];
+    NSDictionary *dictionaryValue = [mapping keyJSONDictionaryFromModel:self];
 
-    NSString *rangeKeyAttribute = [self aws_rangeKeyAttributeForClass:[self class]];
-    if (rangeKeyAttribute) {
-        [keyArray addObject:rangeKeyAttribute];
-    }
-
-    NSDictionary *dictionaryValue = [AWSMTLJSONAdapter JSONDictionaryFromModel:self];
-    
     for (id key in keyArray) {
         // For key attributes
         AWSDynamoDBAttributeValue *keyAttributeValue = [AWSDynamoDBAttributeValue new];
@@ -884,6 +1870,10 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
 - (instancetype)init {
     if (self = [super init]) {
         _saveBehavior = AWSDynamoDBObjectMapperSaveBehaviorUpdate;
+        _batchConcurrencyLimit = AWSDynamoDBObjectMapperDefaultBatchConcurrencyLimit;
+        _batchRetryLimit = AWSDynamoDBObjectMapperDefaultBatchRetryLimit;
+        _scanConcurrencyLimit = AWSDynamoDBObjectMapperDefaultScanConcurrencyLimit;
+        _readCacheTimeToLive = AWSDynamoDBObjectMapperDefaultReadCacheTimeToLive;
     }
 
     return self;
@@ -893,12 +1883,21 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
     AWSDynamoDBObjectMapperConfiguration *configuration = [[[self class] allocWithZone:zone] init];
     configuration.saveBehavior = self.saveBehavior;
     configuration.consistentRead = [self.consistentRead copy];
+    configuration.batchConcurrencyLimit = self.batchConcurrencyLimit;
+    configuration.batchRetryLimit = self.batchRetryLimit;
+    configuration.scanConcurrencyLimit = self.scanConcurrencyLimit;
+    configuration.readCacheCountLimit = self.readCacheCountLimit;
+    configuration.readCacheTimeToLive = self.readCacheTimeToLive;
     
     return configuration;
 }
 
 @end
 
+@implementation AWSDynamoDBObjectMapperBatchItemResult
+
+@end
+
 @implementation AWSDynamoDBQueryExpression
 
 @end
@@ -944,6 +1943,33 @@ completionHandler:(void (^ _Nullable)(AWSDynamoDBPaginatedOutput * _Nullable res
     }];
 }
 
+- (AWSTask *)enumeratePagesUsingBlock:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))block {
+    AWSTask *blockTask = block(self.items) ?: [AWSTask taskWithResult:nil];
+    return [blockTask continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        if (task.error || task.cancelled) {
+            return task;
+        }
+        if (!self.lastEvaluatedKey) {
+            return nil;
+        }
+        return [[self loadNextPage] continueWithSuccessBlock:^id _Nullable(AWSTask * _Nonnull task) {
+            return [self enumeratePagesUsingBlock:block];
+        }];
+    }];
+}
+
+- (void)enumeratePagesUsingBlock:(AWSTask * _Nullable (^)(NSArray<__kindof AWSDynamoDBObjectModel<AWSDynamoDBModeling> *> *items))block
+               completionHandler:(void (^ _Nullable)(NSError * _Nullable error))completionHandler {
+    [[self enumeratePagesUsingBlock:block] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        NSError *error = task.error;
+
+        if (completionHandler) {
+            completionHandler(error);
+        }
+        return nil;
+    }];
+}
+
 // Internal method
 - (AWSTask *)loadPage {
     if (self.queryInput) {
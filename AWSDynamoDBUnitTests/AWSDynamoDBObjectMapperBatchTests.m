@@ -0,0 +1,351 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSDynamoDB.h"
+
+static NSString *const AWSDynamoDBObjectMapperBatchTestsKey = @"AWSDynamoDBObjectMapperBatchTests";
+static NSString *const AWSDynamoDBObjectMapperBatchTestsTableName = @"AWSDynamoDBObjectMapperBatchTestsTable";
+static const NSUInteger AWSDynamoDBObjectMapperBatchTestsBenchmarkCount = 2500;
+
+@interface AWSDynamoDB()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+@interface AWSDynamoDBObjectMapper()
+
+@property (nonatomic, strong) AWSDynamoDB *dynamoDB;
+
+@end
+
+@interface AWSDynamoDBObjectMapperBatchTestsModel : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *identifier;
+@property (nonatomic, strong) NSString *value;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperBatchTestsModel
+
++ (NSString *)dynamoDBTableName {
+    return AWSDynamoDBObjectMapperBatchTestsTableName;
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"identifier";
+}
+
+@end
+
+// Answers batch requests from memory. Keys in throttledKeys are left unprocessed the number of times given.
+@interface AWSDynamoDBObjectMapperBatchTestsService : AWSDynamoDB
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSNumber *> *throttledKeys;
+@property (nonatomic, strong) NSString *failingKey;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *requestSizes;
+@property (nonatomic, assign) NSUInteger inFlight;
+@property (nonatomic, assign) NSUInteger maxInFlight;
+@property (nonatomic, assign) int latency;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperBatchTestsService
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration {
+    if (self = [super initWithConfiguration:configuration]) {
+        _throttledKeys = [NSMutableDictionary new];
+        _requestSizes = [NSMutableArray new];
+    }
+    return self;
+}
+
+// Returns the keys to leave unprocessed, or nil if the whole request should fail.
+- (NSArray<NSString *> *)beginRequestWithKeys:(NSArray<NSString *> *)keys {
+    @synchronized(self) {
+        [self.requestSizes addObject:@([keys count])];
+        self.inFlight++;
+        self.maxInFlight = MAX(self.maxInFlight, self.inFlight);
+        if (self.failingKey && [keys containsObject:self.failingKey]) {
+            return nil;
+        }
+        NSMutableArray<NSString *> *unprocessedKeys = [NSMutableArray new];
+        for (NSString *key in keys) {
+            NSUInteger remaining = [self.throttledKeys[key] unsignedIntegerValue];
+            if (remaining > 0) {
+                self.throttledKeys[key] = @(remaining - 1);
+                [unprocessedKeys addObject:key];
+            }
+        }
+        return unprocessedKeys;
+    }
+}
+
+- (AWSTask *)respondWithResult:(id)result {
+    return [[AWSTask taskWithDelay:self.latency] continueWithBlock:^id(AWSTask *task) {
+        @synchronized(self) {
+            self.inFlight--;
+        }
+        if (!result) {
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSDynamoDBErrorDomain
+                                                              code:AWSDynamoDBErrorResourceNotFound
+                                                          userInfo:nil]];
+        }
+        return result;
+    }];
+}
+
+- (AWSTask<AWSDynamoDBBatchGetItemOutput *> *)batchGetItem:(AWSDynamoDBBatchGetItemInput *)request {
+    NSMutableArray<NSString *> *keys = [NSMutableArray new];
+    for (NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *key in request.requestItems[AWSDynamoDBObjectMapperBatchTestsTableName].keys) {
+        [keys addObject:key[@"identifier"].S];
+    }
+    NSArray<NSString *> *unprocessedKeys = [self beginRequestWithKeys:keys];
+    if (!unprocessedKeys) {
+        return [self respondWithResult:nil];
+    }
+
+    NSMutableArray *items = [NSMutableArray new];
+    NSMutableArray *unprocessedItems = [NSMutableArray new];
+    for (NSString *key in keys) {
+        AWSDynamoDBAttributeValue *identifier = [AWSDynamoDBAttributeValue new];
+        identifier.S = key;
+        if ([unprocessedKeys containsObject:key]) {
+            [unprocessedItems addObject:@{@"identifier" : identifier}];
+            continue;
+        }
+        AWSDynamoDBAttributeValue *value = [AWSDynamoDBAttributeValue new];
+        value.S = [@"value of " stringByAppendingString:key];
+        [items addObject:@{@"identifier" : identifier, @"value" : value}];
+    }
+    AWSDynamoDBBatchGetItemOutput *output = [AWSDynamoDBBatchGetItemOutput new];
+    output.responses = @{AWSDynamoDBObjectMapperBatchTestsTableName : items};
+    if ([unprocessedItems count] > 0) {
+        AWSDynamoDBKeysAndAttributes *keysAndAttributes = [AWSDynamoDBKeysAndAttributes new];
+        keysAndAttributes.keys = unprocessedItems;
+        output.unprocessedKeys = @{AWSDynamoDBObjectMapperBatchTestsTableName : keysAndAttributes};
+    }
+    return [self respondWithResult:output];
+}
+
+- (AWSTask<AWSDynamoDBBatchWriteItemOutput *> *)batchWriteItem:(AWSDynamoDBBatchWriteItemInput *)request {
+    NSArray<AWSDynamoDBWriteRequest *> *writeRequests = request.requestItems[AWSDynamoDBObjectMapperBatchTestsTableName];
+    NSMutableArray<NSString *> *keys = [NSMutableArray new];
+    for (AWSDynamoDBWriteRequest *writeRequest in writeRequests) {
+        NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *item = writeRequest.putRequest ? writeRequest.putRequest.item : writeRequest.deleteRequest.key;
+        [keys addObject:item[@"identifier"].S];
+    }
+    NSArray<NSString *> *unprocessedKeys = [self beginRequestWithKeys:keys];
+    if (!unprocessedKeys) {
+        return [self respondWithResult:nil];
+    }
+
+    NSMutableArray<AWSDynamoDBWriteRequest *> *unprocessedItems = [NSMutableArray new];
+    [keys enumerateObjectsUsingBlock:^(NSString *key, NSUInteger idx, BOOL *stop) {
+        if ([unprocessedKeys containsObject:key]) {
+            [unprocessedItems addObject:writeRequests[idx]];
+        }
+    }];
+    AWSDynamoDBBatchWriteItemOutput *output = [AWSDynamoDBBatchWriteItemOutput new];
+    if ([unprocessedItems count] > 0) {
+        output.unprocessedItems = @{AWSDynamoDBObjectMapperBatchTestsTableName : unprocessedItems};
+    }
+    return [self respondWithResult:output];
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperBatchTests : XCTestCase
+
+@property (nonatomic, strong) AWSDynamoDBObjectMapper *objectMapper;
+@property (nonatomic, strong) AWSDynamoDBObjectMapperBatchTestsService *service;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperBatchTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [AWSServiceManager defaultServiceManager].defaultServiceConfiguration;
+    [AWSDynamoDBObjectMapper registerDynamoDBObjectMapperWithConfiguration:configuration
+                                                     objectMapperConfiguration:[AWSDynamoDBObjectMapperConfiguration new]
+                                                                        forKey:AWSDynamoDBObjectMapperBatchTestsKey];
+    self.objectMapper = [AWSDynamoDBObjectMapper DynamoDBObjectMapperForKey:AWSDynamoDBObjectMapperBatchTestsKey];
+    self.service = [[AWSDynamoDBObjectMapperBatchTestsService alloc] initWithConfiguration:configuration];
+    self.service.latency = 5;
+    self.objectMapper.dynamoDB = self.service;
+}
+
+- (void)tearDown {
+    [AWSDynamoDBObjectMapper removeDynamoDBObjectMapperForKey:AWSDynamoDBObjectMapperBatchTestsKey];
+    [super tearDown];
+}
+
+- (NSArray<AWSDynamoDBObjectMapperBatchTestsModel *> *)modelsWithCount:(NSUInteger)count {
+    NSMutableArray<AWSDynamoDBObjectMapperBatchTestsModel *> *models = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        AWSDynamoDBObjectMapperBatchTestsModel *model = [AWSDynamoDBObjectMapperBatchTestsModel new];
+        model.identifier = [NSString stringWithFormat:@"item-%lu", (unsigned long)i];
+        model.value = @"value";
+        [models addObject:model];
+    }
+    return models;
+}
+
+- (NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *)waitForTask:(AWSTask<NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *> *)task {
+    [task waitUntilFinished];
+    XCTAssertNil(task.error);
+    return task.result;
+}
+
+- (void)testBatchLoadChunksAndKeepsInputOrder {
+    NSArray<AWSDynamoDBObjectMapperBatchTestsModel *> *models = [self modelsWithCount:250];
+
+    NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *results = [self waitForTask:[self.objectMapper batchLoad:models]];
+
+    XCTAssertEqualObjects([self.service.requestSizes valueForKeyPath:@"@max.self"], @100);
+    XCTAssertEqual([self.service.requestSizes count], 3);
+    XCTAssertEqual([results count], [models count]);
+    [results enumerateObjectsUsingBlock:^(AWSDynamoDBObjectMapperBatchItemResult *result, NSUInteger idx, BOOL *stop) {
+        XCTAssertNil(result.error);
+        AWSDynamoDBObjectMapperBatchTestsModel *model = result.model;
+        XCTAssertTrue([model isKindOfClass:[AWSDynamoDBObjectMapperBatchTestsModel class]]);
+        XCTAssertEqualObjects(model.identifier, models[idx].identifier);
+        XCTAssertEqualObjects(model.value, [@"value of " stringByAppendingString:models[idx].identifier]);
+    }];
+}
+
+- (void)testBatchSaveChunksWithinConcurrencyLimit {
+    AWSDynamoDBObjectMapperConfiguration *configuration = [AWSDynamoDBObjectMapperConfiguration new];
+    configuration.batchConcurrencyLimit = 2;
+    NSArray<AWSDynamoDBObjectMapperBatchTestsModel *> *models = [self modelsWithCount:260];
+
+    NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *results = [self waitForTask:[self.objectMapper batchSave:models
+                                                                                                  configuration:configuration]];
+
+    XCTAssertEqual([self.service.requestSizes count], 11);
+    XCTAssertEqualObjects([self.service.requestSizes valueForKeyPath:@"@max.self"], @25);
+    XCTAssertEqual(self.service.maxInFlight, 2);
+    [results enumerateObjectsUsingBlock:^(AWSDynamoDBObjectMapperBatchItemResult *result, NSUInteger idx, BOOL *stop) {
+        XCTAssertNil(result.error);
+        XCTAssertEqual(result.model, models[idx]);
+    }];
+}
+
+- (void)testUnprocessedItemsAreRetried {
+    NSArray<AWSDynamoDBObjectMapperBatchTestsModel *> *models = [self modelsWithCount:30];
+    self.service.throttledKeys[@"item-3"] = @2;
+    self.service.throttledKeys[@"item-27"] = @1;
+
+    NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *results = [self waitForTask:[self.objectMapper batchRemove:models]];
+
+    // Chunks of 25 and 5, each retried for its own key, and a second retry of item-3.
+    XCTAssertEqual([self.service.requestSizes count], 5);
+    XCTAssertEqual([[self.service.requestSizes valueForKeyPath:@"@sum.self"] unsignedIntegerValue], 33);
+    for (AWSDynamoDBObjectMapperBatchItemResult *result in results) {
+        XCTAssertNil(result.error);
+    }
+}
+
+- (void)testUnprocessedItemsFailAfterRetryLimit {
+    AWSDynamoDBObjectMapperConfiguration *configuration = [AWSDynamoDBObjectMapperConfiguration new];
+    configuration.batchRetryLimit = 2;
+    NSArray<AWSDynamoDBObjectMapperBatchTestsModel *> *models = [self modelsWithCount:10];
+    self.service.throttledKeys[@"item-4"] = @100;
+
+    NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *results = [self waitForTask:[self.objectMapper batchLoad:models
+                                                                                                  configuration:configuration]];
+
+    XCTAssertEqual([self.service.requestSizes count], 3);
+    [results enumerateObjectsUsingBlock:^(AWSDynamoDBObjectMapperBatchItemResult *result, NSUInteger idx, BOOL *stop) {
+        if (idx == 4) {
+            XCTAssertNil(result.model);
+            XCTAssertEqualObjects(result.error.domain, AWSDynamoDBErrorDomain);
+            XCTAssertEqual(result.error.code, AWSDynamoDBErrorProvisionedThroughputExceeded);
+        } else {
+            XCTAssertNil(result.error);
+            XCTAssertNotNil(result.model);
+        }
+    }];
+}
+
+- (void)testRequestErrorFailsOnlyItsChunk {
+    NSArray<AWSDynamoDBObjectMapperBatchTestsModel *> *models = [self modelsWithCount:50];
+    self.service.failingKey = @"item-30";
+
+    NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *results = [self waitForTask:[self.objectMapper batchSave:models]];
+
+    [results enumerateObjectsUsingBlock:^(AWSDynamoDBObjectMapperBatchItemResult *result, NSUInteger idx, BOOL *stop) {
+        if (idx < 25) {
+            XCTAssertNil(result.error);
+        } else {
+            XCTAssertEqual(result.error.code, AWSDynamoDBErrorResourceNotFound);
+        }
+    }];
+}
+
+- (void)testDuplicateKeysAreSentOnce {
+    NSMutableArray<AWSDynamoDBObjectMapperBatchTestsModel *> *models = [[self modelsWithCount:3] mutableCopy];
+    [models addObject:[models[1] copy]];
+
+    NSArray<AWSDynamoDBObjectMapperBatchItemResult *> *results = [self waitForTask:[self.objectMapper batchLoad:models]];
+
+    XCTAssertEqualObjects(self.service.requestSizes, @[@3]);
+    XCTAssertEqual([results count], 4);
+    XCTAssertEqualObjects([results[3].model identifier], @"item-1");
+    XCTAssertEqualObjects([results[1].model identifier], @"item-1");
+}
+
+- (void)testEmptyInput {
+    XCTAssertEqualObjects([self waitForTask:[self.objectMapper batchSave:@[]]], @[]);
+    XCTAssertEqual([self.service.requestSizes count], 0);
+}
+
+- (void)testConfigurationCopiesBatchSettings {
+    AWSDynamoDBObjectMapperConfiguration *configuration = [AWSDynamoDBObjectMapperConfiguration new];
+    XCTAssertEqual(configuration.batchConcurrencyLimit, 4);
+    XCTAssertEqual(configuration.batchRetryLimit, 5);
+
+    configuration.batchConcurrencyLimit = 8;
+    configuration.batchRetryLimit = 1;
+    AWSDynamoDBObjectMapperConfiguration *copy = [configuration copy];
+    XCTAssertEqual(copy.batchConcurrencyLimit, 8);
+    XCTAssertEqual(copy.batchRetryLimit, 1);
+}
+
+#pragma mark - Benchmarks
+
+// Baseline: one round trip per model, as callers saving models one at a time had to make. A 25th of the models keeps it short.
+- (void)testSingleSavePerformance {
+    NSArray<AWSDynamoDBObjectMapperBatchTestsModel *> *models = [self modelsWithCount:AWSDynamoDBObjectMapperBatchTestsBenchmarkCount / 25];
+    [self measureBlock:^{
+        for (AWSDynamoDBObjectMapperBatchTestsModel *model in models) {
+            [[self.objectMapper batchSave:@[model]] waitUntilFinished];
+        }
+    }];
+}
+
+- (void)testBatchSavePerformance {
+    NSArray<AWSDynamoDBObjectMapperBatchTestsModel *> *models = [self modelsWithCount:AWSDynamoDBObjectMapperBatchTestsBenchmarkCount];
+    [self measureBlock:^{
+        XCTAssertEqual([[self waitForTask:[self.objectMapper batchSave:models]] count], AWSDynamoDBObjectMapperBatchTestsBenchmarkCount);
+    }];
+}
+
+@end
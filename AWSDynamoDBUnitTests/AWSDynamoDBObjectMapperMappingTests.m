@@ -0,0 +1,397 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "OCMock.h"
+#import "AWSTestUtility.h"
+#import "AWSDynamoDB.h"
+
+static NSString *const AWSDynamoDBObjectMapperMappingTestsKey = @"AWSDynamoDBObjectMapperMappingTests";
+static const NSUInteger AWSDynamoDBObjectMapperMappingTestsBenchmarkCount = 1000;
+
+@interface AWSDynamoDBObjectModel()
+
+- (NSDictionary *)itemForPutItemInput;
+- (NSDictionary *)itemForUpdateItemInput:(AWSDynamoDBObjectMapperSaveBehavior)behavior;
+- (NSDictionary *)key;
+
+@end
+
+@interface AWSDynamoDBObjectMapper()
+
+@property (nonatomic, strong) AWSDynamoDB *dynamoDB;
+
+@end
+
+@interface AWSDynamoDBAttributeValue (AWSDynamoDBObjectMapper)
+
+- (void)aws_setAttributeValue:(id)attributeValue;
+- (id)aws_getAttributeValue;
+
+@end
+
+// 52 attributes: strings, numbers, sets, lists and maps that nest further maps and lists.
+@interface AWSDynamoDBObjectMapperMappingTestsWideModel : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *string00;
+@property (nonatomic, strong) NSString *string01;
+@property (nonatomic, strong) NSString *string02;
+@property (nonatomic, strong) NSString *string03;
+@property (nonatomic, strong) NSString *string04;
+@property (nonatomic, strong) NSString *string05;
+@property (nonatomic, strong) NSString *string06;
+@property (nonatomic, strong) NSString *string07;
+@property (nonatomic, strong) NSString *string08;
+@property (nonatomic, strong) NSString *string09;
+@property (nonatomic, strong) NSString *string10;
+@property (nonatomic, strong) NSString *string11;
+@property (nonatomic, strong) NSString *string12;
+@property (nonatomic, strong) NSString *string13;
+@property (nonatomic, strong) NSString *string14;
+@property (nonatomic, strong) NSString *string15;
+@property (nonatomic, strong) NSString *string16;
+@property (nonatomic, strong) NSString *string17;
+@property (nonatomic, strong) NSString *string18;
+@property (nonatomic, strong) NSString *string19;
+@property (nonatomic, strong) NSNumber *number00;
+@property (nonatomic, strong) NSNumber *number01;
+@property (nonatomic, strong) NSNumber *number02;
+@property (nonatomic, strong) NSNumber *number03;
+@property (nonatomic, strong) NSNumber *number04;
+@property (nonatomic, strong) NSNumber *number05;
+@property (nonatomic, strong) NSNumber *number06;
+@property (nonatomic, strong) NSNumber *number07;
+@property (nonatomic, strong) NSNumber *number08;
+@property (nonatomic, strong) NSNumber *number09;
+@property (nonatomic, strong) NSNumber *number10;
+@property (nonatomic, strong) NSNumber *number11;
+@property (nonatomic, strong) NSNumber *number12;
+@property (nonatomic, strong) NSNumber *number13;
+@property (nonatomic, strong) NSNumber *number14;
+@property (nonatomic, strong) NSNumber *number15;
+@property (nonatomic, strong) NSNumber *number16;
+@property (nonatomic, strong) NSNumber *number17;
+@property (nonatomic, strong) NSNumber *number18;
+@property (nonatomic, strong) NSNumber *number19;
+@property (nonatomic, strong) NSSet *set00;
+@property (nonatomic, strong) NSSet *set01;
+@property (nonatomic, strong) NSSet *set02;
+@property (nonatomic, strong) NSSet *set03;
+@property (nonatomic, strong) NSArray *list00;
+@property (nonatomic, strong) NSArray *list01;
+@property (nonatomic, strong) NSArray *list02;
+@property (nonatomic, strong) NSArray *list03;
+@property (nonatomic, strong) NSDictionary *map00;
+@property (nonatomic, strong) NSDictionary *map01;
+@property (nonatomic, strong) NSDictionary *map02;
+@property (nonatomic, strong) NSDictionary *map03;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperMappingTestsWideModel
+
++ (NSString *)dynamoDBTableName {
+    return @"AWSDynamoDBObjectMapperMappingTestsWide";
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"string00";
+}
+
++ (NSString *)rangeKeyAttribute {
+    return @"number00";
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperMappingTestsRenamedModel : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *userId;
+@property (nonatomic, strong) NSDate *createdAt;
+@property (nonatomic, strong) NSString *nickname;
+@property (nonatomic, strong) NSString *cachedValue;
+@property (nonatomic, strong) NSString *transientValue;
+@property (nonatomic, assign) NSInteger score;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperMappingTestsRenamedModel
+
++ (NSString *)dynamoDBTableName {
+    return @"AWSDynamoDBObjectMapperMappingTestsRenamed";
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"userId";
+}
+
++ (NSArray<NSString *> *)ignoreAttributes {
+    return @[@"cachedValue"];
+}
+
++ (NSDictionary *)JSONKeyPathsByPropertyKey {
+    return @{@"userId" : @"user_id",
+             @"createdAt" : @"created_at",
+             @"transientValue" : [NSNull null]};
+}
+
++ (NSValueTransformer *)createdAtJSONTransformer {
+    return [AWSMTLValueTransformer reversibleTransformerWithForwardBlock:^id(NSNumber *number) {
+        return [NSDate dateWithTimeIntervalSince1970:[number doubleValue]];
+    } reverseBlock:^id(NSDate *date) {
+        return @((long long)[date timeIntervalSince1970]);
+    }];
+}
+
+@end
+
+// A nested key path keeps the class on the AWSMTLJSONAdapter path.
+@interface AWSDynamoDBObjectMapperMappingTestsNestedModel : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *identifier;
+@property (nonatomic, strong) NSString *city;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperMappingTestsNestedModel
+
++ (NSString *)dynamoDBTableName {
+    return @"AWSDynamoDBObjectMapperMappingTestsNested";
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"identifier";
+}
+
++ (NSDictionary *)JSONKeyPathsByPropertyKey {
+    return @{@"city" : @"address.city"};
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperMappingTests : XCTestCase
+
+@property (nonatomic, strong) AWSDynamoDBObjectMapper *objectMapper;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperMappingTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    [AWSDynamoDBObjectMapper registerDynamoDBObjectMapperWithConfiguration:[AWSServiceManager defaultServiceManager].defaultServiceConfiguration
+                                                     objectMapperConfiguration:[AWSDynamoDBObjectMapperConfiguration new]
+                                                                        forKey:AWSDynamoDBObjectMapperMappingTestsKey];
+    self.objectMapper = [AWSDynamoDBObjectMapper DynamoDBObjectMapperForKey:AWSDynamoDBObjectMapperMappingTestsKey];
+}
+
+- (void)tearDown {
+    [AWSDynamoDBObjectMapper removeDynamoDBObjectMapperForKey:AWSDynamoDBObjectMapperMappingTestsKey];
+    [super tearDown];
+}
+
+- (AWSDynamoDBObjectMapperMappingTestsWideModel *)wideModelWithIndex:(NSUInteger)index {
+    AWSDynamoDBObjectMapperMappingTestsWideModel *model = [AWSDynamoDBObjectMapperMappingTestsWideModel new];
+    for (NSUInteger i = 0; i < 20; i++) {
+        [model setValue:[NSString stringWithFormat:@"item %lu attribute %lu", (unsigned long)index, (unsigned long)i]
+                 forKey:[NSString stringWithFormat:@"string%02lu", (unsigned long)i]];
+        [model setValue:i % 2 ? @(index * 1000 + i) : @(-(double)index - i / 8.0)
+                 forKey:[NSString stringWithFormat:@"number%02lu", (unsigned long)i]];
+    }
+    for (NSUInteger i = 0; i < 4; i++) {
+        [model setValue:[NSSet setWithObjects:@"red", @"green", @"blue", [NSString stringWithFormat:@"%lu", (unsigned long)index], nil]
+                 forKey:[NSString stringWithFormat:@"set%02lu", (unsigned long)i]];
+        [model setValue:@[@(index), @"text", @YES, @[@1, @2, @3]]
+                 forKey:[NSString stringWithFormat:@"list%02lu", (unsigned long)i]];
+        [model setValue:@{@"name" : @"nested",
+                          @"count" : @(index + i),
+                          @"inner" : @{@"flag" : @NO, @"values" : @[@"a", @"b"], @"deeper" : @{@"n" : @(12345678901234LL)}}}
+                 forKey:[NSString stringWithFormat:@"map%02lu", (unsigned long)i]];
+    }
+    return model;
+}
+
+// The item and model AWSMTLJSONAdapter and -aws_setAttributeValue: produced before mappings were compiled.
+- (NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)adapterItemForModel:(AWSDynamoDBObjectModel *)model {
+    NSMutableDictionary *item = [NSMutableDictionary new];
+    [[AWSMTLJSONAdapter JSONDictionaryFromModel:model] enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+        if (value != [NSNull null]) {
+            AWSDynamoDBAttributeValue *attributeValue = [AWSDynamoDBAttributeValue new];
+            [attributeValue aws_setAttributeValue:value];
+            item[key] = attributeValue;
+        }
+    }];
+    return item;
+}
+
+- (id)adapterModelOfClass:(Class)modelClass fromItem:(NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)item {
+    NSMutableDictionary *JSONDictionary = [NSMutableDictionary new];
+    [item enumerateKeysAndObjectsUsingBlock:^(NSString *key, AWSDynamoDBAttributeValue *attributeValue, BOOL *stop) {
+        JSONDictionary[key] = [attributeValue aws_getAttributeValue];
+    }];
+    return [AWSMTLJSONAdapter modelOfClass:modelClass fromJSONDictionary:JSONDictionary error:nil];
+}
+
+// Loads through AWSDynamoDBObjectMapper with GetItem answered from memory.
+- (id)loadModelOfClass:(Class)modelClass fromItem:(NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *)item {
+    AWSDynamoDBGetItemOutput *getItemOutput = [AWSDynamoDBGetItemOutput new];
+    getItemOutput.item = item;
+    id mockDynamoDB = OCMClassMock([AWSDynamoDB class]);
+    OCMStub([mockDynamoDB getItem:[OCMArg any]]).andReturn([AWSTask taskWithResult:getItemOutput]);
+    self.objectMapper.dynamoDB = mockDynamoDB;
+
+    AWSTask *task = [self.objectMapper load:modelClass hashKey:@"hash" rangeKey:nil];
+    [task waitUntilFinished];
+    XCTAssertNil(task.error);
+    return task.result;
+}
+
+- (void)testWideModelMatchesAdapter {
+    AWSDynamoDBObjectMapperMappingTestsWideModel *model = [self wideModelWithIndex:7];
+
+    NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *item = [model itemForPutItemInput];
+    XCTAssertEqual([item count], 52);
+    XCTAssertEqualObjects(item, [self adapterItemForModel:model]);
+
+    AWSDynamoDBObjectMapperMappingTestsWideModel *loaded = [self loadModelOfClass:[AWSDynamoDBObjectMapperMappingTestsWideModel class] fromItem:item];
+    XCTAssertEqualObjects(loaded, [self adapterModelOfClass:[AWSDynamoDBObjectMapperMappingTestsWideModel class] fromItem:item]);
+    XCTAssertEqualObjects(loaded, model);
+
+    NSDictionary *key = [model key];
+    XCTAssertEqualObjects([NSSet setWithArray:[key allKeys]], ([NSSet setWithObjects:@"string00", @"number00", nil]));
+    XCTAssertEqualObjects([key[@"number00"] N], @"-7");
+}
+
+- (void)testRenamedIgnoredAndTransformedProperties {
+    AWSDynamoDBObjectMapperMappingTestsRenamedModel *model = [AWSDynamoDBObjectMapperMappingTestsRenamedModel new];
+    model.userId = @"user";
+    model.createdAt = [NSDate dateWithTimeIntervalSince1970:1600000000];
+    model.cachedValue = @"cached";
+    model.transientValue = @"transient";
+    model.score = 42;
+
+    NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *item = [model itemForPutItemInput];
+    XCTAssertEqualObjects([NSSet setWithArray:[item allKeys]], ([NSSet setWithObjects:@"user_id", @"created_at", @"score", nil]));
+    XCTAssertEqualObjects(item[@"created_at"].N, @"1600000000");
+    XCTAssertEqualObjects(item[@"score"].N, @"42");
+    XCTAssertEqualObjects([model key][@"user_id"].S, @"user");
+
+    // A nil property deletes its attribute on update, and the key is not part of the update.
+    NSDictionary<NSString *, AWSDynamoDBAttributeValueUpdate *> *update = [model itemForUpdateItemInput:AWSDynamoDBObjectMapperSaveBehaviorUpdate];
+    XCTAssertNil(update[@"user_id"]);
+    XCTAssertNil(update[@"cachedValue"]);
+    model.nickname = nil;
+    XCTAssertEqual([model itemForUpdateItemInput:AWSDynamoDBObjectMapperSaveBehaviorUpdate][@"nickname"].action, AWSDynamoDBAttributeActionDelete);
+
+    AWSDynamoDBObjectMapperMappingTestsRenamedModel *loaded = [self loadModelOfClass:[AWSDynamoDBObjectMapperMappingTestsRenamedModel class] fromItem:item];
+    XCTAssertEqualObjects(loaded.userId, @"user");
+    XCTAssertEqualObjects(loaded.createdAt, model.createdAt);
+    XCTAssertEqual(loaded.score, 42);
+    XCTAssertNil(loaded.transientValue);
+    XCTAssertEqualObjects(loaded, [self adapterModelOfClass:[AWSDynamoDBObjectMapperMappingTestsRenamedModel class] fromItem:item]);
+}
+
+- (void)testNestedKeyPathUsesAdapter {
+    AWSDynamoDBObjectMapperMappingTestsNestedModel *model = [AWSDynamoDBObjectMapperMappingTestsNestedModel new];
+    model.identifier = @"id";
+    model.city = @"Seattle";
+
+    NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *item = [model itemForPutItemInput];
+    XCTAssertEqualObjects(item[@"address"].M[@"city"].S, @"Seattle");
+
+    AWSDynamoDBObjectMapperMappingTestsNestedModel *loaded = [self loadModelOfClass:[AWSDynamoDBObjectMapperMappingTestsNestedModel class] fromItem:item];
+    XCTAssertEqualObjects(loaded.city, @"Seattle");
+}
+
+- (void)testNumberParsing {
+    NSArray<NSString *> *numbers = @[@"0", @"-0", @"7", @"-42", @"1234567890123456789012", @"3.25", @"-0.5", @"1e3", @"-"];
+    for (NSString *number in numbers) {
+        AWSDynamoDBAttributeValue *attributeValue = [AWSDynamoDBAttributeValue new];
+        attributeValue.N = number;
+        XCTAssertEqualObjects([attributeValue aws_getAttributeValue], [NSNumber aws_numberFromString:number], @"%@", number);
+    }
+
+    AWSDynamoDBAttributeValue *attributeValue = [AWSDynamoDBAttributeValue new];
+    attributeValue.NS = @[@"123456789012345678", @"-5"];
+    XCTAssertEqualObjects([attributeValue aws_getAttributeValue], ([NSSet setWithObjects:@123456789012345678LL, @-5, nil]));
+}
+
+#pragma mark - Benchmarks
+
+// Baseline: 1000 wide items through AWSMTLJSONAdapter, the path every save took before mappings were compiled.
+- (void)testAdapterSavePerformance {
+    NSMutableArray *models = [NSMutableArray new];
+    for (NSUInteger i = 0; i < AWSDynamoDBObjectMapperMappingTestsBenchmarkCount; i++) {
+        [models addObject:[self wideModelWithIndex:i]];
+    }
+    [self measureBlock:^{
+        for (AWSDynamoDBObjectModel *model in models) {
+            @autoreleasepool {
+                XCTAssertEqual([[self adapterItemForModel:model] count], 52);
+            }
+        }
+    }];
+}
+
+- (void)testSavePerformance {
+    NSMutableArray *models = [NSMutableArray new];
+    for (NSUInteger i = 0; i < AWSDynamoDBObjectMapperMappingTestsBenchmarkCount; i++) {
+        [models addObject:[self wideModelWithIndex:i]];
+    }
+    [self measureBlock:^{
+        for (AWSDynamoDBObjectModel *model in models) {
+            @autoreleasepool {
+                XCTAssertEqual([[model itemForPutItemInput] count], 52);
+            }
+        }
+    }];
+}
+
+- (void)testAdapterLoadPerformance {
+    NSMutableArray *items = [NSMutableArray new];
+    for (NSUInteger i = 0; i < AWSDynamoDBObjectMapperMappingTestsBenchmarkCount; i++) {
+        [items addObject:[[self wideModelWithIndex:i] itemForPutItemInput]];
+    }
+    [self measureBlock:^{
+        for (NSDictionary *item in items) {
+            @autoreleasepool {
+                XCTAssertNotNil([self adapterModelOfClass:[AWSDynamoDBObjectMapperMappingTestsWideModel class] fromItem:item]);
+            }
+        }
+    }];
+}
+
+- (void)testLoadPerformance {
+    AWSDynamoDBScanOutput *scanOutput = [AWSDynamoDBScanOutput new];
+    NSMutableArray *items = [NSMutableArray new];
+    for (NSUInteger i = 0; i < AWSDynamoDBObjectMapperMappingTestsBenchmarkCount; i++) {
+        [items addObject:[[self wideModelWithIndex:i] itemForPutItemInput]];
+    }
+    scanOutput.items = items;
+    id mockDynamoDB = OCMClassMock([AWSDynamoDB class]);
+    OCMStub([mockDynamoDB scan:[OCMArg any]]).andReturn([AWSTask taskWithResult:scanOutput]);
+    self.objectMapper.dynamoDB = mockDynamoDB;
+
+    [self measureBlock:^{
+        AWSTask<AWSDynamoDBPaginatedOutput *> *task = [self.objectMapper scan:[AWSDynamoDBObjectMapperMappingTestsWideModel class]
+                                                                   expression:[AWSDynamoDBScanExpression new]];
+        [task waitUntilFinished];
+        XCTAssertEqual([task.result.items count], AWSDynamoDBObjectMapperMappingTestsBenchmarkCount);
+    }];
+}
+
+@end
@@ -0,0 +1,362 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSDynamoDB.h"
+
+static NSString *const AWSDynamoDBObjectMapperReadCacheTestsKey = @"AWSDynamoDBObjectMapperReadCacheTests";
+static NSString *const AWSDynamoDBObjectMapperReadCacheTestsTableName = @"AWSDynamoDBObjectMapperReadCacheTestsTable";
+static const NSUInteger AWSDynamoDBObjectMapperReadCacheTestsBenchmarkCount = 200;
+
+@interface AWSDynamoDB()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+@interface AWSDynamoDBObjectMapper()
+
+@property (nonatomic, strong) AWSDynamoDB *dynamoDB;
+
+@end
+
+@interface AWSDynamoDBObjectMapperReadCacheTestsModel : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *identifier;
+@property (nonatomic, strong) NSString *value;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperReadCacheTestsModel
+
++ (NSString *)dynamoDBTableName {
+    return AWSDynamoDBObjectMapperReadCacheTestsTableName;
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"identifier";
+}
+
+@end
+
+// Keeps one table in memory and counts the GetItem requests. GetItem reads the table when it is called and responds
+// after the latency.
+@interface AWSDynamoDBObjectMapperReadCacheTestsService : AWSDynamoDB
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary<NSString *, AWSDynamoDBAttributeValue *> *> *items;
+@property (nonatomic, assign) NSUInteger getItemCount;
+@property (nonatomic, assign) int latency;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperReadCacheTestsService
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration {
+    if (self = [super initWithConfiguration:configuration]) {
+        _items = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+- (AWSTask<AWSDynamoDBGetItemOutput *> *)getItem:(AWSDynamoDBGetItemInput *)request {
+    AWSDynamoDBGetItemOutput *output = [AWSDynamoDBGetItemOutput new];
+    @synchronized(self) {
+        self.getItemCount++;
+        output.item = self.items[request.key[@"identifier"].S];
+    }
+    return [[AWSTask taskWithDelay:self.latency] continueWithSuccessBlock:^id(AWSTask *task) {
+        return output;
+    }];
+}
+
+- (AWSTask<AWSDynamoDBPutItemOutput *> *)putItem:(AWSDynamoDBPutItemInput *)request {
+    @synchronized(self) {
+        self.items[request.item[@"identifier"].S] = request.item;
+    }
+    return [AWSTask taskWithResult:[AWSDynamoDBPutItemOutput new]];
+}
+
+- (AWSTask<AWSDynamoDBUpdateItemOutput *> *)updateItem:(AWSDynamoDBUpdateItemInput *)request {
+    @synchronized(self) {
+        NSString *identifier = request.key[@"identifier"].S;
+        NSMutableDictionary *item = [NSMutableDictionary dictionaryWithDictionary:self.items[identifier] ?: request.key];
+        [request.attributeUpdates enumerateKeysAndObjectsUsingBlock:^(NSString *attribute, AWSDynamoDBAttributeValueUpdate *update, BOOL *stop) {
+            item[attribute] = update.value;
+        }];
+        self.items[identifier] = item;
+    }
+    return [AWSTask taskWithResult:[AWSDynamoDBUpdateItemOutput new]];
+}
+
+- (AWSTask<AWSDynamoDBDeleteItemOutput *> *)deleteItem:(AWSDynamoDBDeleteItemInput *)request {
+    @synchronized(self) {
+        [self.items removeObjectForKey:request.key[@"identifier"].S];
+    }
+    return [AWSTask taskWithResult:[AWSDynamoDBDeleteItemOutput new]];
+}
+
+- (AWSTask<AWSDynamoDBBatchWriteItemOutput *> *)batchWriteItem:(AWSDynamoDBBatchWriteItemInput *)request {
+    @synchronized(self) {
+        for (AWSDynamoDBWriteRequest *writeRequest in request.requestItems[AWSDynamoDBObjectMapperReadCacheTestsTableName]) {
+            if (writeRequest.putRequest) {
+                self.items[writeRequest.putRequest.item[@"identifier"].S] = writeRequest.putRequest.item;
+            } else {
+                [self.items removeObjectForKey:writeRequest.deleteRequest.key[@"identifier"].S];
+            }
+        }
+    }
+    return [AWSTask taskWithResult:[AWSDynamoDBBatchWriteItemOutput new]];
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperReadCacheTests : XCTestCase
+
+@property (nonatomic, strong) AWSDynamoDBObjectMapperReadCacheTestsService *service;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperReadCacheTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [AWSServiceManager defaultServiceManager].defaultServiceConfiguration;
+    self.service = [[AWSDynamoDBObjectMapperReadCacheTestsService alloc] initWithConfiguration:configuration];
+    for (NSUInteger i = 0; i < AWSDynamoDBObjectMapperReadCacheTestsBenchmarkCount; i++) {
+        NSString *identifier = [NSString stringWithFormat:@"item-%lu", (unsigned long)i];
+        AWSDynamoDBAttributeValue *identifierValue = [AWSDynamoDBAttributeValue new];
+        identifierValue.S = identifier;
+        AWSDynamoDBAttributeValue *value = [AWSDynamoDBAttributeValue new];
+        value.S = @"value";
+        self.service.items[identifier] = @{@"identifier" : identifierValue, @"value" : value};
+    }
+}
+
+- (void)tearDown {
+    [AWSDynamoDBObjectMapper removeDynamoDBObjectMapperForKey:AWSDynamoDBObjectMapperReadCacheTestsKey];
+    [super tearDown];
+}
+
+- (AWSDynamoDBObjectMapper *)objectMapperWithCountLimit:(NSUInteger)countLimit
+                                             timeToLive:(NSTimeInterval)timeToLive {
+    AWSDynamoDBObjectMapperConfiguration *objectMapperConfiguration = [AWSDynamoDBObjectMapperConfiguration new];
+    objectMapperConfiguration.readCacheCountLimit = countLimit;
+    objectMapperConfiguration.readCacheTimeToLive = timeToLive;
+    [AWSDynamoDBObjectMapper registerDynamoDBObjectMapperWithConfiguration:[AWSServiceManager defaultServiceManager].defaultServiceConfiguration
+                                                 objectMapperConfiguration:objectMapperConfiguration
+                                                                    forKey:AWSDynamoDBObjectMapperReadCacheTestsKey];
+    AWSDynamoDBObjectMapper *objectMapper = [AWSDynamoDBObjectMapper DynamoDBObjectMapperForKey:AWSDynamoDBObjectMapperReadCacheTestsKey];
+    objectMapper.dynamoDB = self.service;
+    return objectMapper;
+}
+
+- (AWSDynamoDBObjectMapperReadCacheTestsModel *)load:(NSString *)identifier
+                                        objectMapper:(AWSDynamoDBObjectMapper *)objectMapper {
+    AWSTask *task = [objectMapper load:[AWSDynamoDBObjectMapperReadCacheTestsModel class]
+                               hashKey:identifier
+                              rangeKey:nil];
+    [task waitUntilFinished];
+    XCTAssertNil(task.error);
+    return task.result;
+}
+
+- (AWSDynamoDBObjectMapperReadCacheTestsModel *)modelWithIdentifier:(NSString *)identifier value:(NSString *)value {
+    AWSDynamoDBObjectMapperReadCacheTestsModel *model = [AWSDynamoDBObjectMapperReadCacheTestsModel new];
+    model.identifier = identifier;
+    model.value = value;
+    return model;
+}
+
+- (void)testCacheIsOffByDefault {
+    AWSDynamoDBObjectMapperConfiguration *configuration = [AWSDynamoDBObjectMapperConfiguration new];
+    XCTAssertEqual(configuration.readCacheCountLimit, 0);
+    XCTAssertEqual(configuration.readCacheTimeToLive, 60.0);
+
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:0 timeToLive:60];
+    [self load:@"item-0" objectMapper:objectMapper];
+    [self load:@"item-0" objectMapper:objectMapper];
+
+    XCTAssertEqual(self.service.getItemCount, 2);
+    XCTAssertEqual(objectMapper.readCacheHitCount, 0);
+    XCTAssertEqual(objectMapper.readCacheMissCount, 0);
+}
+
+- (void)testRepeatedLoadIsAnsweredFromCache {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:10 timeToLive:60];
+
+    AWSDynamoDBObjectMapperReadCacheTestsModel *first = [self load:@"item-0" objectMapper:objectMapper];
+    AWSDynamoDBObjectMapperReadCacheTestsModel *second = [self load:@"item-0" objectMapper:objectMapper];
+
+    XCTAssertEqual(self.service.getItemCount, 1);
+    XCTAssertEqual(objectMapper.readCacheHitCount, 1);
+    XCTAssertEqual(objectMapper.readCacheMissCount, 1);
+    XCTAssertEqualObjects(second.identifier, @"item-0");
+    XCTAssertEqualObjects(second.value, @"value");
+    // Every load gets a model of its own.
+    XCTAssertNotEqual(first, second);
+}
+
+- (void)testMissingItemIsNotCached {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:10 timeToLive:60];
+
+    XCTAssertNil([self load:@"missing" objectMapper:objectMapper]);
+    XCTAssertNil([self load:@"missing" objectMapper:objectMapper]);
+
+    XCTAssertEqual(self.service.getItemCount, 2);
+    XCTAssertEqual(objectMapper.readCacheMissCount, 2);
+}
+
+- (void)testConsistentReadSkipsCache {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:10 timeToLive:60];
+    AWSDynamoDBObjectMapperConfiguration *consistentConfiguration = [AWSDynamoDBObjectMapperConfiguration new];
+    consistentConfiguration.consistentRead = @YES;
+
+    [self load:@"item-0" objectMapper:objectMapper];
+    [[objectMapper load:[AWSDynamoDBObjectMapperReadCacheTestsModel class]
+                hashKey:@"item-0"
+               rangeKey:nil
+          configuration:consistentConfiguration] waitUntilFinished];
+
+    XCTAssertEqual(self.service.getItemCount, 2);
+    XCTAssertEqual(objectMapper.readCacheHitCount, 0);
+    XCTAssertEqual(objectMapper.readCacheMissCount, 1);
+}
+
+- (void)testItemsExpire {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:10 timeToLive:0.1];
+
+    [self load:@"item-0" objectMapper:objectMapper];
+    [self load:@"item-0" objectMapper:objectMapper];
+    [[AWSTask taskWithDelay:200] waitUntilFinished];
+    [self load:@"item-0" objectMapper:objectMapper];
+
+    XCTAssertEqual(self.service.getItemCount, 2);
+    XCTAssertEqual(objectMapper.readCacheHitCount, 1);
+    XCTAssertEqual(objectMapper.readCacheMissCount, 2);
+}
+
+- (void)testLeastRecentlyUsedItemIsEvicted {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:2 timeToLive:60];
+
+    [self load:@"item-0" objectMapper:objectMapper];
+    [self load:@"item-1" objectMapper:objectMapper];
+    [self load:@"item-0" objectMapper:objectMapper];
+    [self load:@"item-2" objectMapper:objectMapper];
+    XCTAssertEqual(self.service.getItemCount, 3);
+
+    // item-1 was used least recently, so item-2 took its place.
+    [self load:@"item-0" objectMapper:objectMapper];
+    [self load:@"item-2" objectMapper:objectMapper];
+    XCTAssertEqual(self.service.getItemCount, 3);
+    [self load:@"item-1" objectMapper:objectMapper];
+    XCTAssertEqual(self.service.getItemCount, 4);
+}
+
+- (void)testSaveAndRemoveInvalidate {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:10 timeToLive:60];
+    AWSDynamoDBObjectMapperConfiguration *clobberConfiguration = [AWSDynamoDBObjectMapperConfiguration new];
+    clobberConfiguration.saveBehavior = AWSDynamoDBObjectMapperSaveBehaviorClobber;
+
+    [self load:@"item-0" objectMapper:objectMapper];
+    [[objectMapper save:[self modelWithIdentifier:@"item-0" value:@"updated"]] waitUntilFinished];
+    XCTAssertEqualObjects([self load:@"item-0" objectMapper:objectMapper].value, @"updated");
+
+    [[objectMapper save:[self modelWithIdentifier:@"item-0" value:@"replaced"]
+          configuration:clobberConfiguration] waitUntilFinished];
+    XCTAssertEqualObjects([self load:@"item-0" objectMapper:objectMapper].value, @"replaced");
+
+    [[objectMapper remove:[self modelWithIdentifier:@"item-0" value:nil]] waitUntilFinished];
+    XCTAssertNil([self load:@"item-0" objectMapper:objectMapper]);
+
+    XCTAssertEqual(self.service.getItemCount, 4);
+    XCTAssertEqual(objectMapper.readCacheHitCount, 0);
+}
+
+- (void)testBatchWritesInvalidate {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:10 timeToLive:60];
+
+    [self load:@"item-0" objectMapper:objectMapper];
+    [self load:@"item-1" objectMapper:objectMapper];
+    [[objectMapper batchSave:@[[self modelWithIdentifier:@"item-0" value:@"updated"]]] waitUntilFinished];
+    [[objectMapper batchRemove:@[[self modelWithIdentifier:@"item-1" value:nil]]] waitUntilFinished];
+
+    XCTAssertEqualObjects([self load:@"item-0" objectMapper:objectMapper].value, @"updated");
+    XCTAssertNil([self load:@"item-1" objectMapper:objectMapper]);
+    XCTAssertEqual(self.service.getItemCount, 4);
+}
+
+- (void)testLoadThatOverlapsSaveDoesNotFillCache {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:10 timeToLive:60];
+    self.service.latency = 100;
+
+    // The load reads the old item, and the save finishes before the load responds.
+    AWSTask *loadTask = [objectMapper load:[AWSDynamoDBObjectMapperReadCacheTestsModel class]
+                                   hashKey:@"item-0"
+                                  rangeKey:nil];
+    [[objectMapper save:[self modelWithIdentifier:@"item-0" value:@"updated"]] waitUntilFinished];
+    [loadTask waitUntilFinished];
+    XCTAssertEqualObjects([loadTask.result value], @"value");
+
+    XCTAssertEqualObjects([self load:@"item-0" objectMapper:objectMapper].value, @"updated");
+    XCTAssertEqual(self.service.getItemCount, 2);
+}
+
+- (void)testRemoveAllCachedItems {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:10 timeToLive:60];
+
+    [self load:@"item-0" objectMapper:objectMapper];
+    [objectMapper removeAllCachedItems];
+    [self load:@"item-0" objectMapper:objectMapper];
+
+    XCTAssertEqual(self.service.getItemCount, 2);
+}
+
+- (void)testConfigurationCopiesReadCacheSettings {
+    AWSDynamoDBObjectMapperConfiguration *configuration = [AWSDynamoDBObjectMapperConfiguration new];
+    configuration.readCacheCountLimit = 500;
+    configuration.readCacheTimeToLive = 5;
+
+    AWSDynamoDBObjectMapperConfiguration *copy = [configuration copy];
+    XCTAssertEqual(copy.readCacheCountLimit, 500);
+    XCTAssertEqual(copy.readCacheTimeToLive, 5);
+}
+
+#pragma mark - Benchmarks
+
+// Baseline: every load is a GetItem request, with 1 ms of simulated latency each.
+- (void)testUncachedLoadPerformance {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:0 timeToLive:60];
+    self.service.latency = 1;
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < AWSDynamoDBObjectMapperReadCacheTestsBenchmarkCount; i++) {
+            XCTAssertNotNil([self load:[NSString stringWithFormat:@"item-%lu", (unsigned long)(i % 20)] objectMapper:objectMapper]);
+        }
+    }];
+}
+
+- (void)testCachedLoadPerformance {
+    AWSDynamoDBObjectMapper *objectMapper = [self objectMapperWithCountLimit:100 timeToLive:60];
+    self.service.latency = 1;
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < AWSDynamoDBObjectMapperReadCacheTestsBenchmarkCount; i++) {
+            XCTAssertNotNil([self load:[NSString stringWithFormat:@"item-%lu", (unsigned long)(i % 20)] objectMapper:objectMapper]);
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,297 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSTestUtility.h"
+#import "AWSDynamoDB.h"
+
+static NSString *const AWSDynamoDBObjectMapperScanTestsKey = @"AWSDynamoDBObjectMapperScanTests";
+static NSString *const AWSDynamoDBObjectMapperScanTestsTableName = @"AWSDynamoDBObjectMapperScanTestsTable";
+static const NSUInteger AWSDynamoDBObjectMapperScanTestsItemCount = 1000;
+
+@interface AWSDynamoDB()
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration;
+
+@end
+
+@interface AWSDynamoDBObjectMapper()
+
+@property (nonatomic, strong) AWSDynamoDB *dynamoDB;
+
+@end
+
+@interface AWSDynamoDBObjectMapperScanTestsModel : AWSDynamoDBObjectModel <AWSDynamoDBModeling>
+
+@property (nonatomic, strong) NSString *identifier;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperScanTestsModel
+
++ (NSString *)dynamoDBTableName {
+    return AWSDynamoDBObjectMapperScanTestsTableName;
+}
+
++ (NSString *)hashKeyAttribute {
+    return @"identifier";
+}
+
+@end
+
+// A table of itemCount items. Item i belongs to segment i % totalSegments, and pages end at the limit of the request.
+@interface AWSDynamoDBObjectMapperScanTestsService : AWSDynamoDB
+
+@property (nonatomic, assign) NSUInteger itemCount;
+@property (nonatomic, assign) int latency;
+@property (nonatomic, strong) NSMutableArray<AWSDynamoDBScanInput *> *requests;
+@property (nonatomic, assign) NSUInteger inFlight;
+@property (nonatomic, assign) NSUInteger maxInFlight;
+@property (nonatomic, copy) void (^requestObserver)(AWSDynamoDBScanInput *request);
+
+@end
+
+@implementation AWSDynamoDBObjectMapperScanTestsService
+
+- (instancetype)initWithConfiguration:(AWSServiceConfiguration *)configuration {
+    if (self = [super initWithConfiguration:configuration]) {
+        _requests = [NSMutableArray new];
+    }
+    return self;
+}
+
+- (AWSTask<AWSDynamoDBScanOutput *> *)scan:(AWSDynamoDBScanInput *)request {
+    if (self.requestObserver) {
+        self.requestObserver(request);
+    }
+    @synchronized(self) {
+        [self.requests addObject:request];
+        self.inFlight++;
+        self.maxInFlight = MAX(self.maxInFlight, self.inFlight);
+    }
+
+    NSUInteger totalSegments = MAX([request.totalSegments unsignedIntegerValue], 1);
+    NSUInteger index = [request.segment unsignedIntegerValue];
+    if (request.exclusiveStartKey) {
+        index = [request.exclusiveStartKey[@"identifier"].S integerValue] + totalSegments;
+    }
+    NSUInteger limit = [request.limit unsignedIntegerValue] ?: NSUIntegerMax;
+
+    NSMutableArray *items = [NSMutableArray new];
+    AWSDynamoDBAttributeValue *identifier = nil;
+    for (; index < self.itemCount && [items count] < limit; index += totalSegments) {
+        identifier = [AWSDynamoDBAttributeValue new];
+        identifier.S = [NSString stringWithFormat:@"%lu", (unsigned long)index];
+        [items addObject:@{@"identifier" : identifier}];
+    }
+    AWSDynamoDBScanOutput *output = [AWSDynamoDBScanOutput new];
+    output.items = items;
+    if (index < self.itemCount) {
+        output.lastEvaluatedKey = @{@"identifier" : identifier};
+    }
+
+    return [[AWSTask taskWithDelay:self.latency] continueWithBlock:^id(AWSTask *task) {
+        @synchronized(self) {
+            self.inFlight--;
+        }
+        return output;
+    }];
+}
+
+@end
+
+@interface AWSDynamoDBObjectMapperScanTests : XCTestCase
+
+@property (nonatomic, strong) AWSDynamoDBObjectMapper *objectMapper;
+@property (nonatomic, strong) AWSDynamoDBObjectMapperScanTestsService *service;
+
+@end
+
+@implementation AWSDynamoDBObjectMapperScanTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [AWSServiceManager defaultServiceManager].defaultServiceConfiguration;
+    [AWSDynamoDBObjectMapper registerDynamoDBObjectMapperWithConfiguration:configuration
+                                                     objectMapperConfiguration:[AWSDynamoDBObjectMapperConfiguration new]
+                                                                        forKey:AWSDynamoDBObjectMapperScanTestsKey];
+    self.objectMapper = [AWSDynamoDBObjectMapper DynamoDBObjectMapperForKey:AWSDynamoDBObjectMapperScanTestsKey];
+    self.service = [[AWSDynamoDBObjectMapperScanTestsService alloc] initWithConfiguration:configuration];
+    self.service.itemCount = AWSDynamoDBObjectMapperScanTestsItemCount;
+    self.service.latency = 2;
+    self.objectMapper.dynamoDB = self.service;
+}
+
+- (void)tearDown {
+    [AWSDynamoDBObjectMapper removeDynamoDBObjectMapperForKey:AWSDynamoDBObjectMapperScanTestsKey];
+    [super tearDown];
+}
+
+- (AWSDynamoDBScanExpression *)expressionWithLimit:(NSUInteger)limit {
+    AWSDynamoDBScanExpression *expression = [AWSDynamoDBScanExpression new];
+    expression.limit = @(limit);
+    return expression;
+}
+
+- (NSSet<NSString *> *)parallelScanWithTotalSegments:(NSUInteger)totalSegments
+                                       configuration:(AWSDynamoDBObjectMapperConfiguration *)configuration {
+    NSMutableSet<NSString *> *identifiers = [NSMutableSet new];
+    __block NSUInteger itemCount = 0;
+    AWSTask *task = [self.objectMapper parallelScan:[AWSDynamoDBObjectMapperScanTestsModel class]
+                                         expression:[self expressionWithLimit:50]
+                                      totalSegments:totalSegments
+                                      configuration:configuration
+                                        pageHandler:^AWSTask *(NSArray<AWSDynamoDBObjectMapperScanTestsModel *> *items, NSUInteger segment) {
+        @synchronized(identifiers) {
+            for (AWSDynamoDBObjectMapperScanTestsModel *item in items) {
+                XCTAssertEqual([item.identifier integerValue] % totalSegments, segment);
+                [identifiers addObject:item.identifier];
+                itemCount++;
+            }
+        }
+        return nil;
+    }];
+    [task waitUntilFinished];
+    XCTAssertNil(task.error);
+    XCTAssertEqual(itemCount, [identifiers count]);
+    return identifiers;
+}
+
+- (void)testParallelScanDeliversEveryItemOnce {
+    NSSet<NSString *> *identifiers = [self parallelScanWithTotalSegments:8 configuration:nil];
+
+    XCTAssertEqual([identifiers count], AWSDynamoDBObjectMapperScanTestsItemCount);
+    for (AWSDynamoDBScanInput *request in self.service.requests) {
+        XCTAssertEqualObjects(request.totalSegments, @8);
+        XCTAssertLessThan([request.segment unsignedIntegerValue], 8);
+        XCTAssertEqualObjects(request.limit, @50);
+    }
+}
+
+- (void)testOneSegmentOmitsSegmentParameters {
+    NSSet<NSString *> *identifiers = [self parallelScanWithTotalSegments:1 configuration:nil];
+
+    XCTAssertEqual([identifiers count], AWSDynamoDBObjectMapperScanTestsItemCount);
+    XCTAssertEqual([self.service.requests count], AWSDynamoDBObjectMapperScanTestsItemCount / 50);
+    XCTAssertNil(self.service.requests.firstObject.segment);
+    XCTAssertNil(self.service.requests.firstObject.totalSegments);
+}
+
+- (void)testScanConcurrencyLimit {
+    AWSDynamoDBObjectMapperConfiguration *configuration = [AWSDynamoDBObjectMapperConfiguration new];
+    configuration.scanConcurrencyLimit = 3;
+
+    NSSet<NSString *> *identifiers = [self parallelScanWithTotalSegments:10 configuration:configuration];
+
+    XCTAssertEqual([identifiers count], AWSDynamoDBObjectMapperScanTestsItemCount);
+    XCTAssertEqual(self.service.maxInFlight, 3);
+}
+
+- (void)testNextPageWaitsForPageHandler {
+    NSObject *lock = [NSObject new];
+    __block NSInteger pagesInHandler = 0;
+    __block NSInteger maxPagesInHandlerAtRequest = 0;
+    self.service.requestObserver = ^(AWSDynamoDBScanInput *request) {
+        @synchronized(lock) {
+            maxPagesInHandlerAtRequest = MAX(maxPagesInHandlerAtRequest, pagesInHandler);
+        }
+    };
+
+    __block NSUInteger pageCount = 0;
+    AWSTask *task = [self.objectMapper parallelScan:[AWSDynamoDBObjectMapperScanTestsModel class]
+                                         expression:[self expressionWithLimit:100]
+                                      totalSegments:1
+                                        pageHandler:^AWSTask *(NSArray *items, NSUInteger segment) {
+        @synchronized(lock) {
+            pagesInHandler++;
+            pageCount++;
+        }
+        return [[AWSTask taskWithDelay:10] continueWithBlock:^id(AWSTask *task) {
+            @synchronized(lock) {
+                pagesInHandler--;
+            }
+            return nil;
+        }];
+    }];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqual(pageCount, 10);
+    XCTAssertEqual(maxPagesInHandlerAtRequest, 0);
+}
+
+- (void)testPageHandlerErrorStopsScan {
+    NSError *handlerError = [NSError errorWithDomain:@"AWSDynamoDBObjectMapperScanTests" code:1 userInfo:nil];
+
+    AWSTask *task = [self.objectMapper parallelScan:[AWSDynamoDBObjectMapperScanTestsModel class]
+                                         expression:[self expressionWithLimit:10]
+                                      totalSegments:4
+                                        pageHandler:^AWSTask *(NSArray *items, NSUInteger segment) {
+        return segment == 2 ? [AWSTask taskWithError:handlerError] : nil;
+    }];
+    [task waitUntilFinished];
+
+    XCTAssertEqualObjects(task.error, handlerError);
+    XCTAssertLessThan([self.service.requests count], AWSDynamoDBObjectMapperScanTestsItemCount / 10);
+}
+
+- (void)testEnumeratePagesLoadsEveryPage {
+    AWSTask<AWSDynamoDBPaginatedOutput *> *scanTask = [self.objectMapper scan:[AWSDynamoDBObjectMapperScanTestsModel class]
+                                                                   expression:[self expressionWithLimit:300]];
+    [scanTask waitUntilFinished];
+
+    NSMutableArray<NSNumber *> *pageSizes = [NSMutableArray new];
+    AWSTask *task = [scanTask.result enumeratePagesUsingBlock:^AWSTask *(NSArray *items) {
+        [pageSizes addObject:@([items count])];
+        return nil;
+    }];
+    [task waitUntilFinished];
+
+    XCTAssertNil(task.error);
+    XCTAssertEqualObjects(pageSizes, (@[@300, @300, @300, @100]));
+    XCTAssertNil(scanTask.result.lastEvaluatedKey);
+}
+
+- (void)testScanExpressionPassesSegment {
+    AWSDynamoDBScanExpression *expression = [self expressionWithLimit:1000];
+    expression.segment = @3;
+    expression.totalSegments = @4;
+
+    AWSTask<AWSDynamoDBPaginatedOutput *> *task = [self.objectMapper scan:[AWSDynamoDBObjectMapperScanTestsModel class]
+                                                               expression:expression];
+    [task waitUntilFinished];
+
+    XCTAssertEqual([task.result.items count], AWSDynamoDBObjectMapperScanTestsItemCount / 4);
+    XCTAssertEqualObjects([task.result.items.firstObject identifier], @"3");
+}
+
+#pragma mark - Benchmarks
+
+// Baseline: the single cursor loadNextPage gives, 20 pages of 50 items with 2 ms per request.
+- (void)testSequentialScanPerformance {
+    [self measureBlock:^{
+        XCTAssertEqual([[self parallelScanWithTotalSegments:1 configuration:nil] count], AWSDynamoDBObjectMapperScanTestsItemCount);
+    }];
+}
+
+- (void)testParallelScanPerformance {
+    [self measureBlock:^{
+        XCTAssertEqual([[self parallelScanWithTotalSegments:8 configuration:nil] count], AWSDynamoDBObjectMapperScanTestsItemCount);
+    }];
+}
+
+@end
@@ -59,6 +59,18 @@ extern NSString *const AWSSRHTTPResponseErrorKey;
 // Optional array of cookies (NSHTTPCookie objects) to apply to the connections
 @property (nonatomic, readwrite) NSArray * requestCookies;
 
+// Number of bytes queued by send: that have not been written to the socket yet.
+@property (atomic, readonly) NSUInteger bufferedAmount;
+
+// When non-zero, hasSpaceAvailable turns NO once bufferedAmount reaches this many
+// bytes, and webSocketHasSpaceAvailable: is sent to the delegate after the backlog
+// drains to half of it. Frames are never dropped; producers are expected to hold
+// off sending while hasSpaceAvailable is NO. Defaults to 0 (unbounded).
+@property (atomic, assign) NSUInteger outputBufferHighWaterMark;
+
+// YES while bufferedAmount is below outputBufferHighWaterMark.
+@property (nonatomic, readonly) BOOL hasSpaceAvailable;
+
 // This returns the negotiated protocol.
 // It will be nil until after the handshake completes.
 @property (nonatomic, readonly, copy) NSString *protocol;
@@ -111,6 +123,9 @@ extern NSString *const AWSSRHTTPResponseErrorKey;
 - (void)webSocket:(AWSSRWebSocket *)webSocket didCloseWithCode:(NSInteger)code reason:(NSString *)reason wasClean:(BOOL)wasClean;
 - (void)webSocket:(AWSSRWebSocket *)webSocket didReceivePong:(NSData *)pongPayload;
 
+// Sent after the output backlog exceeded outputBufferHighWaterMark and has since drained.
+- (void)webSocketHasSpaceAvailable:(AWSSRWebSocket *)webSocket;
+
 @end
 
 #pragma mark - NSURLRequest (AWSSRCertificateAdditions)
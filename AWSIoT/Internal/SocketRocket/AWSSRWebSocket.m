@@ -185,6 +185,7 @@ typedef void (^data_callback)(AWSSRWebSocket *webSocket,  NSData *data);
 @interface AWSSRWebSocket ()  <NSStreamDelegate>
 
 @property (nonatomic) AWSSRReadyState readyState;
+@property (atomic, readwrite) NSUInteger bufferedAmount;
 
 @property (nonatomic) NSOperationQueue *delegateOperationQueue;
 @property (nonatomic) dispatch_queue_t delegateDispatchQueue;
@@ -213,8 +214,12 @@ typedef void (^data_callback)(AWSSRWebSocket *webSocket,  NSData *data);
     NSMutableData *_readBuffer;
     NSUInteger _readBufferOffset;
  
-    NSMutableData *_outputBuffer;
-    NSUInteger _outputBufferOffset;
+    // Frames waiting to be written, in order. Each frame is written straight
+    // from its own buffer; _outputQueueHeadOffset tracks the partial write of
+    // the frame at the head of the queue.
+    NSMutableArray<NSData *> *_outputQueue;
+    NSUInteger _outputQueueHeadOffset;
+    BOOL _outputBufferAboveHighWaterMark;
 
     uint8_t _currentFrameOpcode;
     size_t _currentFrameCount;
@@ -259,6 +264,8 @@ typedef void (^data_callback)(AWSSRWebSocket *webSocket,  NSData *data);
 @synthesize url = _url;
 @synthesize readyState = _readyState;
 @synthesize protocol = _protocol;
+@synthesize bufferedAmount = _bufferedAmount;
+@synthesize outputBufferHighWaterMark = _outputBufferHighWaterMark;
 
 static __strong NSData *CRLFCRLF;
 
@@ -333,7 +340,7 @@ static __strong NSData *CRLFCRLF;
     sr_dispatch_retain(_delegateDispatchQueue);
     
     _readBuffer = [[NSMutableData alloc] init];
-    _outputBuffer = [[NSMutableData alloc] init];
+    _outputQueue = [[NSMutableArray alloc] init];
     
     _currentFrameData = [[NSMutableData alloc] init];
 
@@ -768,6 +775,12 @@ static __strong NSData *CRLFCRLF;
     });
 }
 
+- (BOOL)hasSpaceAvailable;
+{
+    NSUInteger highWaterMark = self.outputBufferHighWaterMark;
+    return highWaterMark == 0 || self.bufferedAmount < highWaterMark;
+}
+
 - (void)_writeData:(NSData *)data;
 {    
     [self assertOnWorkQueue];
@@ -775,7 +788,18 @@ static __strong NSData *CRLFCRLF;
     if (_closeWhenFinishedWriting) {
             return;
     }
-    [_outputBuffer appendData:data];
+    if (data.length == 0) {
+        return;
+    }
+    // Frames are built fresh for every send, so the queue takes ownership of
+    // the buffer instead of copying it into a shared output buffer.
+    [_outputQueue addObject:data];
+    self.bufferedAmount += data.length;
+
+    NSUInteger highWaterMark = self.outputBufferHighWaterMark;
+    if (highWaterMark > 0 && self.bufferedAmount >= highWaterMark) {
+        _outputBufferAboveHighWaterMark = YES;
+    }
     [self _pumpWriting];
 }
 
@@ -1149,24 +1173,40 @@ static const uint8_t SRPayloadLenMask   = 0x7F;
 {
     [self assertOnWorkQueue];
     
-    NSUInteger dataLength = _outputBuffer.length;
-    if (dataLength - _outputBufferOffset > 0 && _outputStream.hasSpaceAvailable) {
-        NSInteger bytesWritten = [_outputStream write:_outputBuffer.bytes + _outputBufferOffset maxLength:dataLength - _outputBufferOffset];
+    while (_outputQueue.count > 0 && _outputStream.hasSpaceAvailable) {
+        NSData *head = _outputQueue.firstObject;
+        NSUInteger remaining = head.length - _outputQueueHeadOffset;
+        NSInteger bytesWritten = [_outputStream write:(const uint8_t *)head.bytes + _outputQueueHeadOffset maxLength:remaining];
         if (bytesWritten == -1) {
             [self _failWithError:[NSError errorWithDomain:AWSSRWebSocketErrorDomain code:2145 userInfo:[NSDictionary dictionaryWithObject:@"Error writing to stream" forKey:NSLocalizedDescriptionKey]]];
              return;
         }
         
-        _outputBufferOffset += bytesWritten;
+        self.bufferedAmount -= bytesWritten;
         
-        if (_outputBufferOffset > 4096 && _outputBufferOffset > (_outputBuffer.length >> 1)) {
-            _outputBuffer = [[NSMutableData alloc] initWithBytes:(char *)_outputBuffer.bytes + _outputBufferOffset length:_outputBuffer.length - _outputBufferOffset];
-            _outputBufferOffset = 0;
+        if ((NSUInteger)bytesWritten < remaining) {
+            // Partial write; the stream will tell us when it has room again.
+            _outputQueueHeadOffset += bytesWritten;
+            break;
         }
+        
+        [_outputQueue removeObjectAtIndex:0];
+        _outputQueueHeadOffset = 0;
+    }
+    
+    // Let producers resume once the backlog has drained to half of the high-water mark.
+    if (_outputBufferAboveHighWaterMark &&
+        self.bufferedAmount <= (self.outputBufferHighWaterMark >> 1)) {
+        _outputBufferAboveHighWaterMark = NO;
+        [self _performDelegateBlock:^{
+            if ([self.delegate respondsToSelector:@selector(webSocketHasSpaceAvailable:)]) {
+                [self.delegate webSocketHasSpaceAvailable:self];
+            }
+        }];
     }
     
     if (_closeWhenFinishedWriting && 
-        _outputBuffer.length - _outputBufferOffset == 0 && 
+        _outputQueue.count == 0 && 
         (_inputStream.streamStatus != NSStreamStatusNotOpen &&
          _inputStream.streamStatus != NSStreamStatusClosed) &&
         !_sentClose) {
@@ -87,12 +87,8 @@ NSString *const AWSKinesisAbstractClientRecorderDatabasePathPrefix = @"com/amazo
 
         // Creates a database for the identifier if it doesn't exist.
         AWSDDLogDebug(@"Database path: [%@]", _databasePath);
-        _databaseQueue = [AWSFMDatabaseQueue serialDatabaseQueueWithPath:_databasePath];
+        _databaseQueue = [AWSFMDatabaseQueue writeAheadLogDatabaseQueueWithPath:_databasePath];
         [_databaseQueue inDatabase:^(AWSFMDatabase *db) {
-            if (![db executeStatements:@"PRAGMA auto_vacuum = FULL"]) {
-                AWSDDLogError(@"Failed to enable 'auto_vacuum' to 'FULL'. %@", db.lastError);
-            }
-
             if (![db executeUpdate:
                   @"CREATE TABLE IF NOT EXISTS record ("
                   @"partition_key TEXT NOT NULL,"
@@ -103,7 +99,7 @@ NSString *const AWSKinesisAbstractClientRecorderDatabasePathPrefix = @"com/amazo
                 AWSDDLogError(@"SQLite error. [%@]", db.lastError);
             }
 
-            if (![db executeUpdate:@"VACUUM"]) {
+            if (![db aws_incrementalVacuum]) {
                 AWSDDLogError(@"SQLite error. [%@]", db.lastError);
             }
         }];
@@ -116,7 +112,7 @@ NSString *const AWSKinesisAbstractClientRecorderDatabasePathPrefix = @"com/amazo
     static dispatch_once_t predicate;
 
     dispatch_once(&predicate, ^{
-        queue = dispatch_queue_create("com.amazonaws.AWSKinesisRecorder", DISPATCH_QUEUE_SERIAL);
+        queue = [AWSExecutor serialQueueWithLabel:@"com.amazonaws.AWSKinesisRecorder" inPoolNamed:AWSExecutorPoolNameBackground];
     });
 
     return queue;
@@ -192,7 +188,7 @@ NSString *const AWSKinesisAbstractClientRecorderDatabasePathPrefix = @"com/amazo
         NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:databasePath
                                                                                     error:&error];
         if (attributes) {
-            NSUInteger fileSize = (NSUInteger)[attributes fileSize];
+            NSUInteger fileSize = (NSUInteger)[AWSFMDatabase aws_diskBytesUsedAtPath:databasePath];
             [self.recorderHelper checkByteThresholdForNotification:notificationByteThreshold
                                                 notificationSender:notificationSender
                                                           fileSize:fileSize];
@@ -213,6 +209,7 @@ NSString *const AWSKinesisAbstractClientRecorderDatabasePathPrefix = @"com/amazo
                         error = db.lastError;
                         return;
                     }
+                    [db aws_incrementalVacuum];
                 }];
 
             }
@@ -321,6 +318,10 @@ NSString *const AWSKinesisAbstractClientRecorderDatabasePathPrefix = @"com/amazo
             }];
         } while (!stop && !error && batchSize > 0);
 
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            [db aws_incrementalVacuum];
+        }];
+
         if (error) {
             return [AWSTask taskWithError:error];
         }
@@ -338,7 +339,9 @@ NSString *const AWSKinesisAbstractClientRecorderDatabasePathPrefix = @"com/amazo
             if (![db executeUpdate:@"DELETE FROM record"]) {
                 AWSDDLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
+                return;
             }
+            [db aws_incrementalVacuum];
         }];
 
         if (error) {
@@ -354,7 +357,7 @@ NSString *const AWSKinesisAbstractClientRecorderDatabasePathPrefix = @"com/amazo
     NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:self.databasePath
                                                                                 error:&error];
     if (attributes) {
-        return (NSUInteger)[attributes fileSize];
+        return (NSUInteger)[AWSFMDatabase aws_diskBytesUsedAtPath:self.databasePath];
     } else {
         AWSDDLogError(@"Error [%@]", error);
         return 0;
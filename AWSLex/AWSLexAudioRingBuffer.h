@@ -0,0 +1,83 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+
+#import <Foundation/Foundation.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ A fixed-size buffer between the audio encoder and the upload stream.
+
+ Encoded audio is appended once and written to the output stream straight from the ring's storage. A separate,
+ bounded window keeps the start of the utterance so that a failed request can be replayed from the beginning. Once the
+ utterance outgrows the window it is released and replay is no longer possible.
+
+ The buffer is not thread safe; callers serialize access.
+ */
+@interface AWSLexAudioRingBuffer : NSObject
+
+/**
+ Number of bytes the ring can hold before they are written to the stream.
+ */
+@property (nonatomic, readonly) NSUInteger capacity;
+
+/**
+ Number of bytes appended but not yet written to the stream.
+ */
+@property (nonatomic, readonly) NSUInteger length;
+
+/**
+ Number of bytes appended since the buffer was created or last reset.
+ */
+@property (nonatomic, readonly) NSUInteger totalLength;
+
+/**
+ YES while the retained window holds every byte appended so far.
+ */
+@property (nonatomic, readonly) BOOL canReplay;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+              retainedWindowSize:(NSUInteger)retainedWindowSize NS_DESIGNATED_INITIALIZER;
+
+/**
+ Appends encoded audio.
+
+ @return NO, without appending anything, if the ring does not have room for `length` bytes.
+ */
+- (BOOL)appendBytes:(const void *)bytes length:(NSUInteger)length;
+
+/**
+ Writes as much of the pending audio as the stream accepts without blocking.
+
+ @return The number of bytes written, or -1 if the stream reported an error.
+ */
+- (NSInteger)writeToStream:(NSOutputStream *)stream;
+
+/**
+ Every byte appended so far, or nil once the utterance has outgrown the retained window.
+ */
+- (nullable NSData *)retainedData;
+
+/**
+ Discards pending and retained audio.
+ */
+- (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
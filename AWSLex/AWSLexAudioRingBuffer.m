@@ -0,0 +1,104 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+
+#import "AWSLexAudioRingBuffer.h"
+
+@implementation AWSLexAudioRingBuffer {
+    uint8_t *_storage;
+    NSUInteger _readIndex;
+    NSUInteger _retainedWindowSize;
+    NSMutableData *_retainedData;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+              retainedWindowSize:(NSUInteger)retainedWindowSize {
+    NSParameterAssert(capacity > 0);
+    if (self = [super init]) {
+        _storage = malloc(capacity);
+        if (!_storage) {
+            return nil;
+        }
+        _capacity = capacity;
+        _retainedWindowSize = retainedWindowSize;
+        [self reset];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_storage);
+}
+
+- (BOOL)appendBytes:(const void *)bytes length:(NSUInteger)length {
+    if (length > _capacity - _length) {
+        return NO;
+    }
+
+    NSUInteger writeIndex = (_readIndex + _length) % _capacity;
+    NSUInteger firstLength = MIN(length, _capacity - writeIndex);
+    memcpy(_storage + writeIndex, bytes, firstLength);
+    memcpy(_storage, (const uint8_t *)bytes + firstLength, length - firstLength);
+    _length += length;
+    _totalLength += length;
+
+    if (_retainedData) {
+        if (_totalLength <= _retainedWindowSize) {
+            [_retainedData appendBytes:bytes length:length];
+        } else {
+            _retainedData = nil;
+        }
+    }
+    return YES;
+}
+
+- (NSInteger)writeToStream:(NSOutputStream *)stream {
+    NSInteger totalWritten = 0;
+    // At most two passes: up to the end of the storage, then the wrapped remainder.
+    while (_length > 0 && [stream hasSpaceAvailable]) {
+        NSUInteger contiguousLength = MIN(_length, _capacity - _readIndex);
+        NSInteger written = [stream write:_storage + _readIndex maxLength:contiguousLength];
+        if (written < 0) {
+            return -1;
+        }
+        if (written == 0) {
+            break;
+        }
+        _readIndex = (_readIndex + written) % _capacity;
+        _length -= written;
+        totalWritten += written;
+        if ((NSUInteger)written < contiguousLength) {
+            break;
+        }
+    }
+    return totalWritten;
+}
+
+- (BOOL)canReplay {
+    return _retainedData != nil;
+}
+
+- (NSData *)retainedData {
+    return [_retainedData copy];
+}
+
+- (void)reset {
+    _readIndex = 0;
+    _length = 0;
+    _totalLength = 0;
+    _retainedData = [NSMutableData dataWithCapacity:MIN(_retainedWindowSize, _capacity)];
+}
+
+@end
@@ -67,7 +67,8 @@ typedef NS_ENUM(NSInteger, AWSLexSpeechEncoding) {
 - (void)interactionKitOnRecordingStart:(AWSLexInteractionKit *)interactionKit;
 
 /*
- * Sent to delegate when the microphone recording ends.
+ * Sent to delegate when the microphone recording ends. The audio stream is empty if the recording was longer than the
+ * audio the interaction kit retains for retries (1 MB).
  */
 - (void)interactionKitOnRecordingEnd:(AWSLexInteractionKit *)interactionKit audioStream:(NSData *)audioStream contentType:(NSString *)contentType;
 
@@ -115,6 +116,8 @@ typedef NS_ENUM(NSInteger, AWSLexSpeechEncoding) {
 
 @end
 
+@class AWSLexAudioPlaybackMetrics;
+
 @protocol AWSLexAudioPlayerDelegate <NSObject>
 
 @optional
@@ -129,6 +132,35 @@ typedef NS_ENUM(NSInteger, AWSLexSpeechEncoding) {
  */
 - (void)interactionKitOnAudioPlaybackFinished:(AWSLexInteractionKit *)interactionKit;
 
+/*
+ * Sent to delegate along with `interactionKitOnAudioPlaybackStarted:`, with the latency of the audio response.
+ */
+- (void)interactionKit:(AWSLexInteractionKit *)interactionKit onAudioPlaybackStartedWithMetrics:(AWSLexAudioPlaybackMetrics *)metrics;
+
+@end
+
+/**
+ Latency of an audio response, measured from the moment the request input was complete: when a text request is sent,
+ or when the end of speech is detected.
+ */
+@interface AWSLexAudioPlaybackMetrics : NSObject
+
+/**
+ Time until the first byte of the audio response was received. For buffered playback, time until the complete
+ response was received.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval timeToFirstByte;
+
+/**
+ Time until playback started.
+ */
+@property (nonatomic, assign, readonly) NSTimeInterval timeToFirstAudio;
+
+/**
+ YES if playback started while the response was still being received.
+ */
+@property (nonatomic, assign, readonly, getter=isStreamed) BOOL streamed;
+
 @end
 
 /*
@@ -567,4 +599,70 @@ typedef NS_ENUM(NSInteger, AWSLexSpeechEncoding) {
 
 @end
 
+
+#pragma mark - AWSLexStreamingAudioPlayer
+
+
+/**
+ Plays an MPEG audio response while it is being received, using an audio queue.
+
+ Playback starts as soon as the first appended chunk holds a complete audio packet. The blocks have the same meaning
+ as on `AWSLexAudioPlayer` and are called on the main queue. If the response cannot be decoded or the audio queue
+ fails before playback starts, the player stops without reporting an error and `finish` returns NO, so that the caller
+ can play the complete response another way. Once playback has started, a failure is reported to the error block.
+
+ The player must be kept alive until its completion or error block is called; releasing it stops playback.
+ */
+@interface AWSLexStreamingAudioPlayer : NSObject
+
+@property (nonatomic, copy, nullable) void (^completionBlock)(void);
+
+@property (nonatomic, copy, nullable) void (^preparedBlock)(void);
+
+/**
+ Called if playback fails after it has started. Part of the response has been heard by then, so it is not played again.
+ */
+@property (nonatomic, copy, nullable) void (^errorBlock)(NSError *error);
+
+/**
+ Number of bytes appended so far.
+ */
+@property (nonatomic, assign, readonly) NSUInteger receivedLength;
+
+/**
+ YES once playback has started.
+ */
+@property (nonatomic, assign, readonly, getter=isStarted) BOOL started;
+
+/**
+ YES if decoding or playback failed. A failed player ignores further data.
+ */
+@property (nonatomic, assign, readonly, getter=isFailed) BOOL failed;
+
+/**
+ YES once `finish` has been called.
+ */
+@property (nonatomic, assign, readonly, getter=isFinished) BOOL finished;
+
+/**
+ Decodes the chunk and enqueues its complete packets for playback. Can be called from any thread, but calls must not
+ overlap.
+ */
+- (void)appendData:(NSData *)data;
+
+/**
+ Signals the end of the response.
+
+ @return YES if the enqueued audio will play out, after which the completion block is called. NO if playback failed or
+ never started; no block is called and the response has to be played by other means.
+ */
+- (BOOL)finish;
+
+/**
+ Stops playback immediately without calling the completion block.
+ */
+- (void)stop;
+
+@end
+
 NS_ASSUME_NONNULL_END
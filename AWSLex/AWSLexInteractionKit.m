@@ -19,7 +19,9 @@
 #import "BFAudioRecorder.h"
 #import "AWSLex.h"
 #import "AWSLexRequestRetryHandler.h"
+#import "AWSLexAudioRingBuffer.h"
 #import <AVFoundation/AVFoundation.h>
+#import <AudioToolbox/AudioToolbox.h>
 
 NSString *const AWSInfoInteractionKit = @"LexInteractionKit";
 NSString *const AWSInteractionKitSDKVersion = @"2.33.7";
@@ -47,6 +49,11 @@ const NSUInteger DefaultInteractionKitStartingPointThreshold = 9;
 const NSUInteger DefaultInteractionKitEndpointThreshold = 80;
 const float      DefaultInteractionKitLrtThreshold = 1.8f;
 
+// Encoded audio waiting for the upload stream. Several seconds of 16 kHz PCM, far more for Opus.
+static const NSUInteger AWSLexInteractionKitAudioRingBufferCapacity = 256 * 1024;
+// Audio kept for replay when a request is retried. Covers a full 15 second utterance of 16 kHz PCM.
+static const NSUInteger AWSLexInteractionKitAudioReplayWindowSize = 1024 * 1024;
+
 typedef NS_ENUM(NSInteger, AWSLexSpeechState) {
     AWSLexSpeechStateUninitialized,
     AWSLexSpeechStateStarted,
@@ -230,8 +237,24 @@ const NSUInteger MaxSpeechTimeoutInterval = 15;
 
 @end
 
+@interface AWSLexAudioPlaybackMetrics()
+
+- (instancetype)initWithTimeToFirstByte:(NSTimeInterval)timeToFirstByte
+                       timeToFirstAudio:(NSTimeInterval)timeToFirstAudio
+                               streamed:(BOOL)streamed;
+
+@end
+
 @implementation AWSLexInteractionKit{
     AWSLexAudioPlayer *audioPlayer;
+    //the streaming playback state and responseWaitStartDate are only touched on playbackQueue
+    dispatch_queue_t playbackQueue;
+    //held until its completion or error block runs, since releasing it stops playback
+    AWSLexStreamingAudioPlayer *streamingAudioPlayer;
+    BOOL hasReceivedAudioResponse;
+    BOOL hasFailedToPrepareAudioSession;
+    //set when the request input is complete, the start of the audio response latency
+    NSDate *responseWaitStartDate;
     NSUInteger numOfBytesSent;
     BOOL isStreaming;
     NSDate *recordingStartDate;
@@ -243,9 +266,11 @@ const NSUInteger MaxSpeechTimeoutInterval = 15;
     // the processed audio to be sent over http
     NSMutableData *consumerAudioBuffer;
     NSInputStream *consumerStream;
-    //the processed audio buffer
-    NSMutableData *producerAudioBuffer;
+    //the processed audio waiting to be written to the producer stream
+    AWSLexAudioRingBuffer *producerAudioBuffer;
     NSOutputStream *producerStream;
+    //the producer stream is closed once the buffered audio has been written
+    BOOL isDrainingProducerStream;
     
     dispatch_queue_t interactionDelegateQueue;
     
@@ -333,6 +358,7 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         retryHandler.delegate = self;
         
         interactionDelegateQueue = dispatch_queue_create("com.amazonaws.lex.InteractionDelegateQueue", DISPATCH_QUEUE_SERIAL);
+        playbackQueue = dispatch_queue_create("com.amazonaws.lex.PlaybackQueue", DISPATCH_QUEUE_SERIAL);
     }
     return self;
 }
@@ -561,11 +587,15 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 - (void)handleEndOfSpeech{
     AWSDDLogVerbose(@"AWSLexSpeechStateEnded",nil);
     speechState = AWSLexSpeechStateEnded;
+    NSData *recordedAudio;
+    @synchronized (self) {
+        recordedAudio = [producerAudioBuffer retainedData] ?: [NSData data];
+    }
     __weak AWSLexInteractionKit *weakSelf = self;
     [self dispatchBlockOnMainQueue:^{
         if(weakSelf.microphoneDelegate && [weakSelf.microphoneDelegate respondsToSelector:@selector(interactionKitOnRecordingEnd:audioStream:contentType:)]) {
             //TODO: need to decode the audio to something thats understandable by the audio player.
-            [weakSelf.microphoneDelegate interactionKitOnRecordingEnd:weakSelf audioStream:[self->producerAudioBuffer copy] contentType:[self->audioSource contentType]];
+            [weakSelf.microphoneDelegate interactionKitOnRecordingEnd:weakSelf audioStream:recordedAudio contentType:[self->audioSource contentType]];
         }
     }];
 }
@@ -573,6 +603,7 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 - (void)closeStreams{
     @synchronized (self) {
         AWSDDLogVerbose(@"closing streams", nil);
+        isDrainingProducerStream = NO;
         [producerStream close];
         [consumerStream close];
     }
@@ -614,7 +645,13 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         consumerStream = cStream;
         producerStream = pStream;
         
-        producerAudioBuffer = [NSMutableData new];
+        if (producerAudioBuffer) {
+            [producerAudioBuffer reset];
+        } else {
+            producerAudioBuffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:AWSLexInteractionKitAudioRingBufferCapacity
+                                                                retainedWindowSize:AWSLexInteractionKitAudioReplayWindowSize];
+        }
+        isDrainingProducerStream = NO;
         consumerAudioBuffer = [NSMutableData new];
         
         producerStream.delegate = self;
@@ -636,29 +673,52 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     if (isListening) {
         AWSDDLogVerbose(@"Stop Listening",nil);
         isListening = NO;
-        [producerStream close];
-        producerStream.delegate = nil;
+        [self setResponseWaitStartDate:[NSDate date]];
+        @synchronized (self) {
+            if (producerAudioBuffer.length > 0 && producerStream.streamStatus == NSStreamStatusOpen) {
+                //closing now would end the upload without the audio still in the buffer
+                isDrainingProducerStream = YES;
+            } else {
+                [self closeProducerStream];
+            }
+        }
         
         [self releaseAudioSource];
     }
 }
 
+- (void)closeProducerStream{
+    isDrainingProducerStream = NO;
+    [producerStream close];
+    producerStream.delegate = nil;
+}
+
 - (void)streamAudio:(NSData *)audio{
-    [producerAudioBuffer appendBytes:audio.bytes length:audio.length];
-    if(producerAudioBuffer.length > numOfBytesSent && [producerStream hasSpaceAvailable]) {
-        NSRange range = NSMakeRange(numOfBytesSent, producerAudioBuffer.length - numOfBytesSent);
-        UInt8 chunkBuffer[range.length];
-        [producerAudioBuffer getBytes:chunkBuffer range:range];
-        NSInteger result = [producerStream write:chunkBuffer maxLength:range.length];
-        AWSDDLogVerbose(@"wrote %ld to producer stream", (long)result);
-        if (result >= 0) {
-            numOfBytesSent += result;
-            //start streaming only after we get an actual audio
-            [self startStreaming];
-        }else{
+    @synchronized (self) {
+        if (![producerAudioBuffer appendBytes:audio.bytes length:audio.length]) {
+            AWSDDLogError(@"Audio buffer is full, the upload is not keeping up with the microphone");
             NSError *audioError = [NSError errorWithDomain:AWSLexInteractionKitErrorDomain code:AWSLexInteractionKitErrorCodeAudioStreaming userInfo:nil];
             [self handleError:audioError];
+            return;
         }
+        [self writeBufferedAudio];
+    }
+}
+
+//Must be called while synchronized on self.
+- (void)writeBufferedAudio{
+    if(producerAudioBuffer.length == 0) {
+        return;
+    }
+    NSInteger result = [producerAudioBuffer writeToStream:producerStream];
+    AWSDDLogVerbose(@"wrote %ld to producer stream", (long)result);
+    if (result >= 0) {
+        numOfBytesSent += result;
+        //start streaming only after we get an actual audio
+        [self startStreaming];
+    }else{
+        NSError *audioError = [NSError errorWithDomain:AWSLexInteractionKitErrorDomain code:AWSLexInteractionKitErrorCodeAudioStreaming userInfo:nil];
+        [self handleError:audioError];
     }
 }
 
@@ -694,6 +754,15 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     AWSDDLogVerbose(@"stream event %lu", (unsigned long)eventCode);
     switch (eventCode)
     {
+        case NSStreamEventHasSpaceAvailable:{
+            @synchronized (self) {
+                [self writeBufferedAudio];
+                if (isDrainingProducerStream && producerAudioBuffer.length == 0) {
+                    [self closeProducerStream];
+                }
+            }
+            break;
+        }
         case NSStreamEventErrorOccurred:{
             NSError *streamError = [NSError errorWithDomain:AWSLexInteractionKitErrorDomain code:AWSLexInteractionKitErrorCodeAudioStreaming userInfo:nil];
             [self handleError:streamError];
@@ -735,6 +804,21 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     
     __weak AWSLexInteractionKit *weakSelf = self;
     
+    //for speech input this is moved to the end of speech in stopListening
+    [self setResponseWaitStartDate:[NSDate date]];
+    dispatch_async(playbackQueue, ^{
+        self->hasReceivedAudioResponse = NO;
+        self->hasFailedToPrepareAudioSession = NO;
+        [self->streamingAudioPlayer stop];
+        self->streamingAudioPlayer = nil;
+    });
+    if (self.interactionKitConfig.autoPlayback && [request.accept isEqualToString:AWSLexAcceptMPEG]) {
+        //start playing while the audio response is still being received
+        [request setDownloadData:^(NSData *data) {
+            [weakSelf streamPlaybackData:data];
+        }];
+    }
+    
     [[requestTask continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
         if(task.error) {
             [self handleError:task.error];
@@ -751,6 +835,10 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         self->postRequest = nil;
         
         if(task.error){
+            dispatch_async(self->playbackQueue, ^{
+                [self->streamingAudioPlayer stop];
+                self->streamingAudioPlayer = nil;
+            });
             [self handleError:task.error];
             return nil;
         }
@@ -758,9 +846,7 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
         __typeof__(self) strongSelf = weakSelf;
         AWSLexPostContentResponse *response = task.result;
         
-        if(response.audioStream) {
-            [strongSelf enqueuePlayback:response.audioStream];
-        }
+        [strongSelf finishPlaybackOfAudioResponse:response.audioStream];
         
         //replace the previous session attribute
         strongSelf.sessionAttributes = response.sessionAttributes;
@@ -891,53 +977,93 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     }
 }
 
-- (void)enqueuePlayback:(NSData *)audioData{
-    if(self.interactionKitConfig.autoPlayback) {
-        NSError *audioPlaybackError;
-        AWSLexAudioSession *session = [AWSLexAudioSession sharedInstance];
-        // It would be little complicated to determine when to stop observing the notification.
-        // To simplify thing, we will start and end observing only during audio is enqueued for now. 
-        [session startObservingAudioSessionRouteChangeNotification];
-        [session setPlayAndRecordCategory:&audioPlaybackError];
-        
-        if(audioPlaybackError) {
-            AWSDDLogError(@"error processing audio , %@", audioPlaybackError);
-            [self handleError:audioPlaybackError];
+- (BOOL)prepareAudioSessionForPlayback{
+    NSError *audioPlaybackError;
+    AWSLexAudioSession *session = [AWSLexAudioSession sharedInstance];
+    // It would be little complicated to determine when to stop observing the notification.
+    // To simplify thing, we will start and end observing only during audio is enqueued for now. 
+    [session startObservingAudioSessionRouteChangeNotification];
+    [session setPlayAndRecordCategory:&audioPlaybackError];
+    
+    if(audioPlaybackError) {
+        AWSDDLogError(@"error processing audio , %@", audioPlaybackError);
+        [self handleError:audioPlaybackError];
+        return NO;
+    }
+    
+    [session overrideOutputAudioPort:&audioPlaybackError];
+    
+    if(audioPlaybackError) {
+        AWSDDLogError(@"error processing audio , %@", audioPlaybackError);
+        [self handleError:audioPlaybackError];
+        return NO;
+    }
+    return YES;
+}
+
+- (void (^)(NSError *))playbackErrorBlock{
+    __typeof__(self) __weak weakSelf = self;
+    return ^(NSError *error) {
+        AWSDDLogError(@"error processing audio , %@", error);
+        [[AWSLexAudioSession sharedInstance] endObservingAudioSessionRouteChangeNotification];
+        [weakSelf handleError:error];
+    };
+}
+
+- (void (^)(void))playbackCompletionBlock{
+    __typeof__(self) __weak weakSelf = self;
+    return ^{
+        [[AWSLexAudioSession sharedInstance] endObservingAudioSessionRouteChangeNotification];
+        if(weakSelf.audioPlayerDelegate
+           && [weakSelf.audioPlayerDelegate respondsToSelector:@selector(interactionKitOnAudioPlaybackFinished:)]) {
+            [weakSelf.audioPlayerDelegate interactionKitOnAudioPlaybackFinished:weakSelf];
+        }
+        if (weakSelf.resumeListening) {
+            [weakSelf setupAndStartListeningForMode:weakSelf.currentState];
+        }
+    };
+}
+
+- (void)setResponseWaitStartDate:(NSDate *)date{
+    dispatch_async(playbackQueue, ^{
+        self->responseWaitStartDate = date;
+    });
+}
+
+//Called on playbackQueue.
+- (void (^)(void))playbackPreparedBlockWithFirstByteDate:(NSDate *)firstByteDate streamed:(BOOL)streamed{
+    __typeof__(self) __weak weakSelf = self;
+    NSDate *startDate = responseWaitStartDate;
+    return ^{
+        if (weakSelf.audioPlayerDelegate &&
+            [weakSelf.audioPlayerDelegate respondsToSelector:@selector(interactionKitOnAudioPlaybackStarted:)]) {
+            [weakSelf.audioPlayerDelegate interactionKitOnAudioPlaybackStarted:weakSelf];
+        }
+        if (!startDate) {
             return;
         }
-        
-        [session overrideOutputAudioPort:&audioPlaybackError];
-        
-        if(audioPlaybackError) {
-            AWSDDLogError(@"error processing audio , %@", audioPlaybackError);
-            [self handleError:audioPlaybackError];
+        AWSLexAudioPlaybackMetrics *metrics = [[AWSLexAudioPlaybackMetrics alloc] initWithTimeToFirstByte:[firstByteDate timeIntervalSinceDate:startDate]
+                                                                                        timeToFirstAudio:-[startDate timeIntervalSinceNow]
+                                                                                                streamed:streamed];
+        AWSDDLogDebug(@"%@", metrics);
+        if (weakSelf.audioPlayerDelegate &&
+            [weakSelf.audioPlayerDelegate respondsToSelector:@selector(interactionKit:onAudioPlaybackStartedWithMetrics:)]) {
+            [weakSelf.audioPlayerDelegate interactionKit:weakSelf onAudioPlaybackStartedWithMetrics:metrics];
+        }
+    };
+}
+
+- (void)enqueuePlayback:(NSData *)audioData{
+    if(self.interactionKitConfig.autoPlayback) {
+        if (![self prepareAudioSessionForPlayback]) {
             return;
         }
         
         // Using AVAudioPlayer wrapper to centralize all the sound related logic.
         audioPlayer = [[AWSLexAudioPlayer alloc] initWithData:audioData];
-        __typeof__(self) __weak weakSelf = self;
-        audioPlayer.errorBlock = ^(NSError *error) {
-            AWSDDLogError(@"error processing audio , %@", error);
-            [[AWSLexAudioSession sharedInstance] endObservingAudioSessionRouteChangeNotification];
-            [weakSelf handleError:error];
-        };
-        audioPlayer.completionBlock = ^{
-            [[AWSLexAudioSession sharedInstance] endObservingAudioSessionRouteChangeNotification];
-            if(weakSelf.audioPlayerDelegate
-               && [weakSelf.audioPlayerDelegate respondsToSelector:@selector(interactionKitOnAudioPlaybackFinished:)]) {
-                [weakSelf.audioPlayerDelegate interactionKitOnAudioPlaybackFinished:weakSelf];
-            }
-            if (weakSelf.resumeListening) {
-                [weakSelf setupAndStartListeningForMode:weakSelf.currentState];
-            }
-        };
-        audioPlayer.preparedBlock = ^{
-            if (weakSelf.audioPlayerDelegate &&
-                [weakSelf.audioPlayerDelegate respondsToSelector:@selector(interactionKitOnAudioPlaybackStarted:)]) {
-                [weakSelf.audioPlayerDelegate interactionKitOnAudioPlaybackStarted:weakSelf];
-            }
-        };
+        audioPlayer.errorBlock = [self playbackErrorBlock];
+        audioPlayer.completionBlock = [self playbackCompletionBlock];
+        audioPlayer.preparedBlock = [self playbackPreparedBlockWithFirstByteDate:[NSDate date] streamed:NO];
         
         [self dispatchBlockOnMainQueue:^{
             [self->audioPlayer start];
@@ -945,13 +1071,95 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     }
 }
 
+//Called with each chunk of an MPEG audio response, on the URL session's delegate queue.
+- (void)streamPlaybackData:(NSData *)audioData{
+    NSDate *receivedDate = [NSDate date];
+    dispatch_async(playbackQueue, ^{
+        if (!self->hasReceivedAudioResponse) {
+            self->hasReceivedAudioResponse = YES;
+            if (![self prepareAudioSessionForPlayback]) {
+                self->hasFailedToPrepareAudioSession = YES;
+                return;
+            }
+            //if the player fails before it starts, the complete response is played by finishPlaybackOfAudioResponse: instead
+            AWSLexStreamingAudioPlayer *player = [AWSLexStreamingAudioPlayer new];
+            __typeof__(self) __weak weakSelf = self;
+            __weak AWSLexStreamingAudioPlayer *weakPlayer = player;
+            void (^completionBlock)(void) = [self playbackCompletionBlock];
+            player.completionBlock = ^{
+                [weakSelf releaseStreamingAudioPlayer:weakPlayer];
+                completionBlock();
+            };
+            void (^errorBlock)(NSError *) = [self playbackErrorBlock];
+            player.errorBlock = ^(NSError *error) {
+                [weakSelf releaseStreamingAudioPlayer:weakPlayer];
+                errorBlock(error);
+            };
+            player.preparedBlock = [self playbackPreparedBlockWithFirstByteDate:receivedDate streamed:YES];
+            self->streamingAudioPlayer = player;
+        }
+        [self->streamingAudioPlayer appendData:audioData];
+    });
+}
+
+//Called once the response is complete. The chunks were dispatched to playbackQueue before it, so they have all been
+//appended when this runs.
+- (void)finishPlaybackOfAudioResponse:(NSData *)audioStream{
+    dispatch_async(playbackQueue, ^{
+        AWSLexStreamingAudioPlayer *player = self->streamingAudioPlayer;
+        if ([player finish]) {
+            //released by its completion or error block
+            return;
+        }
+        self->streamingAudioPlayer = nil;
+        [player stop];
+        //the error has already been reported
+        if (self->hasFailedToPrepareAudioSession) {
+            return;
+        }
+        //part of the response has been heard, so it is not played again; the player's error block reports the failure
+        if (player.isStarted) {
+            return;
+        }
+        if (audioStream) {
+            [self enqueuePlayback:audioStream];
+        }
+    });
+}
+
+//Releases the player once the response is complete. Until then finishPlaybackOfAudioResponse: needs it to decide
+//whether to fall back to buffered playback.
+- (void)releaseStreamingAudioPlayer:(AWSLexStreamingAudioPlayer *)player{
+    dispatch_async(playbackQueue, ^{
+        if (player && self->streamingAudioPlayer == player && player.isFinished) {
+            self->streamingAudioPlayer = nil;
+        }
+    });
+}
+
 #pragma mark - Retry Handler
 
+- (BOOL)canResetInputStream{
+    if (self.currentState == AWSLexInteractionModeSpeech) {
+        @synchronized (self) {
+            return producerAudioBuffer.canReplay;
+        }
+    }
+    return YES;
+}
+
 - (NSInputStream *)resetInputStream{
     //iOS doesn't allow seeking for non file based streams.
     //So resetting the consumer stream to a new input stream.
     if (self.currentState == AWSLexInteractionModeSpeech) {
-        consumerStream = [[NSInputStream alloc] initWithData:producerAudioBuffer];
+        NSData *retainedAudio;
+        @synchronized (self) {
+            retainedAudio = [producerAudioBuffer retainedData];
+        }
+        if (!retainedAudio) {
+            return nil;
+        }
+        consumerStream = [[NSInputStream alloc] initWithData:retainedAudio];
         return consumerStream;
     }else{
         return [[NSInputStream alloc] initWithData:[textInput dataUsingEncoding:NSUTF8StringEncoding]];
@@ -1106,3 +1314,387 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 }
 
 @end
+
+
+#pragma mark - AWSLexAudioPlaybackMetrics
+
+
+@implementation AWSLexAudioPlaybackMetrics
+
+- (instancetype)initWithTimeToFirstByte:(NSTimeInterval)timeToFirstByte
+                       timeToFirstAudio:(NSTimeInterval)timeToFirstAudio
+                               streamed:(BOOL)streamed {
+    if (self = [super init]) {
+        _timeToFirstByte = timeToFirstByte;
+        _timeToFirstAudio = timeToFirstAudio;
+        _streamed = streamed;
+    }
+    return self;
+}
+
+- (NSString *)description {
+    return [NSString stringWithFormat:@"<%@: %p timeToFirstByte: %.3f timeToFirstAudio: %.3f streamed: %@>",
+            NSStringFromClass([self class]), self, self.timeToFirstByte, self.timeToFirstAudio, self.streamed ? @"YES" : @"NO"];
+}
+
+@end
+
+
+#pragma mark - AWSLexStreamingAudioPlayer
+
+
+static const UInt32 AWSLexStreamingAudioPlayerBufferSize = 16 * 1024;
+// An enum rather than a constant so that it can size the packet description array.
+enum { AWSLexStreamingAudioPlayerMaxPacketDescriptions = 512 };
+
+@interface AWSLexStreamingAudioPlayer()
+
+- (void)handleStreamPropertyChange:(AudioFileStreamPropertyID)propertyID;
+- (void)handlePackets:(const void *)bytes
+               length:(UInt32)length
+          packetCount:(UInt32)packetCount
+         descriptions:(AudioStreamPacketDescription *)descriptions;
+- (void)recycleBuffer:(AudioQueueBufferRef)buffer;
+- (void)handleQueueStopped;
+
+@end
+
+static void AWSLexStreamingAudioPlayerPropertyListener(void *clientData,
+                                                       AudioFileStreamID fileStream,
+                                                       AudioFileStreamPropertyID propertyID,
+                                                       AudioFileStreamPropertyFlags *flags) {
+    [(__bridge AWSLexStreamingAudioPlayer *)clientData handleStreamPropertyChange:propertyID];
+}
+
+static void AWSLexStreamingAudioPlayerPacketsProc(void *clientData,
+                                                  UInt32 numberBytes,
+                                                  UInt32 numberPackets,
+                                                  const void *inputData,
+                                                  AudioStreamPacketDescription *packetDescriptions) {
+    [(__bridge AWSLexStreamingAudioPlayer *)clientData handlePackets:inputData
+                                                               length:numberBytes
+                                                          packetCount:numberPackets
+                                                         descriptions:packetDescriptions];
+}
+
+// Audio queue callbacks run on the queue's own thread and must not take the player's lock: stopping or disposing of the
+// queue while holding it waits for them.
+static void AWSLexStreamingAudioPlayerOutputCallback(void *userData, AudioQueueRef audioQueue, AudioQueueBufferRef buffer) {
+    [(__bridge AWSLexStreamingAudioPlayer *)userData recycleBuffer:buffer];
+}
+
+static void AWSLexStreamingAudioPlayerIsRunningListener(void *userData, AudioQueueRef audioQueue, AudioQueuePropertyID propertyID) {
+    UInt32 isRunning = 0;
+    UInt32 size = sizeof(isRunning);
+    if (AudioQueueGetProperty(audioQueue, kAudioQueueProperty_IsRunning, &isRunning, &size) == noErr && !isRunning) {
+        [(__bridge AWSLexStreamingAudioPlayer *)userData handleQueueStopped];
+    }
+}
+
+@implementation AWSLexStreamingAudioPlayer {
+    AudioFileStreamID _fileStream;
+    AudioQueueRef _audioQueue;
+    AudioQueueBufferRef _fillBuffer;
+    AudioStreamPacketDescription _packetDescriptions[AWSLexStreamingAudioPlayerMaxPacketDescriptions];
+    UInt32 _packetCount;
+    NSMutableArray<NSValue *> *_reusableBuffers;
+    BOOL _started;
+    BOOL _finished;
+    BOOL _failed;
+    BOOL _stopped;
+}
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _reusableBuffers = [NSMutableArray new];
+        OSStatus status = AudioFileStreamOpen((__bridge void *)self,
+                                              AWSLexStreamingAudioPlayerPropertyListener,
+                                              AWSLexStreamingAudioPlayerPacketsProc,
+                                              kAudioFileMP3Type,
+                                              &_fileStream);
+        if (status != noErr) {
+            AWSDDLogError(@"Unable to open audio file stream: %d", (int)status);
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_audioQueue) {
+        AudioQueueDispose(_audioQueue, true);
+    }
+    if (_fileStream) {
+        AudioFileStreamClose(_fileStream);
+    }
+}
+
+- (void)appendData:(NSData *)data {
+    @synchronized (self) {
+        if (_failed || _finished || _stopped || data.length == 0) {
+            return;
+        }
+        _receivedLength += data.length;
+        OSStatus status = AudioFileStreamParseBytes(_fileStream, (UInt32)data.length, data.bytes, 0);
+        if (status != noErr) {
+            [self failWithStatus:status];
+            return;
+        }
+        // Enqueue what this chunk completed instead of waiting for a full buffer, so playback starts with the first chunk.
+        [self enqueueFillBuffer];
+    }
+}
+
+- (BOOL)isStarted {
+    @synchronized (self) {
+        return _started;
+    }
+}
+
+- (BOOL)isFailed {
+    @synchronized (self) {
+        return _failed;
+    }
+}
+
+- (BOOL)isFinished {
+    @synchronized (self) {
+        return _finished;
+    }
+}
+
+- (BOOL)finish {
+    @synchronized (self) {
+        if (_finished) {
+            return _started && !_failed && !_stopped;
+        }
+        _finished = YES;
+        if (_failed || _stopped) {
+            return NO;
+        }
+        [self enqueueFillBuffer];
+        if (_failed) {
+            return NO;
+        }
+        if (!_started) {
+            if (_receivedLength > 0) {
+                // Bytes arrived but not one complete packet could be decoded from them.
+                [self failWithStatus:kAudioFileStreamError_InvalidFile];
+            }
+            return NO;
+        }
+        // Plays out what is enqueued, then stops; the running-state listener reports completion.
+        AudioQueueFlush(_audioQueue);
+        AudioQueueStop(_audioQueue, false);
+        return YES;
+    }
+}
+
+- (void)stop {
+    @synchronized (self) {
+        _stopped = YES;
+        if (_audioQueue) {
+            AudioQueueStop(_audioQueue, true);
+        }
+    }
+}
+
+#pragma mark - Decoding
+
+- (void)handleStreamPropertyChange:(AudioFileStreamPropertyID)propertyID {
+    if (propertyID != kAudioFileStreamProperty_ReadyToProducePackets || _audioQueue) {
+        return;
+    }
+
+    AudioStreamBasicDescription format;
+    UInt32 size = sizeof(format);
+    OSStatus status = AudioFileStreamGetProperty(_fileStream, kAudioFileStreamProperty_DataFormat, &size, &format);
+    if (status == noErr) {
+        status = AudioQueueNewOutput(&format,
+                                     AWSLexStreamingAudioPlayerOutputCallback,
+                                     (__bridge void *)self,
+                                     NULL,
+                                     NULL,
+                                     0,
+                                     &_audioQueue);
+    }
+    if (status != noErr) {
+        [self failWithStatus:status];
+        return;
+    }
+
+    UInt32 cookieSize = 0;
+    Boolean writable = false;
+    if (AudioFileStreamGetPropertyInfo(_fileStream, kAudioFileStreamProperty_MagicCookieData, &cookieSize, &writable) == noErr
+        && cookieSize > 0) {
+        void *cookie = malloc(cookieSize);
+        if (cookie && AudioFileStreamGetProperty(_fileStream, kAudioFileStreamProperty_MagicCookieData, &cookieSize, cookie) == noErr) {
+            AudioQueueSetProperty(_audioQueue, kAudioQueueProperty_MagicCookie, cookie, cookieSize);
+        }
+        free(cookie);
+    }
+
+    AudioQueueAddPropertyListener(_audioQueue,
+                                  kAudioQueueProperty_IsRunning,
+                                  AWSLexStreamingAudioPlayerIsRunningListener,
+                                  (__bridge void *)self);
+    AudioQueueSetParameter(_audioQueue, kAudioQueueParam_Volume, 1.0f);
+}
+
+- (void)handlePackets:(const void *)bytes
+               length:(UInt32)length
+          packetCount:(UInt32)packetCount
+         descriptions:(AudioStreamPacketDescription *)descriptions {
+    if (!_audioQueue || _failed) {
+        return;
+    }
+
+    if (!descriptions) {
+        // Constant bit rate: there are no packet boundaries to keep.
+        const uint8_t *cursor = bytes;
+        UInt32 remaining = length;
+        while (remaining > 0) {
+            if (![self ensureFillBuffer]) {
+                return;
+            }
+            UInt32 space = _fillBuffer->mAudioDataBytesCapacity - _fillBuffer->mAudioDataByteSize;
+            if (space == 0) {
+                [self enqueueFillBuffer];
+                continue;
+            }
+            UInt32 copyLength = MIN(space, remaining);
+            memcpy((uint8_t *)_fillBuffer->mAudioData + _fillBuffer->mAudioDataByteSize, cursor, copyLength);
+            _fillBuffer->mAudioDataByteSize += copyLength;
+            cursor += copyLength;
+            remaining -= copyLength;
+        }
+        return;
+    }
+
+    for (UInt32 i = 0; i < packetCount; i++) {
+        AudioStreamPacketDescription description = descriptions[i];
+        UInt32 packetSize = description.mDataByteSize;
+        if (packetSize > AWSLexStreamingAudioPlayerBufferSize) {
+            AWSDDLogWarn(@"Skipping audio packet of %u bytes, larger than the playback buffer", (unsigned int)packetSize);
+            continue;
+        }
+        if (_fillBuffer
+            && (_fillBuffer->mAudioDataBytesCapacity - _fillBuffer->mAudioDataByteSize < packetSize
+                || _packetCount == AWSLexStreamingAudioPlayerMaxPacketDescriptions)) {
+            [self enqueueFillBuffer];
+        }
+        if (![self ensureFillBuffer]) {
+            return;
+        }
+        memcpy((uint8_t *)_fillBuffer->mAudioData + _fillBuffer->mAudioDataByteSize,
+               (const uint8_t *)bytes + description.mStartOffset,
+               packetSize);
+        description.mStartOffset = _fillBuffer->mAudioDataByteSize;
+        _packetDescriptions[_packetCount++] = description;
+        _fillBuffer->mAudioDataByteSize += packetSize;
+    }
+}
+
+#pragma mark - Buffers
+
+- (BOOL)ensureFillBuffer {
+    if (_fillBuffer) {
+        return YES;
+    }
+
+    NSValue *reusableBuffer;
+    @synchronized (_reusableBuffers) {
+        reusableBuffer = [_reusableBuffers lastObject];
+        if (reusableBuffer) {
+            [_reusableBuffers removeLastObject];
+        }
+    }
+    if (reusableBuffer) {
+        _fillBuffer = [reusableBuffer pointerValue];
+    } else {
+        OSStatus status = AudioQueueAllocateBuffer(_audioQueue, AWSLexStreamingAudioPlayerBufferSize, &_fillBuffer);
+        if (status != noErr) {
+            _fillBuffer = NULL;
+            [self failWithStatus:status];
+            return NO;
+        }
+    }
+    _fillBuffer->mAudioDataByteSize = 0;
+    _packetCount = 0;
+    return YES;
+}
+
+- (void)enqueueFillBuffer {
+    if (!_fillBuffer || _fillBuffer->mAudioDataByteSize == 0) {
+        return;
+    }
+
+    OSStatus status = AudioQueueEnqueueBuffer(_audioQueue,
+                                              _fillBuffer,
+                                              _packetCount,
+                                              _packetCount > 0 ? _packetDescriptions : NULL);
+    _fillBuffer = NULL;
+    _packetCount = 0;
+    if (status != noErr) {
+        [self failWithStatus:status];
+        return;
+    }
+
+    if (!_started) {
+        status = AudioQueueStart(_audioQueue, NULL);
+        if (status != noErr) {
+            [self failWithStatus:status];
+            return;
+        }
+        _started = YES;
+        void (^preparedBlock)(void) = self.preparedBlock;
+        if (preparedBlock) {
+            dispatch_async(dispatch_get_main_queue(), preparedBlock);
+        }
+    }
+}
+
+- (void)recycleBuffer:(AudioQueueBufferRef)buffer {
+    @synchronized (_reusableBuffers) {
+        [_reusableBuffers addObject:[NSValue valueWithPointer:buffer]];
+    }
+}
+
+#pragma mark - Completion
+
+- (void)handleQueueStopped {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        BOOL completed;
+        @synchronized (self) {
+            completed = self->_finished && !self->_failed && !self->_stopped;
+        }
+        if (completed && self.completionBlock) {
+            self.completionBlock();
+        }
+    });
+}
+
+- (void)failWithStatus:(OSStatus)status {
+    if (_failed) {
+        return;
+    }
+    _failed = YES;
+    if (_audioQueue) {
+        AudioQueueStop(_audioQueue, true);
+    }
+    NSError *error = [NSError errorWithDomain:NSOSStatusErrorDomain code:status userInfo:nil];
+    if (!_started) {
+        // The owner plays the buffered response instead once `finish` reports the failure.
+        AWSDDLogWarn(@"Streaming audio playback failed before it started: %@", error);
+        return;
+    }
+    AWSDDLogError(@"Streaming audio playback failed: %@", error);
+    void (^errorBlock)(NSError *) = self.errorBlock;
+    if (errorBlock) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            errorBlock(error);
+        });
+    }
+}
+
+@end
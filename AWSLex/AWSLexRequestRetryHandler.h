@@ -20,6 +20,14 @@
 
 - (NSInputStream *)resetInputStream;
 
+@optional
+
+/*
+ * Return NO when the input can no longer be replayed from the beginning, e.g. because the retained audio was
+ * released. The request then fails instead of being retried.
+ */
+- (BOOL)canResetInputStream;
+
 @end
 
 @interface AWSLexRequestRetryHandler : AWSURLRequestRetryHandler
@@ -30,6 +30,10 @@
                                                     error:error];
     
     if(retryType != AWSNetworkingRetryTypeShouldNotRetry && [response.URL.path hasSuffix:@"/content"]) {
+        id<AWSLexRequestRetryHandlerDelegate> delegate = self.delegate;
+        if([delegate respondsToSelector:@selector(canResetInputStream)] && ![delegate canResetInputStream]) {
+            return AWSNetworkingRetryTypeShouldNotRetry;
+        }
         return AWSNetworkingRetryTypeResetStreamAndRetry;
     }
     
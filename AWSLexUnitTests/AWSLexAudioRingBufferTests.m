@@ -0,0 +1,136 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSLexAudioRingBuffer.h"
+
+@interface AWSLexAudioRingBufferTests : XCTestCase
+
+@end
+
+@implementation AWSLexAudioRingBufferTests
+
+- (NSData *)sequentialDataOfLength:(NSUInteger)length offset:(uint8_t)offset {
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    for (NSUInteger i = 0; i < length; i++) {
+        bytes[i] = (uint8_t)(offset + i);
+    }
+    return data;
+}
+
+- (NSData *)drainStream:(NSInputStream *)inputStream {
+    NSMutableData *drained = [NSMutableData new];
+    uint8_t buffer[64];
+    while ([inputStream hasBytesAvailable]) {
+        NSInteger read = [inputStream read:buffer maxLength:sizeof(buffer)];
+        if (read <= 0) {
+            break;
+        }
+        [drained appendBytes:buffer length:read];
+    }
+    return drained;
+}
+
+- (void)testAppendRejectsMoreThanCapacity {
+    AWSLexAudioRingBuffer *ringBuffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:16 retainedWindowSize:64];
+    NSData *data = [self sequentialDataOfLength:12 offset:0];
+
+    XCTAssertTrue([ringBuffer appendBytes:data.bytes length:data.length]);
+    XCTAssertFalse([ringBuffer appendBytes:data.bytes length:data.length]);
+    XCTAssertEqual(ringBuffer.length, 12);
+    XCTAssertEqual(ringBuffer.totalLength, 12);
+}
+
+- (void)testWriteWrapsAroundStorage {
+    AWSLexAudioRingBuffer *ringBuffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:16 retainedWindowSize:64];
+    NSInputStream *inputStream;
+    NSOutputStream *outputStream;
+    [NSStream getBoundStreamsWithBufferSize:64 inputStream:&inputStream outputStream:&outputStream];
+    [inputStream open];
+    [outputStream open];
+
+    NSData *first = [self sequentialDataOfLength:12 offset:0];
+    XCTAssertTrue([ringBuffer appendBytes:first.bytes length:first.length]);
+    XCTAssertEqual([ringBuffer writeToStream:outputStream], 12);
+    XCTAssertEqualObjects([self drainStream:inputStream], first);
+
+    // The read index now sits at 12, so these 10 bytes are stored in two segments.
+    NSData *second = [self sequentialDataOfLength:10 offset:12];
+    XCTAssertTrue([ringBuffer appendBytes:second.bytes length:second.length]);
+    XCTAssertEqual([ringBuffer writeToStream:outputStream], 10);
+    XCTAssertEqual(ringBuffer.length, 0);
+    XCTAssertEqualObjects([self drainStream:inputStream], second);
+
+    [outputStream close];
+    [inputStream close];
+}
+
+- (void)testPartialWriteKeepsRemainder {
+    AWSLexAudioRingBuffer *ringBuffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:64 retainedWindowSize:64];
+    NSInputStream *inputStream;
+    NSOutputStream *outputStream;
+    [NSStream getBoundStreamsWithBufferSize:8 inputStream:&inputStream outputStream:&outputStream];
+    [inputStream open];
+    [outputStream open];
+
+    NSData *data = [self sequentialDataOfLength:20 offset:0];
+    XCTAssertTrue([ringBuffer appendBytes:data.bytes length:data.length]);
+
+    NSMutableData *received = [NSMutableData new];
+    while (ringBuffer.length > 0) {
+        XCTAssertGreaterThanOrEqual([ringBuffer writeToStream:outputStream], 0);
+        [received appendData:[self drainStream:inputStream]];
+    }
+    XCTAssertEqualObjects(received, data);
+
+    [outputStream close];
+    [inputStream close];
+}
+
+- (void)testRetainedWindowIsReleasedOnceExceeded {
+    AWSLexAudioRingBuffer *ringBuffer = [[AWSLexAudioRingBuffer alloc] initWithCapacity:16 retainedWindowSize:24];
+    NSInputStream *inputStream;
+    NSOutputStream *outputStream;
+    [NSStream getBoundStreamsWithBufferSize:64 inputStream:&inputStream outputStream:&outputStream];
+    [inputStream open];
+    [outputStream open];
+
+    NSData *first = [self sequentialDataOfLength:12 offset:0];
+    NSData *second = [self sequentialDataOfLength:12 offset:12];
+    [ringBuffer appendBytes:first.bytes length:first.length];
+    [ringBuffer writeToStream:outputStream];
+    [ringBuffer appendBytes:second.bytes length:second.length];
+
+    NSMutableData *expected = [first mutableCopy];
+    [expected appendData:second];
+    XCTAssertTrue(ringBuffer.canReplay);
+    XCTAssertEqualObjects([ringBuffer retainedData], expected);
+
+    [ringBuffer writeToStream:outputStream];
+    [ringBuffer appendBytes:first.bytes length:1];
+    XCTAssertFalse(ringBuffer.canReplay);
+    XCTAssertNil([ringBuffer retainedData]);
+
+    [ringBuffer reset];
+    XCTAssertTrue(ringBuffer.canReplay);
+    XCTAssertEqual(ringBuffer.length, 0);
+    XCTAssertEqual(ringBuffer.totalLength, 0);
+
+    [outputStream close];
+    [inputStream close];
+}
+
+@end
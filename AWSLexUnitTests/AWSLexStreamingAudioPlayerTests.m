@@ -0,0 +1,239 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "OCMock.h"
+#import "AWSTestUtility.h"
+#import "AWSLexInteractionKit.h"
+
+@interface AWSLexAudioPlaybackMetrics()
+
+- (instancetype)initWithTimeToFirstByte:(NSTimeInterval)timeToFirstByte
+                       timeToFirstAudio:(NSTimeInterval)timeToFirstAudio
+                               streamed:(BOOL)streamed;
+
+@end
+
+@interface AWSLexInteractionKit()
+
+- (BOOL)prepareAudioSessionForPlayback;
+- (void)handleError:(NSError *)error;
+- (void)enqueuePlayback:(NSData *)audioData;
+- (void)streamPlaybackData:(NSData *)audioData;
+- (void)finishPlaybackOfAudioResponse:(NSData *)audioStream;
+
+@end
+
+static NSString *const AWSLexStreamingAudioPlayerTestsKey = @"AWSLexStreamingAudioPlayerTests";
+
+@interface AWSLexStreamingAudioPlayerTests : XCTestCase
+
+@property (nonatomic, strong) AWSLexInteractionKit *interactionKit;
+
+@end
+
+@implementation AWSLexStreamingAudioPlayerTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [AWSServiceManager defaultServiceManager].defaultServiceConfiguration;
+    AWSLexInteractionKitConfig *config = [AWSLexInteractionKitConfig defaultInteractionKitConfigWithBotName:@"bot"
+                                                                                                  botAlias:@"alias"];
+    [AWSLexInteractionKit registerInteractionKitWithServiceConfiguration:configuration
+                                             interactionKitConfiguration:config
+                                                                  forKey:AWSLexStreamingAudioPlayerTestsKey];
+    self.interactionKit = [AWSLexInteractionKit interactionKitForKey:AWSLexStreamingAudioPlayerTestsKey];
+}
+
+- (void)tearDown {
+    self.interactionKit = nil;
+    [AWSLexInteractionKit removeInteractionKitForKey:AWSLexStreamingAudioPlayerTestsKey];
+    [super tearDown];
+}
+
+- (NSData *)undecodableData {
+    NSMutableData *data = [NSMutableData dataWithLength:512];
+    memset(data.mutableBytes, 0x5A, data.length);
+    return data;
+}
+
+// Waits for the blocks already dispatched to the kit's playback queue.
+- (void)drainPlaybackQueue {
+    dispatch_queue_t playbackQueue = [self.interactionKit valueForKey:@"playbackQueue"];
+    dispatch_sync(playbackQueue, ^{});
+}
+
+#pragma mark - AWSLexStreamingAudioPlayer
+
+- (void)testFinishWithoutDataReportsNotStarted {
+    AWSLexStreamingAudioPlayer *player = [AWSLexStreamingAudioPlayer new];
+
+    XCTAssertFalse([player finish]);
+    XCTAssertFalse(player.isStarted);
+    XCTAssertFalse(player.isFailed);
+    XCTAssertFalse([player finish]);
+}
+
+- (void)testFinishWithUndecodableDataReportsFailure {
+    AWSLexStreamingAudioPlayer *player = [AWSLexStreamingAudioPlayer new];
+    __block BOOL completed = NO;
+    player.completionBlock = ^{
+        completed = YES;
+    };
+
+    [player appendData:[self undecodableData]];
+    XCTAssertEqual(player.receivedLength, 512);
+
+    XCTAssertFalse([player finish]);
+    XCTAssertTrue(player.isFailed);
+    XCTAssertFalse(player.isStarted);
+
+    [player appendData:[self undecodableData]];
+    XCTAssertEqual(player.receivedLength, 512);
+    XCTAssertFalse(completed);
+}
+
+#pragma mark - AWSLexAudioPlaybackMetrics
+
+- (void)testPlaybackMetrics {
+    AWSLexAudioPlaybackMetrics *metrics = [[AWSLexAudioPlaybackMetrics alloc] initWithTimeToFirstByte:0.25
+                                                                                    timeToFirstAudio:0.5
+                                                                                            streamed:YES];
+    XCTAssertEqualWithAccuracy(metrics.timeToFirstByte, 0.25, 0.0001);
+    XCTAssertEqualWithAccuracy(metrics.timeToFirstAudio, 0.5, 0.0001);
+    XCTAssertTrue(metrics.isStreamed);
+    XCTAssertTrue([metrics.description containsString:@"timeToFirstByte: 0.250"]);
+    XCTAssertTrue([metrics.description containsString:@"timeToFirstAudio: 0.500"]);
+    XCTAssertTrue([metrics.description containsString:@"streamed: YES"]);
+
+    metrics = [[AWSLexAudioPlaybackMetrics alloc] initWithTimeToFirstByte:1 timeToFirstAudio:1 streamed:NO];
+    XCTAssertFalse(metrics.isStreamed);
+    XCTAssertTrue([metrics.description containsString:@"streamed: NO"]);
+}
+
+#pragma mark - Streaming or buffered playback
+
+- (void)testResponseIsPlayedBufferedWhenNothingWasStreamed {
+    id kitMock = OCMPartialMock(self.interactionKit);
+    NSData *audioStream = [self undecodableData];
+    OCMExpect([kitMock enqueuePlayback:audioStream]);
+
+    [self.interactionKit finishPlaybackOfAudioResponse:audioStream];
+
+    OCMVerifyAllWithDelay(kitMock, 2.0);
+    [kitMock stopMocking];
+}
+
+- (void)testResponseIsPlayedBufferedWhenStreamingFails {
+    id kitMock = OCMPartialMock(self.interactionKit);
+    OCMStub([kitMock prepareAudioSessionForPlayback]).andReturn(YES);
+    NSData *audioStream = [self undecodableData];
+    OCMExpect([kitMock enqueuePlayback:audioStream]);
+
+    [self.interactionKit streamPlaybackData:audioStream];
+    [self.interactionKit finishPlaybackOfAudioResponse:audioStream];
+
+    OCMVerifyAllWithDelay(kitMock, 2.0);
+    [kitMock stopMocking];
+}
+
+- (void)testResponseIsNotPlayedAgainWhenStreamingPlaysItOut {
+    id kitMock = OCMPartialMock(self.interactionKit);
+    OCMReject([kitMock enqueuePlayback:[OCMArg any]]);
+    id playerMock = OCMClassMock([AWSLexStreamingAudioPlayer class]);
+    OCMStub([playerMock finish]).andReturn(YES);
+    [self.interactionKit setValue:playerMock forKey:@"streamingAudioPlayer"];
+
+    [self.interactionKit finishPlaybackOfAudioResponse:[self undecodableData]];
+    [self drainPlaybackQueue];
+
+    OCMVerify([playerMock finish]);
+    OCMVerifyAll(kitMock);
+    // Releasing the player would stop the audio that is still queued.
+    XCTAssertEqual([self.interactionKit valueForKey:@"streamingAudioPlayer"], playerMock);
+    [kitMock stopMocking];
+}
+
+- (void)testResponseIsNotPlayedAgainWhenStreamingFailsMidStream {
+    id kitMock = OCMPartialMock(self.interactionKit);
+    OCMReject([kitMock enqueuePlayback:[OCMArg any]]);
+    id playerMock = OCMClassMock([AWSLexStreamingAudioPlayer class]);
+    OCMStub([playerMock finish]).andReturn(NO);
+    OCMStub([playerMock isStarted]).andReturn(YES);
+    [self.interactionKit setValue:playerMock forKey:@"streamingAudioPlayer"];
+
+    [self.interactionKit finishPlaybackOfAudioResponse:[self undecodableData]];
+    [self drainPlaybackQueue];
+
+    OCMVerify([playerMock stop]);
+    OCMVerifyAll(kitMock);
+    XCTAssertNil([self.interactionKit valueForKey:@"streamingAudioPlayer"]);
+    [kitMock stopMocking];
+}
+
+- (void)testPlaybackFailureAfterStartIsReported {
+    id kitMock = OCMPartialMock(self.interactionKit);
+    OCMStub([kitMock prepareAudioSessionForPlayback]).andReturn(YES);
+    NSError *error = [NSError errorWithDomain:NSOSStatusErrorDomain code:-50 userInfo:nil];
+    OCMExpect([kitMock handleError:error]);
+
+    [self.interactionKit streamPlaybackData:[self undecodableData]];
+    [self drainPlaybackQueue];
+    AWSLexStreamingAudioPlayer *player = [self.interactionKit valueForKey:@"streamingAudioPlayer"];
+    XCTAssertNotNil(player.errorBlock);
+    player.errorBlock(error);
+
+    OCMVerifyAllWithDelay(kitMock, 2.0);
+    [kitMock stopMocking];
+}
+
+- (void)testPlayerIsReleasedWhenPlaybackCompletes {
+    id kitMock = OCMPartialMock(self.interactionKit);
+    OCMStub([kitMock prepareAudioSessionForPlayback]).andReturn(YES);
+
+    [self.interactionKit streamPlaybackData:[self undecodableData]];
+    [self drainPlaybackQueue];
+    AWSLexStreamingAudioPlayer *player = [self.interactionKit valueForKey:@"streamingAudioPlayer"];
+    XCTAssertNotNil(player);
+
+    // Completion before the response is complete keeps the player for finishPlaybackOfAudioResponse:.
+    player.completionBlock();
+    [self drainPlaybackQueue];
+    XCTAssertEqual([self.interactionKit valueForKey:@"streamingAudioPlayer"], player);
+
+    [player finish];
+    player.completionBlock();
+    [self drainPlaybackQueue];
+    XCTAssertNil([self.interactionKit valueForKey:@"streamingAudioPlayer"]);
+    [kitMock stopMocking];
+}
+
+- (void)testResponseIsNotPlayedWhenAudioSessionCannotBePrepared {
+    id kitMock = OCMPartialMock(self.interactionKit);
+    OCMStub([kitMock prepareAudioSessionForPlayback]).andReturn(NO);
+    OCMReject([kitMock enqueuePlayback:[OCMArg any]]);
+    NSData *audioStream = [self undecodableData];
+
+    [self.interactionKit streamPlaybackData:audioStream];
+    [self.interactionKit finishPlaybackOfAudioResponse:audioStream];
+    [self drainPlaybackQueue];
+
+    OCMVerifyAll(kitMock);
+    [kitMock stopMocking];
+}
+
+@end
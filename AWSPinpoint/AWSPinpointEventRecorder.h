@@ -78,6 +78,11 @@ FOUNDATION_EXPORT NSString *const AWSPinpointEventByteThresholdReachedNotificati
  */
 @property (nonatomic, assign) NSUInteger batchRecordsByteLimit;
 
+/**
+ The maximum number of batches `submitAllEvents` keeps in flight at once. While they are in flight the next batch is read from disk, so a large backlog drains without waiting on the database between requests. The default value is 2. The maximum is 8.
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentBatchSubmissions;
+
 /**
  Saves an event to local storage to be sent later.
  
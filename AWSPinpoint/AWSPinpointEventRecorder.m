@@ -33,6 +33,8 @@ NSUInteger const AWSPinpointClientByteLimitDefault = 5 * 1024 * 1024; // 5MB
 NSTimeInterval const AWSPinpointClientAgeLimitDefault = 0.0; // Keeps the data indefinitely unless it hits the size limit.
 NSUInteger const AWSPinpointClientBatchRecordByteLimitDefault = 512 * 1024; // 0.5MB
 NSUInteger const AWSPinpointClientBatchRecordByteLimitMax = 4 * 1024 * 1024; // 4MB
+NSUInteger const AWSPinpointClientConcurrentBatchSubmissionsDefault = 2;
+NSUInteger const AWSPinpointClientConcurrentBatchSubmissionsMax = 8;
 NSString *const AWSPinpointClientRecorderDatabasePathPrefix = @"com/amazonaws/AWSPinpointRecorder";
 NSUInteger const AWSPinpointClientValidEvent = 0;
 NSUInteger const AWSPinpointClientInvalidEvent = 1;
@@ -43,6 +45,12 @@ NSUInteger const AWSPinpointClientInvalidEvent = 1;
  */
 NSUInteger const AWSPinpointServiceDefinedMaxEventsPerBatch = 100;
 
+/**
+ * Archiving overhead of one event record in a batch, on top of the bytes of its columns. Used to size a batch against
+ * `batchRecordsByteLimit` one row at a time instead of archiving the batch after every row.
+ */
+NSUInteger const AWSPinpointClientBatchRecordOverheadBytes = 64;
+
 // Constants
 NSString *const AWSPinpointEventByteThresholdReachedNotification = @"com.amazonaws.AWSPinpointEventByteThresholdReachedNotification";
 NSString *const AWSPinpointEventByteThresholdReachedNotificationDiskBytesUsedKey = @"diskBytesUsed";
@@ -57,6 +65,26 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
 @property (nonatomic, strong) NSString *databasePath;
 @property (nonatomic, strong) NSObject *lock;
 
+- (void) getBatchRecordsExcludingEventIds:(NSSet<NSString *> *)excludedEventIds
+                                   result:(void (^)(NSDictionary *eventsWithEventId, NSError *error))result;
+- (AWSTask<NSDictionary <NSString *, NSDictionary *> *> *)submitBatchEvents:(NSDictionary*) eventsWithEventId
+                                                            endpointProfile:(AWSPinpointEndpointProfile *) endpointProfile;
+
+@end
+
+/**
+ Drains the Event table for one `submitAllEvents` call. Up to `maxConcurrentBatches` PutEvents requests are kept in
+ flight, and the next batch is read while they are outstanding. Events of a batch in flight are left out of the
+ batches read after it.
+ */
+@interface AWSPinpointEventBatchSubmitter : NSObject
+
+- (instancetype)initWithEventRecorder:(AWSPinpointEventRecorder *)eventRecorder
+                      endpointProfile:(AWSPinpointEndpointProfile *)endpointProfile
+                 maxConcurrentBatches:(NSUInteger)maxConcurrentBatches;
+
+- (AWSTask<NSArray<AWSPinpointEvent *> *> *)submit;
+
 @end
 
 @interface AWSPinpointSession()
@@ -99,6 +127,7 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
         _diskByteLimit = AWSPinpointClientByteLimitDefault;
         _diskAgeLimit = AWSPinpointClientAgeLimitDefault;
         _batchRecordsByteLimit = AWSPinpointClientBatchRecordByteLimitDefault;
+        _maxConcurrentBatchSubmissions = AWSPinpointClientConcurrentBatchSubmissionsDefault;
         
         // Creates a directory for storing databases if it doesn't exist.
         BOOL fileExistsAtPath = [[NSFileManager defaultManager] fileExistsAtPath:databaseDirectoryPath];
@@ -115,12 +144,9 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
         
         // Creates a database for the identifier if it doesn't exist.
         AWSDDLogDebug(@"Database path: [%@]", _databasePath);
-        _databaseQueue = [AWSFMDatabaseQueue serialDatabaseQueueWithPath:_databasePath];
+        _databaseQueue = [AWSFMDatabaseReadWriteQueue readWriteQueueWithPath:_databasePath];
         [_databaseQueue inDatabase:^(AWSFMDatabase *db) {
             db.shouldCacheStatements = YES;
-            if (![db executeStatements:@"PRAGMA auto_vacuum = FULL"]) {
-                AWSDDLogError(@"Failed to enable 'auto_vacuum' to 'FULL'. %@", db.lastError);
-            }
             
             //Event Table
             if (![db executeUpdate:
@@ -169,7 +195,7 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
     static dispatch_once_t predicate;
     
     dispatch_once(&predicate, ^{
-        queue = dispatch_queue_create("com.amazonaws.AWSPinpointEventRecorder", DISPATCH_QUEUE_SERIAL);
+        queue = [AWSExecutor serialQueueWithLabel:@"com.amazonaws.AWSPinpointEventRecorder" inPoolNamed:AWSExecutorPoolNameBackground];
     });
     
     return queue;
@@ -314,7 +340,7 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
         NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:databasePath
                                                                                     error:&error];
         if (attributes) {
-            NSUInteger fileSize = (NSUInteger)[attributes fileSize];
+            NSUInteger fileSize = (NSUInteger)[AWSFMDatabase aws_diskBytesUsedAtPath:databasePath];
             [self checkByteThresholdForNotification:notificationByteThreshold
                                  notificationSender:notificationSender
                                            fileSize:fileSize];
@@ -324,7 +350,9 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                     if (![db executeUpdate:@"DELETE FROM DirtyEvent"]) {
                         AWSDDLogError(@"SQLite error. [%@]", db.lastError);
                         error = db.lastError;
+                        return;
                     }
+                    [db aws_incrementalVacuum];
                 }];
                 
                 if (error) {
@@ -349,6 +377,7 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                             error = db.lastError;
                             return;
                         }
+                        [db aws_incrementalVacuum];
                     }];
                 }
             }
@@ -413,7 +442,7 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
         __block NSError *error = nil;
         __block AWSPinpointEvent *event;
         
-        [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        [databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
             AWSFMResultSet *rs = [db executeQuery:
                                   @"SELECT id, attributes, eventType, metrics, eventTimestamp, sessionId, sessionStartTime, sessionStopTime, timestamp, retryCount "
                                   @"FROM Event "
@@ -423,9 +452,8 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                                                     @"sessionId": sessionId
                                                     }];
             if (!rs) {
-                AWSDDLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
+                AWSDDLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
-                *rollback = YES;
                 return;
             }
             
@@ -435,7 +463,6 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                                                                                                         error:&error];
                 if (error) {
                     AWSDDLogError(@"Error restoring attributes from DB: %@", error);
-                    *rollback = YES;
                     return;
                 }
 
@@ -444,7 +471,6 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                                                                                                      error:&error];
                 if (error) {
                     AWSDDLogError(@"Error restoring metrics from DB: %@", error);
-                    *rollback = YES;
                     return;
                 }
 
@@ -478,16 +504,15 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
         __block NSError *error = nil;
         __block NSMutableArray *events = [NSMutableArray new];
         
-        [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        [databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
             AWSFMResultSet *rs = [db executeQuery:[NSString stringWithFormat:
                                                    @"SELECT id, attributes, eventType, metrics, eventTimestamp, sessionId, sessionStartTime, sessionStopTime, timestamp, retryCount "
                                                    @"FROM Event "
                                                    @"ORDER BY timestamp ASC "
                                                    @"LIMIT %@", limit]];
             if (!rs) {
-                AWSDDLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
+                AWSDDLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
-                *rollback = YES;
                 return;
             }
 
@@ -497,7 +522,6 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                                                                                                         error:&error];
                 if (error) {
                     AWSDDLogError(@"Error restoring event attributes from DB: %@", error);
-                    *rollback = YES;
                     return;
                 }
 
@@ -506,7 +530,6 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                                                                                                      error:&error];
                 if (error) {
                     AWSDDLogError(@"Error restoring event metrics from DB: %@", error);
-                    *rollback = YES;
                     return;
                 }
 
@@ -541,16 +564,15 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
         __block NSError *error = nil;
         __block NSMutableArray *events = [NSMutableArray new];
         
-        [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        [databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
             AWSFMResultSet *rs = [db executeQuery:[NSString stringWithFormat:
                                                    @"SELECT id, attributes, eventType, metrics, eventTimestamp, sessionId, sessionStartTime, sessionStopTime, timestamp, retryCount "
                                                    @"FROM DirtyEvent "
                                                    @"ORDER BY timestamp ASC "
                                                    @"LIMIT %@", limit]];
             if (!rs) {
-                AWSDDLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
+                AWSDDLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
-                *rollback = YES;
                 return;
             }
             
@@ -560,7 +582,6 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                                                                                                         error:&error];
                 if (error) {
                     AWSDDLogError(@"Error restoring dirty event attributes from DB: %@", error);
-                    *rollback = YES;
                     return;
                 }
 
@@ -569,7 +590,6 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                                                                                                      error:&error];
                 if (error) {
                     AWSDDLogError(@"Error restoring dirty event metrics from DB: %@", error);
-                    *rollback = YES;
                     return;
                 }
 
@@ -602,28 +622,17 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                                                           userInfo:@{NSLocalizedDescriptionKey: @"Event submission is in progress."}]];
         }
 
-        __block NSMutableArray *result = [NSMutableArray new];
-        
         self.submissionInProgress = YES;
-        dispatch_group_t serviceGroup = dispatch_group_create();
-        dispatch_group_enter(serviceGroup);
-        return [[self currentEndpointProfile] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSPinpointEndpointProfile *> * _Nonnull task) {
-            __block AWSTask *returnTask;
-            [self getBatchRecords:^(NSDictionary *eventsWithEventId, NSError *error) {
-                __block NSError *_error = [error copy];
-                __block NSDictionary *_eventsWithEventId = [eventsWithEventId copy];
-                returnTask = [[self submitEvents:&result eventsWithEventId:_eventsWithEventId endpointProfile:task.result error:_error]
-                              continueWithBlock:^id _Nullable(AWSTask<NSArray<AWSPinpointEvent *> *> * _Nonnull t) {
-                                  dispatch_group_leave(serviceGroup);
-                                  return t;
-                              }];
-            }];
-            
-            dispatch_group_notify(serviceGroup,dispatch_get_main_queue(),^{
+        return [[[self currentEndpointProfile] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSPinpointEndpointProfile *> * _Nonnull task) {
+            AWSPinpointEventBatchSubmitter *submitter = [[AWSPinpointEventBatchSubmitter alloc] initWithEventRecorder:self
+                                                                                                      endpointProfile:task.result
+                                                                                                 maxConcurrentBatches:self.maxConcurrentBatchSubmissions];
+            return [submitter submit];
+        }] continueWithBlock:^id _Nullable(AWSTask<NSArray<AWSPinpointEvent *> *> * _Nonnull task) {
+            dispatch_async(dispatch_get_main_queue(), ^{
                 self.submissionInProgress = NO;
             });
-
-            return returnTask;
+            return task;
         }];
     }
 }
@@ -636,102 +645,51 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
     return tcs.task;
  }
 
-- (AWSTask<NSArray<AWSPinpointEvent *> *> *)submitEvents:(NSMutableArray**) resultEvents
-                                       eventsWithEventId:(NSDictionary *)eventsWithEventId
-                                         endpointProfile:(AWSPinpointEndpointProfile *) endpointProfile
-                                                   error:(NSError *)error {
-    __block AWSTask *returnTask;
-    __block NSMutableArray *result = *resultEvents;
-    __block NSDictionary *_eventsWithEventId = [eventsWithEventId copy];
-    __block NSError *_error = [error copy];
-    
-    AWSDDLogVerbose(@"Submitting Batch with %lu events ", (unsigned long)[eventsWithEventId count]);
-    
-    if (_error) {
-        returnTask = [AWSTask taskWithError:_error];
-    } else if ([_eventsWithEventId count] < 1) {
-        AWSDDLogWarn(@"No events to submit.");
-        _error = [NSError errorWithDomain:AWSPinpointAnalyticsErrorDomain
-                                     code:AWSPinpointAnalyticsErrorUnknown
-                                 userInfo:@{NSLocalizedDescriptionKey: @"No events to submit."}];
-        returnTask = [AWSTask taskWithError:_error];
-    } else {
-        returnTask = [[self submitBatchEvents:_eventsWithEventId
-                              endpointProfile:endpointProfile] continueWithBlock:^id _Nullable(AWSTask<NSDictionary <NSString *, NSDictionary *> *> * _Nonnull t) {
-            __block AWSTask *nextTask;
-            
-            if (t.error) {
-                nextTask = [AWSTask taskWithError:t.error];
-            } else {
-                for (NSDictionary* object in [t.result allValues]) {
-                    if ([[object objectForKey:@"statusCode"] intValue] == 202) {
-                        //Aggregate results
-                        [result addObject:[object objectForKey:@"event"]];
-                    }
-                }
-
-                [self getBatchRecords:^(NSDictionary *eventsWithEventId, NSError *error) {
-                    __block NSError *__error = error;
-                    __block NSDictionary *__eventsWithEventId = eventsWithEventId;
-                    if (__error) {
-                        nextTask = [AWSTask taskWithError:t.error];
-                    } else if ([eventsWithEventId count] > 0) {
-                        nextTask = [self submitEvents:&result eventsWithEventId:__eventsWithEventId endpointProfile:endpointProfile error:__error];
-                    } else {
-                        nextTask = [AWSTask taskWithResult:result];
-                    }
-                }];
-            }
-            return nextTask;
-        }];
-    }
-    
-    return returnTask;
+- (void) getBatchRecords:(void (^)(NSDictionary *eventsWithEventId, NSError *error))result {
+    [self getBatchRecordsExcludingEventIds:nil result:result];
 }
 
-- (void) getBatchRecords:(void (^)(NSDictionary *eventsWithEventId, NSError *error))result {
+- (void) getBatchRecordsExcludingEventIds:(NSSet<NSString *> *)excludedEventIds
+                                   result:(void (^)(NSDictionary *eventsWithEventId, NSError *error))result {
     AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
     __block NSError *error = nil;
     
-    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+    [databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
+        // Excluded events are skipped as they are read, so the limit makes room for all of them.
         AWSFMResultSet *rs = [db executeQuery:[NSString stringWithFormat:
                                                @"SELECT id, attributes, eventType, metrics, eventTimestamp, sessionId, sessionStartTime, sessionStopTime, timestamp, retryCount "
                                                @"FROM Event "
                                                @"WHERE dirty = %@ "
                                                @"ORDER BY timestamp ASC "
                                                @"LIMIT %@",
-                                               [NSNumber numberWithInteger:AWSPinpointClientValidEvent], [NSNumber numberWithInteger:AWSPinpointServiceDefinedMaxEventsPerBatch]]];
+                                               [NSNumber numberWithInteger:AWSPinpointClientValidEvent], [NSNumber numberWithUnsignedInteger:AWSPinpointServiceDefinedMaxEventsPerBatch + [excludedEventIds count]]]];
         if (!rs) {
-            AWSDDLogError(@"SQLite error. Rolling back... [%@]", db.lastError);
+            AWSDDLogError(@"SQLite error. [%@]", db.lastError);
             error = db.lastError;
-            *rollback = YES;
             return;
         }
         
         NSMutableDictionary *temporaryEventsWithEventId = [NSMutableDictionary new];
-        while ([rs next]) {
-            [temporaryEventsWithEventId setObject:@{
-                                         @"id": [rs stringForColumn:@"id"],
-                                         @"attributes": [rs dataForColumn:@"attributes"],
-                                         @"eventType": [rs stringForColumn:@"eventType"],
-                                         @"metrics": [rs dataForColumn:@"metrics"],
-                                         @"eventTimestamp": [rs stringForColumn:@"eventTimestamp"],
-                                         @"sessionId": [rs stringForColumn:@"sessionId"],
-                                         @"sessionStartTime": [rs stringForColumn:@"sessionStartTime"],
-                                         @"sessionStopTime": [rs stringForColumn:@"sessionStopTime"]
-                                         } forKey:[rs stringForColumn:@"id"]];
-
-            NSError *codingError;
-            NSData *batchData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:temporaryEventsWithEventId
-                                                                      requiringSecureCoding:YES
-                                                                                      error:&codingError];
-            if (codingError) {
-                AWSDDLogError(@"Error getting size of batchData: %@", codingError);
-                error = codingError;
-                break;
+        NSUInteger batchDataSize = 0;
+        while ([rs next] && [temporaryEventsWithEventId count] < AWSPinpointServiceDefinedMaxEventsPerBatch) {
+            NSString *eventId = [rs stringForColumn:@"id"];
+            if ([excludedEventIds containsObject:eventId]) {
+                continue;
             }
-
-            if ([batchData length] > self.batchRecordsByteLimit) {
+            NSDictionary *record = @{
+                                     @"id": eventId,
+                                     @"attributes": [rs dataForColumn:@"attributes"],
+                                     @"eventType": [rs stringForColumn:@"eventType"],
+                                     @"metrics": [rs dataForColumn:@"metrics"],
+                                     @"eventTimestamp": [rs stringForColumn:@"eventTimestamp"],
+                                     @"sessionId": [rs stringForColumn:@"sessionId"],
+                                     @"sessionStartTime": [rs stringForColumn:@"sessionStartTime"],
+                                     @"sessionStopTime": [rs stringForColumn:@"sessionStopTime"]
+                                     };
+            [temporaryEventsWithEventId setObject:record forKey:record[@"id"]];
+            batchDataSize += [AWSPinpointEventRecorder byteSizeOfBatchRecord:record];
+
+            if (batchDataSize > self.batchRecordsByteLimit) {
                 // if the batch size exceeds `batchRecordsByteLimit`, stop there.
                 break;
             }
@@ -742,6 +700,18 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
     }];
 }
 
++ (NSUInteger)byteSizeOfBatchRecord:(NSDictionary *)record {
+    __block NSUInteger byteSize = AWSPinpointClientBatchRecordOverheadBytes;
+    [record enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+        if ([value isKindOfClass:[NSData class]]) {
+            byteSize += [value length];
+        } else {
+            byteSize += [value lengthOfBytesUsingEncoding:NSUTF8StringEncoding];
+        }
+    }];
+    return byteSize;
+}
+
 - (AWSTask<NSDictionary <NSString *, NSDictionary *> *> *)submitBatchEvents:(NSDictionary*) eventsWithEventId
                                                             endpointProfile:(AWSPinpointEndpointProfile *) endpointProfile {
     AWSFMDatabaseQueue *databaseQueue = self.databaseQueue;
@@ -764,51 +734,32 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                                }];
         
         return [[AWSTask taskForCompletionOfAllTasksWithResults:@[submitTask]] continueWithBlock:^id _Nullable(AWSTask * _Nonnull t) {
-            AWSTask *failTask = [AWSTask taskFromExecutor:[AWSExecutor executorWithDispatchQueue:[AWSPinpointEventRecorder sharedQueue]] withBlock:^id _Nonnull{
-                // If an event failed three times, mark even as dirty
+            AWSTask *dirtyTask = [AWSTask taskFromExecutor:[AWSExecutor executorWithDispatchQueue:[AWSPinpointEventRecorder sharedQueue]] withBlock:^id _Nonnull{
+                // Marks events that failed more than three times dirty, then moves all dirty events into the DirtyEvent
+                // table. One transaction, so batches completing at the same time cannot move an event twice.
                 [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+                    NSNumber *invalidEvent = [NSNumber numberWithInteger:AWSPinpointClientInvalidEvent];
                     BOOL result = [db executeUpdate:[NSString stringWithFormat:
                                                      @"UPDATE Event "
                                                      @"SET dirty = %@ "
-                                                     @"WHERE retryCount > 3", [NSNumber numberWithInteger:AWSPinpointClientInvalidEvent]]];
-                    if (!result) {
-                        AWSDDLogError(@"SQLite error. [%@]", db.lastError);
-                        error = db.lastError;
-                    }
-                }];
-                return [AWSTask taskWithResult:nil];
-            }];
-            
-            AWSTask *moveTask = [AWSTask taskFromExecutor:[AWSExecutor executorWithDispatchQueue:[AWSPinpointEventRecorder sharedQueue]] withBlock:^id _Nonnull{
-                //Move dirty events into DirtyEvent table
-                [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
-                    BOOL result = [db executeUpdate:[NSString stringWithFormat:
-                                                     @"INSERT INTO DirtyEvent "
-                                                     @"SELECT * FROM Event "
-                                                     @"WHERE dirty = %@ ", [NSNumber numberWithInteger:AWSPinpointClientInvalidEvent]]];
+                                                     @"WHERE retryCount > 3", invalidEvent]]
+                    && [db executeUpdate:[NSString stringWithFormat:
+                                          @"INSERT INTO DirtyEvent "
+                                          @"SELECT * FROM Event "
+                                          @"WHERE dirty = %@ ", invalidEvent]]
+                    && [db executeUpdate:[NSString stringWithFormat:
+                                          @"DELETE FROM Event "
+                                          @"WHERE dirty = %@ ", invalidEvent]];
                     if (!result) {
                         AWSDDLogError(@"SQLite error. [%@]", db.lastError);
                         error = db.lastError;
+                        *rollback = YES;
                     }
                 }];
                 return [AWSTask taskWithResult:nil];
             }];
             
-            AWSTask *deleteTask = [AWSTask taskFromExecutor:[AWSExecutor executorWithDispatchQueue:[AWSPinpointEventRecorder sharedQueue]] withBlock:^id _Nonnull{
-                //Delete dirty events
-                [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
-                    BOOL result = [db executeUpdate:[NSString stringWithFormat:
-                                                     @"DELETE FROM Event "
-                                                     @"WHERE dirty = %@ ", [NSNumber numberWithInteger:AWSPinpointClientInvalidEvent]]];
-                    if (!result) {
-                        AWSDDLogError(@"SQLite error. [%@]", db.lastError);
-                        error = db.lastError;
-                    }
-                }];
-                return [AWSTask taskWithResult:nil];
-            }];
-            
-            return [[AWSTask taskForCompletionOfAllTasksWithResults:@[failTask, moveTask, deleteTask]] continueWithBlock:^id _Nullable(AWSTask * _Nonnull t) {
+            return [dirtyTask continueWithBlock:^id _Nullable(AWSTask * _Nonnull t) {
                 if (error) {
                     return [AWSTask taskWithError:error];
                 }
@@ -827,7 +778,9 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
             if (![db executeUpdate:@"DELETE FROM Event"]) {
                 AWSDDLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
+                return;
             }
+            [db aws_incrementalVacuum];
         }];
         
         if (error) {
@@ -847,7 +800,9 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
             if (![db executeUpdate:@"DELETE FROM DirtyEvent"]) {
                 AWSDDLogError(@"SQLite error. [%@]", db.lastError);
                 error = db.lastError;
+                return;
             }
+            [db aws_incrementalVacuum];
         }];
         
         if (error) {
@@ -863,13 +818,23 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
     NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:self.databasePath
                                                                                 error:&error];
     if (attributes) {
-        return [attributes fileSize];
+        return [AWSFMDatabase aws_diskBytesUsedAtPath:self.databasePath];
     } else {
         AWSDDLogError(@"Error [%@]", error);
         return 0;
     }
 }
 
+- (void)setMaxConcurrentBatchSubmissions:(NSUInteger)maxConcurrentBatchSubmissions {
+    if (maxConcurrentBatchSubmissions > AWSPinpointClientConcurrentBatchSubmissionsMax) {
+        AWSDDLogWarn(@"The maximum number of concurrent batch submissions is %lu, cannot set to %lu (falling back to the limit)",
+                     (unsigned long)AWSPinpointClientConcurrentBatchSubmissionsMax, (unsigned long)maxConcurrentBatchSubmissions);
+        _maxConcurrentBatchSubmissions = AWSPinpointClientConcurrentBatchSubmissionsMax;
+    } else {
+        _maxConcurrentBatchSubmissions = MAX(maxConcurrentBatchSubmissions, 1);
+    }
+}
+
 - (void)setBatchRecordsByteLimit:(NSUInteger)batchRecordsByteLimit {
     if (batchRecordsByteLimit > AWSPinpointClientBatchRecordByteLimitMax) {
         AWSDDLogWarn(@"The batch byte limit is %@, cannot set to %@ (falling back to the limit)",
@@ -1056,35 +1021,29 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                 AWSDDLogError(@"Server rejected submission of %lu events. (Events will be marked dirty.) Response code:%ld, Error Message:%@", (unsigned long)[events count], (long)responseCode, task.error);
                 
                 return [AWSTask taskForCompletionOfAllTasksWithResults:@[[AWSTask taskFromExecutor:[AWSExecutor executorWithDispatchQueue:[AWSPinpointEventRecorder sharedQueue]] withBlock:^id _Nonnull{
-                    for (__block NSString *eventID in _temporaryEvents) {
-                        [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
-                            BOOL result = [db executeUpdate:[NSString stringWithFormat:@"UPDATE Event SET dirty = %@ WHERE id = :id", [NSNumber numberWithInteger:AWSPinpointClientInvalidEvent]]
-                                    withParameterDictionary:@{
-                                                              @"id" : eventID
-                                                              }];
-                            if (!result) {
-                                *error = [db.lastError copy];
-                                AWSDDLogError(@"SQLite error. [%@]", *error);
-                            }
-                        }];
-                    }
+                    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+                        BOOL result = [db aws_executeUpdate:[NSString stringWithFormat:@"UPDATE Event SET dirty = %@ WHERE id IN (%%@)", [NSNumber numberWithInteger:AWSPinpointClientInvalidEvent]]
+                                           withValuesInList:[_temporaryEvents allKeys]];
+                        if (!result) {
+                            *error = [db.lastError copy];
+                            AWSDDLogError(@"SQLite error. [%@]", *error);
+                            *rollback = YES;
+                        }
+                    }];
                     return [AWSTask taskWithError:[self processError:task.error]];
                 }]]];
             } else {
                 AWSDDLogError(@"Unable to successfully deliver events to server. Events will be retried. Error Message:%@", task.error);
                 return [AWSTask taskForCompletionOfAllTasksWithResults:@[[AWSTask taskFromExecutor:[AWSExecutor executorWithDispatchQueue:[AWSPinpointEventRecorder sharedQueue]] withBlock:^id _Nonnull{
-                    for (__block NSString *eventID in _temporaryEvents) {
-                        [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
-                            BOOL result = [db executeUpdate:@"UPDATE Event SET retryCount = retryCount + 1 WHERE id = :id"
-                                    withParameterDictionary:@{
-                                                              @"id" : eventID
-                                                              }];
-                            if (!result) {
-                                *error = [db.lastError copy];
-                                AWSDDLogError(@"SQLite error. [%@]", *error);
-                            }
-                        }];
-                    }
+                    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+                        BOOL result = [db aws_executeUpdate:@"UPDATE Event SET retryCount = retryCount + 1 WHERE id IN (%@)"
+                                           withValuesInList:[_temporaryEvents allKeys]];
+                        if (!result) {
+                            *error = [db.lastError copy];
+                            AWSDDLogError(@"SQLite error. [%@]", *error);
+                            *rollback = YES;
+                        }
+                    }];
                     return task;
                 }]]];
             }
@@ -1108,46 +1067,24 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
                          (unsigned int)[[_processedEvents objectForKey:@"dirtyEvents"] count]);
 
             return [[AWSTask taskForCompletionOfAllTasksWithResults:@[[AWSTask taskFromExecutor:[AWSExecutor executorWithDispatchQueue:[AWSPinpointEventRecorder sharedQueue]] withBlock:^id _Nonnull{
-                //submitted events, update database
-                for (__block NSString *eventID in [_processedEvents objectForKey:@"acceptedEvents"]) {
-                    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
-                        BOOL result = [db executeUpdate:@"DELETE FROM Event WHERE id = :id"
-                                withParameterDictionary:@{
-                                                          @"id" : eventID
-                                                          }];
-                        if (!result) {
-                            *error = [db.lastError copy];
-                            AWSDDLogError(@"SQLite error. [%@]", *error);
-                        }
-                    }];
-                }
-                //retryable events, update database
-                for (__block NSString *eventID in [_processedEvents objectForKey:@"retryableEvents"]) {
-                    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
-                        BOOL result = [db executeUpdate:@"UPDATE Event SET retryCount = retryCount + 1 WHERE id = :id"
-                                withParameterDictionary:@{
-                                                          @"id" : eventID
-                                                          }];
-                        if (!result) {
-                            *error = [db.lastError copy];
-                            AWSDDLogError(@"SQLite error. [%@]", *error);
-                        }
-                    }];
-                }
-                
-                //rejected events, mark dirty, update database
-                for (__block NSString *eventID in [_processedEvents objectForKey:@"dirtyEvents"]) {
-                    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
-                        BOOL result = [db executeUpdate:[NSString stringWithFormat:@"UPDATE Event SET dirty = %@ WHERE id = :id", [NSNumber numberWithInteger:AWSPinpointClientInvalidEvent]]
-                                withParameterDictionary:@{
-                                                          @"id" : eventID
-                                                          }];
-                        if (!result) {
-                            *error = [db.lastError copy];
-                            AWSDDLogError(@"SQLite error. [%@]", *error);
-                        }
-                    }];
-                }
+                // One transaction for the whole batch: accepted events are deleted, retryable events have their retry count
+                // incremented and rejected events are marked dirty.
+                [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+                    BOOL result = [db aws_executeUpdate:@"DELETE FROM Event WHERE id IN (%@)"
+                                       withValuesInList:[[_processedEvents objectForKey:@"acceptedEvents"] allKeys]]
+                    && [db aws_executeUpdate:@"UPDATE Event SET retryCount = retryCount + 1 WHERE id IN (%@)"
+                            withValuesInList:[[_processedEvents objectForKey:@"retryableEvents"] allKeys]]
+                    && [db aws_executeUpdate:[NSString stringWithFormat:@"UPDATE Event SET dirty = %@ WHERE id IN (%%@)", [NSNumber numberWithInteger:AWSPinpointClientInvalidEvent]]
+                            withValuesInList:[[_processedEvents objectForKey:@"dirtyEvents"] allKeys]];
+                    if (!result) {
+                        *error = [db.lastError copy];
+                        AWSDDLogError(@"SQLite error. [%@]", *error);
+                        *rollback = YES;
+                    }
+                }];
+                [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+                    [db aws_incrementalVacuum];
+                }];
                 
                 return task;
             }]]] continueWithBlock:^id _Nullable(AWSTask * _Nonnull t) {
@@ -1307,3 +1244,130 @@ NSString *const FAILURE_REASON = @"NSLocalizedFailureReason";
 }
 
 @end
+
+#pragma mark - AWSPinpointEventBatchSubmitter
+
+@interface AWSPinpointEventBatchSubmitter()
+
+@property (nonatomic, strong) AWSPinpointEventRecorder *eventRecorder;
+@property (nonatomic, strong) AWSPinpointEndpointProfile *endpointProfile;
+@property (nonatomic, assign) NSUInteger maxConcurrentBatches;
+// Serializes the state below; database reads also run on it, never on a thread waiting for a PutEvents response.
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) AWSTaskCompletionSource<NSArray<AWSPinpointEvent *> *> *taskCompletionSource;
+@property (nonatomic, strong) NSMutableArray<AWSPinpointEvent *> *submittedEvents;
+@property (nonatomic, strong) NSMutableSet<NSString *> *inFlightEventIds;
+@property (nonatomic, assign) NSUInteger inFlightBatchCount;
+@property (nonatomic, strong) NSDictionary *nextBatch;
+@property (nonatomic, assign) BOOL submittedAnyBatch;
+@property (nonatomic, strong) NSError *error;
+
+@end
+
+@implementation AWSPinpointEventBatchSubmitter
+
+- (instancetype)initWithEventRecorder:(AWSPinpointEventRecorder *)eventRecorder
+                      endpointProfile:(AWSPinpointEndpointProfile *)endpointProfile
+                 maxConcurrentBatches:(NSUInteger)maxConcurrentBatches {
+    if (self = [super init]) {
+        _eventRecorder = eventRecorder;
+        _endpointProfile = endpointProfile;
+        _maxConcurrentBatches = MAX(maxConcurrentBatches, 1);
+        _queue = dispatch_queue_create("com.amazonaws.AWSPinpointEventBatchSubmitter", DISPATCH_QUEUE_SERIAL);
+        _taskCompletionSource = [AWSTaskCompletionSource taskCompletionSource];
+        _submittedEvents = [NSMutableArray new];
+        _inFlightEventIds = [NSMutableSet new];
+    }
+    return self;
+}
+
+- (AWSTask<NSArray<AWSPinpointEvent *> *> *)submit {
+    dispatch_async(self.queue, ^{
+        [self fillPipeline];
+    });
+    return self.taskCompletionSource.task;
+}
+
+// Runs on `queue` at the start and after every batch completes.
+- (void)fillPipeline {
+    BOOL drained = NO;
+    while (!self.error && self.inFlightBatchCount < self.maxConcurrentBatches) {
+        NSDictionary *batch = self.nextBatch ?: [self readBatch];
+        self.nextBatch = nil;
+        if ([batch count] == 0) {
+            drained = YES;
+            break;
+        }
+        [self sendBatch:batch];
+    }
+
+    if (self.inFlightBatchCount == 0) {
+        [self finish];
+        return;
+    }
+
+    // Every slot is busy; have the next batch ready for when one frees up. Once the table has been drained, wait for the
+    // batches in flight instead: their retryable events are the only ones left to read.
+    if (!self.error && !drained && !self.nextBatch) {
+        NSDictionary *batch = [self readBatch];
+        self.nextBatch = [batch count] > 0 ? batch : nil;
+    }
+}
+
+- (NSDictionary *)readBatch {
+    __block NSDictionary *batch = nil;
+    [self.eventRecorder getBatchRecordsExcludingEventIds:self.inFlightEventIds result:^(NSDictionary *eventsWithEventId, NSError *error) {
+        if (error) {
+            self.error = error;
+        } else {
+            batch = eventsWithEventId;
+        }
+    }];
+    return batch;
+}
+
+- (void)sendBatch:(NSDictionary *)batch {
+    NSSet<NSString *> *eventIds = [NSSet setWithArray:[batch allKeys]];
+    [self.inFlightEventIds unionSet:eventIds];
+    self.inFlightBatchCount++;
+    self.submittedAnyBatch = YES;
+
+    AWSDDLogVerbose(@"Submitting Batch with %lu events ", (unsigned long)[batch count]);
+    [[self.eventRecorder submitBatchEvents:batch
+                           endpointProfile:self.endpointProfile] continueWithBlock:^id _Nullable(AWSTask<NSDictionary <NSString *, NSDictionary *> *> * _Nonnull task) {
+        dispatch_async(self.queue, ^{
+            [self.inFlightEventIds minusSet:eventIds];
+            self.inFlightBatchCount--;
+            if (task.error) {
+                // No new batches are sent after an error; the ones in flight are still reconciled.
+                if (!self.error) {
+                    self.error = task.error;
+                }
+            } else {
+                for (NSDictionary *object in [task.result allValues]) {
+                    if ([[object objectForKey:@"statusCode"] intValue] == 202) {
+                        //Aggregate results
+                        [self.submittedEvents addObject:[object objectForKey:@"event"]];
+                    }
+                }
+            }
+            [self fillPipeline];
+        });
+        return nil;
+    }];
+}
+
+- (void)finish {
+    if (self.error) {
+        [self.taskCompletionSource trySetError:self.error];
+    } else if (!self.submittedAnyBatch) {
+        AWSDDLogWarn(@"No events to submit.");
+        [self.taskCompletionSource trySetError:[NSError errorWithDomain:AWSPinpointAnalyticsErrorDomain
+                                                                   code:AWSPinpointAnalyticsErrorUnknown
+                                                               userInfo:@{NSLocalizedDescriptionKey: @"No events to submit."}]];
+    } else {
+        [self.taskCompletionSource trySetResult:[self.submittedEvents copy]];
+    }
+}
+
+@end
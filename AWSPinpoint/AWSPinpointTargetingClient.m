@@ -28,6 +28,8 @@ NSString *const AWSPinpointEndpointMetricsKey = @"AWSPinpointEndpointMetricsKey"
 NSString *const AWSPinpointEndpointProfileKey = @"AWSPinpointEndpointProfileKey";
 NSString *const AWSPinpointTargetingClientErrorDomain = @"com.amazonaws.AWSPinpointAnalyticsClientErrorDomain";
 NSString *const APNS_CHANNEL_TYPE = @"APNS";
+// How long attribute and metric changes are collected before they are written to the keychain together.
+NSTimeInterval const AWSPinpointTargetingClientPersistenceDelay = 1.0;
 
 @interface AWSPinpointTargetingClient()
 
@@ -38,6 +40,11 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
 @property (nonatomic) NSMutableDictionary* globalMetrics;
 @property (nonatomic) AWSPinpointEndpointProfile *endpointProfile;
 @property (nonatomic, strong) AWSUICKeyChainStore *keychain;
+// Keychain writes run here, off the caller's thread. The in-memory maps above are the source of truth.
+@property (nonatomic, strong) dispatch_queue_t persistenceQueue;
+@property (nonatomic, assign) BOOL attributesNeedPersisting;
+@property (nonatomic, assign) BOOL metricsNeedPersisting;
+@property (nonatomic, assign) BOOL persistenceScheduled;
 @end
 
 @interface AWSPinpointConfiguration()
@@ -64,14 +71,34 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
     if (self = [super init]) {
         _context = context;
         _keychain = context.keychain;
+        _persistenceQueue = dispatch_queue_create("com.amazonaws.AWSPinpointTargetingClient.persistence", DISPATCH_QUEUE_SERIAL);
         [self migrateLegacyKeyValueStore];
         [self initGlobalAttributes];
         [self initGlobalMetrics];
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(flushPendingChanges)
+                                                     name:UIApplicationDidEnterBackgroundNotification
+                                                   object:nil];
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(flushPendingChanges)
+                                                     name:UIApplicationWillTerminateNotification
+                                                   object:nil];
     }
     
     return self;
 }
 
+- (void)dealloc {
+    // A scheduled write keeps the client alive until it has run, so nothing is pending here.
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:UIApplicationDidEnterBackgroundNotification
+                                                  object:nil];
+    [[NSNotificationCenter defaultCenter] removeObserver:self
+                                                    name:UIApplicationWillTerminateNotification
+                                                  object:nil];
+}
+
 - (void)initGlobalAttributes {
     NSData *customAttributesData = [_keychain dataForKey:AWSPinpointEndpointAttributesKey];
     NSMutableDictionary *attributes = [_context.configuration.userDefaults objectForKey:AWSPinpointEndpointAttributesKey];
@@ -189,26 +216,33 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
 }
 
 - (void) addMetricsAndAttributesToEndpointProfile:(AWSPinpointEndpointProfile *) localEndpointProfile {
+    NSDictionary *globalAttributes;
+    NSDictionary *globalMetrics;
+    @synchronized(self) {
+        globalAttributes = [self.globalAttributes copy];
+        globalMetrics = [self.globalMetrics copy];
+    }
+
     // Add attributes
-    if (self.globalAttributes.count > 0) {
-        AWSDDLogVerbose(@"Applying Global Endpoint Attributes: %@", self.globalAttributes);
-        for (NSString *key in [self.globalAttributes allKeys]) {
-            if ([[self.globalAttributes objectForKey:key] isKindOfClass:[NSArray class]]) {
-                [localEndpointProfile addAttribute:[self.globalAttributes objectForKey:key] forKey:key];
+    if (globalAttributes.count > 0) {
+        AWSDDLogVerbose(@"Applying Global Endpoint Attributes: %@", globalAttributes);
+        for (NSString *key in [globalAttributes allKeys]) {
+            if ([[globalAttributes objectForKey:key] isKindOfClass:[NSArray class]]) {
+                [localEndpointProfile addAttribute:[globalAttributes objectForKey:key] forKey:key];
             } else {
-                AWSDDLogWarn(@"Metric should be of NSArray type: %@, Skipping...", [self.globalAttributes objectForKey:key]);
+                AWSDDLogWarn(@"Metric should be of NSArray type: %@, Skipping...", [globalAttributes objectForKey:key]);
             }
         }
     }
     
     // Add metrics
-    if (self.globalMetrics.count > 0) {
-        AWSDDLogVerbose(@"Applying Global Endpoint Metrics: %@", self.globalMetrics);
-        for (NSString *key in [self.globalMetrics allKeys]) {
-            if ([[self.globalMetrics objectForKey:key] isKindOfClass:[NSNumber class]]) {
-                [localEndpointProfile addMetric:[self.globalMetrics objectForKey:key] forKey:key];
+    if (globalMetrics.count > 0) {
+        AWSDDLogVerbose(@"Applying Global Endpoint Metrics: %@", globalMetrics);
+        for (NSString *key in [globalMetrics allKeys]) {
+            if ([[globalMetrics objectForKey:key] isKindOfClass:[NSNumber class]]) {
+                [localEndpointProfile addMetric:[globalMetrics objectForKey:key] forKey:key];
             } else {
-                AWSDDLogWarn(@"Metric should be of NSNumber type: %@, Skipping...", [self.globalMetrics objectForKey:key]);
+                AWSDDLogWarn(@"Metric should be of NSNumber type: %@, Skipping...", [globalMetrics objectForKey:key]);
             }
         }
     }
@@ -276,18 +310,25 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
 
 - (AWSTask *)executeUpdate:(AWSPinpointEndpointProfile *) endpointProfile {
     self.endpointProfile = endpointProfile;
+    NSData *endpointProfileData;
     @synchronized (self.endpointProfile) {
         NSError *codingError;
-        NSData *endpointProfileData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:endpointProfile
-                                                                            requiringSecureCoding:YES
-                                                                                            error:&codingError];
+        endpointProfileData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:endpointProfile
+                                                                    requiringSecureCoding:YES
+                                                                                    error:&codingError];
         if (codingError) {
             AWSDDLogError(@"Error archiving endpointProfileData. Updating service but not persisting locally: %@", codingError);
         }
-        [_keychain setData:endpointProfileData forKey:AWSPinpointEndpointProfileKey];
     }
 
-    return [[self.context.targetingService updateEndpoint:[self updateEndpointRequestForEndpoint:self.endpointProfile]] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+    // The profile is written to the keychain while the update is in flight; the returned task waits for both.
+    AWSUICKeyChainStore *keychain = self.keychain;
+    AWSTask *persistTask = [AWSTask taskFromExecutor:[AWSExecutor executorWithDispatchQueue:self.persistenceQueue] withBlock:^id _Nonnull{
+        [keychain setData:endpointProfileData forKey:AWSPinpointEndpointProfileKey];
+        return [AWSTask taskWithResult:nil];
+    }];
+
+    AWSTask *updateTask = [[self.context.targetingService updateEndpoint:[self updateEndpointRequestForEndpoint:self.endpointProfile]] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
         if (task.error) {
             AWSDDLogError(@"Unable to successfully update endpoint. Error Message:%@", task.error);
             return task;
@@ -296,6 +337,72 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
             return task;
         }
     }];
+
+    return [[AWSTask taskForCompletionOfAllTasks:@[persistTask, updateTask]] continueWithBlock:^id _Nullable(AWSTask * _Nonnull task) {
+        return updateTask;
+    }];
+}
+
+#pragma mark - Persistence
+
+// Called with `self` locked. The first change after a write schedules the next one; later changes ride along.
+- (void)setNeedsPersistenceOfAttributes:(BOOL)attributes metrics:(BOOL)metrics {
+    self.attributesNeedPersisting |= attributes;
+    self.metricsNeedPersisting |= metrics;
+    if (self.persistenceScheduled) {
+        return;
+    }
+    self.persistenceScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(AWSPinpointTargetingClientPersistenceDelay * NSEC_PER_SEC)), self.persistenceQueue, ^{
+        [self persistPendingChanges];
+    });
+}
+
+// Runs on `persistenceQueue`.
+- (void)persistPendingChanges {
+    NSMutableDictionary *attributes = nil;
+    NSMutableDictionary *metrics = nil;
+    @synchronized(self) {
+        if (self.attributesNeedPersisting) {
+            attributes = [self.globalAttributes mutableCopy];
+        }
+        if (self.metricsNeedPersisting) {
+            metrics = [self.globalMetrics mutableCopy];
+        }
+        self.attributesNeedPersisting = NO;
+        self.metricsNeedPersisting = NO;
+        self.persistenceScheduled = NO;
+    }
+
+    if (attributes) {
+        NSError *codingError;
+        NSData *globalAttributesData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:attributes
+                                                                            requiringSecureCoding:YES
+                                                                                            error:&codingError];
+        if (codingError) {
+            AWSDDLogError(@"Error archiving globalAttributesData with error: %@", codingError);
+        } else {
+            [_keychain setData:globalAttributesData forKey:AWSPinpointEndpointAttributesKey];
+        }
+    }
+
+    if (metrics) {
+        NSError *codingError;
+        NSData *globalMetricsData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:metrics
+                                                                         requiringSecureCoding:YES
+                                                                                         error:&codingError];
+        if (codingError) {
+            AWSDDLogError(@"Error archiving globalMetricsData with error: %@", codingError);
+        } else {
+            [_keychain setData:globalMetricsData forKey:AWSPinpointEndpointMetricsKey];
+        }
+    }
+}
+
+- (void)flushPendingChanges {
+    dispatch_sync(self.persistenceQueue, ^{
+        [self persistPendingChanges];
+    });
 }
 
 - (void) verifyMinimumLengthForKey:(NSString*) key {
@@ -322,17 +429,8 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
     }
     
     @synchronized(self) {
-        //Save value to disk
-        [self.globalAttributes setValue:theValue forKey:theKey];
-        NSError *codingError;
-        NSData *globalAttributesData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:self.globalAttributes
-                                                                            requiringSecureCoding:YES
-                                                                                            error:&codingError];
-        if (codingError) {
-            AWSDDLogError(@"Error archiving globalAttributesData with error: %@", codingError);
-        } else {
-            [_keychain setData:globalAttributesData forKey:AWSPinpointEndpointAttributesKey];
-        }
+        [self.globalAttributes setValue:[theValue copy] forKey:theKey];
+        [self setNeedsPersistenceOfAttributes:YES metrics:NO];
     }
 }
 
@@ -345,15 +443,7 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
     
     @synchronized(self) {
         [self.globalAttributes removeObjectForKey:theKey];
-        NSError *codingError;
-        NSData *globalAttributesData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:self.globalAttributes
-                                                                            requiringSecureCoding:YES
-                                                                                            error:&codingError];
-        if (codingError) {
-            AWSDDLogError(@"Error archiving globalAttributesData with error: %@", codingError);
-        } else {
-            [_keychain setData:globalAttributesData forKey:AWSPinpointEndpointAttributesKey];
-        }
+        [self setNeedsPersistenceOfAttributes:YES metrics:NO];
     }
 }
 
@@ -374,15 +464,7 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
     
     @synchronized(self) {
         [self.globalMetrics setValue:theValue forKey:theKey];
-        NSError *codingError;
-        NSData *globalMetricsData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:self.globalMetrics
-                                                                            requiringSecureCoding:YES
-                                                                                            error:&codingError];
-        if (codingError) {
-            AWSDDLogError(@"Error archiving globalMetricsData with error: %@", codingError);
-        } else {
-            [_keychain setData:globalMetricsData forKey:AWSPinpointEndpointMetricsKey];
-        }
+        [self setNeedsPersistenceOfAttributes:NO metrics:YES];
     }
 }
 
@@ -395,16 +477,7 @@ NSString *const APNS_CHANNEL_TYPE = @"APNS";
     
     @synchronized(self) {
         [self.globalMetrics removeObjectForKey:theKey];
-        NSError *codingError;
-        NSData *globalMetricsData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:self.globalMetrics
-                                                                            requiringSecureCoding:YES
-                                                                                            error:&codingError];
-        if (codingError) {
-            AWSDDLogError(@"Error archiving globalMetricsData with error: %@", codingError);
-        } else {
-            [_keychain setData:globalMetricsData forKey:AWSPinpointEndpointMetricsKey];
-        }
-        
+        [self setNeedsPersistenceOfAttributes:NO metrics:YES];
     }
 }
 
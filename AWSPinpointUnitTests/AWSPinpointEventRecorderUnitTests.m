@@ -0,0 +1,275 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "OCMock.h"
+#import "AWSPinpoint.h"
+
+static NSString *const UserDefaultSuiteNameAWSPinpointEventRecorderUnitTests = @"AWSPinpointEventRecorderUnitTests";
+static const NSUInteger AWSPinpointEventRecorderUnitTestsBatchSize = 100;
+
+@interface AWSPinpointEventRecorder()
+- (void) getBatchRecords:(void (^)(NSDictionary *eventsWithEventId, NSError *error))result;
+- (void) getBatchRecordsExcludingEventIds:(NSSet<NSString *> *)excludedEventIds
+                                   result:(void (^)(NSDictionary *eventsWithEventId, NSError *error))result;
++ (NSUInteger)byteSizeOfBatchRecord:(NSDictionary *)record;
+- (AWSTask<NSDictionary <NSString *, NSDictionary *> *> *)submitBatchEvents:(NSDictionary*) eventsWithEventId
+                                                            endpointProfile:(AWSPinpointEndpointProfile *) endpointProfile;
+@end
+
+// Implemented in AWSPinpointEventRecorder.m; created with NSClassFromString.
+@interface AWSPinpointEventBatchSubmitter : NSObject
+- (instancetype)initWithEventRecorder:(AWSPinpointEventRecorder *)eventRecorder
+                      endpointProfile:(AWSPinpointEndpointProfile *)endpointProfile
+                 maxConcurrentBatches:(NSUInteger)maxConcurrentBatches;
+- (AWSTask<NSArray<AWSPinpointEvent *> *> *)submit;
+@end
+
+@interface AWSPinpointConfiguration()
+@property (nonatomic, strong) NSUserDefaults *userDefaults;
+@end
+
+@interface AWSPinpointEventRecorderUnitTests : XCTestCase
+@property (nonatomic, strong) AWSPinpoint *pinpoint;
+// Stand-ins for the Event table and PutEvents while a batch submitter is tested; guarded by self.
+@property (nonatomic, strong) NSMutableOrderedSet<NSString *> *pendingEventIds;
+@property (nonatomic, strong) NSMutableArray<NSDictionary *> *submittedBatches;
+@property (nonatomic, strong) NSMutableArray<AWSTaskCompletionSource *> *submissions;
+@end
+
+@implementation AWSPinpointEventRecorderUnitTests
+
+- (void)setUp {
+    [super setUp];
+    AWSCognitoCredentialsProvider *credentialsProvider = [[AWSCognitoCredentialsProvider alloc] initWithRegionType:AWSRegionUSEast1
+                                                                                                    identityPoolId:@"fakeIdentityPoolId"
+                                                                                                     unauthRoleArn:@"fakeUnauthRoleArn"
+                                                                                                       authRoleArn:@"fakeAuthRoleArn"
+                                                                                           identityProviderManager:nil];
+    AWSServiceConfiguration *awsConfiguration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                            credentialsProvider:credentialsProvider];
+    [AWSServiceManager defaultServiceManager].defaultServiceConfiguration = awsConfiguration;
+
+    [[NSUserDefaults standardUserDefaults] removeSuiteNamed:UserDefaultSuiteNameAWSPinpointEventRecorderUnitTests];
+
+    AWSPinpointConfiguration *configuration = [[AWSPinpointConfiguration alloc] initWithAppId:@"fakeAppIdEventRecorderUnitTests" launchOptions:@{}];
+    configuration.userDefaults = [[NSUserDefaults alloc] initWithSuiteName:UserDefaultSuiteNameAWSPinpointEventRecorderUnitTests];
+    configuration.enableAutoSessionRecording = NO;
+    self.pinpoint = [AWSPinpoint pinpointWithConfiguration:configuration];
+    // 100 of the events saved below come to more than the default 512 KB.
+    self.pinpoint.analyticsClient.eventRecorder.batchRecordsByteLimit = 4 * 1024 * 1024;
+    [[self.pinpoint.analyticsClient.eventRecorder removeAllEvents] waitUntilFinished];
+}
+
+- (void)tearDown {
+    [[self.pinpoint.analyticsClient.eventRecorder removeAllEvents] waitUntilFinished];
+    [super tearDown];
+}
+
+// Events with 40 attributes of about 100 bytes each, about 5 KB archived.
+- (void)saveEventsWithLargeAttributes:(NSUInteger)count {
+    AWSPinpointEventRecorder *eventRecorder = self.pinpoint.analyticsClient.eventRecorder;
+    for (NSUInteger i = 0; i < count; i++) {
+        AWSPinpointEvent *event = [self.pinpoint.analyticsClient createEventWithEventType:@"TEST_EVENT_LARGE_ATTRIBUTES"];
+        for (NSUInteger j = 0; j < 40; j++) {
+            NSString *value = [@"" stringByPaddingToLength:100 withString:[NSString stringWithFormat:@"%lu-%lu,", (unsigned long)i, (unsigned long)j] startingAtIndex:0];
+            [event addAttribute:value forKey:[NSString stringWithFormat:@"attribute%lu", (unsigned long)j]];
+            [event addMetric:@(i * j) forKey:[NSString stringWithFormat:@"metric%lu", (unsigned long)j]];
+        }
+        [[eventRecorder saveEvent:event] waitUntilFinished];
+    }
+}
+
+- (NSDictionary *)batchRecords {
+    __block NSDictionary *batch = nil;
+    [self.pinpoint.analyticsClient.eventRecorder getBatchRecords:^(NSDictionary *eventsWithEventId, NSError *error) {
+        XCTAssertNil(error);
+        batch = eventsWithEventId;
+    }];
+    return batch;
+}
+
+- (void)testBatchRecordsAreSizedFromTheirRows {
+    [self saveEventsWithLargeAttributes:AWSPinpointEventRecorderUnitTestsBatchSize];
+
+    NSDictionary *batch = [self batchRecords];
+    XCTAssertEqual([batch count], AWSPinpointEventRecorderUnitTestsBatchSize);
+
+    // The running estimate stays close to the size of the archived batch it replaces.
+    NSUInteger estimatedSize = 0;
+    for (NSDictionary *record in [batch allValues]) {
+        estimatedSize += [AWSPinpointEventRecorder byteSizeOfBatchRecord:record];
+    }
+    NSData *batchData = [AWSNSCodingUtilities versionSafeArchivedDataWithRootObject:batch
+                                                              requiringSecureCoding:YES
+                                                                              error:nil];
+    XCTAssertEqualWithAccuracy((double)estimatedSize, (double)[batchData length], [batchData length] * 0.1);
+}
+
+- (void)testBatchRecordsStopAtByteLimit {
+    [self saveEventsWithLargeAttributes:20];
+    NSDictionary *record = [[[self batchRecords] allValues] firstObject];
+    NSUInteger recordSize = [AWSPinpointEventRecorder byteSizeOfBatchRecord:record];
+
+    // As before, the row that goes over the limit is the last one in the batch.
+    self.pinpoint.analyticsClient.eventRecorder.batchRecordsByteLimit = recordSize * 5 + recordSize / 2;
+    XCTAssertEqual([[self batchRecords] count], 6);
+}
+
+- (void)testBatchRecordsSkipEventsInFlight {
+    [self saveEventsWithLargeAttributes:150];
+    NSDictionary *firstBatch = [self batchRecords];
+    XCTAssertEqual([firstBatch count], AWSPinpointEventRecorderUnitTestsBatchSize);
+
+    __block NSDictionary *nextBatch = nil;
+    [self.pinpoint.analyticsClient.eventRecorder getBatchRecordsExcludingEventIds:[NSSet setWithArray:[firstBatch allKeys]]
+                                                                           result:^(NSDictionary *eventsWithEventId, NSError *error) {
+        XCTAssertNil(error);
+        nextBatch = eventsWithEventId;
+    }];
+    XCTAssertEqual([nextBatch count], 50);
+    XCTAssertFalse([[NSSet setWithArray:[nextBatch allKeys]] intersectsSet:[NSSet setWithArray:[firstBatch allKeys]]]);
+}
+
+- (void)testMaxConcurrentBatchSubmissionsIsClamped {
+    AWSPinpointEventRecorder *eventRecorder = self.pinpoint.analyticsClient.eventRecorder;
+    XCTAssertEqual(eventRecorder.maxConcurrentBatchSubmissions, 2);
+
+    eventRecorder.maxConcurrentBatchSubmissions = 0;
+    XCTAssertEqual(eventRecorder.maxConcurrentBatchSubmissions, 1);
+    eventRecorder.maxConcurrentBatchSubmissions = 100;
+    XCTAssertEqual(eventRecorder.maxConcurrentBatchSubmissions, 8);
+}
+
+#pragma mark - AWSPinpointEventBatchSubmitter
+
+- (void)getBatchRecordsExcludingEventIds:(NSSet<NSString *> *)excludedEventIds
+                                  result:(void (^)(NSDictionary *eventsWithEventId, NSError *error))result {
+    NSMutableDictionary *batch = [NSMutableDictionary new];
+    @synchronized(self) {
+        for (NSString *eventId in self.pendingEventIds) {
+            if ([batch count] == AWSPinpointEventRecorderUnitTestsBatchSize) {
+                break;
+            }
+            if (![excludedEventIds containsObject:eventId]) {
+                batch[eventId] = @{@"id" : eventId};
+            }
+        }
+    }
+    result(batch, nil);
+}
+
+- (AWSTask *)submitBatchEvents:(NSDictionary *)eventsWithEventId endpointProfile:(AWSPinpointEndpointProfile *)endpointProfile {
+    AWSTaskCompletionSource *submission = [AWSTaskCompletionSource taskCompletionSource];
+    @synchronized(self) {
+        [self.submittedBatches addObject:eventsWithEventId];
+        [self.submissions addObject:submission];
+    }
+    return submission.task;
+}
+
+- (AWSTask<NSArray *> *)submitEventCount:(NSUInteger)eventCount maxConcurrentBatches:(NSUInteger)maxConcurrentBatches {
+    self.pendingEventIds = [NSMutableOrderedSet new];
+    for (NSUInteger i = 0; i < eventCount; i++) {
+        [self.pendingEventIds addObject:[NSString stringWithFormat:@"event%03lu", (unsigned long)i]];
+    }
+    self.submittedBatches = [NSMutableArray new];
+    self.submissions = [NSMutableArray new];
+
+    id eventRecorderMock = OCMClassMock([AWSPinpointEventRecorder class]);
+    OCMStub([eventRecorderMock getBatchRecordsExcludingEventIds:[OCMArg any] result:[OCMArg any]])
+        .andCall(self, @selector(getBatchRecordsExcludingEventIds:result:));
+    OCMStub([eventRecorderMock submitBatchEvents:[OCMArg any] endpointProfile:[OCMArg any]])
+        .andCall(self, @selector(submitBatchEvents:endpointProfile:));
+
+    AWSPinpointEventBatchSubmitter *submitter = [[NSClassFromString(@"AWSPinpointEventBatchSubmitter") alloc] initWithEventRecorder:eventRecorderMock
+                                                                                                                   endpointProfile:nil
+                                                                                                              maxConcurrentBatches:maxConcurrentBatches];
+    return [submitter submit];
+}
+
+- (void)waitForSubmissionCount:(NSUInteger)submissionCount {
+    NSPredicate *predicate = [NSPredicate predicateWithBlock:^BOOL(id object, NSDictionary *bindings) {
+        @synchronized(self) {
+            return [self.submissions count] == submissionCount;
+        }
+    }];
+    [self waitForExpectations:@[[[XCTNSPredicateExpectation alloc] initWithPredicate:predicate object:nil]] timeout:5];
+}
+
+// Accepts every event of the batch; the event ID stands in for the event.
+- (void)acceptSubmission:(NSUInteger)index {
+    NSDictionary *batch = nil;
+    AWSTaskCompletionSource *submission = nil;
+    @synchronized(self) {
+        batch = self.submittedBatches[index];
+        submission = self.submissions[index];
+        [self.pendingEventIds removeObjectsInArray:[batch allKeys]];
+    }
+    NSMutableDictionary *result = [NSMutableDictionary new];
+    for (NSString *eventId in batch) {
+        result[eventId] = @{@"statusCode" : @202, @"event" : eventId};
+    }
+    [submission setResult:result];
+}
+
+- (void)testBatchSubmitterKeepsBatchesInFlightAndCombinesResults {
+    AWSTask<NSArray *> *task = [self submitEventCount:250 maxConcurrentBatches:2];
+
+    // Two batches go out together; the third waits for a slot.
+    [self waitForSubmissionCount:2];
+    [self acceptSubmission:1];
+    [self waitForSubmissionCount:3];
+    XCTAssertFalse(task.completed);
+    [self acceptSubmission:0];
+    [self acceptSubmission:2];
+
+    [task waitUntilFinished];
+    XCTAssertNil(task.error);
+    XCTAssertEqual([self.submittedBatches count], 3);
+    NSMutableSet<NSString *> *submittedEventIds = [NSMutableSet new];
+    for (NSDictionary *batch in self.submittedBatches) {
+        XCTAssertFalse([submittedEventIds intersectsSet:[NSSet setWithArray:[batch allKeys]]]);
+        [submittedEventIds addObjectsFromArray:[batch allKeys]];
+    }
+    XCTAssertEqual([submittedEventIds count], 250);
+    XCTAssertEqualObjects([NSSet setWithArray:task.result], submittedEventIds);
+}
+
+- (void)testBatchSubmitterStopsAfterFirstError {
+    AWSTask<NSArray *> *task = [self submitEventCount:250 maxConcurrentBatches:2];
+    [self waitForSubmissionCount:2];
+
+    NSError *error = [NSError errorWithDomain:AWSPinpointAnalyticsErrorDomain code:AWSPinpointAnalyticsErrorUnknown userInfo:nil];
+    [self.submissions[0] setError:error];
+    // The batch still in flight is reconciled, but no batch is sent after the error.
+    [self acceptSubmission:1];
+
+    [task waitUntilFinished];
+    XCTAssertEqual(task.error, error);
+    XCTAssertEqual([self.submissions count], 2);
+}
+
+#pragma mark - Benchmarks
+
+// One flush worth of batch assembly: 100 events with large attribute and metric maps.
+- (void)testGetBatchRecordsPerformance {
+    [self saveEventsWithLargeAttributes:AWSPinpointEventRecorderUnitTestsBatchSize];
+    [self measureBlock:^{
+        XCTAssertEqual([[self batchRecords] count], AWSPinpointEventRecorderUnitTestsBatchSize);
+    }];
+}
+
+@end
@@ -0,0 +1,132 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSPinpoint.h"
+#import "AWSPinpointContext.h"
+
+static NSString *const UserDefaultSuiteNameAWSPinpointTargetingClientUnitTests = @"AWSPinpointTargetingClientUnitTests";
+
+extern NSString *const AWSPinpointEndpointAttributesKey;
+extern NSString *const AWSPinpointEndpointMetricsKey;
+
+@interface AWSPinpointTargetingClient()
+@property (nonatomic, weak) AWSPinpointContext *context;
+@property (nonatomic, strong) AWSUICKeyChainStore *keychain;
+- (instancetype)initWithContext:(AWSPinpointContext *) context;
+- (void)flushPendingChanges;
+@end
+
+@interface AWSPinpointConfiguration()
+@property (nonatomic, strong) NSUserDefaults *userDefaults;
+@end
+
+@interface AWSPinpointTargetingClientUnitTests : XCTestCase
+@property (nonatomic, strong) AWSPinpoint *pinpoint;
+@end
+
+@implementation AWSPinpointTargetingClientUnitTests
+
+- (void)setUp {
+    [super setUp];
+    AWSCognitoCredentialsProvider *credentialsProvider = [[AWSCognitoCredentialsProvider alloc] initWithRegionType:AWSRegionUSEast1
+                                                                                                    identityPoolId:@"fakeIdentityPoolId"
+                                                                                                     unauthRoleArn:@"fakeUnauthRoleArn"
+                                                                                                       authRoleArn:@"fakeAuthRoleArn"
+                                                                                           identityProviderManager:nil];
+    AWSServiceConfiguration *awsConfiguration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                            credentialsProvider:credentialsProvider];
+    [AWSServiceManager defaultServiceManager].defaultServiceConfiguration = awsConfiguration;
+
+    [[NSUserDefaults standardUserDefaults] removeSuiteNamed:UserDefaultSuiteNameAWSPinpointTargetingClientUnitTests];
+    AWSUICKeyChainStore *keychain = [AWSUICKeyChainStore keyChainStoreWithService:AWSPinpointContextKeychainService];
+    [keychain removeItemForKey:AWSPinpointEndpointAttributesKey];
+    [keychain removeItemForKey:AWSPinpointEndpointMetricsKey];
+
+    AWSPinpointConfiguration *configuration = [[AWSPinpointConfiguration alloc] initWithAppId:@"fakeAppIdTargetingClientUnitTests" launchOptions:@{}];
+    configuration.userDefaults = [[NSUserDefaults alloc] initWithSuiteName:UserDefaultSuiteNameAWSPinpointTargetingClientUnitTests];
+    configuration.enableAutoSessionRecording = NO;
+    self.pinpoint = [AWSPinpoint pinpointWithConfiguration:configuration];
+}
+
+- (void)tearDown {
+    AWSPinpointTargetingClient *targetingClient = self.pinpoint.targetingClient;
+    [targetingClient flushPendingChanges];
+    [targetingClient.keychain removeItemForKey:AWSPinpointEndpointAttributesKey];
+    [targetingClient.keychain removeItemForKey:AWSPinpointEndpointMetricsKey];
+    [super tearDown];
+}
+
+- (void)testChangesAreNotWrittenImmediately {
+    AWSPinpointTargetingClient *targetingClient = self.pinpoint.targetingClient;
+    [targetingClient addAttribute:@[@"value"] forKey:@"key"];
+    [targetingClient addMetric:@(1) forKey:@"metric"];
+
+    XCTAssertNil([targetingClient.keychain dataForKey:AWSPinpointEndpointAttributesKey]);
+    XCTAssertNil([targetingClient.keychain dataForKey:AWSPinpointEndpointMetricsKey]);
+
+    // The in-memory copy is applied to profiles right away.
+    AWSPinpointEndpointProfile *profile = [targetingClient currentEndpointProfile];
+    XCTAssertEqualObjects([profile attributeForKey:@"key"], @[@"value"]);
+    XCTAssertEqualObjects([profile metricForKey:@"metric"], @(1));
+}
+
+- (void)testFlushWritesLatestValues {
+    AWSPinpointTargetingClient *targetingClient = self.pinpoint.targetingClient;
+    for (NSUInteger i = 0; i < 50; i++) {
+        [targetingClient addAttribute:@[[NSString stringWithFormat:@"value%lu", (unsigned long)i]] forKey:[NSString stringWithFormat:@"key%lu", (unsigned long)i]];
+        [targetingClient addMetric:@(i) forKey:[NSString stringWithFormat:@"metric%lu", (unsigned long)i]];
+    }
+    [targetingClient removeAttributeForKey:@"key0"];
+    [targetingClient removeMetricForKey:@"metric0"];
+
+    [targetingClient flushPendingChanges];
+
+    AWSPinpointTargetingClient *reloadedClient = [[AWSPinpointTargetingClient alloc] initWithContext:targetingClient.context];
+    AWSPinpointEndpointProfile *profile = [reloadedClient currentEndpointProfile];
+    XCTAssertEqual([[profile allAttributes] count], 49);
+    XCTAssertEqual([[profile allMetrics] count], 49);
+    XCTAssertNil([profile attributeForKey:@"key0"]);
+    XCTAssertEqualObjects([profile attributeForKey:@"key49"], @[@"value49"]);
+    XCTAssertEqualObjects([profile metricForKey:@"metric49"], @(49));
+}
+
+- (void)testChangesAreWrittenAfterDelay {
+    AWSPinpointTargetingClient *targetingClient = self.pinpoint.targetingClient;
+    [targetingClient addAttribute:@[@"value"] forKey:@"key"];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Attributes written"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(2 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        XCTAssertNotNil([targetingClient.keychain dataForKey:AWSPinpointEndpointAttributesKey]);
+        XCTAssertNil([targetingClient.keychain dataForKey:AWSPinpointEndpointMetricsKey]);
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+#pragma mark - Benchmarks
+
+// Previously every call archived both maps and wrote the keychain.
+- (void)testAddAttributePerformance {
+    AWSPinpointTargetingClient *targetingClient = self.pinpoint.targetingClient;
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 40; i++) {
+            [targetingClient addAttribute:@[@"value"] forKey:[NSString stringWithFormat:@"key%lu", (unsigned long)i]];
+            [targetingClient addMetric:@(i) forKey:[NSString stringWithFormat:@"metric%lu", (unsigned long)i]];
+        }
+    }];
+}
+
+@end
@@ -196,6 +196,19 @@ typedef NS_ENUM(NSInteger, AWSS3PresignedURLErrorType) {
  */
 - (AWSTask<NSURL *> *)getPreSignedURL:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest;
 
+/**
+ Build time-limited pre-signed URLs for many objects in the same bucket with the same HTTP method, expiry, headers and parameters.
+
+ The credentials are resolved once, and the signing key and everything in the signature but the object key are computed once for the whole batch. When the credentials provider has valid cached credentials the returned task has already completed, so its result can be read right away.
+
+ @param getPreSignedURLRequest The AWSS3PreSignedURLRequest that defines the parameters shared by all URLs. Its `key` is ignored, and unlike `getPreSignedURL:` the request is not modified.
+ @param keys The names of the S3 objects.
+ @return The pre-signed NSURLs, in the order of `keys`. The task fails if any key is nil or empty or if any errors occured.
+ @see AWSS3GetPreSignedURLRequest
+ */
+- (AWSTask<NSArray<NSURL *> *> *)getPreSignedURLs:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest
+                                          forKeys:(NSArray<NSString *> *)keys;
+
 @end
 
 /** The GetPreSignedURLRequest contains the parameters used to create
@@ -152,102 +152,145 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     return self;
 }
 
-- (AWSTask<NSURL *> *)getPreSignedURL:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest {
-    //retrive parameters from request;
+- (NSError *)validatePreSignedURLRequest:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest {
     NSString *bucketName = getPreSignedURLRequest.bucket;
-    NSString *keyName = getPreSignedURLRequest.key;
-    AWSHTTPMethod httpMethod = getPreSignedURLRequest.HTTPMethod;
-    AWSServiceConfiguration *configuration = self.configuration;
-    id<AWSCredentialsProvider>credentialsProvider = configuration.credentialsProvider;
     AWSEndpoint *endpoint = self.configuration.endpoint;
-    BOOL isAccelerateModeEnabled = getPreSignedURLRequest.isAccelerateModeEnabled;
-
     NSDate *expires = getPreSignedURLRequest.expires;
 
-    return [[[AWSTask taskWithResult:nil] continueWithBlock:^id(AWSTask *task) {
-
-        //validate additionalParams
-        for (id key in getPreSignedURLRequest.requestParameters) {
-            id value = getPreSignedURLRequest.requestParameters[key];
-            if (![key isKindOfClass:[NSString class]]
-                || ![value isKindOfClass:[NSString class]]) {
-                return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                                  code:AWSS3PresignedURLErrorInvalidRequestParameters
-                                                              userInfo:@{NSLocalizedDescriptionKey: @"requestParameters can only contain key-value pairs in NSString type."}]
-                        ];
-            }
+    //validate additionalParams
+    for (id key in getPreSignedURLRequest.requestParameters) {
+        id value = getPreSignedURLRequest.requestParameters[key];
+        if (![key isKindOfClass:[NSString class]]
+            || ![value isKindOfClass:[NSString class]]) {
+            return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                       code:AWSS3PresignedURLErrorInvalidRequestParameters
+                                   userInfo:@{NSLocalizedDescriptionKey: @"requestParameters can only contain key-value pairs in NSString type."}];
         }
+    }
 
-        //validate endpoint
-        if (!endpoint) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorEndpointIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"endpoint in configuration can not be nil"}]
-                    ];
-        } else if (endpoint.serviceType != AWSServiceS3) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidServiceType
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"Invalid serviceType: serviceType in endpoint must be AWSServiceS3"}]
-                    ];
-        }
+    //validate endpoint
+    if (!endpoint) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorEndpointIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"endpoint in configuration can not be nil"}];
+    } else if (endpoint.serviceType != AWSServiceS3) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidServiceType
+                               userInfo:@{NSLocalizedDescriptionKey: @"Invalid serviceType: serviceType in endpoint must be AWSServiceS3"}];
+    }
 
-        //validate credentialsProvider
-        if (!credentialsProvider) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PreSignedURLErrorCredentialProviderIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"credentialsProvider in configuration can not be nil"}]
-                    ];
-        }
+    //validate credentialsProvider
+    if (!self.configuration.credentialsProvider) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PreSignedURLErrorCredentialProviderIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"credentialsProvider in configuration can not be nil"}];
+    }
 
-        //validate bucketName
-        if (!bucketName || [bucketName length] < 1) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorBucketNameIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"S3 bucket can not be nil or empty"}]];
-        }
+    //validate bucketName
+    if (!bucketName || [bucketName length] < 1) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorBucketNameIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"S3 bucket can not be nil or empty"}];
+    }
 
-        // Validates the buket name for transfer acceleration.
-        if (isAccelerateModeEnabled && ![bucketName aws_isVirtualHostedStyleCompliant]) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidBucketNameForAccelerateModeEnabled
-                                                          userInfo:@{
-                                                                     NSLocalizedDescriptionKey: @"For your bucket to work with transfer acceleration, the bucket name must conform to DNS naming requirements and must not contain periods."}]];
-        }
+    // Validates the buket name for transfer acceleration.
+    if (getPreSignedURLRequest.isAccelerateModeEnabled && ![bucketName aws_isVirtualHostedStyleCompliant]) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidBucketNameForAccelerateModeEnabled
+                               userInfo:@{NSLocalizedDescriptionKey: @"For your bucket to work with transfer acceleration, the bucket name must conform to DNS naming requirements and must not contain periods."}];
+    }
 
-        //validate keyName
-        if (!keyName || [keyName length] < 1) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorKeyNameIsNil
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"S3 key can not be nil or empty"}]
-                    ];
-        }
+    //validate expires Date
+    if (!expires) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidExpiresDate
+                               userInfo:@{NSLocalizedDescriptionKey: @"expires can not be nil"}];
+    }else if ([expires timeIntervalSinceNow] < 0.0) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidExpiresDate
+                               userInfo:@{NSLocalizedDescriptionKey: @"expires can not be in past"}];
+    }
 
-        //validate expires Date
-        if (!expires) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidExpiresDate
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"expires can not be nil"}]
-                    ];
-        }else if ([expires timeIntervalSinceNow] < 0.0) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidExpiresDate
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"expires can not be in past"}]
-                    ];
+    //validate httpMethod
+    switch (getPreSignedURLRequest.HTTPMethod) {
+        case AWSHTTPMethodGET:
+        case AWSHTTPMethodPUT:
+        case AWSHTTPMethodHEAD:
+        case AWSHTTPMethodDELETE:
+            break;
+        default:
+            return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                       code:AWSS3PresignedURLErrorUnsupportedHTTPVerbs
+                                   userInfo:@{NSLocalizedDescriptionKey: @"unsupported HTTP Method, currently only support AWSHTTPMethodGET, AWSHTTPMethodPUT, AWSHTTPMethodHEAD, AWSHTTPMethodDELETE"}];
+    }
+
+    return nil;
+}
+
+- (NSError *)validateKeyName:(NSString *)keyName {
+    if (!keyName || [keyName length] < 1) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorKeyNameIsNil
+                               userInfo:@{NSLocalizedDescriptionKey: @"S3 key can not be nil or empty"}];
+    }
+    return nil;
+}
+
+//generate baseURL String (use virtualHostStyle if possible)
+//base url is not url encoded.
+- (NSString *)keyPathForBucket:(NSString *)bucketName key:(NSString *)keyName {
+    if (bucketName == nil || [bucketName aws_isVirtualHostedStyleCompliant]) {
+        return (keyName == nil ? @"" : [NSString stringWithFormat:@"%@", [keyName aws_stringWithURLEncodingPath]]);
+    } else {
+        return (keyName == nil ? [NSString stringWithFormat:@"%@", bucketName] : [NSString stringWithFormat:@"%@/%@", bucketName, [keyName aws_stringWithURLEncodingPath]]);
+    }
+}
+
+//generate correct hostName (use virtualHostStyle if possible)
+- (NSString *)hostForBucket:(NSString *)bucketName accelerateModeEnabled:(BOOL)isAccelerateModeEnabled {
+    AWSEndpoint *endpoint = self.configuration.endpoint;
+    if (!self.configuration.localTestingEnabled &&
+        bucketName &&
+        [bucketName aws_isVirtualHostedStyleCompliant]) {
+        if (isAccelerateModeEnabled) {
+            return [NSString stringWithFormat:@"%@.%@", bucketName, AWSS3PreSignedURLBuilderAcceleratedEndpoint];
+        } else {
+            return [NSString stringWithFormat:@"%@.%@", bucketName, endpoint.hostName];
         }
+    } else {
+        return endpoint.hostName;
+    }
+}
 
-        //validate httpMethod
-        switch (httpMethod) {
-            case AWSHTTPMethodGET:
-            case AWSHTTPMethodPUT:
-            case AWSHTTPMethodHEAD:
-            case AWSHTTPMethodDELETE:
-                break;
-            default:
-                return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                                  code:AWSS3PresignedURLErrorUnsupportedHTTPVerbs
-                                                              userInfo:@{NSLocalizedDescriptionKey: @"unsupported HTTP Method, currently only support AWSHTTPMethodGET, AWSHTTPMethodPUT, AWSHTTPMethodHEAD, AWSHTTPMethodDELETE"}]
-                        ];
-                break;
+- (AWSEndpoint *)endpointWithHost:(NSString *)host {
+    AWSEndpoint *endpoint = self.configuration.endpoint;
+    NSString *portNumber = endpoint.portNumber != nil ? [NSString stringWithFormat:@":%@", endpoint.portNumber.stringValue]: @"";
+    return [[AWSEndpoint alloc]initWithRegion:self.configuration.regionType service:AWSServiceS3 URL:[NSURL URLWithString:[NSString stringWithFormat:@"%@://%@%@", endpoint.useUnsafeURL?@"http":@"https", host, portNumber]]];
+}
+
+- (NSError *)validateExpireDuration:(int32_t)expireDuration {
+    if (expireDuration > 604800) {
+        return [NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                   code:AWSS3PresignedURLErrorInvalidExpiresDate
+                               userInfo:@{NSLocalizedDescriptionKey: @"Invalid ExpiresDate, must be less than seven days in future"}];
+    }
+    return nil;
+}
+
+- (AWSTask<NSURL *> *)getPreSignedURL:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest {
+    //retrive parameters from request;
+    NSString *bucketName = getPreSignedURLRequest.bucket;
+    NSString *keyName = getPreSignedURLRequest.key;
+    AWSHTTPMethod httpMethod = getPreSignedURLRequest.HTTPMethod;
+    id<AWSCredentialsProvider>credentialsProvider = self.configuration.credentialsProvider;
+    BOOL isAccelerateModeEnabled = getPreSignedURLRequest.isAccelerateModeEnabled;
+
+    NSDate *expires = getPreSignedURLRequest.expires;
+
+    return [[[AWSTask taskWithResult:nil] continueWithBlock:^id(AWSTask *task) {
+        NSError *error = [self validatePreSignedURLRequest:getPreSignedURLRequest] ?: [self validateKeyName:keyName];
+        if (error) {
+            return [AWSTask taskWithError:error];
         }
 
         return [[credentialsProvider credentials] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
@@ -259,28 +302,9 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             return credentialsProvider;
         }];
     }] continueWithSuccessBlock:^id _Nullable(AWSTask * _Nonnull task) {
-        //generate baseURL String (use virtualHostStyle if possible)
-        //base url is not url encoded.
-        NSString *keyPath = nil;
-        if (bucketName == nil || [bucketName aws_isVirtualHostedStyleCompliant]) {
-            keyPath = (keyName == nil ? @"" : [NSString stringWithFormat:@"%@", [keyName aws_stringWithURLEncodingPath]]);
-        } else {
-            keyPath = (keyName == nil ? [NSString stringWithFormat:@"%@", bucketName] : [NSString stringWithFormat:@"%@/%@", bucketName, [keyName aws_stringWithURLEncodingPath]]);
-        }
+        NSString *keyPath = [self keyPathForBucket:bucketName key:keyName];
 
-        //generate correct hostName (use virtualHostStyle if possible)
-        NSString *host = nil;
-        if (!self.configuration.localTestingEnabled &&
-            bucketName &&
-            [bucketName aws_isVirtualHostedStyleCompliant]) {
-            if (isAccelerateModeEnabled) {
-                host = [NSString stringWithFormat:@"%@.%@", bucketName, AWSS3PreSignedURLBuilderAcceleratedEndpoint];
-            } else {
-                host = [NSString stringWithFormat:@"%@.%@", bucketName, endpoint.hostName];
-            }
-        } else {
-            host = endpoint.hostName;
-        }
+        NSString *host = [self hostForBucket:bucketName accelerateModeEnabled:isAccelerateModeEnabled];
         [getPreSignedURLRequest setValue:host forRequestHeader:@"host"];
         
         //If this is a presigned request for a multipart upload, set the uploadID and partNumber on the request.
@@ -293,15 +317,12 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
             [getPreSignedURLRequest setValue:[NSString stringWithFormat:@"%@", getPreSignedURLRequest.partNumber]
                          forRequestParameter:@"partNumber"];
         }
-        NSString *portNumber = endpoint.portNumber != nil ? [NSString stringWithFormat:@":%@", endpoint.portNumber.stringValue]: @"";
-        AWSEndpoint *newEndpoint = [[AWSEndpoint alloc]initWithRegion:configuration.regionType service:AWSServiceS3 URL:[NSURL URLWithString:[NSString stringWithFormat:@"%@://%@%@", endpoint.useUnsafeURL?@"http":@"https", host, portNumber]]];
+        AWSEndpoint *newEndpoint = [self endpointWithHost:host];
         
         int32_t expireDuration = [expires timeIntervalSinceNow];
-        if (expireDuration > 604800) {
-            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
-                                                              code:AWSS3PresignedURLErrorInvalidExpiresDate
-                                                          userInfo:@{NSLocalizedDescriptionKey: @"Invalid ExpiresDate, must be less than seven days in future"}]
-                    ];
+        NSError *error = [self validateExpireDuration:expireDuration];
+        if (error) {
+            return [AWSTask taskWithError:error];
         }
 
         return [AWSSignatureV4Signer  generateQueryStringForSignatureV4WithCredentialProvider:task.result
@@ -315,6 +336,85 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
     }];
 }
 
+- (AWSTask<NSArray<NSURL *> *> *)getPreSignedURLs:(AWSS3GetPreSignedURLRequest *)getPreSignedURLRequest
+                                          forKeys:(NSArray<NSString *> *)keys {
+    NSError *error = [self validatePreSignedURLRequest:getPreSignedURLRequest];
+    for (NSString *keyName in keys) {
+        if (error) {
+            break;
+        }
+        error = [self validateKeyName:keyName];
+    }
+    if (error) {
+        return [AWSTask taskWithError:error];
+    }
+
+    NSString *bucketName = getPreSignedURLRequest.bucket;
+    AWSHTTPMethod httpMethod = getPreSignedURLRequest.HTTPMethod;
+    NSDate *expires = getPreSignedURLRequest.expires;
+    NSTimeInterval minimumCredentialsExpirationInterval = getPreSignedURLRequest.minimumCredentialsExpirationInterval;
+    id<AWSCredentialsProvider>credentialsProvider = self.configuration.credentialsProvider;
+
+    // Unlike getPreSignedURL:, the request is not modified; the host header and multipart parameters go into copies.
+    NSString *host = [self hostForBucket:bucketName accelerateModeEnabled:getPreSignedURLRequest.isAccelerateModeEnabled];
+    NSMutableDictionary<NSString *, NSString *> *requestHeaders = [getPreSignedURLRequest.requestHeaders mutableCopy];
+    requestHeaders[@"host"] = host;
+    NSMutableDictionary<NSString *, NSString *> *requestParameters = [getPreSignedURLRequest.requestParameters mutableCopy];
+    if (getPreSignedURLRequest.uploadID
+        && getPreSignedURLRequest.partNumber) {
+        requestParameters[@"uploadId"] = getPreSignedURLRequest.uploadID;
+        requestParameters[@"partNumber"] = [NSString stringWithFormat:@"%@", getPreSignedURLRequest.partNumber];
+    }
+    AWSEndpoint *newEndpoint = [self endpointWithHost:host];
+
+    // The credentials are resolved once for the whole batch. With cached credentials every continuation runs inline, so
+    // the returned task has already completed.
+    return [[[credentialsProvider credentials] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
+        AWSCredentials *credentials = task.result;
+        if ([credentials.expiration timeIntervalSinceNow] < minimumCredentialsExpirationInterval) {
+            [credentialsProvider invalidateCachedTemporaryCredentials];
+            return [credentialsProvider credentials];
+        }
+
+        return task;
+    }] continueWithSuccessBlock:^id _Nullable(AWSTask<AWSCredentials *> * _Nonnull task) {
+        AWSCredentials *credentials = task.result;
+        if (!credentials) {
+            return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                                              code:AWSS3PreSignedURLErrorInternalError
+                                                          userInfo:@{NSLocalizedDescriptionKey: @"Credentials result unexpectedly nil generating presigned URLs"}]];
+        }
+
+        int32_t expireDuration = [expires timeIntervalSinceNow];
+        NSError *error = [self validateExpireDuration:expireDuration];
+        if (error) {
+            return [AWSTask taskWithError:error];
+        }
+
+        AWSSignatureV4URLPresigner *presigner = [[AWSSignatureV4URLPresigner alloc] initWithCredentials:credentials
+                                                                                             httpMethod:httpMethod
+                                                                                         expireDuration:expireDuration
+                                                                                               endpoint:newEndpoint
+                                                                                                   date:[NSDate aws_clockSkewFixedDate]
+                                                                                         requestHeaders:requestHeaders
+                                                                                      requestParameters:requestParameters];
+        NSMutableArray<NSURL *> *URLs = [NSMutableArray arrayWithCapacity:[keys count]];
+        for (NSString *keyName in keys) {
+            @autoreleasepool {
+                NSURL *URL = [presigner signedURLWithKeyPath:[self keyPathForBucket:bucketName key:keyName]];
+                if (!URL) {
+                    return [AWSTask taskWithError:[NSError errorWithDomain:AWSS3PresignedURLErrorDomain
+                                                                      code:AWSS3PreSignedURLErrorInternalError
+                                                                  userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"Failed to build a presigned URL for key %@", keyName]}]];
+                }
+                [URLs addObject:URL];
+            }
+        }
+
+        return URLs;
+    }];
+}
+
 @end
 
 @implementation AWSS3GetPreSignedURLRequest
@@ -157,6 +157,7 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
                                                                          
         AWSSignatureV4Signer *signer = [[AWSSignatureV4Signer alloc] initWithCredentialsProvider:_configuration.credentialsProvider
                                                                                         endpoint:_configuration.endpoint];
+        signer.chunkedEncodingChunkSize = _configuration.chunkedEncodingChunkSize;
         AWSNetworkingRequestInterceptor *baseInterceptor = [[AWSNetworkingRequestInterceptor alloc] initWithUserAgent:_configuration.userAgent];
         _configuration.requestInterceptors = @[baseInterceptor, signer];
 
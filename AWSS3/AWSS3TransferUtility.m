@@ -42,6 +42,7 @@ static NSString *const AWSS3TransferUtilityRetrySucceeded = @"AWSS3TransferUtili
 static NSUInteger const AWSS3TransferUtilityMultiPartSize = 5 * 1024 * 1024;
 static NSString *const AWSS3TransferUtiltityRequestTimeoutErrorCode = @"RequestTimeout";
 static int const AWSS3TransferUtilityMultiPartDefaultConcurrencyLimit = 5;
+static NSUInteger const AWSS3TransferUtilityRecoveryPageSize = 500;
 
 #pragma mark - Private classes
 
@@ -340,26 +341,35 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
 - (void) recover: (void (^)(NSError *_Nullable error)) completionHandler {
    
     AWSDDLogDebug(@"In Recovery for TU Session [%@]", _sessionIdentifier);
-    //Create temporary datastructures to hold the database records.
+    //Only the transfers recorded so far are recovered. Transfers started while recovery runs are left alone.
+    NSSet<NSString *> *transferIDs = [AWSS3TransferUtilityDatabaseHelper getTransferIDsFromDB:_sessionIdentifier databaseQueue:_databaseQueue];
     
-    //This dictionary will contain the master level info for a multipart transfer
-    NSMutableDictionary *tempMultiPartMasterTaskDictionary = [NSMutableDictionary new];
-    //This dictionary will contain details of indvidual transfers ( upload, downloads and subtasks)
-    NSMutableDictionary *tempTransferDictionary = [NSMutableDictionary new];
-    
-    //Hydrate from DB
-    [self hydrateFromDB:tempMultiPartMasterTaskDictionary
-       tempTransferDictionary:tempTransferDictionary];
-    
-    //Link Transfers to NSURL Session.
-    [self linkTransfersToNSURLSession:tempMultiPartMasterTaskDictionary tempTransferDictionary:tempTransferDictionary completionHandler:completionHandler];
+    //The rest of recovery reads and links the records in the background, so the transfer utility can be used right away.
+    //The completion handler is called once the recovered transfers have been linked to the NSURLSession.
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        //Create temporary datastructures to hold the database records.
+        
+        //This dictionary will contain the master level info for a multipart transfer
+        NSMutableDictionary *tempMultiPartMasterTaskDictionary = [NSMutableDictionary new];
+        //This dictionary will contain details of indvidual transfers ( upload, downloads and subtasks)
+        NSMutableDictionary *tempTransferDictionary = [NSMutableDictionary new];
+        
+        //Hydrate from DB
+        [self hydrateFromDB:tempMultiPartMasterTaskDictionary
+     tempTransferDictionary:tempTransferDictionary
+                transferIDs:transferIDs];
+        
+        //Link Transfers to NSURL Session.
+        [self linkTransfersToNSURLSession:tempMultiPartMasterTaskDictionary tempTransferDictionary:tempTransferDictionary completionHandler:completionHandler];
+    });
 }
 
 - (void) hydrateFromDB:(NSMutableDictionary *) tempMultiPartMasterTaskDictionary
       tempTransferDictionary: (NSMutableDictionary *) tempTransferDictionary
+                 transferIDs: (NSSet<NSString *> *) transferIDs
 {
-    //Get All Tasks from DB
-    NSMutableArray *tasks = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:_sessionIdentifier databaseQueue:_databaseQueue];
+    //Get the transfer records from DB. Parts are read per multipart upload below.
+    NSMutableArray *tasks = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:_sessionIdentifier transferIDs:transferIDs databaseQueue:_databaseQueue];
     
     //Iterate through the tasks and populate transferRequests and Multipart dictionary.
     for( NSMutableDictionary *task in tasks ) {
@@ -409,27 +419,59 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             [tempMultiPartMasterTaskDictionary setObject:transferUtilityMultiPartUploadTask forKey:transferUtilityMultiPartUploadTask.uploadID];
             AWSDDLogDebug(@"Found MultiPartUpload [%@] with Multipart ID [%@] and status [%@]",transferUtilityMultiPartUploadTask.transferID,transferUtilityMultiPartUploadTask.uploadID, @(transferUtilityMultiPartUploadTask.status) );
         }
-        else if ([transferType isEqualToString:@"MULTI_PART_UPLOAD_SUB_TASK"]) {
-            AWSS3TransferUtilityUploadSubTask *subTask = [self hydrateMultiPartUploadSubTask:task sessionTaskID:sessionTaskID];
-            AWSDDLogDebug(@"Found MultiPartUpload SubTask [%@] with taskNumber [%@] and status [%@]",subTask.transferID,@(subTask.taskIdentifier), @(subTask.status) );
-            
-            //Get the Master MultiPart record from the Dictionary.
-            AWSS3TransferUtilityMultiPartUploadTask *multiPartUploadTask = [tempMultiPartMasterTaskDictionary objectForKey:subTask.uploadID];
-            if ( !multiPartUploadTask ) {
-                //Couldn't find the multipart upload master record. Must be an orphan part record. Clean up the DB and continue.
-                [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:subTask.transferID databaseQueue:self->_databaseQueue];
-                continue;
-            }
-            //Check if the subTask is is already completed. If it is, add it to the completed parts list, update the progress object and go to the next iteration of the loop
-            if (subTask.status== AWSS3TransferUtilityTransferStatusCompleted ) {
-                [multiPartUploadTask.completedPartsSet addObject:subTask];
-                continue;
+    }
+    
+    //Part records whose multipart upload record is gone are orphans. Clean up the DB.
+    [AWSS3TransferUtilityDatabaseHelper deleteOrphanedSubTasksFromDB:_sessionIdentifier databaseQueue:_databaseQueue];
+    
+    for (AWSS3TransferUtilityMultiPartUploadTask *multiPartUploadTask in [tempMultiPartMasterTaskDictionary allValues]) {
+        [self hydrateSubTasksForMultiPartUploadTask:multiPartUploadTask tempTransferDictionary:tempTransferDictionary];
+    }
+}
+
+- (void) hydrateSubTasksForMultiPartUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *) multiPartUploadTask
+                        tempTransferDictionary:(NSMutableDictionary *) tempTransferDictionary
+{
+    //Read the parts a page at a time in part number order.
+    NSInteger lastPartNumber = 0;
+    NSUInteger count = 0;
+    do {
+        @autoreleasepool {
+            NSMutableArray *tasks = [AWSS3TransferUtilityDatabaseHelper getMultiPartUploadSubTaskDataFromDB:multiPartUploadTask.transferID
+                                                                                            afterPartNumber:lastPartNumber
+                                                                                                      limit:AWSS3TransferUtilityRecoveryPageSize
+                                                                                              databaseQueue:_databaseQueue];
+            count = [tasks count];
+            for (NSMutableDictionary *task in tasks) {
+                int sessionTaskID = [[task objectForKey:@"session_task_id"] intValue];
+                AWSS3TransferUtilityUploadSubTask *subTask = [self hydrateMultiPartUploadSubTask:task sessionTaskID:sessionTaskID];
+                AWSDDLogDebug(@"Found MultiPartUpload SubTask [%@] with taskNumber [%@] and status [%@]",subTask.transferID,@(subTask.taskIdentifier), @(subTask.status) );
+                lastPartNumber = [subTask.partNumber integerValue];
+                
+                //Check if the subTask is is already completed. If it is, add it to the completed parts list and go to the next iteration of the loop
+                if (subTask.status== AWSS3TransferUtilityTransferStatusCompleted ) {
+                    [multiPartUploadTask.completedPartsSet addObject:subTask];
+                    continue;
+                }
+                
+                //Parts that were never given a session task go back in the queue, up to a page of them. Paging keeps them in part order.
+                //The rest stay in the database until the queue runs out.
+                if (sessionTaskID == 0 && subTask.status == AWSS3TransferUtilityTransferStatusWaiting) {
+                    if (multiPartUploadTask.pendingPartsInDBAfterPartNumber == nil) {
+                        if ([multiPartUploadTask.pendingPartsQueue count] < AWSS3TransferUtilityRecoveryPageSize) {
+                            [multiPartUploadTask.pendingPartsQueue addObject:subTask];
+                        } else {
+                            multiPartUploadTask.pendingPartsInDBAfterPartNumber = [multiPartUploadTask.pendingPartsQueue lastObject].partNumber;
+                        }
+                    }
+                    continue;
+                }
+                
+                //The subTask must be in In_Progress, Waiting or Paused status. Lodge it in the temporary Dictionary for linking.
+                [tempTransferDictionary setObject:subTask forKey:@(sessionTaskID)];
             }
-            
-            //The subTask must be in In_Progress, Waiting or Paused status. Lodge it in the temporary Dictionary for linking.
-            [tempTransferDictionary setObject:subTask forKey:@(sessionTaskID)];
         }
-    }
+    } while (count == AWSS3TransferUtilityRecoveryPageSize);
 }
 
 - (void) linkTransfersToNSURLSession:(NSMutableDictionary *) tempMultiPartMasterTaskDictionary
@@ -653,26 +695,6 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             continue;
         }
         
-        long numberOfPartsInProgress = 0;
-        while (numberOfPartsInProgress < [self.transferUtilityConfiguration.multiPartConcurrencyLimit integerValue]) {
-            if ([multiPartUploadTask.waitingPartsDictionary count] > 0) {
-                //Get a part from the waitingList
-                AWSS3TransferUtilityUploadSubTask *nextSubTask = [[multiPartUploadTask.waitingPartsDictionary allValues] objectAtIndex:0];
-                
-                //Add to inProgress list
-                [multiPartUploadTask.inProgressPartsDictionary setObject:nextSubTask forKey:@(nextSubTask.taskIdentifier)];
-               
-                //Remove it from the waitingList
-                [multiPartUploadTask.waitingPartsDictionary removeObjectForKey:@(nextSubTask.taskIdentifier)];
-                AWSDDLogDebug(@"Moving Task[%@] to progress for Multipart[%@]", @(nextSubTask.taskIdentifier), multiPartUploadTask.uploadID);
-                [nextSubTask.sessionTask resume];
-            
-                numberOfPartsInProgress++;
-                continue;
-            }
-            break;
-        }
-
         // move suspended tasks from in progress to waiting to allow multipart upload process to run properly
         NSMutableArray *inProgressAndSuspendedTasks = @[].mutableCopy;
 
@@ -687,6 +709,12 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             [multiPartUploadTask.inProgressPartsDictionary removeObjectForKey:@(aSubTask.taskIdentifier)];
             [multiPartUploadTask.waitingPartsDictionary setObject:aSubTask forKey:@(aSubTask.taskIdentifier)];
         }
+
+        //Fill the free slots from the waiting parts and then the queue, in part order.
+        NSError *schedulingError = [self startNextPartsForMultiPartUploadTask:multiPartUploadTask];
+        if (schedulingError) {
+            [self failMultiPartUploadTask:multiPartUploadTask error:schedulingError];
+        }
     }
 }
 
@@ -1216,6 +1244,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
         
         AWSDDLogInfo(@"Initiated multipart upload on server: %@", output.uploadId);
         AWSDDLogInfo(@"Concurrency Limit is %@", self.transferUtilityConfiguration.multiPartConcurrencyLimit);
+        NSMutableArray<AWSS3TransferUtilityUploadSubTask *> *subTasks = [NSMutableArray arrayWithCapacity:partCount];
         //Loop through the file and upload the parts one by one
         for (int32_t i = 1; i <= partCount ; i++) {
             NSUInteger dataLength = AWSS3TransferUtilityMultiPartSize;
@@ -1235,7 +1264,7 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             
             NSError *subTaskCreationError;
             
-            //Move to inProgress or Waiting based on concurrency limit
+            //Create the parts that fit in the concurrency limit. The rest are queued in part order and created as earlier parts finish.
             if (i <= [self.transferUtilityConfiguration.multiPartConcurrencyLimit integerValue]) {
                 subTaskCreationError = [self createUploadSubTask:transferUtilityMultiPartUploadTask subTask:subTask startTransfer:NO internalDictionaryToAddSubTaskTo:transferUtilityMultiPartUploadTask.inProgressPartsDictionary];
                 if(!subTaskCreationError) {
@@ -1244,17 +1273,12 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
                 }
             }
             else {
-                subTaskCreationError = [self createUploadSubTask:transferUtilityMultiPartUploadTask subTask:subTask startTransfer:NO internalDictionaryToAddSubTaskTo:transferUtilityMultiPartUploadTask.waitingPartsDictionary];
-                if (!subTaskCreationError ) {
-                    subTask.status = AWSS3TransferUtilityTransferStatusWaiting;
-                    AWSDDLogDebug(@"Added task for part [%@] to Waiting list", subTask.partNumber);
-                }
+                subTask.status = AWSS3TransferUtilityTransferStatusWaiting;
+                [transferUtilityMultiPartUploadTask.pendingPartsQueue addObject:subTask];
             }
             
             if (!subTaskCreationError) {
-                //Save in Database after the file has been created, so that file can be referenced incase upload is paused and needs to be restarted.
-                [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTaskInDB:transferUtilityMultiPartUploadTask subTask:subTask
-            databaseQueue:self.databaseQueue];
+                [subTasks addObject:subTask];
             } else {
                 //Abort the request, so the server can clean up any partials.
                 [self callAbortMultiPartForUploadTask:transferUtilityMultiPartUploadTask];
@@ -1268,12 +1292,19 @@ static AWSS3TransferUtility *_defaultS3TransferUtility = nil;
             
         }
         
+        //Save in Database after the files have been created, so that they can be referenced incase upload is paused and needs to be restarted.
+        //Queued parts are saved without a session task, which is how recovery tells them apart.
+        [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:transferUtilityMultiPartUploadTask
+                                                                            subTasks:subTasks
+                                                                       databaseQueue:self.databaseQueue];
+        
         //Start the subTasks
         for(id taskIdentifier in transferUtilityMultiPartUploadTask.inProgressPartsDictionary) {
             AWSS3TransferUtilityUploadSubTask *subTask = [transferUtilityMultiPartUploadTask.inProgressPartsDictionary objectForKey:taskIdentifier];
             AWSDDLogDebug(@"Starting subTask %@", @(subTask.taskIdentifier));
-            [subTask.sessionTask resume];
+            [self resumeUploadSubTask:subTask];
         }
+        [self prefetchNextPartForMultiPartUploadTask:transferUtilityMultiPartUploadTask];
         
         return [AWSTask taskWithResult:transferUtilityMultiPartUploadTask];
     }];
@@ -1428,15 +1459,14 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
        internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAddSubTaskTo
 {
     __block NSError *error = nil;
-    //Create a temporary part file if required.
-    if (!(subTask.file || [subTask.file isEqualToString:@""]) || ![[NSFileManager defaultManager] fileExistsAtPath:subTask.file]) {
-        //Create a temporary file for this part.
-        NSString * partFileName = [self createTemporaryFileForPart:transferUtilityMultiPartUploadTask.file partNumber:[subTask.partNumber integerValue] dataLength:subTask.totalBytesExpectedToSend error:&error];
-        if (partFileName == nil)  {
-            //Unable to create partFile. Send back error object to indicate that createUploadSubtask failed.
-            return error;
-        }
-        subTask.file = partFileName;
+    //Wait for the part file if it is being prefetched.
+    if (subTask.prefetchTask) {
+        [subTask.prefetchTask waitUntilFinished];
+        subTask.prefetchTask = nil;
+    }
+    if (![self preparePartForMultiPartUploadTask:transferUtilityMultiPartUploadTask subTask:subTask error:&error]) {
+        //Unable to create partFile. Send back error object to indicate that createUploadSubtask failed.
+        return error;
     }
     
     //Create a presignedURL for this part.
@@ -1455,9 +1485,8 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
     
     [transferUtilityMultiPartUploadTask.expression assignRequestParameters:request];
 
-    NSString *contentMD5 = nil;
-    if (transferUtilityMultiPartUploadTask.expression.useContentMD5) {
-        contentMD5 = [NSString aws_base64md5FromData: [NSData dataWithContentsOfFile: subTask.file]];
+    NSString *contentMD5 = subTask.contentMD5;
+    if (contentMD5 != nil) {
         [request setContentMD5: contentMD5];
     }
 
@@ -1511,10 +1540,13 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
                                                                status:subTask.status
                                                           retry_count:transferUtilityMultiPartUploadTask.retryCount
                                                         databaseQueue:self.databaseQueue];
+        //Recovery links parts to NSURLSession tasks by this ID. A part whose ID was still held when the app died looks
+        //like it never started and would be uploaded a second time, so it is written before the task is resumed.
+        [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:self.databaseQueue];
 
         if (startTransfer) {
             AWSDDLogDebug(@"[CreateUploadSubTask] startTransfer is true, Starting subTask %@", @(subTask.taskIdentifier));
-            [subTask.sessionTask resume];
+            [self resumeUploadSubTask:subTask];
         }
        
         return nil;
@@ -1543,6 +1575,7 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
     if (![[NSFileManager defaultManager] fileExistsAtPath:subTask.file]) {
         //Set it to nil. This will force the creatUploadSubTask to create the part from the main file
         subTask.file = nil;
+        subTask.contentMD5 = nil;
     }
     
     NSError *subTaskCreationError;
@@ -1564,6 +1597,108 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
     }
 }
 
+#pragma mark - Multipart part scheduling
+
+-(BOOL) preparePartForMultiPartUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *) transferUtilityMultiPartUploadTask
+                                  subTask:(AWSS3TransferUtilityUploadSubTask *) subTask
+                                    error:(NSError **) error {
+    NSDate *startDate = [NSDate date];
+    //Create a temporary part file if required.
+    if ([subTask.file length] == 0 || ![[NSFileManager defaultManager] fileExistsAtPath:subTask.file]) {
+        NSString *partFileName = [self createTemporaryFileForPart:transferUtilityMultiPartUploadTask.file partNumber:[subTask.partNumber integerValue] dataLength:subTask.totalBytesExpectedToSend error:error];
+        if (partFileName == nil) {
+            return NO;
+        }
+        subTask.file = partFileName;
+        subTask.contentMD5 = nil;
+    }
+    if (transferUtilityMultiPartUploadTask.expression.useContentMD5 && subTask.contentMD5 == nil) {
+        subTask.contentMD5 = [NSString aws_base64md5FromData:[NSData dataWithContentsOfFile:subTask.file]];
+    }
+    subTask.preparationDuration += -[startDate timeIntervalSinceNow];
+    return YES;
+}
+
+-(void) loadPendingPartsForMultiPartUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *) transferUtilityMultiPartUploadTask {
+    NSNumber *afterPartNumber = transferUtilityMultiPartUploadTask.pendingPartsInDBAfterPartNumber;
+    if (afterPartNumber == nil || [transferUtilityMultiPartUploadTask.pendingPartsQueue count] > 0) {
+        return;
+    }
+    NSMutableArray *tasks = [AWSS3TransferUtilityDatabaseHelper getPendingMultiPartUploadSubTaskDataFromDB:transferUtilityMultiPartUploadTask.transferID
+                                                                                           afterPartNumber:[afterPartNumber integerValue]
+                                                                                                     limit:AWSS3TransferUtilityRecoveryPageSize
+                                                                                             databaseQueue:_databaseQueue];
+    for (NSMutableDictionary *task in tasks) {
+        [transferUtilityMultiPartUploadTask.pendingPartsQueue addObject:[self hydrateMultiPartUploadSubTask:task sessionTaskID:0]];
+    }
+    transferUtilityMultiPartUploadTask.pendingPartsInDBAfterPartNumber = [tasks count] == AWSS3TransferUtilityRecoveryPageSize ? [transferUtilityMultiPartUploadTask.pendingPartsQueue lastObject].partNumber : nil;
+    AWSDDLogDebug(@"Read %lu pending parts for Multipart[%@]", (unsigned long)[tasks count], transferUtilityMultiPartUploadTask.uploadID);
+}
+
+-(void) prefetchNextPartForMultiPartUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *) transferUtilityMultiPartUploadTask {
+    AWSS3TransferUtilityUploadSubTask *subTask = [transferUtilityMultiPartUploadTask.pendingPartsQueue firstObject];
+    if (subTask == nil || subTask.prefetchTask || transferUtilityMultiPartUploadTask.cancelled) {
+        return;
+    }
+    //Read the next part and compute its checksum while the parts in flight upload, so that it can start as soon as a slot frees up.
+    AWSExecutor *executor = [AWSExecutor executorForPoolNamed:AWSExecutorPoolNameSerialization];
+    subTask.prefetchTask = [AWSTask taskFromExecutor:executor withBlock:^id _Nullable{
+        NSError *error = nil;
+        if (![self preparePartForMultiPartUploadTask:transferUtilityMultiPartUploadTask subTask:subTask error:&error]) {
+            //createUploadSubTask will try again and report the error.
+            AWSDDLogDebug(@"Unable to prefetch part [%@] for Multipart[%@]: %@", subTask.partNumber, transferUtilityMultiPartUploadTask.uploadID, error);
+        }
+        return nil;
+    }];
+}
+
+-(void) resumeUploadSubTask:(AWSS3TransferUtilityUploadSubTask *) subTask {
+    subTask.transferStartDate = [NSDate date];
+    [subTask.sessionTask resume];
+}
+
+-(AWSS3TransferUtilityUploadSubTask *) nextWaitingPartForMultiPartUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *) transferUtilityMultiPartUploadTask {
+    //Waiting parts already have a session task. There are at most a handful of them: parts being retried and parts restored by recovery.
+    AWSS3TransferUtilityUploadSubTask *nextSubTask = nil;
+    for (AWSS3TransferUtilityUploadSubTask *subTask in [transferUtilityMultiPartUploadTask.waitingPartsDictionary objectEnumerator]) {
+        if (nextSubTask == nil || [subTask.partNumber compare:nextSubTask.partNumber] == NSOrderedAscending) {
+            nextSubTask = subTask;
+        }
+    }
+    return nextSubTask;
+}
+
+-(NSError *) startNextPartsForMultiPartUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *) transferUtilityMultiPartUploadTask {
+    NSInteger concurrencyLimit = [self.transferUtilityConfiguration.multiPartConcurrencyLimit integerValue];
+    while ([transferUtilityMultiPartUploadTask.inProgressPartsDictionary count] < concurrencyLimit) {
+        //Parts that already have a session task go first, lowest part number first.
+        AWSS3TransferUtilityUploadSubTask *nextSubTask = [self nextWaitingPartForMultiPartUploadTask:transferUtilityMultiPartUploadTask];
+        if (nextSubTask) {
+            [transferUtilityMultiPartUploadTask.inProgressPartsDictionary setObject:nextSubTask forKey:@(nextSubTask.taskIdentifier)];
+            [transferUtilityMultiPartUploadTask.waitingPartsDictionary removeObjectForKey:@(nextSubTask.taskIdentifier)];
+            AWSDDLogDebug(@"Moving Task[%@] to progress for Multipart[%@]", @(nextSubTask.taskIdentifier), transferUtilityMultiPartUploadTask.uploadID);
+            [self resumeUploadSubTask:nextSubTask];
+            continue;
+        }
+        
+        //Then the queued parts, in part order.
+        [self loadPendingPartsForMultiPartUploadTask:transferUtilityMultiPartUploadTask];
+        nextSubTask = [transferUtilityMultiPartUploadTask.pendingPartsQueue firstObject];
+        if (nextSubTask == nil) {
+            break;
+        }
+        [transferUtilityMultiPartUploadTask.pendingPartsQueue removeObjectAtIndex:0];
+        NSError *subTaskCreationError = [self createUploadSubTask:transferUtilityMultiPartUploadTask subTask:nextSubTask startTransfer:YES internalDictionaryToAddSubTaskTo:transferUtilityMultiPartUploadTask.inProgressPartsDictionary];
+        if (subTaskCreationError) {
+            return subTaskCreationError;
+        }
+        AWSDDLogDebug(@"Started part [%@] as Task[%@] for Multipart[%@]", nextSubTask.partNumber, @(nextSubTask.taskIdentifier), transferUtilityMultiPartUploadTask.uploadID);
+    }
+    [self loadPendingPartsForMultiPartUploadTask:transferUtilityMultiPartUploadTask];
+    [self prefetchNextPartForMultiPartUploadTask:transferUtilityMultiPartUploadTask];
+    return nil;
+}
+
 #pragma mark - Download methods
 
 - (AWSTask<AWSS3TransferUtilityDownloadTask *> *)downloadDataForKey:(NSString *)key
@@ -1922,6 +2057,8 @@ internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAd
     compReq.uploadId = uploadTask.uploadID;
     compReq.multipartUpload = multipartUpload;
     
+    //Write the held part updates first, so that the database has every part's ETag if the app dies during the request.
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:self.databaseQueue];
     return [self.s3 completeMultipartUpload:compReq];
 }
 
@@ -1977,6 +2114,9 @@ handleEventsForBackgroundURLSession:(NSString *)identifier
 
 - (void)URLSessionDidFinishEventsForBackgroundURLSession:(NSURLSession *)session {
     AWSDDLogDebug(@"URLSessionDidFinishEventsForBackgroundURLSession called for NSURLSession %@", _sessionIdentifier);
+    //The app is suspended once the completion handler is called, and after a background relaunch it gets no
+    //notification that would write the held part updates, so they are written here.
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:self.databaseQueue];
     dispatch_async(dispatch_get_main_queue(), ^{
         if (self.backgroundURLSessionCompletionHandler) {
             self.backgroundURLSessionCompletionHandler();
@@ -2153,28 +2293,7 @@ didCompleteWithError:(NSError *)error {
                 NSError *updatedError = [[NSError alloc] initWithDomain:error.domain code:error.code userInfo:userInfo];
                 
                 //Error is not retriable.
-                transferUtilityMultiPartUploadTask.error = updatedError;
-                transferUtilityMultiPartUploadTask.status = AWSS3TransferUtilityTransferStatusError;
-                
-                //Execute call back if provided.
-                [self completeTask:transferUtilityMultiPartUploadTask];
-
-                //Make sure all other parts that are in progress are canceled.
-                for (NSNumber *key in [transferUtilityMultiPartUploadTask.inProgressPartsDictionary allKeys]) {
-                    AWSS3TransferUtilityUploadSubTask *subTask = [transferUtilityMultiPartUploadTask.inProgressPartsDictionary objectForKey:key];
-                    [subTask.sessionTask cancel];
-                }
-
-                for (NSNumber *key in [transferUtilityMultiPartUploadTask.waitingPartsDictionary allKeys]) {
-                    AWSS3TransferUtilityUploadSubTask *subTask = [transferUtilityMultiPartUploadTask.waitingPartsDictionary objectForKey:key];
-                    [subTask.sessionTask cancel];
-                }
-
-                //Abort the request, so the server can clean up any partials.
-                [self callAbortMultiPartForUploadTask:transferUtilityMultiPartUploadTask];
-                
-                //clean up.
-                [self cleanupForMultiPartUploadTask:transferUtilityMultiPartUploadTask];
+                [self failMultiPartUploadTask:transferUtilityMultiPartUploadTask error:updatedError];
                 return;
             }
             
@@ -2190,6 +2309,12 @@ didCompleteWithError:(NSError *)error {
             //Delete the temporary upload file for this subTask
             [self removeFile:subTask.file];
             subTask.status = AWSS3TransferUtilityTransferStatusCompleted;
+            if (subTask.transferStartDate) {
+                subTask.transferDuration = -[subTask.transferStartDate timeIntervalSinceNow];
+            }
+            AWSDDLogInfo(@"Part [%@] of Multipart[%@]: %lld bytes prepared in %.3fs and uploaded in %.3fs",
+                         subTask.partNumber, transferUtilityMultiPartUploadTask.uploadID, subTask.totalBytesExpectedToSend,
+                         subTask.preparationDuration, subTask.transferDuration);
             
             //Update Database
             [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:subTask.transferID
@@ -2199,28 +2324,13 @@ didCompleteWithError:(NSError *)error {
                                                                    status:subTask.status
                                                               retry_count:transferUtilityMultiPartUploadTask.retryCount databaseQueue:self.databaseQueue];
             
-            //If there are parts waiting to be uploaded, pick from the waiting parts list and move it to inProgress
-            if ([transferUtilityMultiPartUploadTask.waitingPartsDictionary count] > 0) {
-                long numberOfPartsInProgress = [transferUtilityMultiPartUploadTask.inProgressPartsDictionary count];
-                while (numberOfPartsInProgress < [self.transferUtilityConfiguration.multiPartConcurrencyLimit integerValue]) {
-                    if ([transferUtilityMultiPartUploadTask.waitingPartsDictionary count] > 0) {
-                        //Get a part from the waitingList
-                        AWSS3TransferUtilityUploadSubTask *nextSubTask = [[transferUtilityMultiPartUploadTask.waitingPartsDictionary allValues] objectAtIndex:0];
-                        
-                        //Add to inProgress list
-                        [transferUtilityMultiPartUploadTask.inProgressPartsDictionary setObject:nextSubTask forKey:@(nextSubTask.taskIdentifier)];
-                        
-                        //Remove it from the waitingList
-                        [transferUtilityMultiPartUploadTask.waitingPartsDictionary removeObjectForKey:@(nextSubTask.taskIdentifier)];
-                        AWSDDLogDebug(@"Moving Task[%@] to progress for Multipart[%@]", @(nextSubTask.taskIdentifier), transferUtilityMultiPartUploadTask.uploadID);
-                        [nextSubTask.sessionTask resume];
-                        numberOfPartsInProgress++;
-                        continue;
-                    }
-                    break;
-                }
+            //If there are parts waiting to be uploaded, start the next ones in part order.
+            NSError *schedulingError = [self startNextPartsForMultiPartUploadTask:transferUtilityMultiPartUploadTask];
+            if (schedulingError) {
+                [self failMultiPartUploadTask:transferUtilityMultiPartUploadTask error:schedulingError];
+                return;
             }
-            else if ([transferUtilityMultiPartUploadTask.inProgressPartsDictionary count] == 0) {
+            if ([transferUtilityMultiPartUploadTask.inProgressPartsDictionary count] == 0) {
                 //If there are no more inProgress parts, then we are done.
                 
                 //Validate that all the content has been uploaded.
@@ -2429,6 +2539,32 @@ totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend {
 
 }
 
+- (void) failMultiPartUploadTask: (AWSS3TransferUtilityMultiPartUploadTask *) task
+                           error: (NSError *) error {
+    task.error = error;
+    task.status = AWSS3TransferUtilityTransferStatusError;
+    
+    //Execute call back if provided.
+    [self completeTask:task];
+    
+    //Make sure all other parts that are in progress are canceled.
+    for (NSNumber *key in [task.inProgressPartsDictionary allKeys]) {
+        AWSS3TransferUtilityUploadSubTask *subTask = [task.inProgressPartsDictionary objectForKey:key];
+        [subTask.sessionTask cancel];
+    }
+    
+    for (NSNumber *key in [task.waitingPartsDictionary allKeys]) {
+        AWSS3TransferUtilityUploadSubTask *subTask = [task.waitingPartsDictionary objectForKey:key];
+        [subTask.sessionTask cancel];
+    }
+    
+    //Abort the request, so the server can clean up any partials.
+    [self callAbortMultiPartForUploadTask:task];
+    
+    //clean up.
+    [self cleanupForMultiPartUploadTask:task];
+}
+
 - (void) cleanupForMultiPartUploadTask: (AWSS3TransferUtilityMultiPartUploadTask *) task  {
     
     //Add it to list of completed Tasks
@@ -2439,6 +2575,19 @@ totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend {
         [self.taskDictionary removeObjectForKey:@(subTask.taskIdentifier)];
         [self removeFile:subTask.file];
     }
+    for ( AWSS3TransferUtilityUploadSubTask *subTask in [task.waitingPartsDictionary allValues] ) {
+        [self.taskDictionary removeObjectForKey:@(subTask.taskIdentifier)];
+        [self removeFile:subTask.file];
+    }
+    
+    //Only the head of the queue can have a part file, from prefetching.
+    AWSS3TransferUtilityUploadSubTask *nextSubTask = [task.pendingPartsQueue firstObject];
+    if (nextSubTask.prefetchTask) {
+        [nextSubTask.prefetchTask waitUntilFinished];
+        [self removeFile:nextSubTask.file];
+    }
+    [task.pendingPartsQueue removeAllObjects];
+    task.pendingPartsInDBAfterPartNumber = nil;
     
     //Remove temporary file if required.
     if (task.temporaryFileCreated) {
@@ -13,6 +13,7 @@
 // permissions and limitations under the License.
 //
 
+#import <UIKit/UIKit.h>
 #import <AWSCore/AWSFMDB.h>
 #import "AWSS3TransferUtilityDatabaseHelper.h"
 #import "AWSS3TransferUtility.h"
@@ -22,11 +23,70 @@
 //Constants for DB
 NSString *const AWSS3TransferUtilityDatabaseDirectory = @"/com/amazonaws/AWSS3TransferUtility/";
 NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
+// Recorded in PRAGMA user_version. Version 1 adds the awstransfer indexes.
+uint32_t const AWSS3TransferUtilityDatabaseSchemaVersion = 1;
+// How long part status updates are held so that updates arriving close together share one transaction.
+NSTimeInterval const AWSS3TransferUtilityDatabaseUpdateCoalescingDelay = 0.5;
+
+static NSString *const AWSS3TransferUtiltyInsertIntoAWSTransfer = @"INSERT INTO awstransfer ("
+@"transfer_id,ns_url_session_id, session_task_id, transfer_type, bucket_name, key, part_number, multi_part_id, etag, file, "
+@"temporary_file_created, content_length, status, retry_count, request_headers, request_parameters"
+@") VALUES ("
+@":transfer_id,:ns_url_session_id, :session_task_id, :transfer_type, :bucket_name, :key, :part_number, :multi_part_id, :etag, :file, :temporary_file_created, :content_length, "
+@":status, :retry_count, :request_headers, :request_parameters"
+@")";
+
+static NSString *const AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag = @"UPDATE awstransfer "
+@"SET status=:status, etag = :etag, session_task_id = :session_task_id, retry_count = :retry_count "
+@"WHERE transfer_id=:transfer_id and "
+@"      part_number =:part_number ";
+
+// Part status updates that have not been written yet, keyed by transfer ID and part number.
+@interface AWSS3TransferUtilityPendingUpdates : NSObject
+
+@property (nonatomic, strong) NSMutableDictionary<NSString *, NSDictionary *> *updates;
+@property (nonatomic, assign) BOOL flushScheduled;
+
+@end
+
+@implementation AWSS3TransferUtilityPendingUpdates
+
+- (instancetype)init {
+    if (self = [super init]) {
+        _updates = [NSMutableDictionary new];
+    }
+    return self;
+}
+
+@end
 
 #pragma mark - AWSS3 Transfer Utility Database Functions
 
 @implementation AWSS3TransferUtilityDatabaseHelper
 
+// One set of pending updates per database queue. The queues are held weakly.
++ (NSMapTable<AWSFMDatabaseQueue *, AWSS3TransferUtilityPendingUpdates *> *) pendingUpdatesByDatabaseQueue {
+    static NSMapTable *pendingUpdatesByDatabaseQueue = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        pendingUpdatesByDatabaseQueue = [NSMapTable weakToStrongObjectsMapTable];
+
+        //The app may be suspended or killed before the delayed flush runs, so pending updates are written right away.
+        void (^flushAllPendingUpdates)(NSNotification *) = ^(NSNotification *notification) {
+            [AWSS3TransferUtilityDatabaseHelper flushAllPendingUpdates];
+        };
+        [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationDidEnterBackgroundNotification
+                                                          object:nil
+                                                           queue:nil
+                                                      usingBlock:flushAllPendingUpdates];
+        [[NSNotificationCenter defaultCenter] addObserverForName:UIApplicationWillTerminateNotification
+                                                          object:nil
+                                                           queue:nil
+                                                      usingBlock:flushAllPendingUpdates];
+    });
+    return pendingUpdatesByDatabaseQueue;
+}
+
 + (AWSFMDatabaseQueue *) createDatabase:(NSString*) cacheDirectoryPath {
     //Create temporary Dir to hold DB
     NSString *const AWSS3TransferUtilityCreateAWSTransfer =  @"CREATE TABLE IF NOT EXISTS awstransfer ("
@@ -62,7 +122,7 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     NSString * databasePath = [dbDirPath stringByAppendingString:AWSS3TransferUtilityDatabaseName];
     //Open the database if the directory exists
     AWSDDLogInfo(@"Transfer Utility Database Path: [%@]", databasePath);
-    AWSFMDatabaseQueue *databaseQueue = [AWSFMDatabaseQueue databaseQueueWithPath: databasePath];
+    AWSFMDatabaseQueue *databaseQueue = [AWSFMDatabaseReadWriteQueue readWriteQueueWithPath: databasePath];
     
     if (!databaseQueue) {
         AWSDDLogError(@"Unable to create Database Queue for [%@]", databasePath);
@@ -72,11 +132,35 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     [databaseQueue inDatabase:^(AWSFMDatabase *db) {
         if (! [db executeUpdate: AWSS3TransferUtilityCreateAWSTransfer]) {
             AWSDDLogError(@"Failed to create awstransfer Database table. [%@]", db.lastError);
+            return;
         }
+        [AWSS3TransferUtilityDatabaseHelper migrateDatabase:db];
     }];
     return databaseQueue;
 }
 
++ (void) migrateDatabase:(AWSFMDatabase *) db {
+    uint32_t schemaVersion = [db userVersion];
+    if (schemaVersion >= AWSS3TransferUtilityDatabaseSchemaVersion) {
+        return;
+    }
+
+    [db beginTransaction];
+    BOOL result = YES;
+    if (schemaVersion < 1) {
+        //Part updates and deletes look rows up by transfer ID, and hydration reads a session's rows in transfer and part order.
+        result = [db executeUpdate:@"CREATE INDEX IF NOT EXISTS awstransfer_transfer_id_part_number ON awstransfer (transfer_id, part_number)"]
+        && [db executeUpdate:@"CREATE INDEX IF NOT EXISTS awstransfer_ns_url_session_id ON awstransfer (ns_url_session_id, transfer_id, part_number)"];
+    }
+    if (result) {
+        [db setUserVersion:AWSS3TransferUtilityDatabaseSchemaVersion];
+        [db commit];
+    } else {
+        AWSDDLogError(@"Failed to migrate the awstransfer Database table to version [%u]. [%@]", AWSS3TransferUtilityDatabaseSchemaVersion, db.lastError);
+        [db rollback];
+    }
+}
+
 
 //Delete a transfer request given its transfer ID
 + (void) deleteTransferRequestFromDB:(NSString *) transferID
@@ -84,6 +168,7 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     NSString *const AWSS3TransferUtilityDeleteTransfer =  @"DELETE FROM awstransfer "
     @"WHERE transfer_id=:transfer_id";
     
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:databaseQueue];
     [databaseQueue inDatabase:^(AWSFMDatabase *db) {
         BOOL result = [db executeUpdate: AWSS3TransferUtilityDeleteTransfer
                 withParameterDictionary:@{
@@ -106,6 +191,7 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     NSString *const AWSS3TransferUtilityDeleteATask =  @"DELETE FROM awstransfer "
     @"WHERE transfer_id=:transfer_id and "
     @"      session_task_id=:session_task_id ";
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:databaseQueue];
     [databaseQueue inDatabase:^(AWSFMDatabase *db) {
         BOOL result = [db executeUpdate:AWSS3TransferUtilityDeleteATask
                 withParameterDictionary:@{
@@ -127,20 +213,27 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
                             status: (AWSS3TransferUtilityTransferStatusType) status
                        retry_count: (NSUInteger) retryCount
                      databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
-    NSString *const AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag = @"UPDATE awstransfer "
-    @"SET status=:status, etag = :etag, session_task_id = :session_task_id, retry_count = :retry_count "
-    @"WHERE transfer_id=:transfer_id and "
-    @"      part_number =:part_number ";
+    NSDictionary *parameters = @{
+                                 @"transfer_id": transferID,
+                                 @"session_task_id": @(taskIdentifier),
+                                 @"etag": eTag,
+                                 @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:status],
+                                 @"part_number": partNumber,
+                                 @"retry_count": @(retryCount)
+                                 };
+
+    //The record for the transfer itself is written right away. Part records change once or twice per part, so their
+    //updates are held briefly and written together; a later update to the same part replaces an earlier one.
+    if ([partNumber integerValue] > 0) {
+        [AWSS3TransferUtilityDatabaseHelper enqueueUpdate:parameters
+                                                   forKey:[NSString stringWithFormat:@"%@/%@", transferID, partNumber]
+                                            databaseQueue:databaseQueue];
+        return;
+    }
+
     [databaseQueue inDatabase:^(AWSFMDatabase *db) {
         BOOL result = [db executeUpdate: AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag
-                withParameterDictionary:@{
-                                          @"transfer_id": transferID,
-                                          @"session_task_id": @(taskIdentifier),
-                                          @"etag": eTag,
-                                          @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:status],
-                                          @"part_number": partNumber,
-                                          @"retry_count": @(retryCount)
-                                          }];
+                withParameterDictionary:parameters];
         
         if (!result) {
             AWSDDLogError(@"Failed to update transfer_request [%@] in Database. [%@]", transferID,
@@ -149,6 +242,70 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     }];
 }
 
++ (void) enqueueUpdate:(NSDictionary *) parameters
+                forKey:(NSString *) key
+         databaseQueue:(AWSFMDatabaseQueue *) databaseQueue {
+    NSMapTable *pendingUpdatesByDatabaseQueue = [AWSS3TransferUtilityDatabaseHelper pendingUpdatesByDatabaseQueue];
+    @synchronized(pendingUpdatesByDatabaseQueue) {
+        AWSS3TransferUtilityPendingUpdates *pendingUpdates = [pendingUpdatesByDatabaseQueue objectForKey:databaseQueue];
+        if (!pendingUpdates) {
+            pendingUpdates = [AWSS3TransferUtilityPendingUpdates new];
+            [pendingUpdatesByDatabaseQueue setObject:pendingUpdates forKey:databaseQueue];
+        }
+        [pendingUpdates.updates setObject:parameters forKey:key];
+        if (pendingUpdates.flushScheduled) {
+            return;
+        }
+        pendingUpdates.flushScheduled = YES;
+    }
+
+    __weak AWSFMDatabaseQueue *weakDatabaseQueue = databaseQueue;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(AWSS3TransferUtilityDatabaseUpdateCoalescingDelay * NSEC_PER_SEC)), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        AWSFMDatabaseQueue *strongDatabaseQueue = weakDatabaseQueue;
+        if (strongDatabaseQueue) {
+            [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:strongDatabaseQueue];
+        }
+    });
+}
+
++ (void) flushAllPendingUpdates {
+    NSArray<AWSFMDatabaseQueue *> *databaseQueues = nil;
+    NSMapTable *pendingUpdatesByDatabaseQueue = [AWSS3TransferUtilityDatabaseHelper pendingUpdatesByDatabaseQueue];
+    @synchronized(pendingUpdatesByDatabaseQueue) {
+        databaseQueues = [[pendingUpdatesByDatabaseQueue keyEnumerator] allObjects];
+    }
+    for (AWSFMDatabaseQueue *databaseQueue in databaseQueues) {
+        [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:databaseQueue];
+    }
+}
+
++ (void) flushPendingUpdatesInDB:(AWSFMDatabaseQueue *) databaseQueue {
+    if (!databaseQueue) {
+        return;
+    }
+
+    NSArray<NSDictionary *> *updates = nil;
+    NSMapTable *pendingUpdatesByDatabaseQueue = [AWSS3TransferUtilityDatabaseHelper pendingUpdatesByDatabaseQueue];
+    @synchronized(pendingUpdatesByDatabaseQueue) {
+        AWSS3TransferUtilityPendingUpdates *pendingUpdates = [pendingUpdatesByDatabaseQueue objectForKey:databaseQueue];
+        updates = [pendingUpdates.updates allValues];
+        [pendingUpdates.updates removeAllObjects];
+        pendingUpdates.flushScheduled = NO;
+    }
+    if ([updates count] == 0) {
+        return;
+    }
+
+    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        for (NSDictionary *parameters in updates) {
+            if (![db executeUpdate:AWSS3TransferUtilityUpdateTransferUtilityStatusAndETag withParameterDictionary:parameters]) {
+                AWSDDLogError(@"Failed to update transfer_request [%@] in Database. [%@]", parameters[@"transfer_id"],
+                              db.lastError);
+            }
+        }
+    }];
+}
+
 
 + (void) insertUploadTransferRequestInDB:(AWSS3TransferUtilityUploadTask *) task
                            databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
@@ -221,23 +378,60 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
 + (void) insertMultiPartUploadRequestSubTaskInDB:(AWSS3TransferUtilityMultiPartUploadTask *) task
                                          subTask:(AWSS3TransferUtilityUploadSubTask *) subTask
                                    databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
-    [AWSS3TransferUtilityDatabaseHelper insertTransferRequestInDB:task.transferID
-                                                   nsURLSessionID:task.nsURLSessionID
-                                                   taskIdentifier:@(subTask.taskIdentifier)
-                                                     transferType:subTask.transferType
-                                                           bucket:task.bucket
-                                                              key:task.key
-                                                       partNumber:subTask.partNumber
-                                                      multiPartID:task.uploadID
-                                                             eTag:@""
-                                                             file:subTask.file
-                                             temporaryFileCreated: YES
-                                                    contentLength:@(subTask.totalBytesExpectedToSend)
-                                                           status:subTask.status
-                                                       retryCount:@(0)
-                                               requestHeadersJSON:[self getJSONRepresentation:task.expression.requestHeaders]
-                                            requestParametersJSON:[self getJSONRepresentation:task.expression.requestParameters]
-                                                    databaseQueue:databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                        subTasks:@[subTask]
+                                                                   databaseQueue:databaseQueue];
+}
+
++ (void) insertMultiPartUploadRequestSubTasksInDB:(AWSS3TransferUtilityMultiPartUploadTask *) task
+                                         subTasks:(NSArray<AWSS3TransferUtilityUploadSubTask *> *) subTasks
+                                    databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    if ([subTasks count] == 0) {
+        return;
+    }
+
+    NSString *requestHeadersJSON = [self getJSONRepresentation:task.expression.requestHeaders];
+    NSString *requestParametersJSON = [self getJSONRepresentation:task.expression.requestParameters];
+    NSMutableArray<NSDictionary *> *rows = [NSMutableArray arrayWithCapacity:[subTasks count]];
+    NSMutableArray<NSString *> *keys = [NSMutableArray arrayWithCapacity:[subTasks count]];
+    for (AWSS3TransferUtilityUploadSubTask *subTask in subTasks) {
+        [rows addObject:@{
+                          @"transfer_id": task.transferID,
+                          @"ns_url_session_id": task.nsURLSessionID,
+                          @"session_task_id": @(subTask.taskIdentifier),
+                          @"transfer_type": subTask.transferType,
+                          @"bucket_name": task.bucket,
+                          @"key": task.key,
+                          @"part_number": subTask.partNumber,
+                          @"multi_part_id": task.uploadID,
+                          @"etag": @"",
+                          @"file": [AWSS3TransferUtilityDatabaseHelper relativePathFromAbsolutePath:subTask.file],
+                          @"temporary_file_created": @1,
+                          @"content_length": @(subTask.totalBytesExpectedToSend),
+                          @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:subTask.status],
+                          @"request_headers": requestHeadersJSON,
+                          @"request_parameters": requestParametersJSON,
+                          @"retry_count": @0
+                          }];
+        [keys addObject:[NSString stringWithFormat:@"%@/%@", task.transferID, subTask.partNumber]];
+    }
+
+    //The new rows already carry each part's current state, so updates queued while the parts were being created are dropped.
+    NSMapTable *pendingUpdatesByDatabaseQueue = [AWSS3TransferUtilityDatabaseHelper pendingUpdatesByDatabaseQueue];
+    @synchronized(pendingUpdatesByDatabaseQueue) {
+        [[pendingUpdatesByDatabaseQueue objectForKey:databaseQueue].updates removeObjectsForKeys:keys];
+    }
+
+    //One transaction for all parts rather than one implicit transaction, and one sync to disk, per part.
+    [databaseQueue inTransaction:^(AWSFMDatabase *db, BOOL *rollback) {
+        for (NSDictionary *row in rows) {
+            if (![db executeUpdate:AWSS3TransferUtiltyInsertIntoAWSTransfer withParameterDictionary:row]) {
+                AWSDDLogError(@"Failed to save Transfer [%@] part [%@] in awstransfer database table. [%@]", task.transferID, row[@"part_number"], db.lastError);
+                *rollback = YES;
+                return;
+            }
+        }
+    }];
 }
 
 + (void) insertTransferRequestInDB: (NSString *) transferID
@@ -257,14 +451,6 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
                 requestHeadersJSON: (NSString *) requestHeadersJSON
              requestParametersJSON: (NSString *) requestParametersJSON
                      databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
-    NSString *const AWSS3TransferUtiltyInsertIntoAWSTransfer = @"INSERT INTO awstransfer ("
-    @"transfer_id,ns_url_session_id, session_task_id, transfer_type, bucket_name, key, part_number, multi_part_id, etag, file, "
-    @"temporary_file_created, content_length, status, retry_count, request_headers, request_parameters"
-    @") VALUES ("
-    @":transfer_id,:ns_url_session_id, :session_task_id, :transfer_type, :bucket_name, :key, :part_number, :multi_part_id, :etag, :file, :temporary_file_created, :content_length, "
-    @":status, :retry_count, :request_headers, :request_parameters"
-    @")";
-    
     NSNumber *tempFileCreated = [NSNumber numberWithInt:0];
     if (temporaryFileCreated) {
         tempFileCreated = [NSNumber numberWithInt:1];
@@ -306,14 +492,128 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
     @"From awstransfer "
     @"Where ns_url_session_id=:ns_url_session_id order by transfer_id, part_number";
     
-    NSMutableArray *tasks = [NSMutableArray new];
-    //Read from DB
-    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
-        //Get all AWSTransferRecords
-        AWSFMResultSet *rs = [db executeQuery:AWSS3TransferUtilityQueryAWSTransfer
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:databaseQueue];
+    return [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:AWSS3TransferUtilityQueryAWSTransfer
+                                                              parameters:@{
+                                                                           @"ns_url_session_id": nsURLSessionID
+                                                                           }
+                                                           databaseQueue:databaseQueue];
+}
+
++ (NSSet<NSString *> *) getTransferIDsFromDB:(NSString *)nsURLSessionID
+                               databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    //Answered from the ns_url_session_id index without reading the table.
+    NSString *const AWSS3TransferUtilityQueryTransferIDs = @"Select transfer_id From awstransfer "
+    @"Where ns_url_session_id=:ns_url_session_id and part_number = 0";
+
+    NSMutableSet<NSString *> *transferIDs = [NSMutableSet new];
+    [databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
+        AWSFMResultSet *rs = [db executeQuery:AWSS3TransferUtilityQueryTransferIDs
                       withParameterDictionary:@{
                                                 @"ns_url_session_id": nsURLSessionID
                                                 }];
+        while ([rs next]) {
+            [transferIDs addObject:[rs stringForColumnIndex:0]];
+        }
+        [rs close];
+    }];
+    return transferIDs;
+}
+
++ (NSMutableArray *) getTransferTaskDataFromDB:(NSString *)nsURLSessionID
+                                   transferIDs:(NSSet<NSString *> *)transferIDs
+                                 databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    NSString *const AWSS3TransferUtilityQueryTransfers = @"Select transfer_id, session_task_id, "
+    @"transfer_type, bucket_name, key, part_number, multi_part_id, etag, file, temporary_file_created, content_length, "
+    @"status, retry_count, request_headers, request_parameters "
+    @"From awstransfer "
+    @"Where ns_url_session_id=:ns_url_session_id and part_number = 0 order by transfer_id";
+
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:databaseQueue];
+    NSMutableArray *tasks = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:AWSS3TransferUtilityQueryTransfers
+                                                                               parameters:@{
+                                                                                            @"ns_url_session_id": nsURLSessionID
+                                                                                            }
+                                                                            databaseQueue:databaseQueue];
+    [tasks filterUsingPredicate:[NSPredicate predicateWithBlock:^BOOL(NSDictionary *task, NSDictionary *bindings) {
+        return [transferIDs containsObject:[task objectForKey:@"transfer_id"]];
+    }]];
+    return tasks;
+}
+
++ (NSMutableArray *) getMultiPartUploadSubTaskDataFromDB:(NSString *)transferID
+                                         afterPartNumber:(NSInteger)partNumber
+                                                   limit:(NSUInteger)limit
+                                           databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    //Pages through the transfer_id index. Parts share the request headers and parameters of their upload, so those are not read.
+    NSString *const AWSS3TransferUtilityQuerySubTasks = @"Select transfer_id, session_task_id, "
+    @"transfer_type, bucket_name, key, part_number, multi_part_id, etag, file, temporary_file_created, content_length, "
+    @"status, retry_count "
+    @"From awstransfer "
+    @"Where transfer_id=:transfer_id and part_number > :part_number order by part_number limit :limit";
+
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:databaseQueue];
+    return [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:AWSS3TransferUtilityQuerySubTasks
+                                                              parameters:@{
+                                                                           @"transfer_id": transferID,
+                                                                           @"part_number": @(partNumber),
+                                                                           @"limit": @(limit)
+                                                                           }
+                                                           databaseQueue:databaseQueue];
+}
+
+//Waiting parts that were never given a session task, in part number order.
++ (NSMutableArray *) getPendingMultiPartUploadSubTaskDataFromDB:(NSString *)transferID
+                                                afterPartNumber:(NSInteger)partNumber
+                                                          limit:(NSUInteger)limit
+                                                  databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    NSString *const AWSS3TransferUtilityQueryPendingSubTasks = @"Select transfer_id, session_task_id, "
+    @"transfer_type, bucket_name, key, part_number, multi_part_id, etag, file, temporary_file_created, content_length, "
+    @"status, retry_count "
+    @"From awstransfer "
+    @"Where transfer_id=:transfer_id and part_number > :part_number and session_task_id = 0 and status=:status "
+    @"order by part_number limit :limit";
+
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:databaseQueue];
+    return [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:AWSS3TransferUtilityQueryPendingSubTasks
+                                                              parameters:@{
+                                                                           @"transfer_id": transferID,
+                                                                           @"part_number": @(partNumber),
+                                                                           @"status": [AWSS3TransferUtilityDatabaseHelper getStringRepresentation:AWSS3TransferUtilityTransferStatusWaiting],
+                                                                           @"limit": @(limit)
+                                                                           }
+                                                           databaseQueue:databaseQueue];
+}
+
+//Delete the part records of multipart uploads that no longer have a record of their own.
++ (void) deleteOrphanedSubTasksFromDB:(NSString *)nsURLSessionID
+                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue {
+    NSString *const AWSS3TransferUtilityDeleteOrphanedSubTasks = @"DELETE FROM awstransfer "
+    @"WHERE ns_url_session_id=:ns_url_session_id and part_number > 0 and transfer_id NOT IN ("
+    @"SELECT transfer_id FROM awstransfer WHERE ns_url_session_id=:ns_url_session_id and part_number = 0)";
+
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:databaseQueue];
+    [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        if (![db executeUpdate:AWSS3TransferUtilityDeleteOrphanedSubTasks
+       withParameterDictionary:@{
+                                 @"ns_url_session_id": nsURLSessionID
+                                 }]) {
+            AWSDDLogError(@"Failed to delete orphaned parts for session [%@] in Database. [%@]", nsURLSessionID, db.lastError);
+        }
+    }];
+}
+
++ (NSMutableArray *) getTransferTaskDataFromDB:(NSString *)query
+                                    parameters:(NSDictionary *)parameters
+                                 databaseQueue: (AWSFMDatabaseQueue *) databaseQueue
+{
+    NSMutableArray *tasks = [NSMutableArray new];
+    //Read from DB
+    [databaseQueue inReadOnlyDatabase:^(AWSFMDatabase *db) {
+        //Get all AWSTransferRecords
+        AWSFMResultSet *rs = [db executeQuery:query
+                      withParameterDictionary:parameters];
+        BOOL hasRequest = [rs columnIndexForName:@"request_headers"] >= 0;
         while ([rs next]) {
             NSMutableDictionary *transfer = [NSMutableDictionary new];
             [transfer setObject:[rs stringForColumn:@"transfer_id"] forKey:@"transfer_id"];
@@ -328,8 +628,10 @@ NSString *const AWSS3TransferUtilityDatabaseName = @"transfer_utility_database";
             [transfer setObject:@([rs intForColumn:@"temporary_file_created"]) forKey:@"temporary_file_created"];
             [transfer setObject:@([rs intForColumn:@"content_length"]) forKey:@"content_length"];
             [transfer setObject:@([rs intForColumn:@"retry_count"]) forKey:@"retry_count"];
-            [transfer setObject:[rs stringForColumn:@"request_headers"] forKey:@"request_headers"];
-            [transfer setObject:[rs stringForColumn:@"request_parameters"] forKey:@"request_parameters"];
+            if (hasRequest) {
+                [transfer setObject:[rs stringForColumn:@"request_headers"] forKey:@"request_headers"];
+                [transfer setObject:[rs stringForColumn:@"request_parameters"] forKey:@"request_parameters"];
+            }
             NSNumber *statusValue = [ NSNumber numberWithInteger:[AWSS3TransferUtilityDatabaseHelper getEnumRepresentation:[rs stringForColumn:@"status"]]];
             [transfer setObject: statusValue forKey:@"status"];
             [tasks addObject:transfer];
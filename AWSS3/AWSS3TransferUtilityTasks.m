@@ -128,6 +128,7 @@
         _waitingPartsDictionary = [NSMutableDictionary new];
         _inProgressPartsDictionary = [NSMutableDictionary new];
         _completedPartsSet = [NSMutableSet new];
+        _pendingPartsQueue = [NSMutableArray new];
     }
     return self;
 }
@@ -56,6 +56,10 @@
 @property NSMutableDictionary <NSNumber *, AWSS3TransferUtilityUploadSubTask *> *waitingPartsDictionary;
 @property (strong, nonatomic) NSMutableSet <AWSS3TransferUtilityUploadSubTask *> *completedPartsSet;
 @property (strong, nonatomic) NSMutableDictionary <NSNumber *, AWSS3TransferUtilityUploadSubTask *> *inProgressPartsDictionary;
+//Parts that have neither a temporary part file nor a session task yet, in part number order.
+@property (strong, nonatomic) NSMutableArray <AWSS3TransferUtilityUploadSubTask *> *pendingPartsQueue;
+//Set when recovery left the pending parts after this part number in the database. They are read a page at a time as the queue runs out.
+@property (strong, nonatomic) NSNumber *pendingPartsInDBAfterPartNumber;
 @property int partNumber;
 @property NSNumber *contentLength;
 
@@ -85,6 +89,13 @@
 @property NSString *transferID;
 @property AWSS3TransferUtilityTransferStatusType status;
 @property NSString *uploadID;
+@property NSString *contentMD5;
+//Prepares the part file and checksum in the background while earlier parts upload.
+@property (strong) AWSTask *prefetchTask;
+//Time spent creating the part file and checksum, and time from resuming the session task to its completion.
+@property NSTimeInterval preparationDuration;
+@property (strong) NSDate *transferStartDate;
+@property NSTimeInterval transferDuration;
 
 @end
 
@@ -174,9 +185,37 @@
                                          subTask:(AWSS3TransferUtilityUploadSubTask *) subTask
                                    databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
 
++ (void) insertMultiPartUploadRequestSubTasksInDB:(AWSS3TransferUtilityMultiPartUploadTask *) task
+                                         subTasks:(NSArray<AWSS3TransferUtilityUploadSubTask *> *) subTasks
+                                    databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) flushPendingUpdatesInDB:(AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) flushAllPendingUpdates;
+
++ (NSMutableArray *) getTransferTaskDataFromDB:(NSString *)nsURLSessionID
+                                 databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (NSSet<NSString *> *) getTransferIDsFromDB:(NSString *)nsURLSessionID
+                               databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
 + (NSMutableArray *) getTransferTaskDataFromDB:(NSString *)nsURLSessionID
+                                   transferIDs:(NSSet<NSString *> *)transferIDs
                                  databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
 
++ (NSMutableArray *) getMultiPartUploadSubTaskDataFromDB:(NSString *)transferID
+                                         afterPartNumber:(NSInteger)partNumber
+                                                   limit:(NSUInteger)limit
+                                           databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (NSMutableArray *) getPendingMultiPartUploadSubTaskDataFromDB:(NSString *)transferID
+                                                afterPartNumber:(NSInteger)partNumber
+                                                          limit:(NSUInteger)limit
+                                                  databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
++ (void) deleteOrphanedSubTasksFromDB:(NSString *)nsURLSessionID
+                        databaseQueue: (AWSFMDatabaseQueue *) databaseQueue;
+
 + (NSString *) getJSONRepresentation: (NSDictionary *) dict;
 + (NSDictionary*) getDictionaryFromJson: (NSString *)json;
 
@@ -0,0 +1,186 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "AWSS3PreSignedURL.h"
+
+static NSString *const AWSS3PreSignedURLBuilderUnitTestsKey = @"AWSS3PreSignedURLBuilderUnitTests";
+static const NSUInteger AWSS3PreSignedURLBuilderUnitTestsBatchSize = 10000;
+
+@interface AWSS3PreSignedURLBuilderUnitTests : XCTestCase
+
+@end
+
+@implementation AWSS3PreSignedURLBuilderUnitTests
+
+- (void)setUp {
+    [super setUp];
+    AWSStaticCredentialsProvider *credentialsProvider = [[AWSStaticCredentialsProvider alloc] initWithAccessKey:@"AKIDEXAMPLE"
+                                                                                                      secretKey:@"wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY"];
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1
+                                                                         credentialsProvider:credentialsProvider];
+    [AWSS3PreSignedURLBuilder registerS3PreSignedURLBuilderWithConfiguration:configuration
+                                                                      forKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+}
+
+- (void)tearDown {
+    [AWSS3PreSignedURLBuilder removeS3PreSignedURLBuilderForKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+    [super tearDown];
+}
+
+- (AWSS3GetPreSignedURLRequest *)requestWithBucket:(NSString *)bucket {
+    AWSS3GetPreSignedURLRequest *request = [AWSS3GetPreSignedURLRequest new];
+    request.bucket = bucket;
+    request.HTTPMethod = AWSHTTPMethodGET;
+    request.expires = [NSDate dateWithTimeIntervalSinceNow:3600];
+    return request;
+}
+
+- (NSArray<NSString *> *)keysWithCount:(NSUInteger)count {
+    NSMutableArray<NSString *> *keys = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [keys addObject:[NSString stringWithFormat:@"photos/2022/%05lu.jpg", (unsigned long)i]];
+    }
+    return keys;
+}
+
+- (NSURL *)singleSignedURLWithEndpoint:(AWSEndpoint *)endpoint
+                               keyPath:(NSString *)keyPath
+                           credentials:(AWSCredentials *)credentials
+                                  date:(NSDate *)date
+                               headers:(NSDictionary<NSString *, NSString *> *)headers
+                            parameters:(NSDictionary<NSString *, NSString *> *)parameters {
+    // The request generateQueryStringForSignatureV4WithCredentialProvider: builds, signed at a fixed date.
+    NSURLComponents *urlComponents = [[NSURLComponents alloc] initWithURL:endpoint.URL resolvingAgainstBaseURL:NO];
+    urlComponents.percentEncodedPath = [NSString stringWithFormat:@"/%@", keyPath];
+    urlComponents.queryItems = [AWSNetworkingHelpers queryItemsFromDictionary:parameters];
+    NSMutableURLRequest *request = [[NSMutableURLRequest alloc] initWithURL:urlComponents.URL];
+    request.HTTPMethod = @"GET";
+    request.allHTTPHeaderFields = headers;
+
+    AWSStaticCredentialsProvider *credentialsProvider = [[AWSStaticCredentialsProvider alloc] initWithAccessKey:credentials.accessKey
+                                                                                                      secretKey:credentials.secretKey];
+    return [[AWSSignatureV4Signer sigV4SignedURLWithRequest:request
+                                         credentialProvider:credentialsProvider
+                                                 regionName:endpoint.regionName
+                                                serviceName:endpoint.serviceName
+                                                       date:date
+                                             expireDuration:3600
+                                                   signBody:NO
+                                           signSessionToken:YES] result];
+}
+
+- (void)testPresignerMatchesSingleURLSigning {
+    AWSCredentials *credentials = [[AWSCredentials alloc] initWithAccessKey:@"AKIDEXAMPLE"
+                                                                  secretKey:@"wJalrXUtnFEMI/K7MDENG+bPxRfiCYEXAMPLEKEY"
+                                                                 sessionKey:nil
+                                                                 expiration:nil];
+    AWSEndpoint *endpoint = [[AWSEndpoint alloc] initWithRegion:AWSRegionUSEast1
+                                                        service:AWSServiceS3
+                                                            URL:[NSURL URLWithString:@"https://somebucket.s3.amazonaws.com"]];
+    NSDate *date = [NSDate dateWithTimeIntervalSince1970:1440938160];
+    NSDictionary *headers = @{@"host" : @"somebucket.s3.amazonaws.com", @"Content-Type" : @"image/jpeg"};
+    NSDictionary *parameters = @{@"versionId" : @"3HL4kqtJlcpXroDTDmJ+rmSpXd3dIbrHY+MTRCxf3vjVBH40Nr8X8gdRQBpUMLUo"};
+
+    AWSSignatureV4URLPresigner *presigner = [[AWSSignatureV4URLPresigner alloc] initWithCredentials:credentials
+                                                                                         httpMethod:AWSHTTPMethodGET
+                                                                                     expireDuration:3600
+                                                                                           endpoint:endpoint
+                                                                                               date:date
+                                                                                     requestHeaders:headers
+                                                                                  requestParameters:parameters];
+    NSArray<NSString *> *keys = @[@"test.txt", @"photos/a b+c.jpg", @"日本語/ファイル.txt", @"a~b!c'd(e)f*g"];
+    for (NSString *key in keys) {
+        NSString *keyPath = [key aws_stringWithURLEncodingPath];
+        NSURL *expected = [self singleSignedURLWithEndpoint:endpoint
+                                                    keyPath:keyPath
+                                                credentials:credentials
+                                                       date:date
+                                                    headers:headers
+                                                 parameters:parameters];
+        XCTAssertNotNil(expected);
+        XCTAssertEqualObjects([[presigner signedURLWithKeyPath:keyPath] absoluteString], [expected absoluteString], @"key %@", key);
+    }
+}
+
+- (void)testBatchReturnsCompletedTaskInKeyOrder {
+    AWSS3PreSignedURLBuilder *builder = [AWSS3PreSignedURLBuilder S3PreSignedURLBuilderForKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+    AWSS3GetPreSignedURLRequest *request = [self requestWithBucket:@"somebucket"];
+    NSArray<NSString *> *keys = [self keysWithCount:100];
+
+    AWSTask<NSArray<NSURL *> *> *task = [builder getPreSignedURLs:request forKeys:keys];
+
+    XCTAssertTrue(task.completed);
+    XCTAssertNil(task.error);
+    XCTAssertEqual([task.result count], [keys count]);
+    [task.result enumerateObjectsUsingBlock:^(NSURL *URL, NSUInteger idx, BOOL *stop) {
+        XCTAssertEqualObjects(URL.host, @"somebucket.s3.amazonaws.com");
+        XCTAssertEqualObjects(URL.path, [@"/" stringByAppendingString:keys[idx]]);
+        XCTAssertTrue([URL.query containsString:@"X-Amz-Signature="]);
+    }];
+
+    // The shared request is left as the caller configured it.
+    XCTAssertNil(request.requestHeaders[@"host"]);
+}
+
+- (void)testBatchUsesPathStyleForNonCompliantBuckets {
+    AWSS3PreSignedURLBuilder *builder = [AWSS3PreSignedURLBuilder S3PreSignedURLBuilderForKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+    AWSS3GetPreSignedURLRequest *request = [self requestWithBucket:@"some.bucket"];
+
+    NSArray<NSURL *> *URLs = [[builder getPreSignedURLs:request forKeys:@[@"a.txt"]] result];
+
+    XCTAssertEqualObjects(URLs.firstObject.host, @"s3.amazonaws.com");
+    XCTAssertEqualObjects(URLs.firstObject.path, @"/some.bucket/a.txt");
+}
+
+- (void)testBatchRejectsEmptyKeys {
+    AWSS3PreSignedURLBuilder *builder = [AWSS3PreSignedURLBuilder S3PreSignedURLBuilderForKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+    AWSS3GetPreSignedURLRequest *request = [self requestWithBucket:@"somebucket"];
+
+    AWSTask *task = [builder getPreSignedURLs:request forKeys:@[@"a.txt", @""]];
+    XCTAssertEqual(task.error.code, AWSS3PresignedURLErrorKeyNameIsNil);
+
+    request.expires = [NSDate dateWithTimeIntervalSinceNow:8 * 24 * 3600];
+    task = [builder getPreSignedURLs:request forKeys:@[@"a.txt"]];
+    XCTAssertEqual(task.error.code, AWSS3PresignedURLErrorInvalidExpiresDate);
+}
+
+#pragma mark - Benchmarks
+
+// Baseline: one getPreSignedURL: call per key.
+- (void)testSingleURLPerformance {
+    AWSS3PreSignedURLBuilder *builder = [AWSS3PreSignedURLBuilder S3PreSignedURLBuilderForKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+    NSArray<NSString *> *keys = [self keysWithCount:AWSS3PreSignedURLBuilderUnitTestsBatchSize];
+    [self measureBlock:^{
+        for (NSString *key in keys) {
+            @autoreleasepool {
+                AWSS3GetPreSignedURLRequest *request = [self requestWithBucket:@"somebucket"];
+                request.key = key;
+                XCTAssertNotNil([[builder getPreSignedURL:request] result]);
+            }
+        }
+    }];
+}
+
+- (void)testBatchPerformance {
+    AWSS3PreSignedURLBuilder *builder = [AWSS3PreSignedURLBuilder S3PreSignedURLBuilderForKey:AWSS3PreSignedURLBuilderUnitTestsKey];
+    NSArray<NSString *> *keys = [self keysWithCount:AWSS3PreSignedURLBuilderUnitTestsBatchSize];
+    AWSS3GetPreSignedURLRequest *request = [self requestWithBucket:@"somebucket"];
+    [self measureBlock:^{
+        XCTAssertEqual([[[builder getPreSignedURLs:request forKeys:keys] result] count], AWSS3PreSignedURLBuilderUnitTestsBatchSize);
+    }];
+}
+
+@end
@@ -0,0 +1,248 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <UIKit/UIKit.h>
+#import <XCTest/XCTest.h>
+#import <AWSCore/AWSFMDB.h>
+#import "AWSS3.h"
+#import "AWSS3TransferUtilityDatabaseHelper.h"
+#import "AWSS3TransferUtility_private.h"
+
+static NSString *const AWSS3TransferUtilityDatabaseHelperTestsSessionID = @"AWSS3TransferUtilityDatabaseHelperTestsSession";
+static const NSUInteger AWSS3TransferUtilityDatabaseHelperTestsPartCount = 1000;
+
+@interface AWSS3TransferUtilityDatabaseHelperTests : XCTestCase
+
+@property (nonatomic, strong) NSString *cacheDirectoryPath;
+@property (nonatomic, strong) AWSFMDatabaseQueue *databaseQueue;
+
+@end
+
+@implementation AWSS3TransferUtilityDatabaseHelperTests
+
+- (void)setUp {
+    [super setUp];
+    self.cacheDirectoryPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    self.databaseQueue = [AWSS3TransferUtilityDatabaseHelper createDatabase:self.cacheDirectoryPath];
+    XCTAssertNotNil(self.databaseQueue);
+}
+
+- (void)tearDown {
+    [self.databaseQueue close];
+    [[NSFileManager defaultManager] removeItemAtPath:self.cacheDirectoryPath error:nil];
+    [super tearDown];
+}
+
+- (AWSS3TransferUtilityMultiPartUploadTask *)multiPartUploadTask {
+    AWSS3TransferUtilityMultiPartUploadTask *task = [AWSS3TransferUtilityMultiPartUploadTask new];
+    task.transferID = [[NSUUID UUID] UUIDString];
+    task.nsURLSessionID = AWSS3TransferUtilityDatabaseHelperTestsSessionID;
+    task.transferType = @"MULTI_PART_UPLOAD";
+    task.bucket = @"somebucket";
+    task.key = @"some/key.bin";
+    task.uploadID = @"uploadID";
+    task.file = @"/tmp/file.bin";
+    task.contentLength = @(AWSS3TransferUtilityDatabaseHelperTestsPartCount * 5 * 1024 * 1024);
+    task.expression = [AWSS3TransferUtilityMultiPartUploadExpression new];
+    task.status = AWSS3TransferUtilityTransferStatusInProgress;
+    return task;
+}
+
+- (NSArray<AWSS3TransferUtilityUploadSubTask *> *)subTasksForTask:(AWSS3TransferUtilityMultiPartUploadTask *)task count:(NSUInteger)count {
+    NSMutableArray *subTasks = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 1; i <= count; i++) {
+        AWSS3TransferUtilityUploadSubTask *subTask = [AWSS3TransferUtilityUploadSubTask new];
+        subTask.transferID = task.transferID;
+        subTask.partNumber = @(i);
+        subTask.taskIdentifier = i;
+        subTask.transferType = @"MULTI_PART_UPLOAD_SUB_TASK";
+        subTask.totalBytesExpectedToSend = 5 * 1024 * 1024;
+        subTask.file = [NSString stringWithFormat:@"/tmp/part-%lu", (unsigned long)i];
+        subTask.status = AWSS3TransferUtilityTransferStatusWaiting;
+        [subTasks addObject:subTask];
+    }
+    return subTasks;
+}
+
+// Reads a row without going through the helper, which writes pending updates first.
+- (NSDictionary *)rowForTransferID:(NSString *)transferID partNumber:(NSNumber *)partNumber {
+    __block NSDictionary *row = nil;
+    [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        AWSFMResultSet *rs = [db executeQuery:@"SELECT status, etag FROM awstransfer WHERE transfer_id = ? AND part_number = ?", transferID, partNumber];
+        if ([rs next]) {
+            row = @{@"status" : [rs stringForColumn:@"status"], @"etag" : [rs stringForColumn:@"etag"]};
+        }
+        [rs close];
+    }];
+    return row;
+}
+
+- (void)testCreateDatabaseAddsIndexes {
+    NSMutableSet<NSString *> *indexes = [NSMutableSet new];
+    __block uint32_t userVersion = 0;
+    [self.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        AWSFMResultSet *rs = [db executeQuery:@"SELECT name FROM sqlite_master WHERE type = 'index' AND tbl_name = 'awstransfer'"];
+        while ([rs next]) {
+            [indexes addObject:[rs stringForColumn:@"name"]];
+        }
+        [rs close];
+        userVersion = [db userVersion];
+    }];
+
+    XCTAssertTrue([indexes containsObject:@"awstransfer_transfer_id_part_number"]);
+    XCTAssertTrue([indexes containsObject:@"awstransfer_ns_url_session_id"]);
+    XCTAssertEqual(userVersion, 1);
+
+    // Opening the existing database again leaves it as it is.
+    [self.databaseQueue close];
+    self.databaseQueue = [AWSS3TransferUtilityDatabaseHelper createDatabase:self.cacheDirectoryPath];
+    XCTAssertNotNil(self.databaseQueue);
+}
+
+- (void)testSubTasksAreInsertedTogether {
+    AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTask];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestInDB:task databaseQueue:self.databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                        subTasks:[self subTasksForTask:task count:100]
+                                                                   databaseQueue:self.databaseQueue];
+
+    NSArray<NSDictionary *> *rows = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:AWSS3TransferUtilityDatabaseHelperTestsSessionID
+                                                                                    databaseQueue:self.databaseQueue];
+    XCTAssertEqual([rows count], 101);
+    [rows enumerateObjectsUsingBlock:^(NSDictionary *row, NSUInteger idx, BOOL *stop) {
+        XCTAssertEqualObjects(row[@"part_number"], @(idx));
+    }];
+    XCTAssertEqualObjects(rows[100][@"status"], @(AWSS3TransferUtilityTransferStatusWaiting));
+    XCTAssertEqualObjects(rows[100][@"file"], [NSHomeDirectory() stringByAppendingPathComponent:@"/tmp/part-100"]);
+}
+
+- (void)testPartUpdatesAreCoalesced {
+    AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTask];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestInDB:task databaseQueue:self.databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                        subTasks:[self subTasksForTask:task count:2]
+                                                                   databaseQueue:self.databaseQueue];
+
+    [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:task.transferID
+                                                       partNumber:@1
+                                                   taskIdentifier:1
+                                                             eTag:@""
+                                                           status:AWSS3TransferUtilityTransferStatusInProgress
+                                                      retry_count:0
+                                                    databaseQueue:self.databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:task.transferID
+                                                       partNumber:@1
+                                                   taskIdentifier:1
+                                                             eTag:@"etag1"
+                                                           status:AWSS3TransferUtilityTransferStatusCompleted
+                                                      retry_count:0
+                                                    databaseQueue:self.databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:task.transferID
+                                                       partNumber:@0
+                                                   taskIdentifier:0
+                                                             eTag:@""
+                                                           status:AWSS3TransferUtilityTransferStatusPaused
+                                                      retry_count:0
+                                                    databaseQueue:self.databaseQueue];
+
+    // The transfer's own record is written right away; the part's is held.
+    XCTAssertEqualObjects([self rowForTransferID:task.transferID partNumber:@0][@"status"], @"PAUSED");
+    XCTAssertEqualObjects([self rowForTransferID:task.transferID partNumber:@1][@"status"], @"WAITING");
+
+    [AWSS3TransferUtilityDatabaseHelper flushPendingUpdatesInDB:self.databaseQueue];
+
+    NSDictionary *row = [self rowForTransferID:task.transferID partNumber:@1];
+    XCTAssertEqualObjects(row[@"status"], @"COMPLETED");
+    XCTAssertEqualObjects(row[@"etag"], @"etag1");
+    XCTAssertEqualObjects([self rowForTransferID:task.transferID partNumber:@2][@"status"], @"WAITING");
+}
+
+- (void)testPendingPartUpdatesAreWrittenAfterDelay {
+    AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTask];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                        subTasks:[self subTasksForTask:task count:1]
+                                                                   databaseQueue:self.databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:task.transferID
+                                                       partNumber:@1
+                                                   taskIdentifier:1
+                                                             eTag:@"etag1"
+                                                           status:AWSS3TransferUtilityTransferStatusCompleted
+                                                      retry_count:0
+                                                    databaseQueue:self.databaseQueue];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"Part update written"];
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(2 * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        XCTAssertEqualObjects([self rowForTransferID:task.transferID partNumber:@1][@"status"], @"COMPLETED");
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+}
+
+- (void)testPendingPartUpdatesAreWrittenWhenAppEntersBackground {
+    [self assertPendingPartUpdatesSurviveQueueClosedAfterNotification:UIApplicationDidEnterBackgroundNotification];
+}
+
+- (void)testPendingPartUpdatesAreWrittenWhenAppTerminates {
+    [self assertPendingPartUpdatesSurviveQueueClosedAfterNotification:UIApplicationWillTerminateNotification];
+}
+
+// Posts the notification, then closes and releases the database queue before the delayed flush can run, as happens
+// when the app is killed.
+- (void)assertPendingPartUpdatesSurviveQueueClosedAfterNotification:(NSNotificationName)notificationName {
+    AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTask];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                        subTasks:[self subTasksForTask:task count:1]
+                                                                   databaseQueue:self.databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:task.transferID
+                                                       partNumber:@1
+                                                   taskIdentifier:7
+                                                             eTag:@"etag1"
+                                                           status:AWSS3TransferUtilityTransferStatusCompleted
+                                                      retry_count:0
+                                                    databaseQueue:self.databaseQueue];
+
+    [[NSNotificationCenter defaultCenter] postNotificationName:notificationName object:nil];
+    [self.databaseQueue close];
+    self.databaseQueue = [AWSS3TransferUtilityDatabaseHelper createDatabase:self.cacheDirectoryPath];
+
+    NSDictionary *row = [self rowForTransferID:task.transferID partNumber:@1];
+    XCTAssertEqualObjects(row[@"status"], @"COMPLETED");
+    XCTAssertEqualObjects(row[@"etag"], @"etag1");
+}
+
+#pragma mark - Benchmarks
+
+// Baseline: one insert, and one implicit transaction, per part.
+- (void)testInsertSubTasksOneAtATimePerformance {
+    [self measureBlock:^{
+        AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTask];
+        for (AWSS3TransferUtilityUploadSubTask *subTask in [self subTasksForTask:task count:AWSS3TransferUtilityDatabaseHelperTestsPartCount]) {
+            [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTaskInDB:task
+                                                                                subTask:subTask
+                                                                          databaseQueue:self.databaseQueue];
+        }
+    }];
+}
+
+- (void)testInsertSubTasksTogetherPerformance {
+    [self measureBlock:^{
+        AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTask];
+        [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task
+                                                                            subTasks:[self subTasksForTask:task count:AWSS3TransferUtilityDatabaseHelperTestsPartCount]
+                                                                       databaseQueue:self.databaseQueue];
+    }];
+}
+
+@end
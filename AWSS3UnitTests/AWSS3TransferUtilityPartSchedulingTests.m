@@ -0,0 +1,238 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import "OCMock.h"
+#import "AWSTestUtility.h"
+#import "AWSS3.h"
+#import "AWSS3TransferUtility_private.h"
+
+static NSString *const AWSS3TransferUtilityPartSchedulingTestsKey = @"AWSS3TransferUtilityPartSchedulingTests";
+static const NSUInteger AWSS3TransferUtilityPartSchedulingTestsPartSize = 5 * 1024 * 1024;
+static const NSUInteger AWSS3TransferUtilityPartSchedulingTestsBenchmarkPartCount = 10000;
+
+@interface AWSS3TransferUtility()
+-(NSError *) createUploadSubTask:(AWSS3TransferUtilityMultiPartUploadTask *) transferUtilityMultiPartUploadTask
+                         subTask: (AWSS3TransferUtilityUploadSubTask *) subTask
+                   startTransfer: (BOOL) startTransfer
+internalDictionaryToAddSubTaskTo: (NSMutableDictionary *) internalDictionaryToAddSubTaskTo;
+-(NSError *) startNextPartsForMultiPartUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *) transferUtilityMultiPartUploadTask;
+-(void) prefetchNextPartForMultiPartUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *) transferUtilityMultiPartUploadTask;
+- (void) cleanupForMultiPartUploadTask: (AWSS3TransferUtilityMultiPartUploadTask *) task;
+@end
+
+@interface AWSS3TransferUtilityPartSchedulingTests : XCTestCase
+
+@property (nonatomic, strong) AWSS3TransferUtility *transferUtility;
+@property (nonatomic, strong) id transferUtilityMock;
+@property (nonatomic, strong) id sessionTask;
+@property (nonatomic, strong) NSMutableArray<NSNumber *> *startedParts;
+@property (nonatomic, assign) NSUInteger nextTaskIdentifier;
+
+@end
+
+@implementation AWSS3TransferUtilityPartSchedulingTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1 credentialsProvider:nil];
+    XCTestExpectation *registered = [self expectationWithDescription:@"Registered"];
+    [AWSS3TransferUtility registerS3TransferUtilityWithConfiguration:configuration
+                                                              forKey:AWSS3TransferUtilityPartSchedulingTestsKey
+                                                   completionHandler:^(NSError * _Nullable error) {
+        [registered fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    self.transferUtility = [AWSS3TransferUtility S3TransferUtilityForKey:AWSS3TransferUtilityPartSchedulingTestsKey];
+    self.sessionTask = OCMClassMock([NSURLSessionUploadTask class]);
+    self.startedParts = [NSMutableArray new];
+}
+
+- (void)tearDown {
+    [self.transferUtilityMock stopMocking];
+    [AWSS3TransferUtility removeS3TransferUtilityForKey:AWSS3TransferUtilityPartSchedulingTestsKey];
+    [super tearDown];
+}
+
+// Session tasks are created without presigning or touching NSURLSession, and no part files are prefetched.
+- (void)stubPartCreation {
+    self.transferUtilityMock = OCMPartialMock(self.transferUtility);
+    __weak AWSS3TransferUtilityPartSchedulingTests *weakSelf = self;
+    OCMStub([self.transferUtilityMock createUploadSubTask:OCMOCK_ANY
+                                                  subTask:OCMOCK_ANY
+                                            startTransfer:YES
+                         internalDictionaryToAddSubTaskTo:OCMOCK_ANY]).andDo(^(NSInvocation *invocation) {
+        __unsafe_unretained AWSS3TransferUtilityUploadSubTask *subTask = nil;
+        __unsafe_unretained NSMutableDictionary *dictionary = nil;
+        [invocation getArgument:&subTask atIndex:3];
+        [invocation getArgument:&dictionary atIndex:5];
+        subTask.taskIdentifier = ++weakSelf.nextTaskIdentifier;
+        subTask.sessionTask = weakSelf.sessionTask;
+        [dictionary setObject:subTask forKey:@(subTask.taskIdentifier)];
+        [weakSelf.startedParts addObject:subTask.partNumber];
+        __unsafe_unretained NSError *error = nil;
+        [invocation setReturnValue:&error];
+    });
+    OCMStub([self.transferUtilityMock prefetchNextPartForMultiPartUploadTask:OCMOCK_ANY]);
+}
+
+- (AWSS3TransferUtilityMultiPartUploadTask *)multiPartUploadTaskWithQueuedParts:(NSUInteger)partCount {
+    AWSS3TransferUtilityMultiPartUploadTask *task = [AWSS3TransferUtilityMultiPartUploadTask new];
+    task.transferID = [[NSUUID UUID] UUIDString];
+    task.uploadID = [[NSUUID UUID] UUIDString];
+    task.bucket = @"somebucket";
+    task.key = @"some/key.bin";
+    task.status = AWSS3TransferUtilityTransferStatusInProgress;
+    for (NSUInteger i = 1; i <= partCount; i++) {
+        [task.pendingPartsQueue addObject:[self subTaskForTask:task partNumber:i]];
+    }
+    return task;
+}
+
+- (AWSS3TransferUtilityUploadSubTask *)subTaskForTask:(AWSS3TransferUtilityMultiPartUploadTask *)task partNumber:(NSUInteger)partNumber {
+    AWSS3TransferUtilityUploadSubTask *subTask = [AWSS3TransferUtilityUploadSubTask new];
+    subTask.transferID = task.transferID;
+    subTask.partNumber = @(partNumber);
+    subTask.transferType = @"MULTI_PART_UPLOAD_SUB_TASK";
+    subTask.totalBytesExpectedToSend = AWSS3TransferUtilityPartSchedulingTestsPartSize;
+    subTask.file = @"";
+    subTask.status = AWSS3TransferUtilityTransferStatusWaiting;
+    return subTask;
+}
+
+- (void)completePart:(NSNumber *)partNumber ofTask:(AWSS3TransferUtilityMultiPartUploadTask *)task {
+    for (AWSS3TransferUtilityUploadSubTask *subTask in [task.inProgressPartsDictionary allValues]) {
+        if ([subTask.partNumber isEqualToNumber:partNumber]) {
+            [task.inProgressPartsDictionary removeObjectForKey:@(subTask.taskIdentifier)];
+            [task.completedPartsSet addObject:subTask];
+            return;
+        }
+    }
+    XCTFail(@"Part %@ is not in progress", partNumber);
+}
+
+- (void)testOnlyTheInFlightWindowIsCreated {
+    [self stubPartCreation];
+    AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTaskWithQueuedParts:12];
+
+    XCTAssertNil([self.transferUtility startNextPartsForMultiPartUploadTask:task]);
+
+    NSArray *expected = @[@1, @2, @3, @4, @5];
+    XCTAssertEqualObjects(self.startedParts, expected);
+    XCTAssertEqual([task.inProgressPartsDictionary count], 5);
+    XCTAssertEqual([task.pendingPartsQueue count], 7);
+    XCTAssertEqualObjects(task.pendingPartsQueue.firstObject.partNumber, @6);
+}
+
+- (void)testQueuedPartsStartInPartOrder {
+    [self stubPartCreation];
+    AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTaskWithQueuedParts:8];
+    XCTAssertNil([self.transferUtility startNextPartsForMultiPartUploadTask:task]);
+
+    [self completePart:@3 ofTask:task];
+    XCTAssertNil([self.transferUtility startNextPartsForMultiPartUploadTask:task]);
+    [self completePart:@1 ofTask:task];
+    [self completePart:@5 ofTask:task];
+    XCTAssertNil([self.transferUtility startNextPartsForMultiPartUploadTask:task]);
+
+    NSArray *expected = @[@1, @2, @3, @4, @5, @6, @7, @8];
+    XCTAssertEqualObjects(self.startedParts, expected);
+    XCTAssertEqual([task.pendingPartsQueue count], 0);
+
+    // Nothing left to start.
+    [self completePart:@6 ofTask:task];
+    XCTAssertNil([self.transferUtility startNextPartsForMultiPartUploadTask:task]);
+    XCTAssertEqual([task.inProgressPartsDictionary count], 4);
+}
+
+- (void)testWaitingPartsStartFirstLowestPartNumberFirst {
+    [self stubPartCreation];
+    AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTaskWithQueuedParts:0];
+    for (NSNumber *partNumber in @[@9, @4, @7]) {
+        AWSS3TransferUtilityUploadSubTask *subTask = [self subTaskForTask:task partNumber:[partNumber unsignedIntegerValue]];
+        subTask.taskIdentifier = 100 + [partNumber unsignedIntegerValue];
+        subTask.sessionTask = self.sessionTask;
+        [task.waitingPartsDictionary setObject:subTask forKey:@(subTask.taskIdentifier)];
+    }
+    for (NSUInteger i = 10; i <= 12; i++) {
+        [task.pendingPartsQueue addObject:[self subTaskForTask:task partNumber:i]];
+    }
+    for (NSUInteger i = 1; i <= 3; i++) {
+        AWSS3TransferUtilityUploadSubTask *subTask = [self subTaskForTask:task partNumber:i];
+        subTask.taskIdentifier = i;
+        [task.inProgressPartsDictionary setObject:subTask forKey:@(subTask.taskIdentifier)];
+    }
+
+    XCTAssertNil([self.transferUtility startNextPartsForMultiPartUploadTask:task]);
+
+    // Two slots: parts 4 and 7 resume; 9 keeps waiting and no queued part is created.
+    XCTAssertNotNil([task.inProgressPartsDictionary objectForKey:@104]);
+    XCTAssertNotNil([task.inProgressPartsDictionary objectForKey:@107]);
+    XCTAssertEqual([task.waitingPartsDictionary count], 1);
+    XCTAssertNotNil([task.waitingPartsDictionary objectForKey:@109]);
+    XCTAssertEqual([self.startedParts count], 0);
+    XCTAssertNotNil([[task.inProgressPartsDictionary objectForKey:@104] transferStartDate]);
+}
+
+- (void)testPrefetchPreparesNextPartFileAndChecksum {
+    NSUInteger partLength = 1024 * 1024;
+    NSMutableData *data = [NSMutableData dataWithLength:AWSS3TransferUtilityPartSchedulingTestsPartSize + partLength];
+    arc4random_buf([data mutableBytes], [data length]);
+    NSString *path = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    XCTAssertTrue([data writeToFile:path atomically:YES]);
+
+    AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTaskWithQueuedParts:0];
+    task.file = path;
+    task.expression.useContentMD5 = YES;
+    AWSS3TransferUtilityUploadSubTask *subTask = [self subTaskForTask:task partNumber:2];
+    subTask.totalBytesExpectedToSend = partLength;
+    [task.pendingPartsQueue addObject:subTask];
+
+    [self.transferUtility prefetchNextPartForMultiPartUploadTask:task];
+    XCTAssertNotNil(subTask.prefetchTask);
+    [subTask.prefetchTask waitUntilFinished];
+
+    NSData *partData = [data subdataWithRange:NSMakeRange(AWSS3TransferUtilityPartSchedulingTestsPartSize, partLength)];
+    XCTAssertEqualObjects([NSData dataWithContentsOfFile:subTask.file], partData);
+    XCTAssertEqualObjects(subTask.contentMD5, [NSString aws_base64md5FromData:partData]);
+    XCTAssertGreaterThan(subTask.preparationDuration, 0);
+
+    // The prefetched part file goes away with the transfer.
+    NSString *partFile = subTask.file;
+    [self.transferUtility cleanupForMultiPartUploadTask:task];
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:partFile]);
+    XCTAssertEqual([task.pendingPartsQueue count], 0);
+    [[NSFileManager defaultManager] removeItemAtPath:path error:nil];
+}
+
+#pragma mark - Benchmarks
+
+// A 50 GB upload with the default window of five parts: each completion starts the next part.
+- (void)testSchedulingPerformance {
+    [self stubPartCreation];
+    [self measureBlock:^{
+        AWSS3TransferUtilityMultiPartUploadTask *task = [self multiPartUploadTaskWithQueuedParts:AWSS3TransferUtilityPartSchedulingTestsBenchmarkPartCount];
+        [self.transferUtility startNextPartsForMultiPartUploadTask:task];
+        while ([task.inProgressPartsDictionary count] > 0) {
+            NSNumber *key = [[task.inProgressPartsDictionary keyEnumerator] nextObject];
+            [task.inProgressPartsDictionary removeObjectForKey:key];
+            [self.transferUtility startNextPartsForMultiPartUploadTask:task];
+        }
+    }];
+}
+
+@end
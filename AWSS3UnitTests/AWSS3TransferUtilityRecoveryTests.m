@@ -0,0 +1,239 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+#import <XCTest/XCTest.h>
+#import <AWSCore/AWSFMDB.h>
+#import "OCMock.h"
+#import "AWSTestUtility.h"
+#import "AWSS3.h"
+#import "AWSS3TransferUtilityDatabaseHelper.h"
+#import "AWSS3TransferUtility_private.h"
+
+static NSString *const AWSS3TransferUtilityRecoveryTestsKey = @"AWSS3TransferUtilityRecoveryTests";
+static const NSUInteger AWSS3TransferUtilityRecoveryTestsPartCount = 1200;
+static const NSUInteger AWSS3TransferUtilityRecoveryTestsBenchmarkPartCount = 10000;
+
+@interface AWSS3TransferUtility()
+@property (strong, nonatomic) NSURLSession *session;
+@property (strong, nonatomic) NSString *sessionIdentifier;
+@property (strong, nonatomic) AWSFMDatabaseQueue *databaseQueue;
+@property (copy, nonatomic) void (^backgroundURLSessionCompletionHandler)(void);
+- (void) recover: (void (^)(NSError *_Nullable error)) completionHandler;
+- (void)URLSessionDidFinishEventsForBackgroundURLSession:(NSURLSession *)session;
+- (void)loadPendingPartsForMultiPartUploadTask:(AWSS3TransferUtilityMultiPartUploadTask *)transferUtilityMultiPartUploadTask;
+@end
+
+@interface AWSS3TransferUtilityRecoveryTests : XCTestCase
+
+@property (nonatomic, strong) AWSS3TransferUtility *transferUtility;
+@property (nonatomic, strong) NSMutableArray<NSString *> *transferIDs;
+
+@end
+
+@implementation AWSS3TransferUtilityRecoveryTests
+
+- (void)setUp {
+    [super setUp];
+    [AWSTestUtility setupFakeCognitoCredentialsProvider];
+
+    AWSServiceConfiguration *configuration = [[AWSServiceConfiguration alloc] initWithRegion:AWSRegionUSEast1 credentialsProvider:nil];
+    XCTestExpectation *registered = [self expectationWithDescription:@"Registered"];
+    [AWSS3TransferUtility registerS3TransferUtilityWithConfiguration:configuration
+                                                              forKey:AWSS3TransferUtilityRecoveryTestsKey
+                                                   completionHandler:^(NSError * _Nullable error) {
+        [registered fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    self.transferUtility = [AWSS3TransferUtility S3TransferUtilityForKey:AWSS3TransferUtilityRecoveryTestsKey];
+
+    // No NSURLSession tasks survive, so recovery is all database work.
+    id session = OCMClassMock([NSURLSession class]);
+    OCMStub([session getTasksWithCompletionHandler:([OCMArg invokeBlockWithArgs:@[], @[], @[], nil])]);
+    self.transferUtility.session = session;
+    self.transferIDs = [NSMutableArray new];
+}
+
+- (void)tearDown {
+    for (NSString *transferID in self.transferIDs) {
+        [AWSS3TransferUtilityDatabaseHelper deleteTransferRequestFromDB:transferID databaseQueue:self.transferUtility.databaseQueue];
+    }
+    [AWSS3TransferUtility removeS3TransferUtilityForKey:AWSS3TransferUtilityRecoveryTestsKey];
+    [super tearDown];
+}
+
+// A multipart upload in progress whose parts have all been uploaded.
+- (AWSS3TransferUtilityMultiPartUploadTask *)saveMultiPartUploadWithPartCount:(NSUInteger)partCount {
+    return [self saveMultiPartUploadWithPartCount:partCount status:AWSS3TransferUtilityTransferStatusInProgress completedPartBlock:^BOOL(NSUInteger partNumber) {
+        return YES;
+    }];
+}
+
+// Parts that are not completed are waiting and were never given a session task.
+- (AWSS3TransferUtilityMultiPartUploadTask *)saveMultiPartUploadWithPartCount:(NSUInteger)partCount
+                                                                       status:(AWSS3TransferUtilityTransferStatusType)status
+                                                           completedPartBlock:(BOOL (^)(NSUInteger partNumber))completedPartBlock {
+    AWSS3TransferUtilityMultiPartUploadTask *task = [AWSS3TransferUtilityMultiPartUploadTask new];
+    task.transferID = [[NSUUID UUID] UUIDString];
+    task.nsURLSessionID = self.transferUtility.sessionIdentifier;
+    task.transferType = @"MULTI_PART_UPLOAD";
+    task.bucket = @"somebucket";
+    task.key = @"some/key.bin";
+    task.uploadID = [[NSUUID UUID] UUIDString];
+    task.file = @"/tmp/file.bin";
+    task.contentLength = @(partCount * 5 * 1024 * 1024);
+    task.expression = [AWSS3TransferUtilityMultiPartUploadExpression new];
+    task.status = status;
+    [self.transferIDs addObject:task.transferID];
+
+    NSMutableArray *subTasks = [NSMutableArray arrayWithCapacity:partCount];
+    for (NSUInteger i = 1; i <= partCount; i++) {
+        AWSS3TransferUtilityUploadSubTask *subTask = [AWSS3TransferUtilityUploadSubTask new];
+        subTask.transferID = task.transferID;
+        subTask.partNumber = @(i);
+        subTask.transferType = @"MULTI_PART_UPLOAD_SUB_TASK";
+        subTask.totalBytesExpectedToSend = 5 * 1024 * 1024;
+        subTask.file = @"";
+        if (completedPartBlock(i)) {
+            subTask.taskIdentifier = i;
+            subTask.status = AWSS3TransferUtilityTransferStatusCompleted;
+        } else {
+            subTask.status = AWSS3TransferUtilityTransferStatusWaiting;
+        }
+        [subTasks addObject:subTask];
+    }
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestInDB:task databaseQueue:self.transferUtility.databaseQueue];
+    [AWSS3TransferUtilityDatabaseHelper insertMultiPartUploadRequestSubTasksInDB:task subTasks:subTasks databaseQueue:self.transferUtility.databaseQueue];
+    return task;
+}
+
+- (void)recover {
+    XCTestExpectation *recovered = [self expectationWithDescription:@"Recovered"];
+    [self.transferUtility recover:^(NSError * _Nullable error) {
+        XCTAssertNil(error);
+        [recovered fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:30 handler:nil];
+}
+
+- (void)testRecoverReadsPartsInPages {
+    AWSS3TransferUtilityMultiPartUploadTask *saved = [self saveMultiPartUploadWithPartCount:AWSS3TransferUtilityRecoveryTestsPartCount];
+
+    [self recover];
+
+    NSArray<AWSS3TransferUtilityMultiPartUploadTask *> *tasks = [[self.transferUtility getMultiPartUploadTasks] result];
+    XCTAssertEqual([tasks count], 1);
+    XCTAssertEqualObjects(tasks.firstObject.transferID, saved.transferID);
+    XCTAssertEqual([tasks.firstObject.completedPartsSet count], AWSS3TransferUtilityRecoveryTestsPartCount);
+}
+
+- (void)testRecoverLoadsPendingPartsAPageAtATime {
+    // Every tenth part has been uploaded; the paused upload keeps recovery from scheduling any part.
+    [self saveMultiPartUploadWithPartCount:AWSS3TransferUtilityRecoveryTestsPartCount
+                                    status:AWSS3TransferUtilityTransferStatusPaused
+                        completedPartBlock:^BOOL(NSUInteger partNumber) {
+        return partNumber % 10 == 0;
+    }];
+
+    [self recover];
+
+    AWSS3TransferUtilityMultiPartUploadTask *task = [[[self.transferUtility getMultiPartUploadTasks] result] firstObject];
+    XCTAssertEqual([task.completedPartsSet count], AWSS3TransferUtilityRecoveryTestsPartCount / 10);
+    NSMutableArray<NSNumber *> *pendingPartNumbers = [NSMutableArray new];
+    while ([task.pendingPartsQueue count] > 0) {
+        XCTAssertLessThanOrEqual([task.pendingPartsQueue count], 500);
+        for (AWSS3TransferUtilityUploadSubTask *subTask in task.pendingPartsQueue) {
+            [pendingPartNumbers addObject:subTask.partNumber];
+        }
+        // The scheduler reads the next page once the queue runs out.
+        [task.pendingPartsQueue removeAllObjects];
+        [self.transferUtility loadPendingPartsForMultiPartUploadTask:task];
+    }
+
+    XCTAssertNil(task.pendingPartsInDBAfterPartNumber);
+    XCTAssertEqual([pendingPartNumbers count], AWSS3TransferUtilityRecoveryTestsPartCount - AWSS3TransferUtilityRecoveryTestsPartCount / 10);
+    for (NSUInteger i = 0; i < [pendingPartNumbers count]; i++) {
+        NSUInteger partNumber = i + i / 9 + 1;
+        XCTAssertEqual([pendingPartNumbers[i] unsignedIntegerValue], partNumber);
+    }
+}
+
+- (void)testRecoverDeletesOrphanedParts {
+    AWSS3TransferUtilityMultiPartUploadTask *orphan = [self saveMultiPartUploadWithPartCount:3];
+    [self.transferUtility.databaseQueue inDatabase:^(AWSFMDatabase *db) {
+        XCTAssertTrue([db executeUpdate:@"DELETE FROM awstransfer WHERE transfer_id = ? AND part_number = 0", orphan.transferID]);
+    }];
+
+    [self recover];
+
+    NSArray *rows = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:self.transferUtility.sessionIdentifier
+                                                                    databaseQueue:self.transferUtility.databaseQueue];
+    XCTAssertEqual([rows count], 0);
+}
+
+- (void)testTransfersStartedDuringRecoveryAreLeftAlone {
+    NSSet *transferIDs = [AWSS3TransferUtilityDatabaseHelper getTransferIDsFromDB:self.transferUtility.sessionIdentifier
+                                                                    databaseQueue:self.transferUtility.databaseQueue];
+    XCTAssertEqual([transferIDs count], 0);
+
+    AWSS3TransferUtilityMultiPartUploadTask *saved = [self saveMultiPartUploadWithPartCount:2];
+    NSArray *rows = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:self.transferUtility.sessionIdentifier
+                                                                      transferIDs:transferIDs
+                                                                    databaseQueue:self.transferUtility.databaseQueue];
+    XCTAssertEqual([rows count], 0);
+
+    rows = [AWSS3TransferUtilityDatabaseHelper getTransferTaskDataFromDB:self.transferUtility.sessionIdentifier
+                                                             transferIDs:[NSSet setWithObject:saved.transferID]
+                                                           databaseQueue:self.transferUtility.databaseQueue];
+    XCTAssertEqual([rows count], 1);
+    XCTAssertEqualObjects(rows.firstObject[@"transfer_type"], @"MULTI_PART_UPLOAD");
+}
+
+- (void)testPendingPartUpdatesAreWrittenBeforeBackgroundSessionCompletionHandler {
+    AWSS3TransferUtilityMultiPartUploadTask *saved = [self saveMultiPartUploadWithPartCount:1];
+    [AWSS3TransferUtilityDatabaseHelper updateTransferRequestInDB:saved.transferID
+                                                       partNumber:@1
+                                                   taskIdentifier:1
+                                                             eTag:@"etag1"
+                                                           status:AWSS3TransferUtilityTransferStatusCompleted
+                                                      retry_count:0
+                                                    databaseQueue:self.transferUtility.databaseQueue];
+
+    __block NSString *etag = nil;
+    AWSFMDatabaseQueue *databaseQueue = self.transferUtility.databaseQueue;
+    XCTestExpectation *handlerCalled = [self expectationWithDescription:@"Completion handler called"];
+    self.transferUtility.backgroundURLSessionCompletionHandler = ^{
+        // Read without going through the helper, which writes pending updates first.
+        [databaseQueue inDatabase:^(AWSFMDatabase *db) {
+            etag = [db stringForQuery:@"SELECT etag FROM awstransfer WHERE transfer_id = ? AND part_number = 1", saved.transferID];
+        }];
+        [handlerCalled fulfill];
+    };
+
+    [self.transferUtility URLSessionDidFinishEventsForBackgroundURLSession:self.transferUtility.session];
+    [self waitForExpectationsWithTimeout:5 handler:nil];
+    XCTAssertEqualObjects(etag, @"etag1");
+}
+
+#pragma mark - Benchmarks
+
+// Launch with one 50 GB multipart upload in progress: from recover: to the completion handler.
+- (void)testRecoverPerformance {
+    [self saveMultiPartUploadWithPartCount:AWSS3TransferUtilityRecoveryTestsBenchmarkPartCount];
+    [self measureBlock:^{
+        [self recover];
+    }];
+}
+
+@end
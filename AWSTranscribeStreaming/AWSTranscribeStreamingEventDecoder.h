@@ -25,6 +25,11 @@ NS_ASSUME_NONNULL_BEGIN
 + (nullable AWSTranscribeStreamingTranscriptResultStream *)decodeEvent:(NSData *)data
                                                          decodingError:(NSError **)decodingError;
 
+/// Decodes every stream event contained in `data`, which must end on a message boundary. Both checksums of each
+/// message are verified.
++ (nullable NSArray<AWSTranscribeStreamingTranscriptResultStream *> *)decodeEvents:(NSData *)data
+                                                                      decodingError:(NSError **)decodingError;
+
 @end
 
 NS_ASSUME_NONNULL_END
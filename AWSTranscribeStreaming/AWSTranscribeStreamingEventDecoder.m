@@ -22,123 +22,77 @@
 
 + (nullable AWSTranscribeStreamingTranscriptResultStream *)decodeEvent:(NSData *)data
                                                          decodingError:(NSError **)decodingErrorPointer {
+    return [[AWSTranscribeStreamingEventDecoder decodeEvents:data
+                                               decodingError:decodingErrorPointer] firstObject];
+}
 
-    // Uncomment these lines to write data chunks to a file for testing.
-//    NSURL *destinationURL = [NSURL URLWithString:@"/transcribe_event_stream_data"];
-//    NSFileManager *fileManager = [NSFileManager defaultManager];
-//    NSError *error = nil;
-//    NSURL *temporaryDirectoryURL = [fileManager URLForDirectory:NSCachesDirectory inDomain:NSUserDomainMask appropriateForURL:destinationURL create:YES error:&error];
-//    assert(error == nil);
-//    NSString *temporaryFilename = @"data_chunk";
-//    NSURL *temporaryFileURL = [temporaryDirectoryURL URLByAppendingPathComponent:temporaryFilename];
-//    [data writeToURL:temporaryFileURL options:NSDataWritingAtomic error:&error];
-//    assert(error == nil);
-//    AWSDDLogError(@"Wrote data_chunk to %@", temporaryFileURL);
-
-    if(![AWSTranscribeStreamingEventDecoder verifyPreludeForData:data decodingError:decodingErrorPointer]) {
++ (nullable NSArray<AWSTranscribeStreamingTranscriptResultStream *> *)decodeEvents:(NSData *)data
+                                                                      decodingError:(NSError **)decodingErrorPointer {
+    NSError *eventStreamError = nil;
+    NSArray<AWSEventStreamMessage *> *messages = [AWSEventStreamDecoder decodeMessagesFromData:data
+                                                                                          error:&eventStreamError];
+    if (!messages) {
+        *decodingErrorPointer = [AWSTranscribeStreamingEventDecoder decodingErrorForEventStreamError:eventStreamError];
         return nil;
     }
 
-    if (![AWSTranscribeStreamingEventDecoder verifyMessageLengthHeaderForData:data decodingError:decodingErrorPointer]) {
-        return nil;
+    NSMutableArray<AWSTranscribeStreamingTranscriptResultStream *> *resultStreams = [NSMutableArray arrayWithCapacity:messages.count];
+    for (AWSEventStreamMessage *message in messages) {
+        AWSTranscribeStreamingTranscriptResultStream *resultStream = [AWSTranscribeStreamingEventDecoder resultStreamForMessage:message
+                                                                                                                  decodingError:decodingErrorPointer];
+        if (!resultStream) {
+            return nil;
+        }
+        [resultStreams addObject:resultStream];
     }
-    
-    NSDictionary<NSString *, NSString *> *headers = [AWSTranscribeStreamingEventDecoder getHeadersForData:data];
-    AWSDDLogVerbose(@"Response headers: %@", headers);
 
-    NSString *body = [AWSTranscribeStreamingEventDecoder getBodyForData:data];
-    AWSDDLogVerbose(@"First 100 bytes of body: %@", [body substringToIndex:MIN(100, body.length)]);
-    
-    AWSTranscribeStreamingTranscriptResultStream *resultStream = [AWSTranscribeStreamingTranscriptResultStream resultStreamForWSSBody:body
-                                                                                                                              headers:headers
-                                                                                                                                error:decodingErrorPointer];
-
-    if (*decodingErrorPointer) {
-        AWSDDLogError(@"Error deserializing response data into AWSTranscribeStreamingTranscriptResultStream: %@", *decodingErrorPointer);
-    } else {
-        AWSDDLogDebug(@"Created AWSTranscribeStreamingTranscriptResultStream from decoded message");
-    }
-    
-    return resultStream;
+    return resultStreams;
 }
 
-+(bool)verifyPreludeForData:(NSData *)data
-              decodingError:(NSError **)decodingErrorPointer {
-    if (data.length < 16) {
-        NSString *failureReason = [NSString stringWithFormat:@"Socket overhead is at least 16 bytes, actual data size is %lu",
-                                   data.length];
-
-        NSDictionary *userInfo = @{NSLocalizedFailureReasonErrorKey:failureReason};
-        *decodingErrorPointer = [NSError errorWithDomain:AWSTranscribeStreamingClientErrorDomain
-                                                    code:AWSTranscribeStreamingClientErrorCodeInvalidMessagePrelude
-                                                userInfo:userInfo];
-        return NO;
++ (nullable AWSTranscribeStreamingTranscriptResultStream *)resultStreamForMessage:(AWSEventStreamMessage *)message
+                                                                    decodingError:(NSError **)decodingErrorPointer {
+    // The log arguments are only evaluated when verbose logging is enabled, so the payload is never copied into a string
+    // on the normal path.
+    AWSDDLogVerbose(@"Response headers: %@", message.headers);
+    AWSDDLogVerbose(@"First 100 bytes of body: %@", [[NSString alloc] initWithData:[message.payload subdataWithRange:NSMakeRange(0, MIN(100, message.payload.length))]
+                                                                         encoding:NSUTF8StringEncoding]);
+
+    NSError *error = nil;
+    AWSTranscribeStreamingTranscriptResultStream *resultStream = [AWSTranscribeStreamingTranscriptResultStream resultStreamForMessage:message
+                                                                                                                                error:&error];
+
+    if (error) {
+        AWSDDLogError(@"Error deserializing response data into AWSTranscribeStreamingTranscriptResultStream: %@", error);
+        *decodingErrorPointer = error;
+        return nil;
     }
-    return YES;
-}
 
-+(bool)verifyMessageLengthHeaderForData:(NSData *)data
-                          decodingError:(NSError **)decodingErrorPointer {
-    int totalLength = [AWSTranscribeStreamingEventDecoder getTotalLengthForData:data];
-    if (data.length < totalLength) {
-        NSString *failureReason = [NSString stringWithFormat:@"Prelude specifies data size of %d, actual size is %lu",
-                                   totalLength,
-                                   data.length];
-        NSDictionary *userInfo = @{NSLocalizedFailureReasonErrorKey: failureReason};
-        *decodingErrorPointer = [NSError errorWithDomain:AWSTranscribeStreamingClientErrorDomain
-                                                    code:AWSTranscribeStreamingClientErrorCodeInvalidMessageLengthHeader
-                                                userInfo:userInfo];
-        return NO;
-    }
-    return YES;
+    AWSDDLogDebug(@"Created AWSTranscribeStreamingTranscriptResultStream from decoded message");
+    return resultStream;
 }
 
-+(NSDictionary<NSString *, NSString *> *)getHeadersForData:(NSData *)data {
-    
-    int headerLen = [AWSTranscribeStreamingEventDecoder getHeaderLengthForData:data];
-    NSData *headerData = [data subdataWithRange:NSMakeRange(12, headerLen)];
-    int currentPosition = 0;
-    NSMutableDictionary<NSString *, NSString *> *dictionary = [NSMutableDictionary new];
-    
-    while (currentPosition < headerLen) {
-        int currentHeaderLen = *(int *)[[headerData subdataWithRange:NSMakeRange(currentPosition, 1)]  bytes];
-        currentPosition++;
-        NSString *headerKey = [[NSString alloc] initWithData:[headerData subdataWithRange:NSMakeRange(currentPosition, currentHeaderLen)] encoding:NSUTF8StringEncoding];
-        AWSDDLogVerbose(@"Header Name: %@", headerKey);
-        currentPosition += currentHeaderLen;
-        
-        // skip header type info, always 7 while decoding
-        currentPosition++;
-        
-        int currentHeaderValueLen = CFSwapInt16(*(UInt16 *)[[headerData subdataWithRange:NSMakeRange(currentPosition, 2)]  bytes]);
-        currentPosition += 2;
-
-        NSString *headerValue = [[NSString alloc] initWithData:[headerData subdataWithRange:NSMakeRange(currentPosition, currentHeaderValueLen)] encoding:NSUTF8StringEncoding];
-        AWSDDLogVerbose(@"Header Value: %@", headerValue);
-
-        dictionary[headerKey] = headerValue;
-
-        currentPosition += currentHeaderValueLen;
++ (NSError *)decodingErrorForEventStreamError:(NSError *)eventStreamError {
+    AWSTranscribeStreamingClientErrorCode code;
+    switch (eventStreamError.code) {
+        case AWSEventStreamErrorIncompletePrelude:
+        case AWSEventStreamErrorPreludeChecksumMismatch:
+            code = AWSTranscribeStreamingClientErrorCodeInvalidMessagePrelude;
+            break;
+        case AWSEventStreamErrorIncompleteMessage:
+        case AWSEventStreamErrorInvalidMessageLength:
+            code = AWSTranscribeStreamingClientErrorCodeInvalidMessageLengthHeader;
+            break;
+        default:
+            code = AWSTranscribeStreamingClientErrorCodeEventSerializationError;
+            break;
     }
-    
-    return [NSDictionary dictionaryWithDictionary:dictionary];
-}
-
-+(NSString *)getBodyForData:(NSData *)data {
-    NSUInteger headerLen = [AWSTranscribeStreamingEventDecoder getHeaderLengthForData:data];
-    NSUInteger messageLen = [data length];
-    NSUInteger dataStartPos = 4 + 4 + 4 + headerLen;
-    NSUInteger dataLen = messageLen - dataStartPos - 4;
-    NSString *dataString = [[NSString alloc] initWithData:[data subdataWithRange:NSMakeRange(dataStartPos, dataLen)] encoding:NSUTF8StringEncoding];
-    return dataString;
-}
-
-+(int)getTotalLengthForData:(NSData *)data {
-    return CFSwapInt32(*(UInt32 *)[[data subdataWithRange:NSMakeRange(0, 4)] bytes]);;
-}
 
-+(int)getHeaderLengthForData:(NSData *)data {
-    return CFSwapInt32(*(UInt32 *)[[data subdataWithRange:NSMakeRange(4, 8)] bytes]);;
+    NSMutableDictionary *userInfo = [NSMutableDictionary new];
+    userInfo[NSUnderlyingErrorKey] = eventStreamError;
+    userInfo[NSLocalizedFailureReasonErrorKey] = eventStreamError.userInfo[NSLocalizedFailureReasonErrorKey];
+    return [NSError errorWithDomain:AWSTranscribeStreamingClientErrorDomain
+                               code:code
+                           userInfo:userInfo];
 }
 
 @end
@@ -247,7 +247,9 @@ static AWSSynchronizedMutableDictionary *_serviceClients = nil;
 
 - (void)sendData:(NSData *)data headers:(NSDictionary *)headers {
     NSData *encodedChunk = [AWSTranscribeEventEncoder encodeChunk:data headers:headers];
-    [self.webSocketProvider send:encodedChunk];
+    if (encodedChunk) {
+        [self.webSocketProvider send:encodedChunk];
+    }
 }
 
 - (void)sendEndFrame {
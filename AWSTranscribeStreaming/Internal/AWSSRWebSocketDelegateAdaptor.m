@@ -55,12 +55,20 @@
     
     AWSDDLogVerbose(@"Web socket %@ didReceiveMessage", webSocket);
     NSError *decodingError;
-    AWSTranscribeStreamingTranscriptResultStream *result = [AWSTranscribeStreamingEventDecoder decodeEvent:(NSData *)data
-                                                                                             decodingError:&decodingError];
+    NSArray<AWSTranscribeStreamingTranscriptResultStream *> *results = [AWSTranscribeStreamingEventDecoder decodeEvents:(NSData *)data
+                                                                                                            decodingError:&decodingError];
     
     dispatch_async(self.callbackQueue, ^(void){
-        [self.clientDelegate didReceiveEvent:result
-                               decodingError:decodingError];
+        if (!results) {
+            [self.clientDelegate didReceiveEvent:nil
+                                   decodingError:decodingError];
+            return;
+        }
+        // A single WebSocket message may carry several events.
+        for (AWSTranscribeStreamingTranscriptResultStream *result in results) {
+            [self.clientDelegate didReceiveEvent:result
+                                   decodingError:nil];
+        }
     });
 }
 
@@ -13,14 +13,15 @@
 // permissions and limitations under the License.
 //
 
+#import <AWSCore/AWSCore.h>
 #import "AWSTranscribeStreamingModel.h"
 
 NS_ASSUME_NONNULL_BEGIN
 
 @interface AWSTranscribeStreamingTranscriptResultStream (Helpers)
 
-+ (nullable AWSTranscribeStreamingTranscriptResultStream *)resultStreamForWSSBody:(NSString *)body
-                                                                          headers:(NSDictionary<NSString *, NSString *> *)headers
+/// Builds a result stream straight from the JSON payload bytes of an event-stream message.
++ (nullable AWSTranscribeStreamingTranscriptResultStream *)resultStreamForMessage:(AWSEventStreamMessage *)message
                                                                             error:(NSError * __autoreleasing *)errorPointer;
 
 @end
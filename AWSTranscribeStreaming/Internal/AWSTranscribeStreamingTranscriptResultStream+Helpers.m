@@ -17,6 +17,76 @@
 #import "AWSTranscribeStreamingTranscriptResultStream+Helpers.h"
 #import "AWSTranscribeStreamingClientDelegate.h"
 
+#pragma mark - Transcript event mapping
+
+// Returns the value for `key` only if it is of the expected class, so that a mistyped value is left unset rather than
+// assigned to a property of another type.
+static inline id AWSTranscribeStreamingJSONValue(NSDictionary *dictionary, NSString *key, Class expectedClass) {
+    id value = dictionary[key];
+    return [value isKindOfClass:expectedClass] ? value : nil;
+}
+
+static NSArray *AWSTranscribeStreamingModelsFromJSONArray(id jsonArray, id (*modelFromJSON)(NSDictionary *)) {
+    if (![jsonArray isKindOfClass:[NSArray class]]) {
+        return nil;
+    }
+    NSMutableArray *models = [NSMutableArray arrayWithCapacity:[jsonArray count]];
+    for (id element in jsonArray) {
+        if ([element isKindOfClass:[NSDictionary class]]) {
+            [models addObject:modelFromJSON(element)];
+        }
+    }
+    return models;
+}
+
+static id AWSTranscribeStreamingItemFromJSON(NSDictionary *json) {
+    AWSTranscribeStreamingItem *item = [AWSTranscribeStreamingItem new];
+    item.content = AWSTranscribeStreamingJSONValue(json, @"Content", [NSString class]);
+    item.endTime = AWSTranscribeStreamingJSONValue(json, @"EndTime", [NSNumber class]);
+    item.startTime = AWSTranscribeStreamingJSONValue(json, @"StartTime", [NSNumber class]);
+
+    // Messaging nil returns 0, which is NSOrderedSame, so a missing type has to be checked for first.
+    NSString *type = AWSTranscribeStreamingJSONValue(json, @"Type", [NSString class]);
+    if (!type) {
+        item.types = AWSTranscribeStreamingItemTypeUnknown;
+    } else if ([type caseInsensitiveCompare:@"PRONUNCIATION"] == NSOrderedSame) {
+        item.types = AWSTranscribeStreamingItemTypePronunciation;
+    } else if ([type caseInsensitiveCompare:@"PUNCTUATION"] == NSOrderedSame) {
+        item.types = AWSTranscribeStreamingItemTypePunctuation;
+    } else {
+        item.types = AWSTranscribeStreamingItemTypeUnknown;
+    }
+    return item;
+}
+
+static id AWSTranscribeStreamingAlternativeFromJSON(NSDictionary *json) {
+    AWSTranscribeStreamingAlternative *alternative = [AWSTranscribeStreamingAlternative new];
+    alternative.items = AWSTranscribeStreamingModelsFromJSONArray(json[@"Items"], AWSTranscribeStreamingItemFromJSON);
+    alternative.transcript = AWSTranscribeStreamingJSONValue(json, @"Transcript", [NSString class]);
+    return alternative;
+}
+
+static id AWSTranscribeStreamingResultFromJSON(NSDictionary *json) {
+    AWSTranscribeStreamingResult *result = [AWSTranscribeStreamingResult new];
+    result.alternatives = AWSTranscribeStreamingModelsFromJSONArray(json[@"Alternatives"], AWSTranscribeStreamingAlternativeFromJSON);
+    result.endTime = AWSTranscribeStreamingJSONValue(json, @"EndTime", [NSNumber class]);
+    result.isPartial = AWSTranscribeStreamingJSONValue(json, @"IsPartial", [NSNumber class]);
+    result.resultId = AWSTranscribeStreamingJSONValue(json, @"ResultId", [NSString class]);
+    result.startTime = AWSTranscribeStreamingJSONValue(json, @"StartTime", [NSNumber class]);
+    return result;
+}
+
+static AWSTranscribeStreamingTranscriptEvent *AWSTranscribeStreamingTranscriptEventFromJSON(NSDictionary *json) {
+    AWSTranscribeStreamingTranscriptEvent *transcriptEvent = [AWSTranscribeStreamingTranscriptEvent new];
+    NSDictionary *transcriptJSON = AWSTranscribeStreamingJSONValue(json, @"Transcript", [NSDictionary class]);
+    if (transcriptJSON) {
+        AWSTranscribeStreamingTranscript *transcript = [AWSTranscribeStreamingTranscript new];
+        transcript.results = AWSTranscribeStreamingModelsFromJSONArray(transcriptJSON[@"Results"], AWSTranscribeStreamingResultFromJSON);
+        transcriptEvent.transcript = transcript;
+    }
+    return transcriptEvent;
+}
+
 @implementation AWSTranscribeStreamingTranscriptResultStream (Helpers)
 
 static NSDictionary *errorCodeDictionary = nil;
@@ -29,32 +99,33 @@ static NSDictionary *errorCodeDictionary = nil;
                             };
 }
 
-+ (nullable AWSTranscribeStreamingTranscriptResultStream *)resultStreamForWSSBody:(NSString *)body
-                                                                          headers:(NSDictionary<NSString *, NSString *> *)headers
++ (nullable AWSTranscribeStreamingTranscriptResultStream *)resultStreamForMessage:(AWSEventStreamMessage *)message
                                                                             error:(NSError * __autoreleasing *)errorPointer {
-    
-    NSDictionary *jsonObject = [NSJSONSerialization JSONObjectWithData:[body dataUsingEncoding:NSUTF8StringEncoding]
-                                                               options:NSJSONReadingMutableContainers
-                                                                 error:errorPointer];
+    // Partial results arrive many times per second, so the payload is parsed into immutable containers and mapped onto
+    // the model by hand rather than through AWSMTLJSONAdapter.
+    id jsonObject = [NSJSONSerialization JSONObjectWithData:message.payload
+                                                    options:0
+                                                      error:errorPointer];
     
     if (!jsonObject || *errorPointer) {
         return nil;
     }
     
+    NSString *messageType = [message stringValueForHeader:@":message-type"];
+    if (![jsonObject isKindOfClass:[NSDictionary class]]) {
+        messageType = nil;
+    }
+    
     // Populate error payload
-    if ([headers[@":message-type"] isEqualToString:@"exception"]) {
-        NSString *errorType = headers[@":exception-type"];
+    if ([messageType isEqualToString:@"exception"]) {
+        NSString *errorType = [message stringValueForHeader:@":exception-type"];
         AWSTranscribeStreamingTranscriptResultStream *resultStream = [AWSTranscribeStreamingTranscriptResultStream resultStreamErrorMemberForJSONObject:jsonObject
                                                                                                                                               errorType:errorType
                                                                                                                                                   error:errorPointer];
         return resultStream;
-    } else if ([headers[@":message-type"] isEqualToString:@"event"]) {
-        AWSTranscribeStreamingTranscriptEvent *transcriptEvent = [AWSMTLJSONAdapter modelOfClass:[AWSTranscribeStreamingTranscriptEvent class]
-                                                                              fromJSONDictionary:jsonObject
-                                                                                           error:errorPointer];
-
+    } else if ([messageType isEqualToString:@"event"]) {
         AWSTranscribeStreamingTranscriptResultStream *resultStream = [[AWSTranscribeStreamingTranscriptResultStream alloc] init];
-        resultStream.transcriptEvent = transcriptEvent;
+        resultStream.transcriptEvent = AWSTranscribeStreamingTranscriptEventFromJSON(jsonObject);
         return resultStream;
     } else {
         NSDictionary *userInfo = @{
@@ -0,0 +1,150 @@
+//
+// Copyright 2010-2022 Amazon.com, Inc. or its affiliates. All Rights Reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// A copy of the License is located at
+//
+// http://aws.amazon.com/apache2.0
+//
+// or in the "license" file accompanying this file. This file is distributed
+// on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either
+// express or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+//
+
+import XCTest
+
+@testable import AWSTranscribeStreaming
+
+class AWSTranscribeStreamingEventDecoderTests: XCTestCase {
+
+    /// Number of captured events concatenated into the stream used by the benchmarks
+    static let benchmarkEventCount = 1_000
+
+    /// - Given: A captured transcript event
+    /// - When: The event is decoded
+    /// - Then: Every field of the transcript is mapped onto the model
+    func testDecodesAllTranscriptFields() throws {
+        let resultStream = try decodeSingleEvent(TestData.transcriptEventData)
+
+        let result = try XCTUnwrap(resultStream.transcriptEvent?.transcript?.results?.first)
+        XCTAssertEqual(result.endTime, 0.53)
+        XCTAssertEqual(result.startTime, 0.12)
+        XCTAssertEqual(result.isPartial, true)
+        XCTAssertEqual(result.resultId, "94862f4a-3793-4e5b-8e85-1915c8d33f92")
+
+        let alternative = try XCTUnwrap(result.alternatives?.first)
+        XCTAssertEqual(alternative.transcript, "Hello were")
+
+        let items = try XCTUnwrap(alternative.items)
+        XCTAssertEqual(items.count, 2)
+        XCTAssertEqual(items[0].content, "Hello")
+        XCTAssertEqual(items[0].startTime, 0.12)
+        XCTAssertEqual(items[0].endTime, 0.21)
+        XCTAssertEqual(items[0].types, .pronunciation)
+        XCTAssertEqual(items[1].content, "were")
+        XCTAssertEqual(items[1].startTime, 0.22)
+        XCTAssertEqual(items[1].endTime, 0.49)
+        XCTAssertEqual(items[1].types, .pronunciation)
+    }
+
+    /// - Given: A transcript event whose items have a missing, mistyped or unrecognized `Type`
+    /// - When: The event is decoded
+    /// - Then: Those items are `.unknown`, as they were when decoded through `AWSMTLJSONAdapter`
+    func testItemWithoutTypeIsUnknown() throws {
+        let payload = #"{"Transcript":{"Results":[{"Alternatives":[{"Items":["#
+            + #"{"Content":"Hello","EndTime":0.21,"StartTime":0.12},"#
+            + #"{"Content":"were","Type":1},"#
+            + #"{"Content":".","Type":"other"},"#
+            + #"{"Content":",","Type":"punctuation"}]}]}]}}"#
+        let data = try AWSEventStreamEncoder.encodeMessage(withStringHeaders: [":event-type": "TranscriptEvent",
+                                                                               ":content-type": "application/json",
+                                                                               ":message-type": "event"],
+                                                           payload: Data(payload.utf8))
+        let resultStream = try decodeSingleEvent(data)
+
+        let items = try XCTUnwrap(resultStream.transcriptEvent?.transcript?.results?.first?.alternatives?.first?.items)
+        XCTAssertEqual(items.count, 4)
+        XCTAssertEqual(items[0].content, "Hello")
+        XCTAssertEqual(items[0].types, .unknown)
+        XCTAssertEqual(items[1].types, .unknown)
+        XCTAssertEqual(items[2].types, .unknown)
+        XCTAssertEqual(items[3].types, .punctuation)
+    }
+
+    /// - Given: A captured exception event
+    /// - When: The event is decoded
+    /// - Then: The matching exception member is populated and no transcript is present
+    func testDecodesExceptionEvent() throws {
+        let resultStream = try decodeSingleEvent(TestData.transcriptErrorEvent)
+
+        XCTAssertNotNil(resultStream.badRequestException)
+        XCTAssertEqual(resultStream.badRequestException?.localizedDescription,
+                       "Your request timed out because no new audio was received for 15 seconds.")
+        XCTAssertNil(resultStream.transcriptEvent)
+    }
+
+    /// - Given: Several events delivered in one message
+    /// - When: The message is decoded
+    /// - Then: One result stream is returned per event, in order
+    func testDecodesConcatenatedEvents() throws {
+        var data = TestData.transcriptEventData
+        data.append(TestData.transcriptErrorEvent)
+
+        var decodingError: NSError?
+        let resultStreams = AWSTranscribeStreamingEventDecoder.decodeEvents(data, decodingError: &decodingError)
+
+        XCTAssertNil(decodingError)
+        XCTAssertEqual(resultStreams?.count, 2)
+        XCTAssertNotNil(resultStreams?.first?.transcriptEvent)
+        XCTAssertNotNil(resultStreams?.last?.badRequestException)
+    }
+
+    // MARK: - Benchmarks
+
+    /// Decodes a captured stream of partial results, as delivered while a user is speaking
+    func testDecodeThroughput() {
+        let data = capturedStream()
+
+        measure {
+            var decodingError: NSError?
+            let resultStreams = AWSTranscribeStreamingEventDecoder.decodeEvents(data, decodingError: &decodingError)
+            XCTAssertEqual(resultStreams?.count, AWSTranscribeStreamingEventDecoderTests.benchmarkEventCount)
+        }
+    }
+
+    /// Baseline for `testDecodeThroughput`: the previous path through a string, mutable JSON containers and
+    /// `AWSMTLJSONAdapter`, applied to the same payloads
+    func testDecodeThroughputWithJSONAdapter() throws {
+        let messages = try XCTUnwrap(AWSEventStreamDecoder.decodeMessages(from: capturedStream()))
+
+        measure {
+            let jsonObjects = messages.compactMap { message -> Any? in
+                let body = String(data: message.payload, encoding: .utf8)!
+                return try? JSONSerialization.jsonObject(with: body.data(using: .utf8)!, options: .mutableContainers)
+            }
+            let events = try? AWSMTLJSONAdapter.models(of: AWSTranscribeStreamingTranscriptEvent.self,
+                                                       fromJSONArray: jsonObjects)
+            XCTAssertEqual(events?.count, AWSTranscribeStreamingEventDecoderTests.benchmarkEventCount)
+        }
+    }
+
+    // MARK: - Utilities
+
+    func decodeSingleEvent(_ data: Data) throws -> AWSTranscribeStreamingTranscriptResultStream {
+        var decodingError: NSError?
+        let resultStream = AWSTranscribeStreamingEventDecoder.decodeEvent(data, decodingError: &decodingError)
+        XCTAssertNil(decodingError)
+        return try XCTUnwrap(resultStream)
+    }
+
+    func capturedStream() -> Data {
+        var data = Data()
+        for _ in 0 ..< AWSTranscribeStreamingEventDecoderTests.benchmarkEventCount {
+            data.append(TestData.transcriptEventData)
+        }
+        return data
+    }
+
+}